@@ -0,0 +1,602 @@
+/* fdatasync and fileno aren't part of strict C11 mode. */
+#ifndef _DEFAULT_SOURCE
+#	define _DEFAULT_SOURCE
+#endif
+
+#include <stdatomic.h>
+#include "harbol.h"
+#ifndef OS_WINDOWS
+#	include <unistd.h>
+#endif
+
+/* throughput numbers for the containers where speed is the whole point.
+ * build with 'make bench'; it takes POSIX threads, so it doesn't run on Windows.
+ */
+
+static double bench_now(void)
+{
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+void bench_harbol_lockfree(void);
+void bench_harbol_bytebuffer(void);
+void bench_harbol_lz(void);
+void bench_harbol_checksum(void);
+void bench_harbol_encoding(void);
+void bench_harbol_filewriter(void);
+void bench_harbol_tuple(void);
+void bench_harbol_coltable(void);
+
+int main(void)
+{
+	bench_harbol_lockfree();
+	bench_harbol_bytebuffer();
+	bench_harbol_lz();
+	bench_harbol_checksum();
+	bench_harbol_encoding();
+	bench_harbol_filewriter();
+	bench_harbol_tuple();
+	bench_harbol_coltable();
+	return 0;
+}
+
+
+/* Lock-Free Stack and Queue benchmark */
+/////////////////////////////////////////
+#define BENCH_LF_ITEMS    1000000
+
+enum BenchLFKind {
+	BenchLFQueue, BenchLFStack, BenchLockedFIFO, BenchLockedLIFO,
+};
+
+struct BenchLFShared {
+	struct HarbolLFQueue Queue;
+	struct HarbolLFStack Stack;
+	struct HarbolBiList List;
+	pthread_mutex_t Lock;
+	_Atomic size_t Consumed;
+	size_t Total;
+	enum BenchLFKind Kind;
+};
+
+static bool bench_lf_put(struct BenchLFShared *const s, const union HarbolValue v)
+{
+	switch( s->Kind ) {
+		case BenchLFQueue: return harbol_lfqueue_enqueue(&s->Queue, v);
+		case BenchLFStack: return harbol_lfstack_push(&s->Stack, v);
+		default: {
+			pthread_mutex_lock(&s->Lock);
+			const bool res = harbol_bilist_insert_at_tail(&s->List, v);
+			pthread_mutex_unlock(&s->Lock);
+			return res;
+		}
+	}
+}
+
+static bool bench_lf_take(struct BenchLFShared *const s, union HarbolValue *const v)
+{
+	switch( s->Kind ) {
+		case BenchLFQueue: return harbol_lfqueue_dequeue(&s->Queue, v);
+		case BenchLFStack: return harbol_lfstack_pop(&s->Stack, v);
+		default: {
+			pthread_mutex_lock(&s->Lock);
+			struct HarbolBiListNode *node = ( s->Kind==BenchLockedFIFO ) ? s->List.Head : s->List.Tail;
+			const bool res = node != NULL;
+			if( res ) {
+				*v = node->Data;
+				harbol_bilist_del_node_by_ref(&s->List, &node, NULL);
+			}
+			pthread_mutex_unlock(&s->Lock);
+			return res;
+		}
+	}
+}
+
+static void *bench_lf_producer(void *const arg)
+{
+	struct BenchLFShared *const s = arg;
+	for( size_t n=0; n<BENCH_LF_ITEMS; n++ )
+		bench_lf_put(s, (union HarbolValue){.UInt64=n});
+	return NULL;
+}
+
+static void *bench_lf_consumer(void *const arg)
+{
+	struct BenchLFShared *const s = arg;
+	union HarbolValue v;
+	while( atomic_load_explicit(&s->Consumed, memory_order_relaxed) < s->Total )
+		if( bench_lf_take(s, &v) )
+			atomic_fetch_add_explicit(&s->Consumed, 1, memory_order_relaxed);
+	return NULL;
+}
+
+static double bench_lf_run(const enum BenchLFKind kind, const size_t producers, const size_t consumers)
+{
+	struct BenchLFShared *const s = calloc(1, sizeof *s);
+	if( !s )
+		return 0.0;
+	
+	s->Kind = kind;
+	s->Total = producers * BENCH_LF_ITEMS;
+	harbol_lfstack_init(&s->Stack);
+	harbol_lfqueue_init(&s->Queue);
+	pthread_mutex_init(&s->Lock, NULL);
+	
+	pthread_t threads[16];
+	const double start = bench_now();
+	for( size_t i=0; i<producers; i++ )
+		pthread_create(&threads[i], NULL, bench_lf_producer, s);
+	for( size_t i=0; i<consumers; i++ )
+		pthread_create(&threads[producers + i], NULL, bench_lf_consumer, s);
+	for( size_t i=0; i<producers + consumers; i++ )
+		pthread_join(threads[i], NULL);
+	const double secs = bench_now() - start;
+	
+	harbol_lfstack_del(&s->Stack, NULL);
+	harbol_lfqueue_del(&s->Queue, NULL);
+	harbol_bilist_del(&s->List, NULL);
+	pthread_mutex_destroy(&s->Lock);
+	const double mops = (double)s->Total / secs / 1e6;
+	free(s);
+	return mops;
+}
+
+void bench_harbol_lockfree(void)
+{
+	static const char *const names[] = { "lfqueue", "lfstack", "mutex bilist (fifo)", "mutex bilist (lifo)" };
+	static const size_t configs[][2] = { {1,1}, {2,2}, {4,4}, {8,8} };
+	
+	puts("lockfree :: producer/consumer throughput, million items/sec.");
+	printf("%-22s", "producers x consumers");
+	for( size_t c=0; c<sizeof configs / sizeof configs[0]; c++ )
+		printf(" | %6zux%-3zu", configs[c][0], configs[c][1]);
+	putchar('\n');
+	for( enum BenchLFKind k=BenchLFQueue; k<=BenchLockedLIFO; k++ ) {
+		printf("%-22s", names[k]);
+		for( size_t c=0; c<sizeof configs / sizeof configs[0]; c++ )
+			printf(" | %10.2f", bench_lf_run(k, configs[c][0], configs[c][1]));
+		putchar('\n');
+	}
+	putchar('\n');
+}
+/////////////////////////////////////////
+
+
+/* Byte Buffer benchmark */
+/////////////////////////////////////////
+#define BENCH_BB_BYTES    (100u * 1024u * 1024u)
+
+void bench_harbol_bytebuffer(void)
+{
+	puts("bytebuffer :: serializing 100MB.");
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	
+	double start = bench_now();
+	for( size_t n=0; n<BENCH_BB_BYTES; n++ )
+		harbol_bytebuffer_insert_byte(&buf, (uint8_t)n);
+	double secs = bench_now() - start;
+	printf("%-32s | %8.3f s | %9.1f MB/s | capacity %zu\n", "insert_byte, growing", secs, BENCH_BB_BYTES / secs / (1024.0 * 1024.0), harbol_bytebuffer_get_len(&buf));
+	harbol_bytebuffer_del(&buf);
+	
+	start = bench_now();
+	harbol_bytebuffer_reserve(&buf, BENCH_BB_BYTES);
+	for( size_t n=0; n<BENCH_BB_BYTES; n++ )
+		harbol_bytebuffer_insert_byte(&buf, (uint8_t)n);
+	secs = bench_now() - start;
+	printf("%-32s | %8.3f s | %9.1f MB/s\n", "insert_byte, reserved", secs, BENCH_BB_BYTES / secs / (1024.0 * 1024.0));
+	harbol_bytebuffer_del(&buf);
+	
+	start = bench_now();
+	for( size_t n=0; n<BENCH_BB_BYTES; n += sizeof(uint64_t) )
+		harbol_bytebuffer_insert_integer(&buf, n, sizeof(uint64_t));
+	secs = bench_now() - start;
+	printf("%-32s | %8.3f s | %9.1f MB/s\n", "insert_integer (8 bytes)", secs, BENCH_BB_BYTES / secs / (1024.0 * 1024.0));
+	harbol_bytebuffer_del(&buf);
+	
+	// writing whole blocks straight into spare capacity.
+	start = bench_now();
+	for( size_t n=0; n<BENCH_BB_BYTES; n += 4096 ) {
+		uint8_t *const block = harbol_bytebuffer_prepare(&buf, 4096);
+		for( size_t k=0; k<4096; k++ )
+			block[k] = (uint8_t)(n + k);
+		harbol_bytebuffer_commit(&buf, 4096);
+	}
+	secs = bench_now() - start;
+	printf("%-32s | %8.3f s | %9.1f MB/s\n", "prepare/commit (4K blocks)", secs, BENCH_BB_BYTES / secs / (1024.0 * 1024.0));
+	harbol_bytebuffer_del(&buf);
+	putchar('\n');
+}
+/////////////////////////////////////////
+
+
+/* LZ Compression benchmark */
+/////////////////////////////////////////
+#define BENCH_LZ_BYTES    (32u * 1024u * 1024u)
+
+/* the corpus: config-like text, serialized records and random bytes. */
+static void bench_lz_corpus(struct HarbolByteBuffer *const buf, const int kind)
+{
+	static const char *const words[] = {
+		"'name': ", "'value': ", "'enabled': true, ", "'count': ", "'section' { ", "}, ", "\"harbol\" ", "0x7f, ", "null, ", "\n\t",
+		"'path': \"/usr/local/share\", ", "'color': c[255, 128, 0, 255], ", "'origin': v[0.0, 24.43, 25.0], ", "3.14159, ", "'id': ", "\n",
+	};
+	uint64_t seed = 0x9E3779B97F4A7C15ull;
+	struct HarbolByteWriter w;
+	harbol_bytewriter_init(&w, buf);
+	while( buf->Count < BENCH_LZ_BYTES ) {
+		seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+		switch( kind ) {
+			case 0: {
+				const char *const word = words[seed % (sizeof words / sizeof words[0])];
+				harbol_bytewriter_put_bytes(&w, word, strlen(word));
+				break;
+			}
+			case 1:
+				harbol_bytewriter_put_u32_le(&w, (uint32_t)(buf->Count / 24));
+				harbol_bytewriter_put_u16_le(&w, (uint16_t)(seed % 100));
+				harbol_bytewriter_put_f64_le(&w, (double)(seed % 10000) / 100.0);
+				harbol_bytewriter_put_uvarint(&w, seed % 5000);
+				harbol_bytewriter_put_u8(&w, (uint8_t)(seed >> 60));
+				break;
+			default:
+				harbol_bytewriter_put_u64_le(&w, seed);
+		}
+	}
+	buf->Count = BENCH_LZ_BYTES;
+}
+
+void bench_harbol_lz(void)
+{
+	static const char *const names[] = { "config text", "serialized records", "random bytes" };
+	puts("lz :: 32MB per corpus, 4MB blocks; GB/s of uncompressed data.");
+	printf("%-20s | %7s | %10s | %10s\n", "corpus", "ratio", "compress", "decompress");
+	for( int kind=0; kind<3; kind++ ) {
+		struct HarbolByteBuffer raw = (struct HarbolByteBuffer){0}, frame = (struct HarbolByteBuffer){0}, back = (struct HarbolByteBuffer){0};
+		bench_lz_corpus(&raw, kind);
+		harbol_bytebuffer_reserve(&frame, harbol_lz_compress_bound(raw.Count) + 1024);
+		harbol_bytebuffer_reserve(&back, raw.Count);
+		
+		double start = bench_now();
+		harbol_lz_compress_buffer(&raw, &frame, 0);
+		const double csecs = bench_now() - start;
+		start = bench_now();
+		const bool ok = harbol_lz_decompress_buffer(&frame, &back);
+		const double dsecs = bench_now() - start;
+		
+		const double gb = (double)raw.Count / 1e9;
+		printf("%-20s | %7.2f | %10.2f | %10.2f%s\n", names[kind], (double)raw.Count / (double)frame.Count, gb / csecs, gb / dsecs, ( ok && back.Count==raw.Count && !memcmp(back.Buffer, raw.Buffer, raw.Count) ) ? "" : " (MISMATCH)");
+		harbol_bytebuffer_del(&raw);
+		harbol_bytebuffer_del(&frame);
+		harbol_bytebuffer_del(&back);
+	}
+	putchar('\n');
+}
+/////////////////////////////////////////
+
+
+/* Checksum benchmark */
+/////////////////////////////////////////
+#define BENCH_CK_BYTES    (64u * 1024u * 1024u)
+#define BENCH_CK_ROUNDS   4
+
+/* a plain one-table, byte-at-a-time crc for comparison. */
+static uint32_t bench_crc32c_bytewise(uint32_t crc, const uint8_t *p, size_t len)
+{
+	static uint32_t table[256];
+	if( !table[1] )
+		for( uint32_t n=0; n<256; n++ ) {
+			uint32_t c = n;
+			for( size_t k=0; k<8; k++ )
+				c = ( c & 1 ) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+			table[n] = c;
+		}
+	crc = ~crc;
+	while( len-- )
+		crc = table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+	return ~crc;
+}
+
+void bench_harbol_checksum(void)
+{
+	printf("checksum :: %u rounds over 64MB, GB/s.\n", BENCH_CK_ROUNDS);
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	uint8_t *const data = harbol_bytebuffer_prepare(&buf, BENCH_CK_BYTES);
+	for( size_t n=0; n<BENCH_CK_BYTES; n++ )
+		data[n] = (uint8_t)(n * 2654435761u >> 13);
+	harbol_bytebuffer_commit(&buf, BENCH_CK_BYTES);
+	
+	const double gb = (double)BENCH_CK_BYTES * BENCH_CK_ROUNDS / 1e9;
+	uint64_t sink = 0;
+	double start = bench_now();
+	for( size_t r=0; r<BENCH_CK_ROUNDS; r++ )
+		sink += bench_crc32c_bytewise(0, buf.Buffer, buf.Count);
+	printf("%-32s | %8.2f\n", "crc32c, bytewise table", gb / (bench_now() - start));
+	
+	start = bench_now();
+	for( size_t r=0; r<BENCH_CK_ROUNDS; r++ )
+		sink += harbol_crc32c_sw(0, buf.Buffer, buf.Count);
+	printf("%-32s | %8.2f\n", "crc32c, slicing-by-8", gb / (bench_now() - start));
+	
+	start = bench_now();
+	for( size_t r=0; r<BENCH_CK_ROUNDS; r++ )
+		sink += harbol_crc32c_bytebuffer(0, &buf);
+	printf("%-32s | %8.2f\n", harbol_crc32c_is_hw() ? "crc32c, sse4.2 3-way" : "crc32c, dispatched (software)", gb / (bench_now() - start));
+	
+	start = bench_now();
+	for( size_t r=0; r<BENCH_CK_ROUNDS; r++ )
+		sink += harbol_xxh64(buf.Buffer, buf.Count, r);
+	printf("%-32s | %8.2f\n", "xxh64", gb / (bench_now() - start));
+	printf("(checksum sum %016" PRIx64 ")\n\n", sink);
+	harbol_bytebuffer_del(&buf);
+}
+/////////////////////////////////////////
+
+
+/* Encoding benchmark */
+/////////////////////////////////////////
+#define BENCH_ENC_BYTES   (16u * 1024u * 1024u)
+
+void bench_harbol_encoding(void)
+{
+	printf("encoding :: 16MB of input, MB/s of input.\n");
+	uint8_t *const data = malloc(BENCH_ENC_BYTES);
+	for( size_t n=0; n<BENCH_ENC_BYTES; n++ )
+		data[n] = (uint8_t)(n * 2654435761u >> 13);
+	const double mb = (double)BENCH_ENC_BYTES / 1e6;
+	
+	// the usual hand-rolled hex dump.
+	char *const text = malloc(BENCH_ENC_BYTES * 2 + 1);
+	double start = bench_now();
+	for( size_t n=0; n<BENCH_ENC_BYTES; n++ )
+		sprintf(text + n * 2, "%02x", data[n]);
+	printf("%-32s | %8.1f\n", "hex encode, sprintf", mb / (bench_now() - start));
+	
+	struct HarbolString str = {NULL, 0};
+	start = bench_now();
+	harbol_hex_encode_to_string(&str, data, BENCH_ENC_BYTES, false);
+	printf("%-32s | %8.1f\n", "hex encode", mb / (bench_now() - start));
+	
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	start = bench_now();
+	harbol_hex_decode(&buf, str.CStr, str.Len, NULL);
+	printf("%-32s | %8.1f\n", "hex decode", mb / (bench_now() - start));
+	
+	harbol_string_del(&str);
+	harbol_bytebuffer_clear(&buf);
+	start = bench_now();
+	harbol_base64_encode_to_string(&str, data, BENCH_ENC_BYTES, HarbolBase64Std, true);
+	printf("%-32s | %8.1f\n", "base64 encode", mb / (bench_now() - start));
+	
+	start = bench_now();
+	harbol_base64_decode(&buf, str.CStr, str.Len, HarbolBase64Std, NULL);
+	printf("%-32s | %8.1f\n", "base64 decode", mb / (bench_now() - start));
+	printf("(round trip %s)\n\n", ( buf.Count==BENCH_ENC_BYTES && !memcmp(buf.Buffer, data, BENCH_ENC_BYTES) ) ? "ok" : "FAILED");
+	
+	harbol_string_del(&str);
+	harbol_bytebuffer_del(&buf);
+	free(text);
+	free(data);
+}
+/////////////////////////////////////////
+
+
+/* File writer benchmark */
+/////////////////////////////////////////
+#define BENCH_FW_RECORDS      512
+#define BENCH_FW_RECORD_LEN   (128u * 1024u)
+
+/* what the caller's loop sees: total time spent in write calls and the longest single stall. */
+void bench_harbol_filewriter(void)
+{
+	printf("filewriter :: %u records of 128KB, each made durable in batches; caller-side ms.\n", BENCH_FW_RECORDS);
+	uint8_t *const record = malloc(BENCH_FW_RECORD_LEN);
+	memset(record, 0x5A, BENCH_FW_RECORD_LEN);
+	
+	FILE *const file = fopen("bench_filewriter.bin", "wb");
+	double busy = 0.0, worst = 0.0;
+	for( size_t i=0; i<BENCH_FW_RECORDS; i++ ) {
+		struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+		memcpy(harbol_bytebuffer_prepare(&buf, BENCH_FW_RECORD_LEN), record, BENCH_FW_RECORD_LEN);
+		harbol_bytebuffer_commit(&buf, BENCH_FW_RECORD_LEN);
+		const double start = bench_now();
+		harbol_bytebuffer_to_file(&buf, file);
+		if( i % 32==31 ) {
+			fflush(file);
+			fdatasync(fileno(file));
+		}
+		const double took = bench_now() - start;
+		busy += took, worst = ( took > worst ) ? took : worst;
+		harbol_bytebuffer_del(&buf);
+	}
+	fclose(file);
+	printf("%-32s | total %8.2f | worst %8.3f\n", "fwrite + fdatasync", busy * 1e3, worst * 1e3);
+	
+	struct HarbolFileWriter fw;
+	harbol_filewriter_open(&fw, "bench_filewriter.bin", 0, 0, NULL, NULL);
+	busy = worst = 0.0;
+	for( size_t i=0; i<BENCH_FW_RECORDS; i++ ) {
+		struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+		memcpy(harbol_bytebuffer_prepare(&buf, BENCH_FW_RECORD_LEN), record, BENCH_FW_RECORD_LEN);
+		harbol_bytebuffer_commit(&buf, BENCH_FW_RECORD_LEN);
+		const double start = bench_now();
+		harbol_filewriter_submit(&fw, &buf, true);
+		if( i % 32==31 )
+			harbol_filewriter_barrier(&fw);
+		const double took = bench_now() - start;
+		busy += took, worst = ( took > worst ) ? took : worst;
+	}
+	const double start = bench_now();
+	harbol_filewriter_flush(&fw, true);
+	printf("%-32s | total %8.2f | worst %8.3f | final flush %8.2f\n", "filewriter submit + barrier", busy * 1e3, worst * 1e3, (bench_now() - start) * 1e3);
+	harbol_filewriter_del(&fw);
+	remove("bench_filewriter.bin");
+	free(record);
+	putchar('\n');
+}
+/////////////////////////////////////////
+
+
+/* Tuple benchmark */
+/////////////////////////////////////////
+#define BENCH_TUPLE_COUNT    1000000
+
+void bench_harbol_tuple(void)
+{
+	printf("tuple :: %u records of {int64, char, int, short}: create + set a field, sum that field, free; ms.\n", BENCH_TUPLE_COUNT);
+	const size_t sizes[] = { sizeof(int64_t), sizeof(char), sizeof(int), sizeof(short) };
+	int64_t sink = 0;
+	
+	struct HarbolTuple **const tuples = malloc(BENCH_TUPLE_COUNT * sizeof *tuples);
+	double start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ ) {
+		tuples[i] = harbol_tuple_new(4, sizes, false);
+		int c = (int)i;
+		harbol_tuple_set_field(tuples[i], 2, &c);
+	}
+	const double tup_fill = bench_now() - start;
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ )
+		sink += *(int *)harbol_tuple_get_field(tuples[i], 2);
+	const double tup_scan = bench_now() - start;
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ )
+		harbol_tuple_free(&tuples[i]);
+	printf("%-32s | fill %8.1f | scan %8.1f | free %8.1f\n", "HarbolTuple", tup_fill * 1e3, tup_scan * 1e3, (bench_now() - start) * 1e3);
+	free(tuples);
+	
+	struct HarbolTupleSchema schema;
+	harbol_tuple_schema_init(&schema, 4, sizes, false);
+	struct HarbolTupleInst **const insts = malloc(BENCH_TUPLE_COUNT * sizeof *insts);
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ ) {
+		insts[i] = harbol_tuple_inst_new(&schema);
+		int c = (int)i;
+		harbol_tuple_inst_set_field(insts[i], 2, &c);
+	}
+	const double inst_fill = bench_now() - start;
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ )
+		sink += *(int *)harbol_tuple_inst_get_field(insts[i], 2);
+	const double inst_scan = bench_now() - start;
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ )
+		harbol_tuple_inst_free(&insts[i]);
+	printf("%-32s | fill %8.1f | scan %8.1f | free %8.1f\n", "schema + HarbolTupleInst", inst_fill * 1e3, inst_scan * 1e3, (bench_now() - start) * 1e3);
+	free(insts);
+	printf("(heap bytes per record before malloc overhead: tuple %zu in 3 blocks, instance %zu in 1; sum %" PRId64 ")\n\n",
+		sizeof(struct HarbolTuple) + 4 * sizeof(union HarbolValue) + schema.Len, sizeof(struct HarbolTupleInst) + schema.Len, sink);
+	
+	printf("tuple :: %u records: serialize into a byte buffer, read back, sum a field; ms.\n", BENCH_TUPLE_COUNT);
+	struct HarbolTuple **const records = malloc(BENCH_TUPLE_COUNT * sizeof *records);
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ ) {
+		records[i] = harbol_tuple_new(4, sizes, false);
+		int c = (int)i;
+		harbol_tuple_set_field(records[i], 2, &c);
+	}
+	struct HarbolByteBuffer wire = (struct HarbolByteBuffer){0};
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ )
+		harbol_bytebuffer_insert_obj(&wire, records[i]->Datum, records[i]->Len);
+	const double loop_out = bench_now() - start;
+	start = bench_now();
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ ) {
+		struct HarbolTuple *t = harbol_tuple_new(4, sizes, false);
+		memcpy(t->Datum, &wire.Buffer[i * t->Len], t->Len);
+		sink += *(int *)harbol_tuple_get_field(t, 2);
+		harbol_tuple_free(&t);
+	}
+	printf("%-33s | write %8.1f | read %8.1f\n", "per-tuple Datum copies", loop_out * 1e3, (bench_now() - start) * 1e3);
+	harbol_bytebuffer_del(&wire);
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ )
+		harbol_tuple_free(&records[i]);
+	free(records);
+	
+	struct HarbolTupleArray arr;
+	harbol_tuple_array_init(&arr, &schema);
+	harbol_tuple_array_reserve(&arr, BENCH_TUPLE_COUNT);
+	for( size_t i=0; i<BENCH_TUPLE_COUNT; i++ ) {
+		int c = (int)i;
+		harbol_tuple_array_append(&arr, NULL);
+		harbol_tuple_array_set_field(&arr, i, 2, &c);
+	}
+	start = bench_now();
+	harbol_tuple_array_serialize(&arr, &wire);
+	const double bulk_out = bench_now() - start;
+	start = bench_now();
+	struct HarbolTupleArray view = {0};
+	harbol_tuple_array_view(&view, wire.Buffer, wire.Count, NULL);
+	for( size_t i=0; i<harbol_tuple_array_get_count(&view); i++ )
+		sink += *(int *)harbol_tuple_array_get_field(&view, i, 2);
+	printf("%-33s | write %8.1f | read %8.1f | sum %" PRId64 "\n\n", "HarbolTupleArray serialize + view", bulk_out * 1e3, (bench_now() - start) * 1e3, sink);
+	harbol_tuple_array_del(&view);
+	harbol_tuple_array_del(&arr);
+	harbol_bytebuffer_del(&wire);
+	harbol_tuple_schema_del(&schema);
+}
+/////////////////////////////////////////
+
+
+/* Columnar table benchmark */
+/////////////////////////////////////////
+#define BENCH_COL_ROWS    1000000
+#define BENCH_COL_ROUNDS  10
+
+void bench_harbol_coltable(void)
+{
+	printf("coltable :: %u rows of {int64, float, int32, uint8}, %u rounds of 'sum qty where qty > 0 and price < 50'; ms.\n", BENCH_COL_ROWS, BENCH_COL_ROUNDS);
+	const size_t sizes[] = { sizeof(int64_t), sizeof(float), sizeof(int32_t), sizeof(uint8_t) };
+	struct HarbolTupleSchema schema;
+	harbol_tuple_schema_init(&schema, 4, sizes, false);
+	struct HarbolColTable table;
+	harbol_coltable_init(&table, &schema);
+	harbol_coltable_reserve(&table, BENCH_COL_ROWS);
+	struct HarbolVector tuples = {0};
+	for( size_t i=0; i<BENCH_COL_ROWS; i++ ) {
+		struct HarbolTuple *const tup = harbol_tuple_new(4, sizes, false);
+		const int64_t id = (int64_t)i;
+		const float price = (float)(i * 2654435761u % 100);
+		const int32_t qty = (int32_t)(i * 40503u % 61) - 30;
+		harbol_tuple_set_field(tup, 0, (void *)&id);
+		harbol_tuple_set_field(tup, 1, (void *)&price);
+		harbol_tuple_set_field(tup, 2, (void *)&qty);
+		harbol_vector_insert(&tuples, (union HarbolValue){ .Ptr = tup });
+		harbol_coltable_append_tuple(&table, tup);
+	}
+	
+	int64_t rows_sum = 0, cols_sum = 0;
+	double start = bench_now();
+	for( size_t r=0; r<BENCH_COL_ROUNDS; r++ )
+		for( size_t i=0; i<tuples.Count; i++ ) {
+			const struct HarbolTuple *const tup = tuples.Table[i].Ptr;
+			const int32_t qty = *(const int32_t *)harbol_tuple_get_field(tup, 2);
+			if( qty > 0 && *(const float *)harbol_tuple_get_field(tup, 1) < 50.0f )
+				rows_sum += qty;
+		}
+	printf("%-32s | %8.1f\n", "vector of tuple pointers", (bench_now() - start) * 1e3);
+	
+	uint32_t *const sel = malloc(BENCH_COL_ROWS * sizeof *sel);
+	const int32_t zero = 0;
+	const float cap = 50.0f;
+	start = bench_now();
+	for( size_t r=0; r<BENCH_COL_ROUNDS; r++ ) {
+		size_t count = harbol_coltable_filter(&table, 2, HarbolColI32, HarbolColGT, &zero, sel);
+		count = harbol_coltable_filter_refine(&table, 1, HarbolColF32, HarbolColLT, &cap, sel, count);
+		int64_t sum = 0;
+		harbol_coltable_sum(&table, 2, HarbolColI32, sel, count, &sum);
+		cols_sum += sum;
+	}
+	printf("%-32s | %8.1f\n", "coltable filter + refine + sum", (bench_now() - start) * 1e3);
+	printf("(sums %s)\n\n", ( rows_sum==cols_sum ) ? "match" : "DIFFER");
+	
+	for( size_t i=0; i<tuples.Count; i++ ) {
+		struct HarbolTuple *tup = tuples.Table[i].Ptr;
+		harbol_tuple_free(&tup);
+	}
+	harbol_vector_del(&tuples, NULL);
+	free(sel);
+	harbol_coltable_del(&table);
+	harbol_tuple_schema_del(&schema);
+}
+/////////////////////////////////////////
@@ -60,6 +60,25 @@ HARBOL_EXPORT union HarbolValue harbol_bilist_node_get_val(const struct HarbolBi
 
 /* Doubly Linked List code */
 /////////////////////////////////////////
+/* nodes made by a pooled list come out of 'Pool'; anything else the list holds was made with 'harbol_bilist_node_new'. */
+static struct HarbolBiListNode *_harbol_bilist_node_alloc(struct HarbolBiList *const list, const union HarbolValue val)
+{
+	if( !list->Pool )
+		return harbol_bilist_node_new_val(val);
+	
+	struct HarbolBiListNode *const node = harbol_objpool_alloc(list->Pool);
+	if( node )
+		node->Data = val;
+	return node;
+}
+
+static void _harbol_bilist_node_release(struct HarbolBiList *const list, struct HarbolBiListNode *const node)
+{
+	if( list->Pool && harbol_objpool_owns(list->Pool, node) )
+		harbol_objpool_dealloc(list->Pool, node);
+	else free(node);
+}
+
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new(void)
 {
 	struct HarbolBiList *list = calloc(1, sizeof *list);
@@ -71,8 +90,17 @@ HARBOL_EXPORT void harbol_bilist_del(struct HarbolBiList *const list, fnHarbolDe
 	if( !list )
 		return;
 	
-	harbol_bilist_node_free(&list->Head, dtor);
+	// walked instead of recursing through 'harbol_bilist_node_free' so long lists can't blow the stack.
+	for( struct HarbolBiListNode *node = list->Head; node; ) {
+		struct HarbolBiListNode *const next = node->Next;
+		if( dtor )
+			(*dtor)(&node->Data.Ptr);
+		_harbol_bilist_node_release(list, node);
+		node = next;
+	}
+	struct HarbolObjPool *const pool = list->Pool;
 	memset(list, 0, sizeof *list);
+	list->Pool = pool;
 }
 
 HARBOL_EXPORT void harbol_bilist_free(struct HarbolBiList **listref, fnHarbolDestructor *const dtor)
@@ -92,6 +120,20 @@ HARBOL_EXPORT void harbol_bilist_init(struct HarbolBiList *const list)
 	memset(list, 0, sizeof *list);
 }
 
+HARBOL_EXPORT bool harbol_bilist_set_pool(struct HarbolBiList *const list, struct HarbolObjPool *const pool)
+{
+	if( !list || list->Len || (pool && harbol_objpool_get_obj_size(pool) < sizeof(struct HarbolBiListNode)) )
+		return false;
+	
+	list->Pool = pool;
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolObjPool *harbol_bilist_get_pool(const struct HarbolBiList *const list)
+{
+	return list ? list->Pool : NULL;
+}
+
 HARBOL_EXPORT size_t harbol_bilist_get_len(const struct HarbolBiList *const list)
 {
 	return list ? list->Len : 0;
@@ -178,17 +220,29 @@ HARBOL_EXPORT bool harbol_bilist_insert_node_at_index(struct HarbolBiList *const
 
 HARBOL_EXPORT bool harbol_bilist_insert_at_head(struct HarbolBiList *const list, const union HarbolValue val)
 {
-	return ( !list ) ? false : harbol_bilist_insert_node_at_head(list, harbol_bilist_node_new_val(val));
+	if( !list )
+		return false;
+	
+	struct HarbolBiListNode *const node = _harbol_bilist_node_alloc(list, val);
+	return node ? harbol_bilist_insert_node_at_head(list, node) : false;
 }
 
 HARBOL_EXPORT bool harbol_bilist_insert_at_tail(struct HarbolBiList *const list, const union HarbolValue val)
 {
-	return ( !list ) ? false : harbol_bilist_insert_node_at_tail(list, harbol_bilist_node_new_val(val));
+	if( !list )
+		return false;
+	
+	struct HarbolBiListNode *const node = _harbol_bilist_node_alloc(list, val);
+	return node ? harbol_bilist_insert_node_at_tail(list, node) : false;
 }
 
 HARBOL_EXPORT bool harbol_bilist_insert_at_index(struct HarbolBiList *const list, const union HarbolValue val, const size_t index)
 {
-	return ( !list ) ? false : harbol_bilist_insert_node_at_index(list, harbol_bilist_node_new_val(val), index);
+	if( !list )
+		return false;
+	
+	struct HarbolBiListNode *const node = _harbol_bilist_node_alloc(list, val);
+	return node ? harbol_bilist_insert_node_at_index(list, node, index) : false;
 }
 
 HARBOL_EXPORT struct HarbolBiListNode *harbol_bilist_get_node_by_index(const struct HarbolBiList *const list, const size_t index)
@@ -279,7 +333,7 @@ HARBOL_EXPORT bool harbol_bilist_del_node_by_index(struct HarbolBiList *const li
 	if( dtor )
 		(*dtor)(&node->Data.Ptr);
 	
-	free(node), node=NULL;
+	_harbol_bilist_node_release(list, node), node=NULL;
 	list->Len--;
 	return true;
 }
@@ -296,7 +350,7 @@ HARBOL_EXPORT bool harbol_bilist_del_node_by_ref(struct HarbolBiList *const list
 	if( dtor )
 		(*dtor)(&node->Data.Ptr);
 	
-	free(*noderef), *noderef=NULL;
+	_harbol_bilist_node_release(list, node), *noderef=NULL;
 	node = NULL;
 	list->Len--;
 	return true;
@@ -312,6 +366,108 @@ HARBOL_EXPORT struct HarbolBiListNode *harbol_bilist_get_tail_node(const struct
 	return list ? list->Tail : NULL;
 }
 
+/* moves the nodes 'first' through 'last' out of 'src' and in front of 'pos' in 'dst' ('pos' being NULL means at the tail, and it can't be inside the range).
+ * 'count' is how many nodes the range holds, which keeps this O(1); pass 0 to have the range counted instead.
+ * both lists need the same pool (or none) since the nodes keep belonging to wherever they were allocated from.
+ */
+HARBOL_EXPORT bool harbol_bilist_splice(struct HarbolBiList *const dst, struct HarbolBiListNode *const pos, struct HarbolBiList *const src, struct HarbolBiListNode *const first, struct HarbolBiListNode *const last, size_t count)
+{
+	if( !dst || !src || !first || !last || dst->Pool != src->Pool )
+		return false;
+	else if( !count ) {
+		for( const struct HarbolBiListNode *n = first; n != last; n = n->Next ) {
+			if( !n )
+				return false;
+			count++;
+		}
+		count++;
+	}
+	
+	// already sitting in front of 'pos'.
+	if( dst==src && (pos==first || pos==last->Next) )
+		return true;
+	
+	first->Prev ? (first->Prev->Next = last->Next) : (src->Head = last->Next);
+	last->Next ? (last->Next->Prev = first->Prev) : (src->Tail = first->Prev);
+	src->Len -= count;
+	
+	first->Prev = pos ? pos->Prev : dst->Tail;
+	last->Next = pos;
+	first->Prev ? (first->Prev->Next = first) : (dst->Head = first);
+	pos ? (pos->Prev = last) : (dst->Tail = last);
+	dst->Len += count;
+	return true;
+}
+
+/* appends every node of 'src' to 'dst', leaving 'src' empty. */
+HARBOL_EXPORT bool harbol_bilist_concat(struct HarbolBiList *const dst, struct HarbolBiList *const src)
+{
+	if( !dst || !src || dst==src || dst->Pool != src->Pool )
+		return false;
+	else if( !src->Head )
+		return true;
+	
+	return harbol_bilist_splice(dst, NULL, src, src->Head, src->Tail, src->Len);
+}
+
+/* moves 'node' and everything after it into the empty list 'tail'; O(n) in the nodes moved to keep both lengths right. */
+HARBOL_EXPORT bool harbol_bilist_split(struct HarbolBiList *const list, struct HarbolBiListNode *const node, struct HarbolBiList *const tail)
+{
+	if( !list || !node || !tail || tail==list || tail->Len )
+		return false;
+	
+	// splicing needs both lists on one pool, but a failed split leaves 'tail' as it was.
+	struct HarbolObjPool *const pool = tail->Pool;
+	tail->Pool = list->Pool;
+	if( harbol_bilist_splice(tail, NULL, list, node, list->Tail, 0) )
+		return true;
+	tail->Pool = pool;
+	return false;
+}
+
+/* stable bottom-up merge sort that only relinks nodes, so it never allocates or recurses. */
+HARBOL_EXPORT bool harbol_bilist_sort(struct HarbolBiList *const list, fnHarbolValueCmp *const cmp)
+{
+	if( !list || !cmp )
+		return false;
+	else if( list->Len < 2 )
+		return true;
+	
+	struct HarbolBiListNode *head = list->Head, *tail = NULL;
+	for( size_t width=1;; width <<= 1 ) {
+		struct HarbolBiListNode *p = head;
+		head = tail = NULL;
+		size_t merges = 0;
+		while( p ) {
+			merges++;
+			struct HarbolBiListNode *q = p;
+			size_t psize = 0, qsize = width;
+			for( ; psize<width && q; psize++ )
+				q = q->Next;
+			
+			while( psize || (qsize && q) ) {
+				struct HarbolBiListNode *e;
+				// taking from the left run on ties is what keeps it stable.
+				if( psize && (!qsize || !q || (*cmp)(p->Data, q->Data) <= 0) ) {
+					e = p, p = p->Next, psize--;
+				} else {
+					e = q, q = q->Next, qsize--;
+				}
+				tail ? (tail->Next = e) : (head = e);
+				e->Prev = tail;
+				tail = e;
+			}
+			p = q;
+		}
+		tail->Next = NULL;
+		if( merges<=1 )
+			break;
+	}
+	list->Head = head;
+	list->Tail = tail;
+	return true;
+}
+
 HARBOL_EXPORT void harbol_bilist_from_unilist(struct HarbolBiList *const bilist, const struct HarbolUniList *const unilist)
 {
 	if( !bilist || !unilist )
@@ -321,13 +477,23 @@ HARBOL_EXPORT void harbol_bilist_from_unilist(struct HarbolBiList *const bilist,
 		harbol_bilist_insert_at_tail(bilist, n->Data);
 }
 
+HARBOL_EXPORT void harbol_bilist_from_unrolled(struct HarbolBiList *const bilist, const struct HarbolUnrolledList *const list)
+{
+	if( !bilist || !list )
+		return;
+	
+	for( struct HarbolUnrolledNode *n=list->Head; n; n = n->Next )
+		for( size_t i=0; i<n->Count; i++ )
+			harbol_bilist_insert_at_tail(bilist, n->Vals[i]);
+}
+
 HARBOL_EXPORT void harbol_bilist_from_hashmap(struct HarbolBiList *const bilist, const struct HarbolHashMap *const map)
 {
 	if( !bilist || !map )
 		return;
 	
-	for( size_t i=0; i<map->Len; i++ ) {
-		struct HarbolVector *vec = map->Table + i;
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		struct HarbolVector *vec = harbol_hashmap_get_bucket(map, i);
 		for( size_t n=0; n<harbol_vector_get_count(vec); n++ ) {
 			struct HarbolKeyValPair *node = vec->Table[n].Ptr;
 			harbol_bilist_insert_at_tail(bilist, node->Data);
@@ -362,6 +528,8 @@ HARBOL_EXPORT void harbol_bilist_from_linkmap(struct HarbolBiList *const bilist,
 	
 	for( size_t i=0; i<map->Order.Count; i++ ) {
 		struct HarbolKeyValPair *n = map->Order.Table[i].Ptr;
+		if( !n )
+			continue;
 		harbol_bilist_insert_at_tail(bilist, n->Data);
 	}
 }
@@ -410,3 +578,12 @@ HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_linkmap(const struct H
 	harbol_bilist_from_linkmap(bilist, map);
 	return bilist;
 }
+
+HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_unrolled(const struct HarbolUnrolledList *const list)
+{
+	if( !list )
+		return NULL;
+	struct HarbolBiList *bilist = harbol_bilist_new();
+	harbol_bilist_from_unrolled(bilist, list);
+	return bilist;
+}
@@ -0,0 +1,723 @@
+#include <math.h>
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolBPTree {
+	struct HarbolBPNode *Root, *First, *Last;
+	size_t Count, Height;
+	enum HarbolBPTreeKeyType KeyType;
+} HarbolBPTree;
+*/
+
+/* separator key 'Keys[i]' is the smallest key that can sit under 'Kids[i+1]'.
+ * Every node owns its own copy of string keys, separators included, so deleting from a leaf never leaves a dangling separator.
+ */
+
+#define HARBOL_BPTREE_MIN_KEYS    (HARBOL_BPTREE_ORDER / 2)
+
+static inline int _harbol_bptree_cmp(const enum HarbolBPTreeKeyType type, const union HarbolValue a, const union HarbolValue b)
+{
+	switch( type ) {
+		case HarbolBPKeyStr: return strcmp(a.Ptr, b.Ptr);
+		case HarbolBPKeyInt: return (a.Int64 > b.Int64) - (a.Int64 < b.Int64);
+		case HarbolBPKeyDouble: return (a.Double > b.Double) - (a.Double < b.Double);
+	}
+	return 0;
+}
+
+static inline bool _harbol_bptree_key_ok(const enum HarbolBPTreeKeyType type, const union HarbolValue key)
+{
+	// NaN doesn't order against anything, so it can't be a key.
+	return ( type==HarbolBPKeyStr ) ? key.Ptr != NULL : ( type==HarbolBPKeyDouble ) ? !isnan(key.Double) : true;
+}
+
+static bool _harbol_bptree_key_dup(const enum HarbolBPTreeKeyType type, const union HarbolValue key, union HarbolValue *const restrict out)
+{
+	*out = key;
+	if( type != HarbolBPKeyStr )
+		return true;
+	
+	const size_t len = strlen(key.Ptr);
+	out->Ptr = malloc(len + 1);
+	if( !out->Ptr )
+		return false;
+	memcpy(out->Ptr, key.Ptr, len + 1);
+	return true;
+}
+
+static inline void _harbol_bptree_key_free(const enum HarbolBPTreeKeyType type, union HarbolValue *const key)
+{
+	if( type==HarbolBPKeyStr )
+		free(key->Ptr), key->Ptr=NULL;
+}
+
+static struct HarbolBPNode *_harbol_bptree_node_new(const bool leaf)
+{
+#ifdef OS_WINDOWS
+	struct HarbolBPNode *const node = _aligned_malloc(sizeof *node, HARBOL_BPTREE_LINE);
+#else
+	struct HarbolBPNode *const node = aligned_alloc(HARBOL_BPTREE_LINE, harbol_align_size(sizeof *node, HARBOL_BPTREE_LINE));
+#endif
+	if( node ) {
+		memset(node, 0, sizeof *node);
+		node->Leaf = leaf;
+	}
+	return node;
+}
+
+static void _harbol_bptree_node_free(struct HarbolBPNode *const node)
+{
+#ifdef OS_WINDOWS
+	_aligned_free(node);
+#else
+	free(node);
+#endif
+}
+
+static void _harbol_bptree_node_del(const enum HarbolBPTreeKeyType type, struct HarbolBPNode *const node, fnHarbolDestructor *const dtor)
+{
+	for( size_t i=0; i<node->Count; i++ ) {
+		_harbol_bptree_key_free(type, &node->Keys[i]);
+		if( node->Leaf && dtor )
+			(*dtor)(&node->Vals[i].Ptr);
+	}
+	if( !node->Leaf )
+		for( size_t i=0; i<=node->Count; i++ )
+			_harbol_bptree_node_del(type, node->Kids[i], dtor);
+	_harbol_bptree_node_free(node);
+}
+
+HARBOL_EXPORT struct HarbolBPTree *harbol_bptree_new(const enum HarbolBPTreeKeyType type)
+{
+	struct HarbolBPTree *tree = calloc(1, sizeof *tree);
+	harbol_bptree_init(tree, type);
+	return tree;
+}
+
+HARBOL_EXPORT void harbol_bptree_init(struct HarbolBPTree *const tree, const enum HarbolBPTreeKeyType type)
+{
+	if( !tree )
+		return;
+	
+	memset(tree, 0, sizeof *tree);
+	tree->KeyType = type;
+}
+
+HARBOL_EXPORT void harbol_bptree_del(struct HarbolBPTree *const tree, fnHarbolDestructor *const dtor)
+{
+	if( !tree )
+		return;
+	
+	if( tree->Root )
+		_harbol_bptree_node_del(tree->KeyType, tree->Root, dtor);
+	harbol_bptree_init(tree, tree->KeyType);
+}
+
+HARBOL_EXPORT void harbol_bptree_free(struct HarbolBPTree **treeref, fnHarbolDestructor *const dtor)
+{
+	if( !treeref || !*treeref )
+		return;
+	
+	harbol_bptree_del(*treeref, dtor);
+	free(*treeref), *treeref=NULL;
+}
+
+HARBOL_EXPORT size_t harbol_bptree_get_count(const struct HarbolBPTree *const tree)
+{
+	return tree ? tree->Count : 0;
+}
+
+HARBOL_EXPORT size_t harbol_bptree_get_height(const struct HarbolBPTree *const tree)
+{
+	return tree ? tree->Height : 0;
+}
+
+/* first slot whose key is >= 'key'. */
+static size_t _harbol_bptree_lower_slot(const enum HarbolBPTreeKeyType type, const struct HarbolBPNode *const node, const union HarbolValue key)
+{
+	size_t lo = 0, hi = node->Count;
+	while( lo < hi ) {
+		const size_t mid = (lo + hi) >> 1;
+		if( _harbol_bptree_cmp(type, node->Keys[mid], key) < 0 )
+			lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+/* first slot whose key is > 'key', which for an interior node is also the child to descend into. */
+static size_t _harbol_bptree_upper_slot(const enum HarbolBPTreeKeyType type, const struct HarbolBPNode *const node, const union HarbolValue key)
+{
+	size_t lo = 0, hi = node->Count;
+	while( lo < hi ) {
+		const size_t mid = (lo + hi) >> 1;
+		if( _harbol_bptree_cmp(type, node->Keys[mid], key) <= 0 )
+			lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+static struct HarbolBPNode *_harbol_bptree_find_leaf(const struct HarbolBPTree *const tree, const union HarbolValue key)
+{
+	struct HarbolBPNode *node = tree->Root;
+	while( node && !node->Leaf )
+		node = node->Kids[_harbol_bptree_upper_slot(tree->KeyType, node, key)];
+	return node;
+}
+
+static union HarbolValue *_harbol_bptree_find(const struct HarbolBPTree *const tree, const union HarbolValue key)
+{
+	if( !tree || !tree->Count || !_harbol_bptree_key_ok(tree->KeyType, key) )
+		return NULL;
+	
+	struct HarbolBPNode *const leaf = _harbol_bptree_find_leaf(tree, key);
+	const size_t slot = _harbol_bptree_lower_slot(tree->KeyType, leaf, key);
+	return ( slot < leaf->Count && !_harbol_bptree_cmp(tree->KeyType, leaf->Keys[slot], key) ) ? &leaf->Vals[slot] : NULL;
+}
+
+HARBOL_EXPORT union HarbolValue harbol_bptree_get(const struct HarbolBPTree *const tree, const union HarbolValue key)
+{
+	const union HarbolValue *const val = _harbol_bptree_find(tree, key);
+	return val ? *val : (union HarbolValue){0};
+}
+
+HARBOL_EXPORT bool harbol_bptree_has_key(const struct HarbolBPTree *const tree, const union HarbolValue key)
+{
+	return _harbol_bptree_find(tree, key) != NULL;
+}
+
+enum {
+	HarbolBPInsertFail=-1, HarbolBPInsertExists, HarbolBPInsertDone, HarbolBPInsertSplit,
+};
+
+static int _harbol_bptree_insert_leaf(struct HarbolBPTree *const tree, struct HarbolBPNode *const leaf, const union HarbolValue key, const union HarbolValue val, const bool replace, union HarbolValue *const up_key, struct HarbolBPNode **const up_node)
+{
+	const size_t slot = _harbol_bptree_lower_slot(tree->KeyType, leaf, key);
+	if( slot < leaf->Count && !_harbol_bptree_cmp(tree->KeyType, leaf->Keys[slot], key) ) {
+		if( replace )
+			leaf->Vals[slot] = val;
+		return HarbolBPInsertExists;
+	}
+	
+	union HarbolValue owned;
+	if( !_harbol_bptree_key_dup(tree->KeyType, key, &owned) )
+		return HarbolBPInsertFail;
+	
+	if( leaf->Count < HARBOL_BPTREE_ORDER ) {
+		memmove(leaf->Keys + slot + 1, leaf->Keys + slot, (leaf->Count - slot) * sizeof *leaf->Keys);
+		memmove(leaf->Vals + slot + 1, leaf->Vals + slot, (leaf->Count - slot) * sizeof *leaf->Vals);
+		leaf->Keys[slot] = owned;
+		leaf->Vals[slot] = val;
+		leaf->Count++;
+		return HarbolBPInsertDone;
+	}
+	
+	struct HarbolBPNode *const right = _harbol_bptree_node_new(true);
+	if( !right ) {
+		_harbol_bptree_key_free(tree->KeyType, &owned);
+		return HarbolBPInsertFail;
+	}
+	union HarbolValue keys[HARBOL_BPTREE_ORDER + 1], vals[HARBOL_BPTREE_ORDER + 1];
+	memcpy(keys, leaf->Keys, slot * sizeof *keys);
+	memcpy(vals, leaf->Vals, slot * sizeof *vals);
+	keys[slot] = owned, vals[slot] = val;
+	memcpy(keys + slot + 1, leaf->Keys + slot, (HARBOL_BPTREE_ORDER - slot) * sizeof *keys);
+	memcpy(vals + slot + 1, leaf->Vals + slot, (HARBOL_BPTREE_ORDER - slot) * sizeof *vals);
+	
+	// appending in order is the common case, so the split leaves the left node full instead of half empty.
+	const size_t total = HARBOL_BPTREE_ORDER + 1;
+	const size_t keep = ( slot==HARBOL_BPTREE_ORDER && !leaf->Next ) ? HARBOL_BPTREE_ORDER : total / 2;
+	if( !_harbol_bptree_key_dup(tree->KeyType, keys[keep], up_key) ) {
+		_harbol_bptree_key_free(tree->KeyType, &owned);
+		_harbol_bptree_node_free(right);
+		return HarbolBPInsertFail;
+	}
+	memcpy(leaf->Keys, keys, keep * sizeof *keys);
+	memcpy(leaf->Vals, vals, keep * sizeof *vals);
+	memcpy(right->Keys, keys + keep, (total - keep) * sizeof *keys);
+	memcpy(right->Vals, vals + keep, (total - keep) * sizeof *vals);
+	leaf->Count = (uint16_t)keep;
+	right->Count = (uint16_t)(total - keep);
+	
+	right->Next = leaf->Next;
+	right->Prev = leaf;
+	if( leaf->Next )
+		leaf->Next->Prev = right;
+	else tree->Last = right;
+	leaf->Next = right;
+	*up_node = right;
+	return HarbolBPInsertSplit;
+}
+
+static int _harbol_bptree_insert_node(struct HarbolBPTree *const tree, struct HarbolBPNode *const node, const union HarbolValue key, const union HarbolValue val, const bool replace, union HarbolValue *const up_key, struct HarbolBPNode **const up_node)
+{
+	if( node->Leaf )
+		return _harbol_bptree_insert_leaf(tree, node, key, val, replace, up_key, up_node);
+	
+	// a full node gets its split partner up front; once the child has split there's no backing out.
+	struct HarbolBPNode *right = NULL;
+	if( node->Count==HARBOL_BPTREE_ORDER && !(right = _harbol_bptree_node_new(false)) )
+		return HarbolBPInsertFail;
+	
+	const size_t slot = _harbol_bptree_upper_slot(tree->KeyType, node, key);
+	union HarbolValue kid_key;
+	struct HarbolBPNode *kid_node = NULL;
+	const int res = _harbol_bptree_insert_node(tree, node->Kids[slot], key, val, replace, &kid_key, &kid_node);
+	if( res != HarbolBPInsertSplit ) {
+		_harbol_bptree_node_free(right);
+		return res;
+	}
+	
+	if( node->Count < HARBOL_BPTREE_ORDER ) {
+		memmove(node->Keys + slot + 1, node->Keys + slot, (node->Count - slot) * sizeof *node->Keys);
+		memmove(node->Kids + slot + 2, node->Kids + slot + 1, (node->Count - slot) * sizeof *node->Kids);
+		node->Keys[slot] = kid_key;
+		node->Kids[slot + 1] = kid_node;
+		node->Count++;
+		return HarbolBPInsertDone;
+	}
+	
+	union HarbolValue keys[HARBOL_BPTREE_ORDER + 1];
+	struct HarbolBPNode *kids[HARBOL_BPTREE_ORDER + 2];
+	memcpy(keys, node->Keys, slot * sizeof *keys);
+	keys[slot] = kid_key;
+	memcpy(keys + slot + 1, node->Keys + slot, (HARBOL_BPTREE_ORDER - slot) * sizeof *keys);
+	memcpy(kids, node->Kids, (slot + 1) * sizeof *kids);
+	kids[slot + 1] = kid_node;
+	memcpy(kids + slot + 2, node->Kids + slot + 1, (HARBOL_BPTREE_ORDER - slot) * sizeof *kids);
+	
+	// the middle key moves up rather than being copied.
+	const size_t total = HARBOL_BPTREE_ORDER + 1;
+	const size_t mid = ( slot==HARBOL_BPTREE_ORDER ) ? HARBOL_BPTREE_ORDER - 1 : total / 2;
+	*up_key = keys[mid];
+	memcpy(node->Keys, keys, mid * sizeof *keys);
+	memcpy(node->Kids, kids, (mid + 1) * sizeof *kids);
+	node->Count = (uint16_t)mid;
+	memcpy(right->Keys, keys + mid + 1, (total - mid - 1) * sizeof *keys);
+	memcpy(right->Kids, kids + mid + 1, (total - mid) * sizeof *kids);
+	right->Count = (uint16_t)(total - mid - 1);
+	*up_node = right;
+	return HarbolBPInsertSplit;
+}
+
+static bool _harbol_bptree_put(struct HarbolBPTree *const tree, const union HarbolValue key, const union HarbolValue val, const bool replace)
+{
+	if( !tree || !_harbol_bptree_key_ok(tree->KeyType, key) )
+		return false;
+	else if( !tree->Root ) {
+		tree->Root = tree->First = tree->Last = _harbol_bptree_node_new(true);
+		if( !tree->Root )
+			return false;
+		tree->Height = 1;
+	}
+	
+	struct HarbolBPNode *root = NULL;
+	if( tree->Root->Count==HARBOL_BPTREE_ORDER && !(root = _harbol_bptree_node_new(false)) )
+		return false;
+	
+	union HarbolValue up_key;
+	struct HarbolBPNode *up_node = NULL;
+	const int res = _harbol_bptree_insert_node(tree, tree->Root, key, val, replace, &up_key, &up_node);
+	if( res==HarbolBPInsertSplit ) {
+		root->Keys[0] = up_key;
+		root->Kids[0] = tree->Root;
+		root->Kids[1] = up_node;
+		root->Count = 1;
+		tree->Root = root;
+		tree->Height++;
+	} else _harbol_bptree_node_free(root);
+	
+	if( res==HarbolBPInsertDone || res==HarbolBPInsertSplit ) {
+		tree->Count++;
+		return true;
+	}
+	return res==HarbolBPInsertExists && replace;
+}
+
+HARBOL_EXPORT bool harbol_bptree_insert(struct HarbolBPTree *const tree, const union HarbolValue key, const union HarbolValue val)
+{
+	return _harbol_bptree_put(tree, key, val, false);
+}
+
+HARBOL_EXPORT bool harbol_bptree_set(struct HarbolBPTree *const tree, const union HarbolValue key, const union HarbolValue val)
+{
+	return _harbol_bptree_put(tree, key, val, true);
+}
+
+/* folds 'Kids[slot+1]' into 'Kids[slot]' and drops the separator between them. */
+static void _harbol_bptree_merge(struct HarbolBPTree *const tree, struct HarbolBPNode *const parent, const size_t slot)
+{
+	struct HarbolBPNode *const left = parent->Kids[slot];
+	struct HarbolBPNode *const right = parent->Kids[slot + 1];
+	if( left->Leaf ) {
+		memcpy(left->Keys + left->Count, right->Keys, right->Count * sizeof *right->Keys);
+		memcpy(left->Vals + left->Count, right->Vals, right->Count * sizeof *right->Vals);
+		left->Count += right->Count;
+		left->Next = right->Next;
+		if( right->Next )
+			right->Next->Prev = left;
+		else tree->Last = left;
+		_harbol_bptree_key_free(tree->KeyType, &parent->Keys[slot]);
+	} else {
+		left->Keys[left->Count] = parent->Keys[slot];
+		memcpy(left->Keys + left->Count + 1, right->Keys, right->Count * sizeof *right->Keys);
+		memcpy(left->Kids + left->Count + 1, right->Kids, (right->Count + 1) * sizeof *right->Kids);
+		left->Count += right->Count + 1;
+	}
+	_harbol_bptree_node_free(right);
+	memmove(parent->Keys + slot, parent->Keys + slot + 1, (parent->Count - slot - 1) * sizeof *parent->Keys);
+	memmove(parent->Kids + slot + 1, parent->Kids + slot + 2, (parent->Count - slot - 1) * sizeof *parent->Kids);
+	parent->Count--;
+}
+
+/* refills an underfull 'Kids[slot]' by borrowing from a sibling, or merges it with one. */
+static void _harbol_bptree_rebalance(struct HarbolBPTree *const tree, struct HarbolBPNode *const parent, const size_t slot)
+{
+	struct HarbolBPNode *const kid = parent->Kids[slot];
+	struct HarbolBPNode *const left = slot > 0 ? parent->Kids[slot - 1] : NULL;
+	struct HarbolBPNode *const right = slot < parent->Count ? parent->Kids[slot + 1] : NULL;
+	
+	if( left && left->Count > HARBOL_BPTREE_MIN_KEYS ) {
+		union HarbolValue sep;
+		// an underfull node is still a valid one, so running out of memory here just skips the refill.
+		if( kid->Leaf && !_harbol_bptree_key_dup(tree->KeyType, left->Keys[left->Count - 1], &sep) )
+			return;
+		
+		memmove(kid->Keys + 1, kid->Keys, kid->Count * sizeof *kid->Keys);
+		if( kid->Leaf ) {
+			memmove(kid->Vals + 1, kid->Vals, kid->Count * sizeof *kid->Vals);
+			kid->Keys[0] = left->Keys[left->Count - 1];
+			kid->Vals[0] = left->Vals[left->Count - 1];
+			_harbol_bptree_key_free(tree->KeyType, &parent->Keys[slot - 1]);
+			parent->Keys[slot - 1] = sep;
+		} else {
+			memmove(kid->Kids + 1, kid->Kids, (kid->Count + 1) * sizeof *kid->Kids);
+			kid->Keys[0] = parent->Keys[slot - 1];
+			kid->Kids[0] = left->Kids[left->Count];
+			parent->Keys[slot - 1] = left->Keys[left->Count - 1];
+		}
+		left->Count--;
+		kid->Count++;
+		return;
+	}
+	if( right && right->Count > HARBOL_BPTREE_MIN_KEYS ) {
+		union HarbolValue sep;
+		if( kid->Leaf && !_harbol_bptree_key_dup(tree->KeyType, right->Keys[1], &sep) )
+			return;
+		
+		if( kid->Leaf ) {
+			kid->Keys[kid->Count] = right->Keys[0];
+			kid->Vals[kid->Count] = right->Vals[0];
+			memmove(right->Vals, right->Vals + 1, (right->Count - 1) * sizeof *right->Vals);
+			_harbol_bptree_key_free(tree->KeyType, &parent->Keys[slot]);
+			parent->Keys[slot] = sep;
+		} else {
+			kid->Keys[kid->Count] = parent->Keys[slot];
+			kid->Kids[kid->Count + 1] = right->Kids[0];
+			parent->Keys[slot] = right->Keys[0];
+			memmove(right->Kids, right->Kids + 1, right->Count * sizeof *right->Kids);
+		}
+		memmove(right->Keys, right->Keys + 1, (right->Count - 1) * sizeof *right->Keys);
+		right->Count--;
+		kid->Count++;
+		return;
+	}
+	// neither sibling can spare a key, so together with this one they fit in a single node.
+	if( left )
+		_harbol_bptree_merge(tree, parent, slot - 1);
+	else if( right )
+		_harbol_bptree_merge(tree, parent, slot);
+}
+
+static bool _harbol_bptree_delete_node(struct HarbolBPTree *const tree, struct HarbolBPNode *const node, const union HarbolValue key, fnHarbolDestructor *const dtor)
+{
+	if( node->Leaf ) {
+		const size_t slot = _harbol_bptree_lower_slot(tree->KeyType, node, key);
+		if( slot >= node->Count || _harbol_bptree_cmp(tree->KeyType, node->Keys[slot], key) )
+			return false;
+		
+		_harbol_bptree_key_free(tree->KeyType, &node->Keys[slot]);
+		if( dtor )
+			(*dtor)(&node->Vals[slot].Ptr);
+		memmove(node->Keys + slot, node->Keys + slot + 1, (node->Count - slot - 1) * sizeof *node->Keys);
+		memmove(node->Vals + slot, node->Vals + slot + 1, (node->Count - slot - 1) * sizeof *node->Vals);
+		node->Count--;
+		return true;
+	}
+	
+	const size_t slot = _harbol_bptree_upper_slot(tree->KeyType, node, key);
+	if( !_harbol_bptree_delete_node(tree, node->Kids[slot], key, dtor) )
+		return false;
+	if( node->Kids[slot]->Count < HARBOL_BPTREE_MIN_KEYS )
+		_harbol_bptree_rebalance(tree, node, slot);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bptree_delete(struct HarbolBPTree *const tree, const union HarbolValue key, fnHarbolDestructor *const dtor)
+{
+	if( !tree || !tree->Root || !_harbol_bptree_key_ok(tree->KeyType, key) )
+		return false;
+	else if( !_harbol_bptree_delete_node(tree, tree->Root, key, dtor) )
+		return false;
+	
+	tree->Count--;
+	struct HarbolBPNode *const root = tree->Root;
+	if( !root->Leaf && !root->Count ) {
+		tree->Root = root->Kids[0];
+		tree->Height--;
+		_harbol_bptree_node_free(root);
+	} else if( root->Leaf && !root->Count ) {
+		_harbol_bptree_node_free(root);
+		tree->Root = tree->First = tree->Last = NULL;
+		tree->Height = 0;
+	}
+	return true;
+}
+
+/* frees the interior nodes of a subtree but leaves its leaves alone. */
+static void _harbol_bptree_interior_del(const enum HarbolBPTreeKeyType type, struct HarbolBPNode *const node)
+{
+	if( node->Leaf )
+		return;
+	
+	for( size_t i=0; i<node->Count; i++ )
+		_harbol_bptree_key_free(type, &node->Keys[i]);
+	for( size_t i=0; i<=node->Count; i++ )
+		_harbol_bptree_interior_del(type, node->Kids[i]);
+	_harbol_bptree_node_free(node);
+}
+
+/* builds the tree in one pass from strictly ascending keys; the tree has to be empty. */
+HARBOL_EXPORT bool harbol_bptree_bulk_load(struct HarbolBPTree *const tree, const union HarbolValue keys[const], const union HarbolValue vals[const], const size_t count)
+{
+	if( !tree || tree->Root || (count && (!keys || !vals)) )
+		return false;
+	else if( !count )
+		return true;
+	
+	for( size_t i=0; i<count; i++ )
+		if( !_harbol_bptree_key_ok(tree->KeyType, keys[i]) || (i && _harbol_bptree_cmp(tree->KeyType, keys[i-1], keys[i]) >= 0) )
+			return false;
+	
+	// spread entries evenly so no node but a lone root ends up below the minimum fill.
+	size_t level_len = (count + HARBOL_BPTREE_ORDER - 1) / HARBOL_BPTREE_ORDER;
+	struct HarbolBPNode **const level = calloc(level_len, sizeof *level);
+	const union HarbolValue **const mins = calloc(level_len, sizeof *mins);
+	struct HarbolBPNode *first = NULL, *prev = NULL;
+	size_t parent = 0, kid = 0;
+	bool interior = false;
+	if( !level || !mins )
+		goto fail;
+	
+	for( size_t i=0, n=0; i<level_len; i++ ) {
+		const size_t take = count / level_len + (i < count % level_len);
+		struct HarbolBPNode *const leaf = level[i] = _harbol_bptree_node_new(true);
+		if( !leaf )
+			goto fail;
+		leaf->Prev = prev;
+		if( prev )
+			prev->Next = leaf;
+		else first = leaf;
+		prev = leaf;
+		for( size_t k=0; k<take; k++, n++ ) {
+			if( !_harbol_bptree_key_dup(tree->KeyType, keys[n], &leaf->Keys[k]) )
+				goto fail;
+			leaf->Vals[k] = vals[n];
+			leaf->Count++;
+		}
+		mins[i] = &leaf->Keys[0];
+	}
+	
+	interior = true;
+	while( level_len > 1 ) {
+		const size_t parents = (level_len + HARBOL_BPTREE_ORDER) / (HARBOL_BPTREE_ORDER + 1);
+		for( parent=0, kid=0; parent<parents; parent++ ) {
+			const size_t take = level_len / parents + (parent < level_len % parents);
+			struct HarbolBPNode *const node = _harbol_bptree_node_new(false);
+			if( !node )
+				goto fail;
+			node->Kids[0] = level[kid];
+			for( size_t k=1; k<take; k++ ) {
+				if( !_harbol_bptree_key_dup(tree->KeyType, *mins[kid + k], &node->Keys[k - 1]) ) {
+					// its children are still in 'level', so only the node's own keys go.
+					for( size_t j=0; j<node->Count; j++ )
+						_harbol_bptree_key_free(tree->KeyType, &node->Keys[j]);
+					_harbol_bptree_node_free(node);
+					goto fail;
+				}
+				node->Kids[k] = level[kid + k];
+				node->Count++;
+			}
+			// the level arrays are reused in place; slot 'parent' never runs ahead of 'kid'.
+			mins[parent] = mins[kid];
+			level[parent] = node;
+			kid += take;
+		}
+		level_len = parents;
+		tree->Height++;
+	}
+	tree->Root = level[0];
+	tree->First = first;
+	tree->Last = prev;
+	tree->Height++;
+	tree->Count = count;
+	free(level);
+	free(mins);
+	return true;
+	
+fail:
+	// leaves all hang off the sibling chain; interior nodes are either finished parents or children still waiting for one.
+	if( interior ) {
+		for( size_t i=0; i<parent; i++ )
+			_harbol_bptree_interior_del(tree->KeyType, level[i]);
+		for( size_t i=kid; i<level_len; i++ )
+			_harbol_bptree_interior_del(tree->KeyType, level[i]);
+	}
+	for( struct HarbolBPNode *leaf = first; leaf; ) {
+		struct HarbolBPNode *const next = leaf->Next;
+		_harbol_bptree_node_del(tree->KeyType, leaf, NULL);
+		leaf = next;
+	}
+	free(level);
+	free(mins);
+	harbol_bptree_init(tree, tree->KeyType);
+	return false;
+}
+
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_first(const struct HarbolBPTree *const tree)
+{
+	return (struct HarbolBPTreeIter){ .Leaf = tree ? tree->First : NULL, .Slot = 0 };
+}
+
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_last(const struct HarbolBPTree *const tree)
+{
+	if( !tree || !tree->Last )
+		return (struct HarbolBPTreeIter){0};
+	return (struct HarbolBPTreeIter){ .Leaf = tree->Last, .Slot = tree->Last->Count - 1U };
+}
+
+/* the end iterator sits one past the last entry, so stepping back from it lands on the last entry. */
+static struct HarbolBPTreeIter _harbol_bptree_seek(const struct HarbolBPTree *const tree, const union HarbolValue key, const bool upper)
+{
+	if( !tree || !tree->Root || !_harbol_bptree_key_ok(tree->KeyType, key) )
+		return (struct HarbolBPTreeIter){0};
+	
+	struct HarbolBPNode *const leaf = _harbol_bptree_find_leaf(tree, key);
+	const size_t slot = upper ? _harbol_bptree_upper_slot(tree->KeyType, leaf, key) : _harbol_bptree_lower_slot(tree->KeyType, leaf, key);
+	if( slot < leaf->Count || !leaf->Next )
+		return (struct HarbolBPTreeIter){ .Leaf = leaf, .Slot = slot };
+	return (struct HarbolBPTreeIter){ .Leaf = leaf->Next, .Slot = 0 };
+}
+
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_lower_bound(const struct HarbolBPTree *const tree, const union HarbolValue key)
+{
+	return _harbol_bptree_seek(tree, key, false);
+}
+
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_upper_bound(const struct HarbolBPTree *const tree, const union HarbolValue key)
+{
+	return _harbol_bptree_seek(tree, key, true);
+}
+
+HARBOL_EXPORT bool harbol_bptree_iter_valid(const struct HarbolBPTreeIter *const iter)
+{
+	return iter && iter->Leaf && iter->Slot < iter->Leaf->Count;
+}
+
+HARBOL_EXPORT bool harbol_bptree_iter_next(struct HarbolBPTreeIter *const iter)
+{
+	if( !iter || !iter->Leaf || iter->Slot >= iter->Leaf->Count )
+		return false;
+	else if( ++iter->Slot >= iter->Leaf->Count && iter->Leaf->Next ) {
+		iter->Leaf = iter->Leaf->Next;
+		iter->Slot = 0;
+	}
+	return harbol_bptree_iter_valid(iter);
+}
+
+HARBOL_EXPORT bool harbol_bptree_iter_prev(struct HarbolBPTreeIter *const iter)
+{
+	if( !iter || !iter->Leaf )
+		return false;
+	else if( iter->Slot > 0 ) {
+		iter->Slot--;
+		return true;
+	} else if( iter->Leaf->Prev ) {
+		iter->Leaf = iter->Leaf->Prev;
+		iter->Slot = iter->Leaf->Count - 1U;
+		return true;
+	}
+	// stepped off the front.
+	*iter = (struct HarbolBPTreeIter){0};
+	return false;
+}
+
+HARBOL_EXPORT union HarbolValue harbol_bptree_iter_key(const struct HarbolBPTreeIter *const iter)
+{
+	return harbol_bptree_iter_valid(iter) ? iter->Leaf->Keys[iter->Slot] : (union HarbolValue){0};
+}
+
+HARBOL_EXPORT union HarbolValue harbol_bptree_iter_val(const struct HarbolBPTreeIter *const iter)
+{
+	return harbol_bptree_iter_valid(iter) ? iter->Leaf->Vals[iter->Slot] : (union HarbolValue){0};
+}
+
+HARBOL_EXPORT void harbol_bptree_from_linkmap(struct HarbolBPTree *const restrict tree, const struct HarbolLinkMap *const restrict map)
+{
+	if( !tree || !map )
+		return;
+	
+	for( size_t i=0; i<map->Order.Count; i++ ) {
+		const struct HarbolKeyValPair *const kv = map->Order.Table[i].KvPairPtr;
+		if( !kv )
+			continue;
+		union HarbolValue key = {.Ptr = kv->KeyName.CStr};
+		switch( tree->KeyType ) {
+			case HarbolBPKeyStr: break;
+			case HarbolBPKeyInt: key.Int64 = strtoll(kv->KeyName.CStr, NULL, 0); break;
+			case HarbolBPKeyDouble: key.Double = strtod(kv->KeyName.CStr, NULL); break;
+		}
+		harbol_bptree_insert(tree, key, kv->Data);
+	}
+}
+
+HARBOL_EXPORT void harbol_bptree_from_vector(struct HarbolBPTree *const restrict tree, const struct HarbolVector *const restrict vec)
+{
+	if( !tree || !vec )
+		return;
+	
+	for( size_t i=0; i<vec->Count; i++ ) {
+		char cstrkey[21] = {0};
+		union HarbolValue key = {.Ptr = cstrkey};
+		switch( tree->KeyType ) {
+			case HarbolBPKeyStr: sprintf(cstrkey, "%zu", i); break;
+			case HarbolBPKeyInt: key.Int64 = (int64_t)i; break;
+			case HarbolBPKeyDouble: key.Double = (double)i; break;
+		}
+		harbol_bptree_insert(tree, key, vec->Table[i]);
+	}
+}
+
+HARBOL_EXPORT struct HarbolBPTree *harbol_bptree_new_from_linkmap(const struct HarbolLinkMap *const map, const enum HarbolBPTreeKeyType type)
+{
+	if( !map )
+		return NULL;
+	struct HarbolBPTree *tree = harbol_bptree_new(type);
+	harbol_bptree_from_linkmap(tree, map);
+	return tree;
+}
+
+HARBOL_EXPORT struct HarbolBPTree *harbol_bptree_new_from_vector(const struct HarbolVector *const vec, const enum HarbolBPTreeKeyType type)
+{
+	if( !vec )
+		return NULL;
+	struct HarbolBPTree *tree = harbol_bptree_new(type);
+	harbol_bptree_from_vector(tree, vec);
+	return tree;
+}
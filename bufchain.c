@@ -0,0 +1,397 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+#ifndef OS_WINDOWS
+#	include <errno.h>
+#	include <limits.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#endif
+
+/*
+typedef struct HarbolBufBacking {
+	size_t Refs;
+	fnHarbolBufRelease *Release;
+	void *Ctx, *Mem;
+	size_t MemLen;
+} HarbolBufBacking;
+
+typedef struct HarbolBufSegment {
+	struct HarbolIBiLink Link;
+	struct HarbolBufBacking *Backing;
+	uint8_t *Data;
+	size_t Len, Cap;
+} HarbolBufSegment;
+
+typedef struct HarbolBufChain {
+	struct HarbolIBiList Segments;
+	size_t Len;
+} HarbolBufChain;
+ */
+
+#ifndef OS_WINDOWS
+#	ifdef IOV_MAX
+#		define HARBOL_BUFCHAIN_IOVS    ( IOV_MAX < 1024 ? IOV_MAX : 1024 )
+#	else
+#		define HARBOL_BUFCHAIN_IOVS    1024
+#	endif
+#endif
+
+static void _harbol_bufchain_release_heap(void *const ctx, void *const mem, const size_t len)
+{
+	(void)ctx; (void)len;
+	free(mem);
+}
+
+/* 'ctx' carries the mapping length for a mapped byte buffer view. */
+static void _harbol_bufchain_release_buffer(void *const ctx, void *const mem, const size_t len)
+{
+	struct HarbolByteBuffer buf = { .Buffer = mem, .Len = len, .Count = len, .MapLen = (size_t)(uintptr_t)ctx };
+	harbol_bytebuffer_del(&buf);
+}
+
+static struct HarbolBufSegment *_harbol_bufchain_segment_new(void *const mem, const size_t len, const size_t cap, fnHarbolBufRelease *const release, void *const ctx)
+{
+	struct HarbolBufSegment *const seg = calloc(1, sizeof *seg);
+	struct HarbolBufBacking *const backing = calloc(1, sizeof *backing);
+	if( !seg || !backing ) {
+		free(seg), free(backing);
+		return NULL;
+	}
+	*backing = (struct HarbolBufBacking){ .Refs = 1, .Release = release, .Ctx = ctx, .Mem = mem, .MemLen = cap };
+	seg->Backing = backing;
+	seg->Data = mem;
+	seg->Len = len;
+	seg->Cap = cap;
+	return seg;
+}
+
+static void _harbol_bufchain_segment_free(struct HarbolBufSegment *const seg)
+{
+	struct HarbolBufBacking *const backing = seg->Backing;
+	if( !--backing->Refs ) {
+		if( backing->Release )
+			(*backing->Release)(backing->Ctx, backing->Mem, backing->MemLen);
+		free(backing);
+	}
+	free(seg);
+}
+
+static inline struct HarbolBufSegment *_harbol_bufchain_seg(struct HarbolIBiLink *const link)
+{
+	return link ? harbol_container_of(link, struct HarbolBufSegment, Link) : NULL;
+}
+
+static void _harbol_bufchain_link(struct HarbolBufChain *const chain, struct HarbolBufSegment *const seg, const bool at_front)
+{
+	at_front ? harbol_ibilist_push_head(&chain->Segments, &seg->Link) : harbol_ibilist_push_tail(&chain->Segments, &seg->Link);
+	chain->Len += seg->Len;
+}
+
+
+HARBOL_EXPORT struct HarbolBufChain *harbol_bufchain_new(void)
+{
+	struct HarbolBufChain *chain = calloc(1, sizeof *chain);
+	return chain;
+}
+
+HARBOL_EXPORT void harbol_bufchain_init(struct HarbolBufChain *const chain)
+{
+	if( !chain )
+		return;
+	
+	memset(chain, 0, sizeof *chain);
+}
+
+HARBOL_EXPORT void harbol_bufchain_del(struct HarbolBufChain *const chain)
+{
+	if( !chain )
+		return;
+	
+	for( struct HarbolIBiLink *link = harbol_ibilist_pop_head(&chain->Segments); link; link = harbol_ibilist_pop_head(&chain->Segments) )
+		_harbol_bufchain_segment_free(_harbol_bufchain_seg(link));
+	memset(chain, 0, sizeof *chain);
+}
+
+HARBOL_EXPORT void harbol_bufchain_free(struct HarbolBufChain **chainref)
+{
+	if( !*chainref )
+		return;
+	
+	harbol_bufchain_del(*chainref);
+	free(*chainref), *chainref=NULL;
+}
+
+HARBOL_EXPORT size_t harbol_bufchain_get_len(const struct HarbolBufChain *const chain)
+{
+	return chain ? chain->Len : 0;
+}
+
+HARBOL_EXPORT size_t harbol_bufchain_get_segment_count(const struct HarbolBufChain *const chain)
+{
+	return chain ? harbol_ibilist_get_len(&chain->Segments) : 0;
+}
+
+HARBOL_EXPORT struct HarbolBufSegment *harbol_bufchain_get_head_segment(const struct HarbolBufChain *const chain)
+{
+	return chain ? _harbol_bufchain_seg(chain->Segments.Head) : NULL;
+}
+
+HARBOL_EXPORT struct HarbolBufSegment *harbol_bufchain_get_next_segment(const struct HarbolBufSegment *const seg)
+{
+	return seg ? _harbol_bufchain_seg(seg->Link.Next) : NULL;
+}
+
+/* takes over the byte buffer's storage (or mapped view) without copying it; 'buf' is left empty. */
+static bool _harbol_bufchain_add_buffer(struct HarbolBufChain *const restrict chain, struct HarbolByteBuffer *const restrict buf, const bool at_front)
+{
+	if( !chain || !buf )
+		return false;
+	else if( !buf->Count ) {
+		harbol_bytebuffer_del(buf);
+		return true;
+	}
+	
+	struct HarbolBufSegment *const seg = _harbol_bufchain_segment_new(buf->Buffer, buf->Count, buf->Count, _harbol_bufchain_release_buffer, (void *)(uintptr_t)buf->MapLen);
+	if( !seg )
+		return false;
+	
+	memset(buf, 0, sizeof *buf);
+	_harbol_bufchain_link(chain, seg, at_front);
+	return true;
+}
+
+/* borrows 'data'; 'release' (if any) runs once no segment refers to it anymore. */
+static bool _harbol_bufchain_add_region(struct HarbolBufChain *const chain, const void *const data, const size_t len, fnHarbolBufRelease *const release, void *const ctx, const bool at_front)
+{
+	if( !chain || (!data && len) )
+		return false;
+	
+	struct HarbolBufSegment *const seg = _harbol_bufchain_segment_new((void *)data, len, len, release, ctx);
+	if( !seg )
+		return false;
+	
+	_harbol_bufchain_link(chain, seg, at_front);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bufchain_append_buffer(struct HarbolBufChain *const restrict chain, struct HarbolByteBuffer *const restrict buf)
+{
+	return _harbol_bufchain_add_buffer(chain, buf, false);
+}
+
+HARBOL_EXPORT bool harbol_bufchain_prepend_buffer(struct HarbolBufChain *const restrict chain, struct HarbolByteBuffer *const restrict buf)
+{
+	return _harbol_bufchain_add_buffer(chain, buf, true);
+}
+
+HARBOL_EXPORT bool harbol_bufchain_append_region(struct HarbolBufChain *const chain, const void *const data, const size_t len, fnHarbolBufRelease *const release, void *const ctx)
+{
+	return _harbol_bufchain_add_region(chain, data, len, release, ctx, false);
+}
+
+HARBOL_EXPORT bool harbol_bufchain_prepend_region(struct HarbolBufChain *const chain, const void *const data, const size_t len, fnHarbolBufRelease *const release, void *const ctx)
+{
+	return _harbol_bufchain_add_region(chain, data, len, release, ctx, true);
+}
+
+/* an empty, writable segment of 'cap' bytes for 'readv' to fill. */
+HARBOL_EXPORT bool harbol_bufchain_append_space(struct HarbolBufChain *const chain, const size_t cap)
+{
+	if( !chain || !cap )
+		return false;
+	
+	void *const mem = malloc(cap);
+	if( !mem )
+		return false;
+	
+	struct HarbolBufSegment *const seg = _harbol_bufchain_segment_new(mem, 0, cap, _harbol_bufchain_release_heap, NULL);
+	if( !seg ) {
+		free(mem);
+		return false;
+	}
+	_harbol_bufchain_link(chain, seg, false);
+	return true;
+}
+
+/* moves every segment of 'src' to the end of 'dst'. */
+HARBOL_EXPORT bool harbol_bufchain_append_chain(struct HarbolBufChain *const restrict dst, struct HarbolBufChain *const restrict src)
+{
+	if( !dst || !src )
+		return false;
+	
+	for( struct HarbolIBiLink *link = harbol_ibilist_pop_head(&src->Segments); link; link = harbol_ibilist_pop_head(&src->Segments) )
+		harbol_ibilist_push_tail(&dst->Segments, link);
+	dst->Len += src->Len;
+	src->Len = 0;
+	return true;
+}
+
+/* leaves the first 'offset' bytes in 'chain' and moves the rest into the empty chain 'tail'.
+ * a segment straddling the split is shared by both sides rather than copied.
+ */
+HARBOL_EXPORT bool harbol_bufchain_split(struct HarbolBufChain *const restrict chain, const size_t offset, struct HarbolBufChain *const restrict tail)
+{
+	if( !chain || !tail || tail->Len || harbol_ibilist_get_len(&tail->Segments) || offset > chain->Len )
+		return false;
+	
+	size_t pos = 0;
+	struct HarbolBufSegment *seg = harbol_bufchain_get_head_segment(chain);
+	while( seg && pos + seg->Len <= offset ) {
+		pos += seg->Len;
+		seg = harbol_bufchain_get_next_segment(seg);
+	}
+	if( !seg )
+		return true;
+	
+	if( offset > pos ) {
+		const size_t keep = offset - pos;
+		struct HarbolBufSegment *const rest = calloc(1, sizeof *rest);
+		if( !rest )
+			return false;
+		
+		*rest = (struct HarbolBufSegment){ .Backing = seg->Backing, .Data = seg->Data + keep, .Len = seg->Len - keep, .Cap = seg->Cap - keep };
+		seg->Backing->Refs++;
+		// neither half may grow into the other's bytes.
+		seg->Len = seg->Cap = keep;
+		harbol_ibilist_insert_after(&chain->Segments, &seg->Link, &rest->Link);
+		seg = rest;
+	}
+	
+	while( seg ) {
+		struct HarbolBufSegment *const next = harbol_bufchain_get_next_segment(seg);
+		harbol_ibilist_remove(&chain->Segments, &seg->Link);
+		harbol_ibilist_push_tail(&tail->Segments, &seg->Link);
+		seg = next;
+	}
+	tail->Len = chain->Len - offset;
+	chain->Len = offset;
+	return true;
+}
+
+/* drops 'amount' bytes off the front, releasing segments that are used up. */
+HARBOL_EXPORT size_t harbol_bufchain_consume(struct HarbolBufChain *const chain, size_t amount)
+{
+	if( !chain )
+		return 0;
+	
+	size_t consumed = 0;
+	struct HarbolBufSegment *seg = harbol_bufchain_get_head_segment(chain);
+	while( seg && amount ) {
+		if( amount < seg->Len ) {
+			seg->Data += amount, seg->Len -= amount, seg->Cap -= amount;
+			consumed += amount;
+			break;
+		}
+		struct HarbolBufSegment *const next = harbol_bufchain_get_next_segment(seg);
+		// a segment with spare room still waiting to be read into stays.
+		if( seg->Cap > seg->Len ) {
+			seg->Data += seg->Len, seg->Cap -= seg->Len;
+			amount -= seg->Len, consumed += seg->Len;
+			seg->Len = 0;
+		} else {
+			amount -= seg->Len, consumed += seg->Len;
+			harbol_ibilist_remove(&chain->Segments, &seg->Link);
+			_harbol_bufchain_segment_free(seg);
+		}
+		seg = next;
+	}
+	chain->Len -= consumed;
+	return consumed;
+}
+
+/* gathers everything into one contiguous byte buffer for code that needs it flat. */
+HARBOL_EXPORT bool harbol_bufchain_to_bytebuffer(const struct HarbolBufChain *const restrict chain, struct HarbolByteBuffer *const restrict buf)
+{
+	if( !chain || !buf )
+		return false;
+	
+	uint8_t *dst = harbol_bytebuffer_prepare(buf, chain->Len);
+	if( !dst )
+		return false;
+	
+	for( const struct HarbolBufSegment *seg = harbol_bufchain_get_head_segment(chain); seg; seg = harbol_bufchain_get_next_segment(seg) ) {
+		if( seg->Len )
+			memcpy(dst, seg->Data, seg->Len);
+		dst += seg->Len;
+	}
+	return harbol_bytebuffer_commit(buf, chain->Len);
+}
+
+#ifndef OS_WINDOWS
+/* writes the whole chain, one 'writev' per batch of up to IOV_MAX segments, consuming what got written.
+ * stops early on an error (including EAGAIN on a non-blocking fd) with 'errno' left as it was;
+ * whatever was written by then is already consumed, so calling again picks up where it left off.
+ */
+HARBOL_EXPORT bool harbol_bufchain_writev(struct HarbolBufChain *const restrict chain, const int fd, size_t *const restrict written)
+{
+	if( written )
+		*written = 0;
+	if( !chain )
+		return false;
+	
+	struct iovec iov[HARBOL_BUFCHAIN_IOVS];
+	while( chain->Len ) {
+		int count = 0;
+		for( const struct HarbolBufSegment *seg = harbol_bufchain_get_head_segment(chain); seg && count < HARBOL_BUFCHAIN_IOVS; seg = harbol_bufchain_get_next_segment(seg) )
+			if( seg->Len )
+				iov[count++] = (struct iovec){ .iov_base = seg->Data, .iov_len = seg->Len };
+		
+		const ssize_t res = writev(fd, iov, count);
+		if( res < 0 ) {
+			if( errno==EINTR )
+				continue;
+			return false;
+		}
+		harbol_bufchain_consume(chain, (size_t)res);
+		if( written )
+			*written += (size_t)res;
+	}
+	return true;
+}
+
+/* one 'readv' into the spare room of the chain's segments, in order; 'got' is 0 at end of file. */
+HARBOL_EXPORT bool harbol_bufchain_readv(struct HarbolBufChain *const restrict chain, const int fd, size_t *const restrict got)
+{
+	if( got )
+		*got = 0;
+	if( !chain )
+		return false;
+	
+	struct iovec iov[HARBOL_BUFCHAIN_IOVS];
+	struct HarbolBufSegment *first = harbol_bufchain_get_head_segment(chain);
+	// only space after the last filled byte counts, so data stays in order.
+	for( struct HarbolBufSegment *seg = first; seg; seg = harbol_bufchain_get_next_segment(seg) )
+		if( seg->Len )
+			first = seg;
+	if( first && first->Len==first->Cap )
+		first = harbol_bufchain_get_next_segment(first);
+	
+	int count = 0;
+	for( struct HarbolBufSegment *seg = first; seg && count < HARBOL_BUFCHAIN_IOVS; seg = harbol_bufchain_get_next_segment(seg) )
+		iov[count++] = (struct iovec){ .iov_base = seg->Data + seg->Len, .iov_len = seg->Cap - seg->Len };
+	if( !count )
+		return false;
+	
+	ssize_t res;
+	do {
+		res = readv(fd, iov, count);
+	} while( res < 0 && errno==EINTR );
+	if( res < 0 )
+		return false;
+	
+	size_t left = (size_t)res;
+	for( struct HarbolBufSegment *seg = first; seg && left; seg = harbol_bufchain_get_next_segment(seg) ) {
+		const size_t fill = ( left < seg->Cap - seg->Len ) ? left : seg->Cap - seg->Len;
+		seg->Len += fill;
+		left -= fill;
+	}
+	chain->Len += (size_t)res;
+	if( got )
+		*got = (size_t)res;
+	return true;
+}
+#endif
@@ -1,3 +1,8 @@
+/* madvise and MAP_ANONYMOUS aren't part of strict C11/POSIX mode. */
+#ifndef _DEFAULT_SOURCE
+#	define _DEFAULT_SOURCE
+#endif
+
 #include <assert.h>
 
 #ifdef OS_WINDOWS
@@ -6,6 +11,13 @@
 
 #include "harbol.h"
 
+#ifndef OS_WINDOWS
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
 
 HARBOL_EXPORT struct HarbolByteBuffer *harbol_bytebuffer_new(void)
 {
@@ -34,25 +46,81 @@ HARBOL_EXPORT uint8_t *harbol_bytebuffer_get_raw_buffer(const struct HarbolByteB
 	return p ? p->Buffer : NULL;
 }
 
-HARBOL_EXPORT void harbol_bytebuffer_insert_byte(struct HarbolByteBuffer *const p, const uint8_t byte)
+/* grows geometrically so a run of small inserts costs amortized O(1) each, rather than a copy of the whole buffer per insert. */
+static bool _harbol_bytebuffer_grow(struct HarbolByteBuffer *const p, const size_t extra)
+{
+	if( p->MapLen )
+		return !extra;
+	else if( extra <= p->Len - p->Count )
+		return true;
+	else if( extra > SIZE_MAX - p->Count )
+		return false;
+	
+	size_t newlen = p->Len ? p->Len : HARBOL_BYTEBUFFER_DEFAULT_SIZE;
+	while( newlen < p->Count + extra )
+		newlen = ( newlen > SIZE_MAX/2 ) ? p->Count + extra : newlen << 1;
+	return harbol_bytebuffer_reserve(p, newlen);
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_reserve(struct HarbolByteBuffer *const p, const size_t len)
+{
+	if( !p )
+		return false;
+	else if( len <= p->Len )
+		return true;
+	else if( p->MapLen )
+		return false;
+	
+	uint8_t *const newbuf = realloc(p->Buffer, len);
+	if( !newbuf )
+		return false;
+	
+	p->Buffer = newbuf;
+	p->Len = len;
+	return true;
+}
+
+/* returns room for at least 'size' more bytes past the end; write into it, then 'commit' however many were used. */
+HARBOL_EXPORT uint8_t *harbol_bytebuffer_prepare(struct HarbolByteBuffer *const p, const size_t size)
+{
+	return ( p && _harbol_bytebuffer_grow(p, size) ) ? p->Buffer + p->Count : NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_commit(struct HarbolByteBuffer *const p, const size_t size)
+{
+	if( !p || p->MapLen || size > p->Len - p->Count )
+		return false;
+	
+	p->Count += size;
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_bytebuffer_get_spare(const struct HarbolByteBuffer *const p)
+{
+	return p ? p->Len - p->Count : 0;
+}
+
+/* keeps the allocation around for reuse. */
+HARBOL_EXPORT void harbol_bytebuffer_clear(struct HarbolByteBuffer *const p)
 {
 	if( !p )
 		return;
-	else if( p->Count >= p->Len )
-		//harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+1, sizeof *p->Buffer);
+	
+	p->Count = 0;
+}
+
+HARBOL_EXPORT void harbol_bytebuffer_insert_byte(struct HarbolByteBuffer *const p, const uint8_t byte)
+{
+	if( !p || (p->Count >= p->Len && !_harbol_bytebuffer_grow(p, 1)) )
+		return;
 	
 	p->Buffer[p->Count++] = byte;
 }
 
 HARBOL_EXPORT void harbol_bytebuffer_insert_integer(struct HarbolByteBuffer *const p, const uint64_t value, const size_t bytes)
 {
-	if( !p )
+	if( !p || bytes > sizeof value || !_harbol_bytebuffer_grow(p, bytes) )
 		return;
-	else if( p->Count+bytes >= p->Len )
-		//while( p->Count+bytes >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+bytes, sizeof *p->Buffer);
 	
 	memcpy(p->Buffer+p->Count, &value, bytes);
 	p->Count += bytes;
@@ -60,12 +128,8 @@ HARBOL_EXPORT void harbol_bytebuffer_insert_integer(struct HarbolByteBuffer *con
 
 HARBOL_EXPORT void harbol_bytebuffer_insert_float32(struct HarbolByteBuffer *const p, const float fval)
 {
-	if( !p )
+	if( !p || !_harbol_bytebuffer_grow(p, sizeof fval) )
 		return;
-	else if( p->Count+sizeof fval >= p->Len )
-		//while( p->Count+sizeof fval >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+sizeof fval, sizeof *p->Buffer);
 	
 	memcpy(p->Buffer+p->Count, &fval, sizeof fval);
 	p->Count += sizeof fval;
@@ -73,12 +137,8 @@ HARBOL_EXPORT void harbol_bytebuffer_insert_float32(struct HarbolByteBuffer *con
 
 HARBOL_EXPORT void harbol_bytebuffer_insert_float64(struct HarbolByteBuffer *const p, const double fval)
 {
-	if( !p )
+	if( !p || !_harbol_bytebuffer_grow(p, sizeof fval) )
 		return;
-	else if( p->Count+sizeof fval >= p->Len )
-		//while( p->Count+sizeof fval >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+sizeof fval, sizeof *p->Buffer);
 	
 	memcpy(p->Buffer+p->Count, &fval, sizeof fval);
 	p->Count += sizeof fval;
@@ -86,12 +146,8 @@ HARBOL_EXPORT void harbol_bytebuffer_insert_float64(struct HarbolByteBuffer *con
 
 HARBOL_EXPORT void harbol_bytebuffer_insert_cstr(struct HarbolByteBuffer *const restrict p, const char str[restrict], const size_t strsize)
 {
-	if( !p )
+	if( !p || strsize==SIZE_MAX || !_harbol_bytebuffer_grow(p, strsize+1) )
 		return;
-	else if( p->Count+strsize+1 >= p->Len )
-		//while( p->Count+strsize+1 >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+strsize+1, sizeof *p->Buffer);
 	
 	memcpy(p->Buffer+p->Count, str, strsize);
 	p->Count += strsize;
@@ -100,12 +156,8 @@ HARBOL_EXPORT void harbol_bytebuffer_insert_cstr(struct HarbolByteBuffer *const
 
 HARBOL_EXPORT void harbol_bytebuffer_insert_obj(struct HarbolByteBuffer *const restrict p, const void *restrict o, const size_t size)
 {
-	if( !p )
+	if( !p || !_harbol_bytebuffer_grow(p, size) )
 		return;
-	else if( p->Count+size >= p->Len )
-		//while( p->Count+size >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+size, sizeof *p->Buffer);
 	
 	memcpy(p->Buffer+p->Count, o, size);
 	p->Count += size;
@@ -113,12 +165,8 @@ HARBOL_EXPORT void harbol_bytebuffer_insert_obj(struct HarbolByteBuffer *const r
 
 HARBOL_EXPORT void harbol_bytebuffer_insert_zeros(struct HarbolByteBuffer *const p, const size_t zeroes)
 {
-	if( !p )
+	if( !p || !_harbol_bytebuffer_grow(p, zeroes) )
 		return;
-	else if( p->Count+zeroes >= p->Len )
-		//while( p->Count+zeroes >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+zeroes, sizeof *p->Buffer);
 	
 	memset(p->Buffer+p->Count, 0, zeroes);
 	p->Count += zeroes;
@@ -126,7 +174,7 @@ HARBOL_EXPORT void harbol_bytebuffer_insert_zeros(struct HarbolByteBuffer *const
 
 HARBOL_EXPORT void harbol_bytebuffer_delete_byte(struct HarbolByteBuffer *const p, const size_t index)
 {
-	if( !p )
+	if( !p || !p->Count || p->MapLen )
 		return;
 	
 	const size_t
@@ -143,6 +191,11 @@ HARBOL_EXPORT void harbol_bytebuffer_del(struct HarbolByteBuffer *const p)
 	if( !p )
 		return;
 	
+#ifndef OS_WINDOWS
+	if( p->MapLen )
+		munmap(p->Buffer, p->MapLen);
+	else
+#endif
 	if( p->Buffer )
 		free(p->Buffer);
 	
@@ -162,7 +215,7 @@ HARBOL_EXPORT void harbol_bytebuffer_resize(struct HarbolByteBuffer *const restr
 {
 	if( !p )
 		return;
-	else harbol_generic_vector_resizer(p, p->Len<<1, sizeof *p->Buffer);
+	else harbol_bytebuffer_reserve(p, p->Len ? p->Len<<1 : HARBOL_BYTEBUFFER_DEFAULT_SIZE);
 }
 
 HARBOL_EXPORT void harbol_bytebuffer_to_file(const struct HarbolByteBuffer *const p, FILE *const file)
@@ -187,15 +240,12 @@ HARBOL_EXPORT size_t harbol_bytebuffer_read_from_file(struct HarbolByteBuffer *c
 	rewind(file);
 	
 	// check if buffer can hold it.
-	// if not, resize until it can.
-	if( p->Count+filesize >= p->Len )
-		//while( p->Count+filesize >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+filesize, sizeof *p->Buffer);
+	if( !_harbol_bytebuffer_grow(p, (size_t)filesize) )
+		return 0;
 	
 	// read in the data.
 	const size_t val = fread(p->Buffer + p->Count, sizeof *p->Buffer, filesize, file);
-	p->Count += filesize;
+	p->Count += val;
 	return val;
 }
 
@@ -204,11 +254,104 @@ HARBOL_EXPORT void harbol_bytebuffer_append(struct HarbolByteBuffer *const p, st
 	if( !p || !o || !o->Buffer )
 		return;
 	
-	if( p->Count+o->Count >= p->Len )
-		//while( p->Count+o->Count >= p->Len )
-		//	harbol_bytebuffer_resize(p);
-		harbol_generic_vector_resizer(p, p->Count+o->Count, sizeof *p->Buffer);
+	if( !_harbol_bytebuffer_grow(p, o->Count) )
+		return;
 	
 	memcpy(p->Buffer+p->Count, o->Buffer, o->Count);
 	p->Count += o->Count;
 }
+
+HARBOL_EXPORT bool harbol_bytebuffer_is_mapped(const struct HarbolByteBuffer *const p)
+{
+	return p && p->MapLen;
+}
+
+#ifndef OS_WINDOWS
+static void _harbol_bytebuffer_advise(void *const addr, const size_t len, const int hints)
+{
+	// hints are only advice; a kernel that ignores or refuses one still maps the file fine.
+	if( hints & HarbolMapSequential )
+		madvise(addr, len, MADV_SEQUENTIAL);
+	if( hints & HarbolMapWillNeed )
+		madvise(addr, len, MADV_WILLNEED);
+#	ifdef MADV_HUGEPAGE
+	if( hints & HarbolMapHugePage )
+		madvise(addr, len, MADV_HUGEPAGE);
+#	endif
+}
+#endif
+
+/* replaces 'p' with a read-only view of the whole file, so nothing is read in until it's touched.
+ * the view is always followed by a 0 byte, so text files can go straight to the C-string parsers.
+ * only the inserting/deleting functions are off limits for a view; 'del' unmaps it.
+ * on Windows, the file is read into the buffer instead.
+ */
+HARBOL_EXPORT bool harbol_bytebuffer_map_file(struct HarbolByteBuffer *const restrict p, const char filename[restrict], const int hints)
+{
+	if( !p || !filename )
+		return false;
+	
+#ifdef OS_WINDOWS
+	(void)hints;
+	FILE *const file = fopen(filename, "rb");
+	if( !file )
+		return false;
+	
+	struct HarbolByteBuffer view = (struct HarbolByteBuffer){0};
+	harbol_bytebuffer_read_from_file(&view, file);
+	const bool res = !ferror(file) && _harbol_bytebuffer_grow(&view, 1);
+	fclose(file);
+	if( !res ) {
+		harbol_bytebuffer_del(&view);
+		return false;
+	}
+	view.Buffer[view.Count] = 0;
+#else
+	const int fd = open(filename, O_RDONLY);
+	if( fd < 0 )
+		return false;
+	
+	struct stat st;
+	const long page = sysconf(_SC_PAGESIZE);
+	if( fstat(fd, &st) || !S_ISREG(st.st_mode) || page <= 0 || (uintmax_t)st.st_size >= SIZE_MAX - (size_t)page ) {
+		close(fd);
+		return false;
+	}
+	
+	const size_t size = (size_t)st.st_size;
+	// reserve at least one byte past the file, rounded to whole pages, as zero-filled anonymous memory.
+	// the file goes over the front of it, so the byte after its end is 0 even when it fills its last page exactly.
+	const size_t maplen = (size / (size_t)page + 1) * (size_t)page;
+	uint8_t *const base = mmap(NULL, maplen, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if( base==MAP_FAILED ) {
+		close(fd);
+		return false;
+	}
+	if( size && mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0)==MAP_FAILED ) {
+		munmap(base, maplen);
+		close(fd);
+		return false;
+	}
+	close(fd);
+	if( size )
+		_harbol_bytebuffer_advise(base, size, hints);
+	
+	const struct HarbolByteBuffer view = { .Buffer = base, .Len = size, .Count = size, .MapLen = maplen };
+#endif
+	harbol_bytebuffer_del(p);
+	*p = view;
+	return true;
+}
+
+/* re-advises a mapped view, e.g. once a sequential pass is done; does nothing for ordinary buffers. */
+HARBOL_EXPORT bool harbol_bytebuffer_advise(const struct HarbolByteBuffer *const p, const int hints)
+{
+	if( !p || !p->MapLen )
+		return false;
+	
+#ifndef OS_WINDOWS
+	if( p->Count )
+		_harbol_bytebuffer_advise(p->Buffer, p->Count, hints);
+#endif
+	return true;
+}
@@ -0,0 +1,450 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolByteWriter {
+	struct HarbolByteBuffer *Buf;
+	bool Failed;
+} HarbolByteWriter;
+
+typedef struct HarbolByteReader {
+	const uint8_t *Data;
+	size_t Len, Pos;
+	bool Failed;
+} HarbolByteReader;
+ */
+
+/* both cursors latch the first error: after a failed call every later one fails too,
+ * so a whole message can be written or read and then checked once with '_ok'.
+ */
+
+/* longest LEB128 encoding of a 64-bit value. */
+#define HARBOL_VARINT_MAX    10
+
+static inline void _harbol_store_le(uint8_t *const restrict dst, const uint64_t val, const size_t bytes)
+{
+	for( size_t i=0; i<bytes; i++ )
+		dst[i] = (uint8_t)(val >> (i * 8));
+}
+
+static inline void _harbol_store_be(uint8_t *const restrict dst, const uint64_t val, const size_t bytes)
+{
+	for( size_t i=0; i<bytes; i++ )
+		dst[i] = (uint8_t)(val >> ((bytes - 1 - i) * 8));
+}
+
+static inline uint64_t _harbol_load_le(const uint8_t *const restrict src, const size_t bytes)
+{
+	uint64_t val = 0;
+	for( size_t i=0; i<bytes; i++ )
+		val |= (uint64_t)src[i] << (i * 8);
+	return val;
+}
+
+static inline uint64_t _harbol_load_be(const uint8_t *const restrict src, const size_t bytes)
+{
+	uint64_t val = 0;
+	for( size_t i=0; i<bytes; i++ )
+		val = (val << 8) | src[i];
+	return val;
+}
+
+
+/* Byte Writer code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_bytewriter_init(struct HarbolByteWriter *const restrict w, struct HarbolByteBuffer *const restrict buf)
+{
+	if( !w )
+		return;
+	
+	w->Buf = buf;
+	w->Failed = !buf;
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_ok(const struct HarbolByteWriter *const w)
+{
+	return w && !w->Failed;
+}
+
+/* hands out 'size' bytes at the end of the buffer and counts them as written. */
+static uint8_t *_harbol_bytewriter_claim(struct HarbolByteWriter *const w, const size_t size)
+{
+	if( !w || w->Failed )
+		return NULL;
+	
+	uint8_t *const dst = harbol_bytebuffer_prepare(w->Buf, size);
+	if( !dst ) {
+		w->Failed = true;
+		return NULL;
+	}
+	harbol_bytebuffer_commit(w->Buf, size);
+	return dst;
+}
+
+static bool _harbol_bytewriter_put_le(struct HarbolByteWriter *const w, const uint64_t val, const size_t bytes)
+{
+	uint8_t *const dst = _harbol_bytewriter_claim(w, bytes);
+	if( dst )
+		_harbol_store_le(dst, val, bytes);
+	return dst != NULL;
+}
+
+static bool _harbol_bytewriter_put_be(struct HarbolByteWriter *const w, const uint64_t val, const size_t bytes)
+{
+	uint8_t *const dst = _harbol_bytewriter_claim(w, bytes);
+	if( dst )
+		_harbol_store_be(dst, val, bytes);
+	return dst != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u8(struct HarbolByteWriter *const w, const uint8_t val)
+{
+	return _harbol_bytewriter_put_le(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u16_le(struct HarbolByteWriter *const w, const uint16_t val)
+{
+	return _harbol_bytewriter_put_le(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u16_be(struct HarbolByteWriter *const w, const uint16_t val)
+{
+	return _harbol_bytewriter_put_be(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u32_le(struct HarbolByteWriter *const w, const uint32_t val)
+{
+	return _harbol_bytewriter_put_le(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u32_be(struct HarbolByteWriter *const w, const uint32_t val)
+{
+	return _harbol_bytewriter_put_be(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u64_le(struct HarbolByteWriter *const w, const uint64_t val)
+{
+	return _harbol_bytewriter_put_le(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u64_be(struct HarbolByteWriter *const w, const uint64_t val)
+{
+	return _harbol_bytewriter_put_be(w, val, sizeof val);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_f32_le(struct HarbolByteWriter *const w, const float val)
+{
+	uint32_t bits;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytewriter_put_le(w, bits, sizeof bits);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_f32_be(struct HarbolByteWriter *const w, const float val)
+{
+	uint32_t bits;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytewriter_put_be(w, bits, sizeof bits);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_f64_le(struct HarbolByteWriter *const w, const double val)
+{
+	uint64_t bits;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytewriter_put_le(w, bits, sizeof bits);
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_f64_be(struct HarbolByteWriter *const w, const double val)
+{
+	uint64_t bits;
+	memcpy(&bits, &val, sizeof bits);
+	return _harbol_bytewriter_put_be(w, bits, sizeof bits);
+}
+
+/* unsigned LEB128: 7 bits per byte, low group first, high bit set on every byte but the last. */
+HARBOL_EXPORT bool harbol_bytewriter_put_uvarint(struct HarbolByteWriter *const w, uint64_t val)
+{
+	uint8_t tmp[HARBOL_VARINT_MAX];
+	size_t len = 0;
+	while( val >= 0x80 ) {
+		tmp[len++] = (uint8_t)val | 0x80;
+		val >>= 7;
+	}
+	tmp[len++] = (uint8_t)val;
+	
+	uint8_t *const dst = _harbol_bytewriter_claim(w, len);
+	if( dst )
+		memcpy(dst, tmp, len);
+	return dst != NULL;
+}
+
+/* zigzag maps small negative numbers to small unsigned ones (0, -1, 1, -2 -> 0, 1, 2, 3) before the LEB128 step. */
+HARBOL_EXPORT bool harbol_bytewriter_put_svarint(struct HarbolByteWriter *const w, const int64_t val)
+{
+	return harbol_bytewriter_put_uvarint(w, ((uint64_t)val << 1) ^ (uint64_t)(val >> 63));
+}
+
+HARBOL_EXPORT bool harbol_bytewriter_put_bytes(struct HarbolByteWriter *const restrict w, const void *const restrict data, const size_t size)
+{
+	if( !w || w->Failed )
+		return false;
+	else if( !size )
+		return true;
+	else if( !data ) {
+		w->Failed = true;
+		return false;
+	}
+	
+	uint8_t *const dst = _harbol_bytewriter_claim(w, size);
+	if( dst )
+		memcpy(dst, data, size);
+	return dst != NULL;
+}
+
+/* varint length followed by the bytes. */
+HARBOL_EXPORT bool harbol_bytewriter_put_blob(struct HarbolByteWriter *const restrict w, const void *const restrict data, const size_t size)
+{
+	return harbol_bytewriter_put_uvarint(w, size) && harbol_bytewriter_put_bytes(w, data, size);
+}
+
+/* same encoding as a blob; no null terminator is stored. */
+HARBOL_EXPORT bool harbol_bytewriter_put_str(struct HarbolByteWriter *const restrict w, const char cstr[restrict], const size_t len)
+{
+	return harbol_bytewriter_put_blob(w, cstr, len);
+}
+/////////////////////////////////////////
+
+
+/* Byte Reader code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_bytereader_init(struct HarbolByteReader *const restrict r, const uint8_t *const restrict data, const size_t len)
+{
+	if( !r )
+		return;
+	
+	r->Data = data;
+	r->Len = data ? len : 0;
+	r->Pos = 0;
+	r->Failed = false;
+}
+
+/* reads the buffer's contents as they are now; writing more to the buffer may move them, invalidating the reader. */
+HARBOL_EXPORT void harbol_bytereader_init_buffer(struct HarbolByteReader *const restrict r, const struct HarbolByteBuffer *const restrict buf)
+{
+	harbol_bytereader_init(r, buf ? buf->Buffer : NULL, buf ? buf->Count : 0);
+}
+
+HARBOL_EXPORT bool harbol_bytereader_ok(const struct HarbolByteReader *const r)
+{
+	return r && !r->Failed;
+}
+
+HARBOL_EXPORT size_t harbol_bytereader_get_pos(const struct HarbolByteReader *const r)
+{
+	return r ? r->Pos : 0;
+}
+
+HARBOL_EXPORT size_t harbol_bytereader_get_remaining(const struct HarbolByteReader *const r)
+{
+	return r ? r->Len - r->Pos : 0;
+}
+
+/* bounds-checked view of the next 'size' bytes; nothing moves if there aren't enough. */
+static const uint8_t *_harbol_bytereader_take(struct HarbolByteReader *const r, const size_t size)
+{
+	if( !r || r->Failed )
+		return NULL;
+	else if( size > r->Len - r->Pos ) {
+		r->Failed = true;
+		return NULL;
+	}
+	
+	const uint8_t *const src = r->Data + r->Pos;
+	r->Pos += size;
+	return src;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_skip(struct HarbolByteReader *const r, const size_t size)
+{
+	return size ? _harbol_bytereader_take(r, size) != NULL : harbol_bytereader_ok(r);
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u8(struct HarbolByteReader *const restrict r, uint8_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = *src;
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u16_le(struct HarbolByteReader *const restrict r, uint16_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = (uint16_t)_harbol_load_le(src, sizeof *val);
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u16_be(struct HarbolByteReader *const restrict r, uint16_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = (uint16_t)_harbol_load_be(src, sizeof *val);
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u32_le(struct HarbolByteReader *const restrict r, uint32_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = (uint32_t)_harbol_load_le(src, sizeof *val);
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u32_be(struct HarbolByteReader *const restrict r, uint32_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = (uint32_t)_harbol_load_be(src, sizeof *val);
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u64_le(struct HarbolByteReader *const restrict r, uint64_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = (uint64_t)_harbol_load_le(src, sizeof *val);
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_u64_be(struct HarbolByteReader *const restrict r, uint64_t *const restrict val)
+{
+	const uint8_t *const src = _harbol_bytereader_take(r, sizeof *val);
+	if( src && val )
+		*val = (uint64_t)_harbol_load_be(src, sizeof *val);
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_f32_le(struct HarbolByteReader *const restrict r, float *const restrict val)
+{
+	uint32_t bits;
+	if( !harbol_bytereader_get_u32_le(r, &bits) )
+		return false;
+	else if( val )
+		memcpy(val, &bits, sizeof *val);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_f32_be(struct HarbolByteReader *const restrict r, float *const restrict val)
+{
+	uint32_t bits;
+	if( !harbol_bytereader_get_u32_be(r, &bits) )
+		return false;
+	else if( val )
+		memcpy(val, &bits, sizeof *val);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_f64_le(struct HarbolByteReader *const restrict r, double *const restrict val)
+{
+	uint64_t bits;
+	if( !harbol_bytereader_get_u64_le(r, &bits) )
+		return false;
+	else if( val )
+		memcpy(val, &bits, sizeof *val);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_f64_be(struct HarbolByteReader *const restrict r, double *const restrict val)
+{
+	uint64_t bits;
+	if( !harbol_bytereader_get_u64_be(r, &bits) )
+		return false;
+	else if( val )
+		memcpy(val, &bits, sizeof *val);
+	return true;
+}
+
+/* rejects truncated input, encodings longer than 10 bytes, values that overflow 64 bits
+ * and overlong encodings padded with zero groups (e.g. 0x80 0x00), so every value has exactly one encoding.
+ */
+HARBOL_EXPORT bool harbol_bytereader_get_uvarint(struct HarbolByteReader *const restrict r, uint64_t *const restrict val)
+{
+	if( !r || r->Failed )
+		return false;
+	
+	uint64_t res = 0;
+	for( size_t i=0; i<HARBOL_VARINT_MAX && r->Pos + i < r->Len; i++ ) {
+		const uint8_t byte = r->Data[r->Pos + i];
+		// the tenth byte only has room for the top bit of a 64-bit value,
+		// and a last byte of 0 only adds a zero group, which the shortest encoding leaves off.
+		if( (i==HARBOL_VARINT_MAX-1 && byte > 1) || (i && !byte) )
+			break;
+		
+		res |= (uint64_t)(byte & 0x7F) << (i * 7);
+		if( !(byte & 0x80) ) {
+			r->Pos += i + 1;
+			if( val )
+				*val = res;
+			return true;
+		}
+	}
+	r->Failed = true;
+	return false;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_svarint(struct HarbolByteReader *const restrict r, int64_t *const restrict val)
+{
+	uint64_t zz;
+	if( !harbol_bytereader_get_uvarint(r, &zz) )
+		return false;
+	else if( val )
+		*val = (int64_t)(zz >> 1) ^ -(int64_t)(zz & 1);
+	return true;
+}
+
+/* zero-copy: 'view' points into the reader's memory and stays valid as long as that memory does. */
+HARBOL_EXPORT bool harbol_bytereader_get_bytes(struct HarbolByteReader *const restrict r, const size_t size, const uint8_t **const restrict view)
+{
+	if( !size ) {
+		if( view && r )
+			*view = r->Data ? r->Data + r->Pos : NULL;
+		return harbol_bytereader_ok(r);
+	}
+	
+	const uint8_t *const src = _harbol_bytereader_take(r, size);
+	if( src && view )
+		*view = src;
+	return src != NULL;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_get_blob(struct HarbolByteReader *const restrict r, const uint8_t **const restrict view, size_t *const restrict size)
+{
+	if( !r || r->Failed )
+		return false;
+	
+	const size_t start = r->Pos;
+	uint64_t len;
+	if( !harbol_bytereader_get_uvarint(r, &len) )
+		return false;
+	else if( len > r->Len - r->Pos ) {
+		// leave the cursor on the length prefix.
+		r->Pos = start;
+		r->Failed = true;
+		return false;
+	}
+	
+	harbol_bytereader_get_bytes(r, (size_t)len, view);
+	if( size )
+		*size = (size_t)len;
+	return true;
+}
+
+/* the string view isn't null terminated; use the length. */
+HARBOL_EXPORT bool harbol_bytereader_get_str(struct HarbolByteReader *const restrict r, const char **const restrict view, size_t *const restrict len)
+{
+	return harbol_bytereader_get_blob(r, (const uint8_t **)view, len);
+}
+/////////////////////////////////////////
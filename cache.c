@@ -0,0 +1,350 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolCache {
+	struct HarbolLinkMap Map;
+	struct HarbolObjPool Entries;
+	fnHarbolDestructor *OnEvict;
+	struct HarbolKeyValPair *Hand;
+	uint8_t *Sketch;
+	size_t SketchWidth, SketchSamples;
+	size_t Capacity, Weight;
+	struct HarbolCacheStats Stats;
+	enum HarbolCachePolicy Policy;
+} HarbolCache;
+*/
+
+/* the linkmap's order doubles as the recency list: the front is the least recently used entry. */
+
+/* the sketch is sized to the capacity, but never so narrow that a scan of one-off keys saturates it through collisions. */
+#define HARBOL_CACHE_SKETCH_ROWS    4
+#define HARBOL_CACHE_SKETCH_MIN    1024
+#define HARBOL_CACHE_SKETCH_MAX    (1 << 16)
+
+HARBOL_EXPORT struct HarbolCache *harbol_cache_new(const enum HarbolCachePolicy policy, const size_t capacity, fnHarbolDestructor *const on_evict)
+{
+	struct HarbolCache *cache = calloc(1, sizeof *cache);
+	if( cache && !harbol_cache_init(cache, policy, capacity, on_evict) )
+		free(cache), cache=NULL;
+	return cache;
+}
+
+HARBOL_EXPORT bool harbol_cache_init(struct HarbolCache *const cache, const enum HarbolCachePolicy policy, const size_t capacity, fnHarbolDestructor *const on_evict)
+{
+	if( !cache || !capacity )
+		return false;
+	
+	memset(cache, 0, sizeof *cache);
+	harbol_objpool_init(&cache->Entries, sizeof(struct HarbolCacheEntry));
+	cache->Policy = policy;
+	cache->Capacity = capacity;
+	cache->OnEvict = on_evict;
+	if( policy==HarbolCacheTinyLFU ) {
+		size_t width = HARBOL_CACHE_SKETCH_MIN;
+		while( width < capacity && width < HARBOL_CACHE_SKETCH_MAX )
+			width <<= 1;
+		// two 4-bit counters per byte.
+		cache->Sketch = calloc(HARBOL_CACHE_SKETCH_ROWS * width / 2, sizeof *cache->Sketch);
+		if( !cache->Sketch )
+			return false;
+		cache->SketchWidth = width;
+	}
+	return true;
+}
+
+static void _harbol_cache_drop_entry(struct HarbolCache *const cache, struct HarbolCacheEntry *const entry)
+{
+	if( cache->OnEvict )
+		(*cache->OnEvict)(&entry->Data.Ptr);
+	cache->Weight -= entry->Weight;
+	harbol_objpool_dealloc(&cache->Entries, entry);
+}
+
+HARBOL_EXPORT void harbol_cache_del(struct HarbolCache *const cache)
+{
+	if( !cache )
+		return;
+	
+	harbol_cache_clear(cache);
+	harbol_linkmap_del(&cache->Map, NULL);
+	harbol_objpool_del(&cache->Entries);
+	free(cache->Sketch);
+	memset(cache, 0, sizeof *cache);
+}
+
+HARBOL_EXPORT void harbol_cache_free(struct HarbolCache **cacheref)
+{
+	if( !cacheref || !*cacheref )
+		return;
+	
+	harbol_cache_del(*cacheref);
+	free(*cacheref), *cacheref=NULL;
+}
+
+/* every entry is given to the eviction callback, but none of it counts as an eviction. */
+HARBOL_EXPORT void harbol_cache_clear(struct HarbolCache *const cache)
+{
+	if( !cache )
+		return;
+	
+	const union HarbolValue *const end = harbol_linkmap_get_iter_end_count(&cache->Map);
+	for( union HarbolValue *iter = harbol_linkmap_get_iter(&cache->Map); iter && iter<end; iter++ )
+		_harbol_cache_drop_entry(cache, iter->KvPairPtr->Data.Ptr);
+	harbol_linkmap_del(&cache->Map, NULL);
+	cache->Hand = NULL;
+}
+
+static inline size_t _harbol_cache_sketch_slot(const struct HarbolCache *const cache, const size_t hash, const size_t row)
+{
+	const size_t h2 = (size_t)int64_hash(hash);
+	return row * cache->SketchWidth + ((hash + row * h2) & (cache->SketchWidth - 1));
+}
+
+static inline uint8_t _harbol_cache_sketch_get(const struct HarbolCache *const cache, const size_t slot)
+{
+	return (cache->Sketch[slot >> 1] >> ((slot & 1) << 2)) & 0xF;
+}
+
+static size_t _harbol_cache_frequency(const struct HarbolCache *const restrict cache, const char strkey[restrict])
+{
+	const size_t hash = generic_hash(strkey);
+	uint8_t freq = 0xF;
+	for( size_t row=0; row<HARBOL_CACHE_SKETCH_ROWS; row++ ) {
+		const uint8_t count = _harbol_cache_sketch_get(cache, _harbol_cache_sketch_slot(cache, hash, row));
+		if( count < freq )
+			freq = count;
+	}
+	return freq;
+}
+
+static void _harbol_cache_record(struct HarbolCache *const restrict cache, const char strkey[restrict])
+{
+	if( !cache->Sketch )
+		return;
+	
+	const size_t hash = generic_hash(strkey);
+	for( size_t row=0; row<HARBOL_CACHE_SKETCH_ROWS; row++ ) {
+		const size_t slot = _harbol_cache_sketch_slot(cache, hash, row);
+		if( _harbol_cache_sketch_get(cache, slot) < 0xF )
+			cache->Sketch[slot >> 1] += 1 << ((slot & 1) << 2);
+	}
+	// aging: halve every counter once enough samples went by so old popularity fades out.
+	if( ++cache->SketchSamples >= cache->SketchWidth * 10 ) {
+		for( size_t i=0; i<HARBOL_CACHE_SKETCH_ROWS * cache->SketchWidth / 2; i++ )
+			cache->Sketch[i] = (cache->Sketch[i] >> 1) & 0x77;
+		cache->SketchSamples >>= 1;
+	}
+}
+
+static struct HarbolKeyValPair *_harbol_cache_next_live(const struct HarbolCache *const cache, size_t slot)
+{
+	const struct HarbolLinkMap *const map = &cache->Map;
+	for( size_t i=0; i<map->Order.Count; i++, slot++ ) {
+		if( slot >= map->Order.Count )
+			slot = map->Front;
+		if( map->Order.Table[slot].Ptr )
+			return map->Order.Table[slot].Ptr;
+	}
+	return NULL;
+}
+
+static struct HarbolKeyValPair *_harbol_cache_pick_victim(struct HarbolCache *const cache)
+{
+	// 'Front' is always the first live slot, so this skips the compaction an index lookup might do.
+	if( cache->Policy != HarbolCacheCLOCK )
+		return _harbol_cache_next_live(cache, cache->Map.Front);
+	
+	// give every referenced entry a second chance, at most two sweeps are ever needed.
+	struct HarbolKeyValPair *kv = cache->Hand ? cache->Hand : _harbol_cache_next_live(cache, cache->Map.Front);
+	while( kv ) {
+		struct HarbolCacheEntry *const entry = kv->Data.Ptr;
+		if( !entry->Referenced )
+			break;
+		entry->Referenced = false;
+		kv = _harbol_cache_next_live(cache, kv->Index + 1);
+	}
+	cache->Hand = kv;
+	return kv;
+}
+
+static void _harbol_cache_remove_node(struct HarbolCache *const cache, struct HarbolKeyValPair *const kv)
+{
+	if( cache->Hand==kv ) {
+		cache->Hand = _harbol_cache_next_live(cache, kv->Index + 1);
+		if( cache->Hand==kv )
+			cache->Hand = NULL;
+	}
+	_harbol_cache_drop_entry(cache, kv->Data.Ptr);
+	harbol_linkmap_delete(&cache->Map, kv->KeyName.CStr, NULL);
+}
+
+static void _harbol_cache_touch_node(struct HarbolCache *const cache, struct HarbolKeyValPair *const kv)
+{
+	if( cache->Policy==HarbolCacheCLOCK ) {
+		struct HarbolCacheEntry *const entry = kv->Data.Ptr;
+		entry->Referenced = true;
+	}
+	else harbol_linkmap_move_node_to_end(&cache->Map, kv);
+}
+
+static void _harbol_cache_shrink_to(struct HarbolCache *const cache, const size_t weight)
+{
+	while( cache->Weight > weight ) {
+		struct HarbolKeyValPair *const victim = _harbol_cache_pick_victim(cache);
+		if( !victim )
+			break;
+		_harbol_cache_remove_node(cache, victim);
+		cache->Stats.Evictions++;
+	}
+}
+
+HARBOL_EXPORT bool harbol_cache_get(struct HarbolCache *const restrict cache, const char strkey[restrict], union HarbolValue *const restrict val)
+{
+	if( !cache || !strkey )
+		return false;
+	
+	_harbol_cache_record(cache, strkey);
+	struct HarbolKeyValPair *const kv = harbol_linkmap_get_node_by_key(&cache->Map, strkey);
+	if( !kv ) {
+		cache->Stats.Misses++;
+		return false;
+	}
+	cache->Stats.Hits++;
+	_harbol_cache_touch_node(cache, kv);
+	if( val ) {
+		const struct HarbolCacheEntry *const entry = kv->Data.Ptr;
+		*val = entry->Data;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cache_peek(const struct HarbolCache *const restrict cache, const char strkey[restrict], union HarbolValue *const restrict val)
+{
+	if( !cache || !strkey )
+		return false;
+	
+	const struct HarbolKeyValPair *const kv = harbol_linkmap_get_node_by_key(&cache->Map, strkey);
+	if( kv && val ) {
+		const struct HarbolCacheEntry *const entry = kv->Data.Ptr;
+		*val = entry->Data;
+	}
+	return kv != NULL;
+}
+
+HARBOL_EXPORT bool harbol_cache_touch(struct HarbolCache *const restrict cache, const char strkey[restrict])
+{
+	if( !cache || !strkey )
+		return false;
+	
+	struct HarbolKeyValPair *const kv = harbol_linkmap_get_node_by_key(&cache->Map, strkey);
+	if( kv )
+		_harbol_cache_touch_node(cache, kv);
+	return kv != NULL;
+}
+
+HARBOL_EXPORT bool harbol_cache_put(struct HarbolCache *const restrict cache, const char strkey[restrict], const union HarbolValue val, const size_t weight)
+{
+	if( !cache || !strkey )
+		return false;
+	
+	// the cache owns 'val' from here on, so anything it can't keep goes to the callback.
+	union HarbolValue rejected = val;
+	if( weight > cache->Capacity ) {
+		if( cache->OnEvict )
+			(*cache->OnEvict)(&rejected.Ptr);
+		cache->Stats.Rejections++;
+		return false;
+	}
+	
+	_harbol_cache_record(cache, strkey);
+	struct HarbolKeyValPair *const kv = harbol_linkmap_get_node_by_key(&cache->Map, strkey);
+	if( kv ) {
+		struct HarbolCacheEntry *const entry = kv->Data.Ptr;
+		if( cache->OnEvict && entry->Data.UInt64 != val.UInt64 )
+			(*cache->OnEvict)(&entry->Data.Ptr);
+		cache->Weight = cache->Weight - entry->Weight + weight;
+		entry->Data = val;
+		entry->Weight = weight;
+		_harbol_cache_touch_node(cache, kv);
+		// the entry being replaced can't be its own victim.
+		entry->Referenced = true;
+		_harbol_cache_shrink_to(cache, cache->Capacity);
+		return true;
+	}
+	
+	if( cache->Weight + weight > cache->Capacity && cache->Policy==HarbolCacheTinyLFU ) {
+		// TinyLFU admission: only let the newcomer in if it's been asked for more than what it'd push out.
+		const struct HarbolKeyValPair *const victim = _harbol_cache_pick_victim(cache);
+		if( victim && _harbol_cache_frequency(cache, strkey) <= _harbol_cache_frequency(cache, victim->KeyName.CStr) ) {
+			if( cache->OnEvict )
+				(*cache->OnEvict)(&rejected.Ptr);
+			cache->Stats.Rejections++;
+			return false;
+		}
+	}
+	_harbol_cache_shrink_to(cache, cache->Capacity - weight);
+	
+	struct HarbolCacheEntry *const entry = harbol_objpool_alloc(&cache->Entries);
+	if( !entry )
+		return false;
+	
+	*entry = (struct HarbolCacheEntry){ .Data = val, .Weight = weight };
+	if( !harbol_linkmap_insert(&cache->Map, strkey, (union HarbolValue){.Ptr=entry}) ) {
+		harbol_objpool_dealloc(&cache->Entries, entry);
+		return false;
+	}
+	cache->Weight += weight;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_cache_remove(struct HarbolCache *const restrict cache, const char strkey[restrict])
+{
+	if( !cache || !strkey )
+		return false;
+	
+	struct HarbolKeyValPair *const kv = harbol_linkmap_get_node_by_key(&cache->Map, strkey);
+	if( kv )
+		_harbol_cache_remove_node(cache, kv);
+	return kv != NULL;
+}
+
+HARBOL_EXPORT void harbol_cache_set_capacity(struct HarbolCache *const cache, const size_t capacity)
+{
+	if( !cache || !capacity )
+		return;
+	
+	cache->Capacity = capacity;
+	_harbol_cache_shrink_to(cache, capacity);
+}
+
+HARBOL_EXPORT size_t harbol_cache_get_count(const struct HarbolCache *const cache)
+{
+	return cache ? harbol_linkmap_get_count(&cache->Map) : 0;
+}
+
+HARBOL_EXPORT size_t harbol_cache_get_weight(const struct HarbolCache *const cache)
+{
+	return cache ? cache->Weight : 0;
+}
+
+HARBOL_EXPORT size_t harbol_cache_get_capacity(const struct HarbolCache *const cache)
+{
+	return cache ? cache->Capacity : 0;
+}
+
+HARBOL_EXPORT struct HarbolCacheStats harbol_cache_get_stats(const struct HarbolCache *const cache)
+{
+	return cache ? cache->Stats : (struct HarbolCacheStats){0};
+}
+
+HARBOL_EXPORT void harbol_cache_reset_stats(struct HarbolCache *const cache)
+{
+	if( !cache )
+		return;
+	
+	memset(&cache->Stats, 0, sizeof cache->Stats);
+}
@@ -434,40 +434,19 @@ static bool harbol_cfg_parse_section(struct HarbolLinkMap *const restrict map, c
 }
 
 
+/* the file is mapped rather than read in, so parsing starts right away and there's no second copy of it. */
 HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_from_file(const char filename[restrict])
 {
 	if( !filename )
 		return NULL;
 	
-	FILE *restrict cfgfile = fopen(filename, "r");
-	if( !cfgfile ) {
-		fprintf(stderr, "harbol_cfg_from_file :: unable to find file '%s'.\n", filename);
-		return NULL;
-	}
-	fseek(cfgfile, 0, SEEK_END);
-	const long filesize = ftell(cfgfile);
-	if( filesize <= -1 ) {
-		fprintf(stderr, "harbol_cfg_from_file :: size of file '%s' is negative: '%li'\n", filename, filesize);
-		fclose(cfgfile), cfgfile=NULL;
-		return NULL;
-	}
-	rewind(cfgfile);
-	
-	char *restrict cfgcode = calloc(filesize+1, sizeof *cfgcode);
-	if( !cfgcode ) {
-		fprintf(stderr, "harbol_cfg_from_file :: unable to allocate buffer for file '%s'.\n", filename);
-		fclose(cfgfile), cfgfile=NULL;
+	struct HarbolByteBuffer view = (struct HarbolByteBuffer){0};
+	if( !harbol_bytebuffer_map_file(&view, filename, HarbolMapSequential) ) {
+		fprintf(stderr, "harbol_cfg_from_file :: unable to open file '%s'.\n", filename);
 		return NULL;
 	}
-	const size_t val = fread(cfgcode, sizeof *cfgcode, filesize, cfgfile);
-	fclose(cfgfile), cfgfile=NULL;
-	if( val != (size_t)filesize ) {
-		fprintf(stderr, "harbol_cfg_from_file :: filesize '%li' does not match fread return value '%zu' for file '%s'\n", filesize, val, filename);
-		free(cfgcode), cfgcode=NULL;
-		return NULL;
-	}
-	struct HarbolLinkMap *const restrict objs = harbol_cfg_parse_cstr(cfgcode);
-	free(cfgcode), cfgcode=NULL;
+	struct HarbolLinkMap *const restrict objs = harbol_cfg_parse_bytebuffer(&view);
+	harbol_bytebuffer_del(&view);
 	return objs;
 }
 
@@ -492,6 +471,28 @@ HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_parse_cstr(const char cfgcode[])
 	}
 }
 
+/* parses a byte buffer in place when its text is already 0-terminated within 'Count' or it's a mapped file view,
+ * whose byte past the end is always 0; otherwise it takes a terminated copy first.
+ * the spare capacity of an owned buffer is never read, it's uninitialized.
+ */
+HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_parse_bytebuffer(const struct HarbolByteBuffer *const buf)
+{
+	if( !buf || !buf->Buffer )
+		return NULL;
+	else if( buf->MapLen || (buf->Count && !buf->Buffer[buf->Count-1]) )
+		return harbol_cfg_parse_cstr((const char *)buf->Buffer);
+	
+	char *const cfgcode = malloc(buf->Count + 1);
+	if( !cfgcode )
+		return NULL;
+	
+	memcpy(cfgcode, buf->Buffer, buf->Count);
+	cfgcode[buf->Count] = 0;
+	struct HarbolLinkMap *const objs = harbol_cfg_parse_cstr(cfgcode);
+	free(cfgcode);
+	return objs;
+}
+
 static void _harbol_cfgkey_del(struct HarbolVariant *const var)
 {
 	switch( var->TypeTag ) {
@@ -545,9 +546,11 @@ HARBOL_EXPORT bool harbol_cfg_to_str(const struct HarbolLinkMap *const restrict
 		return false;
 	else {
 		# define BUFFER_SIZE    512
-		const union HarbolValue *const end = harbol_linkmap_get_iter_end_count(map);
-		for( union HarbolValue *iter = harbol_linkmap_get_iter(map); iter && iter<end; iter++ ) {
-			const struct HarbolKeyValPair *kv = iter->KvPairPtr;
+		// the map is const here, so walk 'Order' itself instead of the compacting iterators.
+		for( size_t i=map->Front; i<map->Order.Count; i++ ) {
+			const struct HarbolKeyValPair *kv = map->Order.Table[i].KvPairPtr;
+			if( !kv )
+				continue;
 			const int32_t type = kv->Data.VarPtr->TypeTag;
 			// print out key and notation.
 			harbol_string_add_char(str, '"');
@@ -1007,9 +1010,10 @@ static bool _harbol_cfg_build_file(const struct HarbolLinkMap *const map, FILE *
 	if( !map || !file )
 		return false;
 	
-	const union HarbolValue *const end = harbol_linkmap_get_iter_end_count(map);
-	for( union HarbolValue *iter = harbol_linkmap_get_iter(map); iter && iter<end; iter++ ) {
-		const struct HarbolKeyValPair *kv = iter->KvPairPtr;
+	for( size_t i=map->Front; i<map->Order.Count; i++ ) {
+		const struct HarbolKeyValPair *kv = map->Order.Table[i].KvPairPtr;
+		if( !kv )
+			continue;
 		const int32_t type = kv->Data.VarPtr->TypeTag;
 		_write_tabs(file, tabs);
 		// print out key and notation.
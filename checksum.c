@@ -0,0 +1,357 @@
+#include <stdatomic.h>
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#	include <nmmintrin.h>
+#	define HARBOL_CRC32C_HW
+#endif
+
+/*
+typedef struct HarbolXXH64 {
+	uint64_t Acc[4], Seed, Total;
+	uint8_t Mem[32];
+	size_t MemLen;
+} HarbolXXH64;
+ */
+
+#define HARBOL_CRC32C_POLY     0x82F63B78u /* Castagnoli, bit-reversed. */
+#define HARBOL_CRC32C_LONG     8192
+#define HARBOL_CRC32C_SHORT    256
+
+
+static inline uint64_t _harbol_load64_le(const uint8_t *const p)
+{
+	return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24
+		| (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static inline uint32_t _harbol_load32_le(const uint8_t *const p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+
+/* CRC32C code */
+/////////////////////////////////////////
+typedef uint32_t fnHarbolCRC32C(uint32_t crc, const uint8_t *data, size_t len);
+
+static uint32_t _g_crc32c_table[8][256];
+#ifdef HARBOL_CRC32C_HW
+/* shifting a crc past LONG or SHORT zero bytes, a byte of the crc at a time; glues the 3 interleaved streams together. */
+static uint32_t _g_crc32c_long[4][256], _g_crc32c_short[4][256];
+#endif
+static fnHarbolCRC32C *_g_crc32c_impl;
+static atomic_int _g_crc32c_state; /* 0 = not set up, 1 = being set up, 2 = ready. */
+
+static uint32_t _harbol_crc32c_sw(uint32_t crc, const uint8_t *p, size_t len)
+{
+	while( len && ((uintptr_t)p & 7) ) {
+		crc = _g_crc32c_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+		len--;
+	}
+	// slicing-by-8: one lookup per byte, but all 8 of them are independent.
+	for(; len >= 8; p += 8, len -= 8 ) {
+		const uint64_t w = _harbol_load64_le(p) ^ crc;
+		crc = _g_crc32c_table[7][w & 0xff] ^ _g_crc32c_table[6][(w >> 8) & 0xff]
+			^ _g_crc32c_table[5][(w >> 16) & 0xff] ^ _g_crc32c_table[4][(w >> 24) & 0xff]
+			^ _g_crc32c_table[3][(w >> 32) & 0xff] ^ _g_crc32c_table[2][(w >> 40) & 0xff]
+			^ _g_crc32c_table[1][(w >> 48) & 0xff] ^ _g_crc32c_table[0][w >> 56];
+	}
+	while( len-- )
+		crc = _g_crc32c_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+	return crc;
+}
+
+#ifdef HARBOL_CRC32C_HW
+static uint32_t _harbol_gf2_times(const uint32_t *mat, uint32_t vec)
+{
+	uint32_t sum = 0;
+	for(; vec; vec >>= 1, mat++ )
+		if( vec & 1 )
+			sum ^= *mat;
+	return sum;
+}
+
+static void _harbol_gf2_square(uint32_t square[restrict 32], const uint32_t mat[restrict 32])
+{
+	for( size_t n=0; n<32; n++ )
+		square[n] = _harbol_gf2_times(mat, mat[n]);
+}
+
+/* builds the table that advances a crc past 'len' zero bytes; 'len' has to be a power of 2. */
+static void _harbol_crc32c_zeros(uint32_t table[4][256], size_t len)
+{
+	uint32_t even[32], odd[32];
+	// the operator for one zero bit, squared up to one byte and then up to 'len' bytes.
+	odd[0] = HARBOL_CRC32C_POLY;
+	for( size_t n=1; n<32; n++ )
+		odd[n] = (uint32_t)1 << (n - 1);
+	_harbol_gf2_square(even, odd);
+	_harbol_gf2_square(odd, even);
+	const uint32_t *op = even;
+	for( ;; ) {
+		_harbol_gf2_square(even, odd);
+		op = even;
+		len >>= 1;
+		if( !len )
+			break;
+		_harbol_gf2_square(odd, even);
+		op = odd;
+		len >>= 1;
+		if( !len )
+			break;
+	}
+	for( uint32_t n=0; n<256; n++ )
+		for( size_t k=0; k<4; k++ )
+			table[k][n] = _harbol_gf2_times(op, n << (8 * k));
+}
+
+static inline uint32_t _harbol_crc32c_shift(uint32_t table[4][256], const uint32_t crc)
+{
+	return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^ table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+}
+
+/* the crc32 instruction has 3 cycles of latency but issues every cycle, so 3 independent streams keep it busy. */
+__attribute__((target("sse4.2")))
+static uint32_t _harbol_crc32c_hw(const uint32_t crc, const uint8_t *p, size_t len)
+{
+#	ifdef __x86_64__
+#		define HARBOL_CRC32C_WORD    8
+	uint64_t crc0 = crc;
+#		define HARBOL_CRC32C_STEP(c, q)    (c) = _mm_crc32_u64((c), _harbol_load64_le(q))
+#	else
+#		define HARBOL_CRC32C_WORD    4
+	uint32_t crc0 = crc;
+#		define HARBOL_CRC32C_STEP(c, q)    (c) = _mm_crc32_u32((c), _harbol_load32_le(q))
+#	endif
+	while( len && ((uintptr_t)p & (HARBOL_CRC32C_WORD - 1)) ) {
+		crc0 = _mm_crc32_u8((uint32_t)crc0, *p++);
+		len--;
+	}
+	static const size_t blocks[2] = { HARBOL_CRC32C_LONG, HARBOL_CRC32C_SHORT };
+	for( size_t b=0; b<2; b++ ) {
+		const size_t block = blocks[b];
+		uint32_t (*const shift)[256] = ( b==0 ) ? _g_crc32c_long : _g_crc32c_short;
+		while( len >= block * 3 ) {
+			__typeof__(crc0) crc1 = 0, crc2 = 0;
+			for( const uint8_t *const end = p + block; p < end; p += HARBOL_CRC32C_WORD ) {
+				HARBOL_CRC32C_STEP(crc0, p);
+				HARBOL_CRC32C_STEP(crc1, p + block);
+				HARBOL_CRC32C_STEP(crc2, p + block * 2);
+			}
+			crc0 = _harbol_crc32c_shift(shift, (uint32_t)crc0) ^ (uint32_t)crc1;
+			crc0 = _harbol_crc32c_shift(shift, (uint32_t)crc0) ^ (uint32_t)crc2;
+			p += block * 2;
+			len -= block * 3;
+		}
+	}
+	for(; len >= HARBOL_CRC32C_WORD; p += HARBOL_CRC32C_WORD, len -= HARBOL_CRC32C_WORD )
+		HARBOL_CRC32C_STEP(crc0, p);
+	while( len-- )
+		crc0 = _mm_crc32_u8((uint32_t)crc0, *p++);
+	return (uint32_t)crc0;
+#	undef HARBOL_CRC32C_STEP
+#	undef HARBOL_CRC32C_WORD
+}
+#endif
+
+static void _harbol_crc32c_setup(void)
+{
+	int expected = 0;
+	if( atomic_load_explicit(&_g_crc32c_state, memory_order_acquire)==2 )
+		return;
+	else if( !atomic_compare_exchange_strong_explicit(&_g_crc32c_state, &expected, 1, memory_order_acquire, memory_order_acquire) ) {
+		while( atomic_load_explicit(&_g_crc32c_state, memory_order_acquire) != 2 );
+		return;
+	}
+	
+	for( uint32_t n=0; n<256; n++ ) {
+		uint32_t c = n;
+		for( size_t k=0; k<8; k++ )
+			c = ( c & 1 ) ? (c >> 1) ^ HARBOL_CRC32C_POLY : c >> 1;
+		_g_crc32c_table[0][n] = c;
+	}
+	for( size_t k=1; k<8; k++ )
+		for( size_t n=0; n<256; n++ )
+			_g_crc32c_table[k][n] = _g_crc32c_table[0][_g_crc32c_table[k-1][n] & 0xff] ^ (_g_crc32c_table[k-1][n] >> 8);
+	
+	_g_crc32c_impl = _harbol_crc32c_sw;
+#ifdef HARBOL_CRC32C_HW
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports("sse4.2") ) {
+		_harbol_crc32c_zeros(_g_crc32c_long, HARBOL_CRC32C_LONG);
+		_harbol_crc32c_zeros(_g_crc32c_short, HARBOL_CRC32C_SHORT);
+		_g_crc32c_impl = _harbol_crc32c_hw;
+	}
+#endif
+	atomic_store_explicit(&_g_crc32c_state, 2, memory_order_release);
+}
+
+/* zlib-style running crc: start from 0 and feed each result back in with the next chunk. */
+HARBOL_EXPORT uint32_t harbol_crc32c(const uint32_t crc, const void *const data, const size_t len)
+{
+	_harbol_crc32c_setup();
+	return ( !data || !len ) ? crc : ~(*_g_crc32c_impl)(~crc, data, len);
+}
+
+/* always the slicing-by-8 table code, whatever the CPU supports. */
+HARBOL_EXPORT uint32_t harbol_crc32c_sw(const uint32_t crc, const void *const data, const size_t len)
+{
+	_harbol_crc32c_setup();
+	return ( !data || !len ) ? crc : ~_harbol_crc32c_sw(~crc, data, len);
+}
+
+HARBOL_EXPORT uint32_t harbol_crc32c_bytebuffer(const uint32_t crc, const struct HarbolByteBuffer *const buf)
+{
+	return buf ? harbol_crc32c(crc, buf->Buffer, buf->Count) : crc;
+}
+
+HARBOL_EXPORT uint32_t harbol_crc32c_string(const uint32_t crc, const struct HarbolString *const str)
+{
+	return str ? harbol_crc32c(crc, str->CStr, str->Len) : crc;
+}
+
+HARBOL_EXPORT bool harbol_crc32c_is_hw(void)
+{
+	_harbol_crc32c_setup();
+	return _g_crc32c_impl != _harbol_crc32c_sw;
+}
+/////////////////////////////////////////
+
+
+/* XXH64 code */
+/////////////////////////////////////////
+#define HARBOL_XXH_P1    0x9E3779B185EBCA87ull
+#define HARBOL_XXH_P2    0xC2B2AE3D27D4EB4Full
+#define HARBOL_XXH_P3    0x165667B19E3779F9ull
+#define HARBOL_XXH_P4    0x85EBCA77C2B2AE63ull
+#define HARBOL_XXH_P5    0x27D4EB2F165667C5ull
+
+static inline uint64_t _harbol_rotl64(const uint64_t x, const int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t _harbol_xxh64_round(uint64_t acc, const uint64_t input)
+{
+	acc += input * HARBOL_XXH_P2;
+	return _harbol_rotl64(acc, 31) * HARBOL_XXH_P1;
+}
+
+static inline uint64_t _harbol_xxh64_merge(uint64_t acc, const uint64_t val)
+{
+	acc ^= _harbol_xxh64_round(0, val);
+	return acc * HARBOL_XXH_P1 + HARBOL_XXH_P4;
+}
+
+HARBOL_EXPORT void harbol_xxh64_init(struct HarbolXXH64 *const state, const uint64_t seed)
+{
+	if( !state )
+		return;
+	
+	memset(state, 0, sizeof *state);
+	state->Seed = seed;
+	state->Acc[0] = seed + HARBOL_XXH_P1 + HARBOL_XXH_P2;
+	state->Acc[1] = seed + HARBOL_XXH_P2;
+	state->Acc[2] = seed;
+	state->Acc[3] = seed - HARBOL_XXH_P1;
+}
+
+HARBOL_EXPORT bool harbol_xxh64_update(struct HarbolXXH64 *const restrict state, const void *const restrict data, size_t len)
+{
+	if( !state || (!data && len) )
+		return false;
+	
+	const uint8_t *p = data;
+	state->Total += len;
+	// finish a stripe left over from the last update first.
+	if( state->MemLen ) {
+		const size_t take = ( len < 32 - state->MemLen ) ? len : 32 - state->MemLen;
+		memcpy(state->Mem + state->MemLen, p, take);
+		state->MemLen += take, p += take, len -= take;
+		if( state->MemLen < 32 )
+			return true;
+		
+		for( size_t i=0; i<4; i++ )
+			state->Acc[i] = _harbol_xxh64_round(state->Acc[i], _harbol_load64_le(state->Mem + i * 8));
+		state->MemLen = 0;
+	}
+	if( len >= 32 ) {
+		uint64_t a0 = state->Acc[0], a1 = state->Acc[1], a2 = state->Acc[2], a3 = state->Acc[3];
+		for(; len >= 32; p += 32, len -= 32 ) {
+			a0 = _harbol_xxh64_round(a0, _harbol_load64_le(p));
+			a1 = _harbol_xxh64_round(a1, _harbol_load64_le(p + 8));
+			a2 = _harbol_xxh64_round(a2, _harbol_load64_le(p + 16));
+			a3 = _harbol_xxh64_round(a3, _harbol_load64_le(p + 24));
+		}
+		state->Acc[0] = a0, state->Acc[1] = a1, state->Acc[2] = a2, state->Acc[3] = a3;
+	}
+	if( len ) {
+		memcpy(state->Mem, p, len);
+		state->MemLen = len;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_xxh64_update_bytebuffer(struct HarbolXXH64 *const restrict state, const struct HarbolByteBuffer *const restrict buf)
+{
+	return buf && harbol_xxh64_update(state, buf->Buffer, buf->Count);
+}
+
+HARBOL_EXPORT bool harbol_xxh64_update_string(struct HarbolXXH64 *const restrict state, const struct HarbolString *const restrict str)
+{
+	return str && harbol_xxh64_update(state, str->CStr, str->Len);
+}
+
+/* doesn't change 'state', so more data can still be added afterwards. */
+HARBOL_EXPORT uint64_t harbol_xxh64_digest(const struct HarbolXXH64 *const state)
+{
+	if( !state )
+		return 0;
+	
+	uint64_t h;
+	if( state->Total >= 32 ) {
+		const uint64_t *const a = state->Acc;
+		h = _harbol_rotl64(a[0], 1) + _harbol_rotl64(a[1], 7) + _harbol_rotl64(a[2], 12) + _harbol_rotl64(a[3], 18);
+		for( size_t i=0; i<4; i++ )
+			h = _harbol_xxh64_merge(h, a[i]);
+	}
+	else h = state->Seed + HARBOL_XXH_P5;
+	h += state->Total;
+	
+	const uint8_t *p = state->Mem;
+	size_t len = state->MemLen;
+	for(; len >= 8; p += 8, len -= 8 ) {
+		h ^= _harbol_xxh64_round(0, _harbol_load64_le(p));
+		h = _harbol_rotl64(h, 27) * HARBOL_XXH_P1 + HARBOL_XXH_P4;
+	}
+	if( len >= 4 ) {
+		h ^= (uint64_t)_harbol_load32_le(p) * HARBOL_XXH_P1;
+		h = _harbol_rotl64(h, 23) * HARBOL_XXH_P2 + HARBOL_XXH_P3;
+		p += 4, len -= 4;
+	}
+	while( len-- ) {
+		h ^= *p++ * HARBOL_XXH_P5;
+		h = _harbol_rotl64(h, 11) * HARBOL_XXH_P1;
+	}
+	h ^= h >> 33;
+	h *= HARBOL_XXH_P2;
+	h ^= h >> 29;
+	h *= HARBOL_XXH_P3;
+	h ^= h >> 32;
+	return h;
+}
+
+HARBOL_EXPORT uint64_t harbol_xxh64(const void *const data, const size_t len, const uint64_t seed)
+{
+	struct HarbolXXH64 state;
+	harbol_xxh64_init(&state, seed);
+	harbol_xxh64_update(&state, data, len);
+	return harbol_xxh64_digest(&state);
+}
+/////////////////////////////////////////
@@ -0,0 +1,324 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolColTable {
+	const struct HarbolTupleSchema *Schema;
+	uint8_t **Columns;
+	size_t Rows, Cap;
+} HarbolColTable;
+ */
+
+/* rows are compared a block at a time: first into a byte per row, which the compiler can vectorize,
+ * then the hits are packed into the selection list without branching.
+ */
+#define HARBOL_COLTABLE_BLOCK    256
+
+static size_t _harbol_coltable_type_size(const enum HarbolColType type)
+{
+	switch( type ) {
+		case HarbolColI8: case HarbolColU8: return 1;
+		case HarbolColI16: case HarbolColU16: return 2;
+		case HarbolColI32: case HarbolColU32: case HarbolColF32: return 4;
+		case HarbolColI64: case HarbolColU64: case HarbolColF64: return 8;
+	}
+	return 0;
+}
+
+static bool _harbol_coltable_check_column(const struct HarbolColTable *const table, const size_t col, const enum HarbolColType type)
+{
+	return table && table->Columns && col < table->Schema->Count && table->Schema->Fields[col].Size==_harbol_coltable_type_size(type);
+}
+
+static bool _harbol_coltable_same_layout(const struct HarbolTupleSchema *const a, const struct HarbolTupleSchema *const b)
+{
+	if( a==b )
+		return true;
+	else if( a->Count != b->Count || a->Len != b->Len )
+		return false;
+	return !memcmp(a->Fields, b->Fields, a->Count * sizeof *a->Fields);
+}
+
+/* a constant trip count for whole blocks lets -O2's cheap vectorizer take these loops. */
+#define HARBOL_COLTABLE_COMPARE(n) \
+		switch( op ) { \
+			case HarbolColLT: for( size_t i=0; i<(n); i++ ) hits[i] = v[i] < value; break; \
+			case HarbolColLE: for( size_t i=0; i<(n); i++ ) hits[i] = v[i] <= value; break; \
+			case HarbolColEQ: for( size_t i=0; i<(n); i++ ) hits[i] = v[i]==value; break; \
+			case HarbolColNE: for( size_t i=0; i<(n); i++ ) hits[i] = v[i] != value; break; \
+			case HarbolColGE: for( size_t i=0; i<(n); i++ ) hits[i] = v[i] >= value; break; \
+			case HarbolColGT: for( size_t i=0; i<(n); i++ ) hits[i] = v[i] > value; break; \
+		}
+
+/* a filter either scans the first 'count' rows or, refining, the 'count' rows listed in 'rows'.
+ * a sum visits the rows listed in 'rows', or the first 'count' if it's NULL.
+ */
+#define HARBOL_COLTABLE_KERNELS(name, type, accum) \
+static size_t _harbol_coltable_filter_##name(const type *const restrict data, const enum HarbolColOp op, const type value, uint32_t *const restrict rows, const size_t count, const bool refine) \
+{ \
+	uint8_t hits[HARBOL_COLTABLE_BLOCK]; \
+	type vals[HARBOL_COLTABLE_BLOCK]; \
+	size_t found = 0; \
+	for( size_t base=0; base<count; base += HARBOL_COLTABLE_BLOCK ) { \
+		const size_t n = ( count - base < HARBOL_COLTABLE_BLOCK ) ? count - base : HARBOL_COLTABLE_BLOCK; \
+		const type *v = data + base; \
+		if( refine ) { \
+			for( size_t i=0; i<n; i++ ) \
+				vals[i] = data[rows[base + i]]; \
+			v = vals; \
+		} \
+		if( n==HARBOL_COLTABLE_BLOCK ) \
+			HARBOL_COLTABLE_COMPARE(HARBOL_COLTABLE_BLOCK) \
+		else HARBOL_COLTABLE_COMPARE(n) \
+		if( refine ) { \
+			for( size_t i=0; i<n; i++ ) { \
+				rows[found] = rows[base + i]; \
+				found += hits[i]; \
+			} \
+		} else { \
+			for( size_t i=0; i<n; i++ ) { \
+				rows[found] = (uint32_t)(base + i); \
+				found += hits[i]; \
+			} \
+		} \
+	} \
+	return found; \
+} \
+\
+static accum _harbol_coltable_sum_##name(const type *const restrict data, const uint32_t *const restrict rows, const size_t count) \
+{ \
+	accum total = 0; \
+	if( rows ) { \
+		for( size_t i=0; i<count; i++ ) \
+			total += data[rows[i]]; \
+	} else { \
+		for( size_t i=0; i<count; i++ ) \
+			total += data[i]; \
+	} \
+	return total; \
+}
+
+HARBOL_COLTABLE_KERNELS(i8, int8_t, int64_t)
+HARBOL_COLTABLE_KERNELS(i16, int16_t, int64_t)
+HARBOL_COLTABLE_KERNELS(i32, int32_t, int64_t)
+HARBOL_COLTABLE_KERNELS(i64, int64_t, int64_t)
+HARBOL_COLTABLE_KERNELS(u8, uint8_t, uint64_t)
+HARBOL_COLTABLE_KERNELS(u16, uint16_t, uint64_t)
+HARBOL_COLTABLE_KERNELS(u32, uint32_t, uint64_t)
+HARBOL_COLTABLE_KERNELS(u64, uint64_t, uint64_t)
+HARBOL_COLTABLE_KERNELS(f32, float, double)
+HARBOL_COLTABLE_KERNELS(f64, double, double)
+
+
+HARBOL_EXPORT struct HarbolColTable *harbol_coltable_new(const struct HarbolTupleSchema *const schema)
+{
+	struct HarbolColTable *table = calloc(1, sizeof *table);
+	if( table && !harbol_coltable_init(table, schema) )
+		free(table), table = NULL;
+	return table;
+}
+
+/* one column per schema field; the schema has to outlive the table. */
+HARBOL_EXPORT bool harbol_coltable_init(struct HarbolColTable *const restrict table, const struct HarbolTupleSchema *const restrict schema)
+{
+	if( !table || !schema || !schema->Count )
+		return false;
+	
+	memset(table, 0, sizeof *table);
+	table->Columns = calloc(schema->Count, sizeof *table->Columns);
+	if( !table->Columns )
+		return false;
+	table->Schema = schema;
+	return true;
+}
+
+HARBOL_EXPORT void harbol_coltable_del(struct HarbolColTable *const table)
+{
+	if( !table || !table->Columns )
+		return;
+	
+	for( size_t i=0; i<table->Schema->Count; i++ )
+		free(table->Columns[i]);
+	free(table->Columns);
+	memset(table, 0, sizeof *table);
+}
+
+HARBOL_EXPORT void harbol_coltable_free(struct HarbolColTable **const tableref)
+{
+	if( !tableref || !*tableref )
+		return;
+	
+	harbol_coltable_del(*tableref);
+	free(*tableref), *tableref=NULL;
+}
+
+HARBOL_EXPORT size_t harbol_coltable_get_rows(const struct HarbolColTable *const table)
+{
+	return table ? table->Rows : 0;
+}
+
+/* room for at least 'rows' rows in every column; row counts stay within 32 bits so rows fit selection lists. */
+HARBOL_EXPORT bool harbol_coltable_reserve(struct HarbolColTable *const table, const size_t rows)
+{
+	if( !table || !table->Columns || rows > UINT32_MAX )
+		return false;
+	else if( rows <= table->Cap )
+		return true;
+	
+	for( size_t i=0; i<table->Schema->Count; i++ ) {
+		uint8_t *const col = realloc(table->Columns[i], rows * table->Schema->Fields[i].Size);
+		if( !col )
+			return false;
+		table->Columns[i] = col;
+	}
+	table->Cap = rows;
+	return true;
+}
+
+/* 'datum' is one row laid out by the table's schema: a tuple's data or the matching struct. */
+HARBOL_EXPORT bool harbol_coltable_append_row(struct HarbolColTable *const restrict table, const void *const restrict datum)
+{
+	if( !table || !datum || !table->Columns )
+		return false;
+	else if( table->Rows==table->Cap && !harbol_coltable_reserve(table, table->Cap ? table->Cap << 1 : 16) )
+		return false;
+	
+	const uint8_t *const src = datum;
+	const struct HarbolTupleField *const fields = table->Schema->Fields;
+	for( size_t i=0; i<table->Schema->Count; i++ )
+		memcpy(table->Columns[i] + table->Rows * fields[i].Size, src + fields[i].Offset, fields[i].Size);
+	table->Rows++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_coltable_append_inst(struct HarbolColTable *const restrict table, const struct HarbolTupleInst *const restrict inst)
+{
+	if( !table || !inst || !table->Columns || !_harbol_coltable_same_layout(table->Schema, inst->Schema) )
+		return false;
+	return harbol_coltable_append_row(table, inst->Datum);
+}
+
+HARBOL_EXPORT bool harbol_coltable_append_tuple(struct HarbolColTable *const restrict table, const struct HarbolTuple *const restrict tup)
+{
+	if( !table || !tup || !tup->Datum || !table->Columns || tup->Len != table->Schema->Len || tup->Fields.Count != table->Schema->Count )
+		return false;
+	
+	for( size_t i=0; i<table->Schema->Count; i++ )
+		if( (size_t)((uint8_t *)harbol_tuple_get_field(tup, i) - tup->Datum) != table->Schema->Fields[i].Offset || harbol_tuple_get_field_size(tup, i) != table->Schema->Fields[i].Size )
+			return false;
+	return harbol_coltable_append_row(table, tup->Datum);
+}
+
+/* the column's values as a plain array of 'harbol_coltable_get_rows' elements; valid until the next append. */
+HARBOL_EXPORT void *harbol_coltable_get_column(const struct HarbolColTable *const table, const size_t col)
+{
+	return ( !table || !table->Columns || col >= table->Schema->Count ) ? NULL : table->Columns[col];
+}
+
+HARBOL_EXPORT void *harbol_coltable_get_cell(const struct HarbolColTable *const table, const size_t row, const size_t col)
+{
+	if( !table || !table->Columns || row >= table->Rows || col >= table->Schema->Count )
+		return NULL;
+	return table->Columns[col] + row * table->Schema->Fields[col].Size;
+}
+
+/* gathers a row back into the schema's layout, e.g. a struct or a tuple's data. */
+HARBOL_EXPORT bool harbol_coltable_get_row(const struct HarbolColTable *const restrict table, const size_t row, void *const restrict datum)
+{
+	if( !table || !datum || !table->Columns || row >= table->Rows )
+		return false;
+	
+	uint8_t *const dst = datum;
+	const struct HarbolTupleField *const fields = table->Schema->Fields;
+	for( size_t i=0; i<table->Schema->Count; i++ )
+		memcpy(dst + fields[i].Offset, table->Columns[i] + row * fields[i].Size, fields[i].Size);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_coltable_row_to_inst(const struct HarbolColTable *const restrict table, const size_t row, struct HarbolTupleInst *const restrict inst)
+{
+	if( !table || !inst || !_harbol_coltable_same_layout(table->Schema, inst->Schema) )
+		return false;
+	return harbol_coltable_get_row(table, row, inst->Datum);
+}
+
+HARBOL_EXPORT bool harbol_coltable_row_to_tuple(const struct HarbolColTable *const restrict table, const size_t row, struct HarbolTuple *const restrict tup)
+{
+	if( !table || !tup || !tup->Datum || !table->Columns || row >= table->Rows || tup->Fields.Count != table->Schema->Count )
+		return false;
+	
+	for( size_t i=0; i<table->Schema->Count; i++ )
+		if( harbol_tuple_get_field_size(tup, i) != table->Schema->Fields[i].Size )
+			return false;
+	for( size_t i=0; i<table->Schema->Count; i++ )
+		harbol_tuple_set_field(tup, i, table->Columns[i] + row * table->Schema->Fields[i].Size);
+	return true;
+}
+
+#define HARBOL_COLTABLE_DISPATCH(call) \
+	switch( type ) { \
+		case HarbolColI8:  call(i8, int8_t, int64_t); \
+		case HarbolColI16: call(i16, int16_t, int64_t); \
+		case HarbolColI32: call(i32, int32_t, int64_t); \
+		case HarbolColI64: call(i64, int64_t, int64_t); \
+		case HarbolColU8:  call(u8, uint8_t, uint64_t); \
+		case HarbolColU16: call(u16, uint16_t, uint64_t); \
+		case HarbolColU32: call(u32, uint32_t, uint64_t); \
+		case HarbolColU64: call(u64, uint64_t, uint64_t); \
+		case HarbolColF32: call(f32, float, double); \
+		case HarbolColF64: call(f64, double, double); \
+	}
+
+/* writes the rows whose 'col' value compares true against '*value' (of the column's type) into 'rows',
+ * which needs room for every row, in ascending order. returns how many.
+ */
+HARBOL_EXPORT size_t harbol_coltable_filter(const struct HarbolColTable *const restrict table, const size_t col, const enum HarbolColType type, const enum HarbolColOp op, const void *const restrict value, uint32_t rows[restrict])
+{
+	if( !rows || !value || !_harbol_coltable_check_column(table, col, type) )
+		return 0;
+	
+#define HARBOL_COLTABLE_FILTER_CALL(name, ctype, accum) { \
+		ctype v; memcpy(&v, value, sizeof v); \
+		return _harbol_coltable_filter_##name((const ctype *)table->Columns[col], op, v, rows, table->Rows, false); \
+	}
+	HARBOL_COLTABLE_DISPATCH(HARBOL_COLTABLE_FILTER_CALL)
+#undef HARBOL_COLTABLE_FILTER_CALL
+	return 0;
+}
+
+/* narrows a selection from an earlier filter to the rows that also pass this one, in place. returns how many are left. */
+HARBOL_EXPORT size_t harbol_coltable_filter_refine(const struct HarbolColTable *const restrict table, const size_t col, const enum HarbolColType type, const enum HarbolColOp op, const void *const restrict value, uint32_t rows[restrict], const size_t count)
+{
+	if( !rows || !value || !_harbol_coltable_check_column(table, col, type) )
+		return 0;
+	
+#define HARBOL_COLTABLE_REFINE_CALL(name, ctype, accum) { \
+		ctype v; memcpy(&v, value, sizeof v); \
+		return _harbol_coltable_filter_##name((const ctype *)table->Columns[col], op, v, rows, count, true); \
+	}
+	HARBOL_COLTABLE_DISPATCH(HARBOL_COLTABLE_REFINE_CALL)
+#undef HARBOL_COLTABLE_REFINE_CALL
+	return 0;
+}
+
+/* sums 'col' over the selected rows (or all rows if 'rows' is NULL) into '*result':
+ * an int64_t for signed columns, a uint64_t for unsigned ones and a double for floating point.
+ */
+HARBOL_EXPORT bool harbol_coltable_sum(const struct HarbolColTable *const restrict table, const size_t col, const enum HarbolColType type, const uint32_t rows[restrict], const size_t count, void *const restrict result)
+{
+	if( !result || !_harbol_coltable_check_column(table, col, type) )
+		return false;
+	
+	const size_t n = rows ? count : table->Rows;
+#define HARBOL_COLTABLE_SUM_CALL(name, ctype, accum) { \
+		const accum total = _harbol_coltable_sum_##name((const ctype *)table->Columns[col], rows, n); \
+		memcpy(result, &total, sizeof total); \
+		return true; \
+	}
+	HARBOL_COLTABLE_DISPATCH(HARBOL_COLTABLE_SUM_CALL)
+#undef HARBOL_COLTABLE_SUM_CALL
+	return false;
+}
@@ -0,0 +1,402 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#	include <tmmintrin.h>
+#	define HARBOL_ENCODING_SSSE3
+#endif
+
+/* every encoder works out the exact output size first and writes straight into the destination's memory.
+ * on x86 with SSSE3, 16 (hex) or 12 (base64) input bytes are handled per step, after Wojciech Muła's base64 work;
+ * the scalar loops finish the tails and cover everything elsewhere.
+ */
+
+static const char _g_hex_lower[16] = "0123456789abcdef", _g_hex_upper[16] = "0123456789ABCDEF";
+static const char _g_base64_std[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char _g_base64_url[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static inline bool _harbol_encoding_has_ssse3(void)
+{
+#ifdef HARBOL_ENCODING_SSSE3
+	return __builtin_cpu_supports("ssse3");
+#else
+	return false;
+#endif
+}
+
+/* room for 'len' more characters at the end of 'str', kept 0-terminated. */
+static char *_harbol_string_extend(struct HarbolString *const str, const size_t len)
+{
+	if( len >= SIZE_MAX - str->Len )
+		return NULL;
+	
+	char *const newstr = realloc(str->CStr, str->Len + len + 1);
+	if( !newstr )
+		return NULL;
+	
+	str->CStr = newstr;
+	return newstr + str->Len;
+}
+
+static void _harbol_string_commit(struct HarbolString *const str, const size_t len)
+{
+	str->Len += len;
+	str->CStr[str->Len] = 0;
+}
+
+static inline int _harbol_hex_value(const uint8_t c)
+{
+	if( c >= '0' && c <= '9' )
+		return c - '0';
+	const uint8_t l = c | 0x20;
+	return ( l >= 'a' && l <= 'f' ) ? l - 'a' + 10 : -1;
+}
+
+
+/* Hex code */
+/////////////////////////////////////////
+#ifdef HARBOL_ENCODING_SSSE3
+__attribute__((target("ssse3")))
+static size_t _harbol_hex_encode_ssse3(char *restrict out, const uint8_t *restrict in, const size_t len, const char digits[const restrict 16])
+{
+	const __m128i lut = _mm_loadu_si128((const __m128i *)digits), mask = _mm_set1_epi8(0x0f);
+	size_t n = 0;
+	for(; len - n >= 16; n += 16, out += 32 ) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(in + n));
+		const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+		const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+		_mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *)(out + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return n;
+}
+
+/* decodes 32 characters per step; stops at the first step holding a bad character and leaves it to the scalar loop. */
+__attribute__((target("ssse3")))
+static size_t _harbol_hex_decode_ssse3(uint8_t *restrict out, const uint8_t *restrict in, const size_t len)
+{
+	const __m128i digit_base = _mm_set1_epi8('0'), alpha_base = _mm_set1_epi8('a'), case_bit = _mm_set1_epi8(0x20);
+	const __m128i nine = _mm_set1_epi8(9), five = _mm_set1_epi8(5), ten = _mm_set1_epi8(10);
+	const __m128i pair_weights = _mm_set1_epi16(0x0110); /* high digit * 16 + low digit. */
+	size_t n = 0;
+	for(; len - n >= 32; n += 32, out += 16 ) {
+		__m128i vals[2];
+		bool bad = false;
+		for( size_t h=0; h<2; h++ ) {
+			const __m128i c = _mm_loadu_si128((const __m128i *)(in + n + h * 16));
+			const __m128i d = _mm_sub_epi8(c, digit_base);
+			const __m128i a = _mm_sub_epi8(_mm_or_si128(c, case_bit), alpha_base);
+			// unsigned x <= y as min(x, y)==x.
+			const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+			const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(a, five), a);
+			bad |= _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xffff;
+			vals[h] = _mm_or_si128(_mm_and_si128(is_digit, d), _mm_and_si128(is_alpha, _mm_add_epi8(a, ten)));
+		}
+		if( bad )
+			break;
+		const __m128i lo = _mm_maddubs_epi16(vals[0], pair_weights), hi = _mm_maddubs_epi16(vals[1], pair_weights);
+		_mm_storeu_si128((__m128i *)out, _mm_packus_epi16(lo, hi));
+	}
+	return n;
+}
+#endif
+
+HARBOL_EXPORT size_t harbol_hex_encoded_len(const size_t len)
+{
+	return ( len > SIZE_MAX / 2 ) ? 0 : len * 2;
+}
+
+static void _harbol_hex_encode(char *restrict out, const uint8_t *restrict in, const size_t len, const bool upper)
+{
+	const char *const digits = upper ? _g_hex_upper : _g_hex_lower;
+	size_t n = 0;
+	if( len >= 16 && _harbol_encoding_has_ssse3() ) {
+#ifdef HARBOL_ENCODING_SSSE3
+		n = _harbol_hex_encode_ssse3(out, in, len, digits);
+		out += n * 2;
+#endif
+	}
+	for(; n<len; n++ ) {
+		*out++ = digits[in[n] >> 4];
+		*out++ = digits[in[n] & 15];
+	}
+}
+
+HARBOL_EXPORT bool harbol_hex_encode_to_string(struct HarbolString *const restrict str, const void *const restrict data, const size_t len, const bool upper)
+{
+	if( !str || (!data && len) || (len && !harbol_hex_encoded_len(len)) )
+		return false;
+	
+	char *const out = _harbol_string_extend(str, len * 2);
+	if( !out )
+		return false;
+	
+	_harbol_hex_encode(out, data, len, upper);
+	_harbol_string_commit(str, len * 2);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hex_encode_to_bytebuffer(struct HarbolByteBuffer *const restrict buf, const void *const restrict data, const size_t len, const bool upper)
+{
+	if( !buf || (!data && len) || (len && !harbol_hex_encoded_len(len)) )
+		return false;
+	else if( !len )
+		return true;
+	
+	uint8_t *const out = harbol_bytebuffer_prepare(buf, len * 2);
+	if( !out )
+		return false;
+	
+	_harbol_hex_encode((char *)out, data, len, upper);
+	return harbol_bytebuffer_commit(buf, len * 2);
+}
+
+/* appends the decoded bytes to 'buf' only if all of 'text' is valid; otherwise 'bad_offset' (if given) gets
+ * the offset of the first bad character, or 'len' when the text has an odd number of digits.
+ */
+HARBOL_EXPORT bool harbol_hex_decode(struct HarbolByteBuffer *const restrict buf, const char text[restrict], const size_t len, size_t *const restrict bad_offset)
+{
+	if( !buf || (!text && len) )
+		return false;
+	else if( !len )
+		return true;
+	
+	const uint8_t *const in = (const uint8_t *)text;
+	size_t n = 0;
+	uint8_t *const out = harbol_bytebuffer_prepare(buf, len / 2);
+	if( !out )
+		return false;
+	if( len >= 32 && _harbol_encoding_has_ssse3() ) {
+#ifdef HARBOL_ENCODING_SSSE3
+		n = _harbol_hex_decode_ssse3(out, in, len & ~(size_t)1);
+#endif
+	}
+	for(; n<len; n += 2 ) {
+		const int hi = _harbol_hex_value(in[n]);
+		const int lo = ( n + 1 < len ) ? _harbol_hex_value(in[n + 1]) : -1;
+		if( hi < 0 || lo < 0 ) {
+			if( bad_offset )
+				*bad_offset = ( hi < 0 ) ? n : n + 1;
+			return false;
+		}
+		out[n / 2] = (uint8_t)(hi << 4 | lo);
+	}
+	return harbol_bytebuffer_commit(buf, len / 2);
+}
+/////////////////////////////////////////
+
+
+/* Base64 code */
+/////////////////////////////////////////
+#ifdef HARBOL_ENCODING_SSSE3
+/* 12 input bytes -> 16 output characters per step; reads 16 bytes, so the last 4 input bytes are left to the scalar loop. */
+__attribute__((target("ssse3")))
+static size_t _harbol_base64_encode_ssse3(char *restrict out, const uint8_t *restrict in, const size_t len, const enum HarbolBase64Alphabet alphabet)
+{
+	const char c62 = ( alphabet==HarbolBase64URL ) ? '-' : '+', c63 = ( alphabet==HarbolBase64URL ) ? '_' : '/';
+	const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, (char)(c62 - 62), (char)(c63 - 63), 'A', 0, 0);
+	size_t n = 0;
+	for(; len - n >= 16; n += 12, out += 16 ) {
+		// spread each 3 byte group over 4 bytes, then pull the four 6-bit fields into place with multiplies.
+		__m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + n)), _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m128i t1 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+		const __m128i t3 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+		const __m128i idx = _mm_or_si128(t1, t3);
+		// sort each 6-bit value into its alphabet range, then add that range's offset.
+		__m128i range = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+		v = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, range), idx);
+		_mm_storeu_si128((__m128i *)out, v);
+	}
+	return n;
+}
+
+/* 16 characters -> 12 bytes per step; writes 16 bytes, so it stops while there's still room past the output.
+ * stops before any step holding a character outside the alphabet (including '=').
+ */
+__attribute__((target("ssse3")))
+static size_t _harbol_base64_decode_ssse3(uint8_t *restrict out, const uint8_t *restrict in, const size_t len, const enum HarbolBase64Alphabet alphabet)
+{
+	const bool url = alphabet==HarbolBase64URL;
+	// per high nibble: the valid range of characters and what to add to get their 6-bit value.
+	// the one character that doesn't fit a range ('/' or '_') is matched on its own.
+	const __m128i lower_lut = url
+		? _mm_setr_epi8(1, 1, 0x2d, 0x30, 0x41, 0x50, 0x61, 0x70, 1, 1, 1, 1, 1, 1, 1, 1)
+		: _mm_setr_epi8(1, 1, 0x2b, 0x30, 0x41, 0x50, 0x61, 0x70, 1, 1, 1, 1, 1, 1, 1, 1);
+	const __m128i upper_lut = url
+		? _mm_setr_epi8(0, 0, 0x2d, 0x39, 0x4f, 0x5a, 0x6f, 0x7a, 0, 0, 0, 0, 0, 0, 0, 0)
+		: _mm_setr_epi8(0, 0, 0x2b, 0x39, 0x4f, 0x5a, 0x6f, 0x7a, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i shift_lut = url
+		? _mm_setr_epi8(0, 0, 0x3e - 0x2d, 0x34 - 0x30, 0x00 - 0x41, 0x0f - 0x50, 0x1a - 0x61, 0x29 - 0x70, 0, 0, 0, 0, 0, 0, 0, 0)
+		: _mm_setr_epi8(0, 0, 0x3e - 0x2b, 0x34 - 0x30, 0x00 - 0x41, 0x0f - 0x50, 0x1a - 0x61, 0x29 - 0x70, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i odd_char = _mm_set1_epi8(url ? '_' : '/');
+	const __m128i odd_fix = _mm_set1_epi8(url ? (char)(63 - ('_' + 0x0f - 0x50)) : (char)(63 - ('/' + 0x3e - 0x2b)));
+	size_t n = 0;
+	for(; len - n >= 24; n += 16, out += 12 ) {
+		const __m128i c = _mm_loadu_si128((const __m128i *)(in + n));
+		const __m128i nibble = _mm_and_si128(_mm_srli_epi32(c, 4), _mm_set1_epi8(0x0f));
+		const __m128i below = _mm_cmplt_epi8(c, _mm_shuffle_epi8(lower_lut, nibble));
+		const __m128i above = _mm_cmpgt_epi8(c, _mm_shuffle_epi8(upper_lut, nibble));
+		const __m128i is_odd = _mm_cmpeq_epi8(c, odd_char);
+		if( _mm_movemask_epi8(_mm_andnot_si128(is_odd, _mm_or_si128(below, above))) )
+			break;
+		
+		__m128i v = _mm_add_epi8(c, _mm_shuffle_epi8(shift_lut, nibble));
+		v = _mm_add_epi8(v, _mm_and_si128(is_odd, odd_fix));
+		// pack 4 x 6 bits into 3 bytes per group, then squeeze out the gaps.
+		v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+		v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+		v = _mm_shuffle_epi8(v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		_mm_storeu_si128((__m128i *)out, v);
+	}
+	return n;
+}
+#endif
+
+HARBOL_EXPORT size_t harbol_base64_encoded_len(const size_t len, const bool pad)
+{
+	if( len / 3 > (SIZE_MAX - 4) / 4 )
+		return 0;
+	return pad ? (len + 2) / 3 * 4 : len / 3 * 4 + ( len % 3 ? len % 3 + 1 : 0 );
+}
+
+static void _harbol_base64_encode(char *restrict out, const uint8_t *restrict in, const size_t len, const enum HarbolBase64Alphabet alphabet, const bool pad)
+{
+	const char *const table = ( alphabet==HarbolBase64URL ) ? _g_base64_url : _g_base64_std;
+	size_t n = 0;
+	if( len >= 16 && _harbol_encoding_has_ssse3() ) {
+#ifdef HARBOL_ENCODING_SSSE3
+		n = _harbol_base64_encode_ssse3(out, in, len, alphabet);
+		out += n / 3 * 4;
+#endif
+	}
+	for(; len - n >= 3; n += 3 ) {
+		const uint32_t w = (uint32_t)in[n] << 16 | (uint32_t)in[n + 1] << 8 | in[n + 2];
+		*out++ = table[w >> 18];
+		*out++ = table[(w >> 12) & 63];
+		*out++ = table[(w >> 6) & 63];
+		*out++ = table[w & 63];
+	}
+	if( len - n ) {
+		const uint32_t w = (uint32_t)in[n] << 16 | ( len - n==2 ? (uint32_t)in[n + 1] << 8 : 0 );
+		*out++ = table[w >> 18];
+		*out++ = table[(w >> 12) & 63];
+		if( len - n==2 )
+			*out++ = table[(w >> 6) & 63];
+		else if( pad )
+			*out++ = '=';
+		if( pad )
+			*out++ = '=';
+	}
+}
+
+HARBOL_EXPORT bool harbol_base64_encode_to_string(struct HarbolString *const restrict str, const void *const restrict data, const size_t len, const enum HarbolBase64Alphabet alphabet, const bool pad)
+{
+	const size_t outlen = harbol_base64_encoded_len(len, pad);
+	if( !str || (!data && len) || (len && !outlen) )
+		return false;
+	
+	char *const out = _harbol_string_extend(str, outlen);
+	if( !out )
+		return false;
+	
+	_harbol_base64_encode(out, data, len, alphabet, pad);
+	_harbol_string_commit(str, outlen);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_base64_encode_to_bytebuffer(struct HarbolByteBuffer *const restrict buf, const void *const restrict data, const size_t len, const enum HarbolBase64Alphabet alphabet, const bool pad)
+{
+	const size_t outlen = harbol_base64_encoded_len(len, pad);
+	if( !buf || (!data && len) || (len && !outlen) )
+		return false;
+	else if( !len )
+		return true;
+	
+	uint8_t *const out = harbol_bytebuffer_prepare(buf, outlen);
+	if( !out )
+		return false;
+	
+	_harbol_base64_encode((char *)out, data, len, alphabet, pad);
+	return harbol_bytebuffer_commit(buf, outlen);
+}
+
+/* padding is optional, but if present it has to make the length a multiple of 4.
+ * appends the decoded bytes to 'buf' only if all of 'text' is valid; otherwise 'bad_offset' (if given) gets
+ * the offset of the first bad character, or 'len' when the text stops partway through a byte.
+ * unused bits in the last character have to be zero, so every input decodes from exactly one encoding.
+ */
+HARBOL_EXPORT bool harbol_base64_decode(struct HarbolByteBuffer *const restrict buf, const char text[restrict], size_t len, const enum HarbolBase64Alphabet alphabet, size_t *const restrict bad_offset)
+{
+	if( !buf || (!text && len) )
+		return false;
+	else if( !len )
+		return true;
+	
+	const uint8_t *const in = (const uint8_t *)text;
+	const char *const table = ( alphabet==HarbolBase64URL ) ? _g_base64_url : _g_base64_std;
+	uint8_t values[256];
+	memset(values, 0xff, sizeof values);
+	for( uint8_t i=0; i<64; i++ )
+		values[(uint8_t)table[i]] = i;
+	
+	// a '=' anywhere but the padding is a bad character like any other.
+	size_t bad = SIZE_MAX;
+	if( len % 4==0 ) {
+		if( in[len - 1]=='=' )
+			len--;
+		if( in[len - 1]=='=' )
+			len--;
+	}
+	
+	const size_t outlen = len / 4 * 3 + ( len % 4 ? len % 4 - 1 : 0 );
+	uint8_t *const out = harbol_bytebuffer_prepare(buf, outlen);
+	if( !out )
+		return false;
+	
+	size_t n = 0;
+	uint8_t *op = out;
+	if( len >= 24 && _harbol_encoding_has_ssse3() ) {
+#ifdef HARBOL_ENCODING_SSSE3
+		n = _harbol_base64_decode_ssse3(out, in, len, alphabet);
+		op += n / 4 * 3;
+#endif
+	}
+	for(; bad==SIZE_MAX && n<len; n += 4 ) {
+		const size_t group = ( len - n < 4 ) ? len - n : 4;
+		uint32_t w = 0;
+		for( size_t k=0; k<group; k++ ) {
+			const uint8_t v = values[in[n + k]];
+			if( v==0xff ) {
+				bad = n + k;
+				break;
+			}
+			w |= (uint32_t)v << (18 - 6 * k);
+		}
+		if( bad != SIZE_MAX )
+			break;
+		else if( group==1 ) {
+			// one leftover character can't hold a whole byte, but only after every character proved valid is that the error.
+			bad = len;
+			break;
+		} else if( group < 4 && (w & (0xffffffu >> (8 * (group - 1)))) ) {
+			bad = n + group - 1;
+			break;
+		}
+		*op++ = (uint8_t)(w >> 16);
+		if( group > 2 )
+			*op++ = (uint8_t)(w >> 8);
+		if( group > 3 )
+			*op++ = (uint8_t)w;
+	}
+	if( bad != SIZE_MAX ) {
+		if( bad_offset )
+			*bad_offset = bad;
+		return false;
+	}
+	return harbol_bytebuffer_commit(buf, outlen);
+}
+/////////////////////////////////////////
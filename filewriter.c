@@ -0,0 +1,370 @@
+/* pwritev isn't part of strict C11/POSIX mode. */
+#ifndef _DEFAULT_SOURCE
+#	define _DEFAULT_SOURCE
+#endif
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+#ifndef OS_WINDOWS
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <limits.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+
+/*
+typedef struct HarbolFileWriterReq {
+	struct HarbolFileWriterReq *Next;
+	struct HarbolByteBuffer Buf;
+	uint64_t Offset;
+	bool Barrier;
+} HarbolFileWriterReq;
+
+typedef struct HarbolFileWriter {
+	pthread_mutex_t Lock;
+	pthread_cond_t Wake, Room, Done;
+	pthread_t Thread;
+	struct HarbolFileWriterReq *Head, *Tail;
+	fnHarbolFileWriterDone *OnDone;
+	void *Ctx;
+	uint64_t Offset, Submitted, Completed;
+	size_t Queued, MaxQueued;
+	int Fd, Flags, Err;
+	bool Stop, OwnsFd;
+} HarbolFileWriter;
+ */
+
+#	ifdef IOV_MAX
+#		define HARBOL_FILEWRITER_IOVS    ( IOV_MAX < 1024 ? IOV_MAX : 1024 )
+#	else
+#		define HARBOL_FILEWRITER_IOVS    1024
+#	endif
+
+/* writes 'iov' fully at 'offset', retrying short writes and interrupts. returns 0 or an errno value. */
+static int _harbol_filewriter_pwritev(const int fd, struct iovec *iov, int count, uint64_t offset)
+{
+	while( count ) {
+		const ssize_t res = pwritev(fd, iov, count, (off_t)offset);
+		if( res < 0 ) {
+			if( errno==EINTR )
+				continue;
+			return errno;
+		} else if( res==0 ) {
+			return EIO;
+		}
+		offset += (uint64_t)res;
+		size_t left = (size_t)res;
+		while( count && left >= iov->iov_len ) {
+			left -= iov->iov_len;
+			iov++, count--;
+		}
+		if( count ) {
+			iov->iov_base = (uint8_t *)iov->iov_base + left;
+			iov->iov_len -= left;
+		}
+	}
+	return 0;
+}
+
+static int _harbol_filewriter_sync(const int fd)
+{
+	int res;
+	do {
+		res = fdatasync(fd);
+	} while( res < 0 && errno==EINTR );
+	return ( res < 0 ) ? errno : 0;
+}
+
+/* the I/O thread: takes everything queued up to and including the first barrier as one batch,
+ * writes it with as few pwritev calls as IOV_MAX allows, syncs if asked to, then reports each request.
+ * once a write fails, the error sticks and later requests are reported with it instead of being written.
+ */
+static void *_harbol_filewriter_run(void *const arg)
+{
+	struct HarbolFileWriter *const fw = arg;
+	struct iovec iov[HARBOL_FILEWRITER_IOVS];
+	pthread_mutex_lock(&fw->Lock);
+	for(;;) {
+		while( !fw->Head && !fw->Stop )
+			pthread_cond_wait(&fw->Wake, &fw->Lock);
+		if( !fw->Head )
+			break;
+		
+		struct HarbolFileWriterReq *const batch = fw->Head;
+		struct HarbolFileWriterReq *last = batch;
+		while( last->Next && !last->Barrier )
+			last = last->Next;
+		fw->Head = last->Next;
+		if( !fw->Head )
+			fw->Tail = NULL;
+		last->Next = NULL;
+		int err = fw->Err;
+		pthread_mutex_unlock(&fw->Lock);
+		
+		size_t bytes = 0, reqs = 0;
+		for( struct HarbolFileWriterReq *req = batch; req; ) {
+			int count = 0;
+			const uint64_t offset = req->Offset;
+			for( ; req && count < HARBOL_FILEWRITER_IOVS; req = req->Next ) {
+				if( req->Buf.Count )
+					iov[count++] = (struct iovec){ .iov_base = req->Buf.Buffer, .iov_len = req->Buf.Count };
+				bytes += req->Buf.Count;
+				reqs++;
+			}
+			if( !err && count )
+				err = _harbol_filewriter_pwritev(fw->Fd, iov, count, offset);
+		}
+		if( !err && (last->Barrier || (fw->Flags & HarbolFileWriterSync)) )
+			err = _harbol_filewriter_sync(fw->Fd);
+		
+		for( struct HarbolFileWriterReq *req = batch; req; ) {
+			struct HarbolFileWriterReq *const next = req->Next;
+			if( fw->OnDone )
+				fw->OnDone(fw->Ctx, req->Offset, req->Buf.Count, err);
+			harbol_bytebuffer_del(&req->Buf);
+			free(req);
+			req = next;
+		}
+		
+		pthread_mutex_lock(&fw->Lock);
+		if( err && !fw->Err )
+			fw->Err = err;
+		fw->Queued -= bytes;
+		fw->Completed += reqs;
+		pthread_cond_broadcast(&fw->Room);
+		pthread_cond_broadcast(&fw->Done);
+	}
+	pthread_mutex_unlock(&fw->Lock);
+	return NULL;
+}
+
+static void _harbol_filewriter_enqueue(struct HarbolFileWriter *const fw, struct HarbolFileWriterReq *const req)
+{
+	if( fw->Tail )
+		fw->Tail->Next = req;
+	else fw->Head = req;
+	fw->Tail = req;
+	fw->Submitted++;
+	pthread_cond_signal(&fw->Wake);
+}
+
+
+HARBOL_EXPORT struct HarbolFileWriter *harbol_filewriter_new(const int fd, const int flags, const size_t max_queued, fnHarbolFileWriterDone *const on_done, void *const ctx)
+{
+	struct HarbolFileWriter *fw = calloc(1, sizeof *fw);
+	if( fw && !harbol_filewriter_init(fw, fd, flags, max_queued, on_done, ctx) )
+		free(fw), fw = NULL;
+	return fw;
+}
+
+/* 'fd' has to be seekable; writing starts at its current position, which the writer doesn't move. */
+HARBOL_EXPORT bool harbol_filewriter_init(struct HarbolFileWriter *const fw, const int fd, const int flags, const size_t max_queued, fnHarbolFileWriterDone *const on_done, void *const ctx)
+{
+	if( !fw )
+		return false;
+	
+	// '_del' takes a nonzero 'MaxQueued' to mean the thread is running, so every failure leaves it zeroed.
+	memset(fw, 0, sizeof *fw);
+	const off_t start = ( fd < 0 ) ? -1 : lseek(fd, 0, SEEK_CUR);
+	if( start < 0 )
+		return false;
+	
+	fw->Fd = fd;
+	fw->Flags = flags;
+	fw->Offset = (uint64_t)start;
+	fw->MaxQueued = max_queued ? max_queued : HARBOL_FILEWRITER_MAX_QUEUED;
+	fw->OnDone = on_done;
+	fw->Ctx = ctx;
+	if( pthread_mutex_init(&fw->Lock, NULL) )
+		goto no_lock;
+	if( pthread_cond_init(&fw->Wake, NULL) )
+		goto no_wake;
+	if( pthread_cond_init(&fw->Room, NULL) )
+		goto no_room;
+	if( pthread_cond_init(&fw->Done, NULL) )
+		goto no_done;
+	if( pthread_create(&fw->Thread, NULL, _harbol_filewriter_run, fw) )
+		goto no_thread;
+	return true;
+	
+no_thread:
+	pthread_cond_destroy(&fw->Done);
+no_done:
+	pthread_cond_destroy(&fw->Room);
+no_room:
+	pthread_cond_destroy(&fw->Wake);
+no_wake:
+	pthread_mutex_destroy(&fw->Lock);
+no_lock:
+	memset(fw, 0, sizeof *fw);
+	return false;
+}
+
+/* creates (or with HarbolFileWriterAppend, extends) 'filename' and closes it again on '_del'. */
+HARBOL_EXPORT bool harbol_filewriter_open(struct HarbolFileWriter *const restrict fw, const char filename[restrict], const int flags, const size_t max_queued, fnHarbolFileWriterDone *const on_done, void *const ctx)
+{
+	if( !fw || !filename )
+		return false;
+	
+	int fd;
+	do {
+		fd = open(filename, O_WRONLY | O_CREAT | ((flags & HarbolFileWriterAppend) ? 0 : O_TRUNC), 0644);
+	} while( fd < 0 && errno==EINTR );
+	if( fd < 0 )
+		return false;
+	else if( (flags & HarbolFileWriterAppend) && lseek(fd, 0, SEEK_END) < 0 ) {
+		close(fd);
+		return false;
+	} else if( !harbol_filewriter_init(fw, fd, flags, max_queued, on_done, ctx) ) {
+		close(fd);
+		return false;
+	}
+	fw->OwnsFd = true;
+	return true;
+}
+
+/* writes out everything still queued, then stops the I/O thread. */
+HARBOL_EXPORT void harbol_filewriter_del(struct HarbolFileWriter *const fw)
+{
+	if( !fw || !fw->MaxQueued )
+		return;
+	
+	pthread_mutex_lock(&fw->Lock);
+	fw->Stop = true;
+	pthread_cond_signal(&fw->Wake);
+	pthread_mutex_unlock(&fw->Lock);
+	pthread_join(fw->Thread, NULL);
+	
+	pthread_cond_destroy(&fw->Done);
+	pthread_cond_destroy(&fw->Room);
+	pthread_cond_destroy(&fw->Wake);
+	pthread_mutex_destroy(&fw->Lock);
+	if( fw->OwnsFd )
+		close(fw->Fd);
+	memset(fw, 0, sizeof *fw);
+}
+
+HARBOL_EXPORT void harbol_filewriter_free(struct HarbolFileWriter **const fwref)
+{
+	if( !fwref || !*fwref )
+		return;
+	
+	harbol_filewriter_del(*fwref);
+	free(*fwref), *fwref=NULL;
+}
+
+/* takes ownership of 'buf' (leaving it empty) and queues it to be written after everything submitted before it.
+ * waits for room while more than 'MaxQueued' bytes would be queued, unless 'block' is false,
+ * in which case it fails instead and 'buf' is left alone; a buffer bigger than the limit goes in once the queue is empty.
+ * fails without taking 'buf' once a write has failed.
+ */
+HARBOL_EXPORT bool harbol_filewriter_submit(struct HarbolFileWriter *const restrict fw, struct HarbolByteBuffer *const restrict buf, const bool block)
+{
+	if( !fw || !buf || !fw->MaxQueued )
+		return false;
+	
+	struct HarbolFileWriterReq *const req = calloc(1, sizeof *req);
+	if( !req )
+		return false;
+	
+	const size_t len = buf->Count;
+	pthread_mutex_lock(&fw->Lock);
+	while( !fw->Err && fw->Queued && (fw->Queued >= fw->MaxQueued || len > fw->MaxQueued - fw->Queued) ) {
+		if( !block ) {
+			pthread_mutex_unlock(&fw->Lock);
+			free(req);
+			return false;
+		}
+		pthread_cond_wait(&fw->Room, &fw->Lock);
+	}
+	if( fw->Err ) {
+		pthread_mutex_unlock(&fw->Lock);
+		free(req);
+		return false;
+	}
+	req->Buf = *buf;
+	req->Offset = fw->Offset;
+	fw->Offset += len;
+	fw->Queued += len;
+	_harbol_filewriter_enqueue(fw, req);
+	pthread_mutex_unlock(&fw->Lock);
+	memset(buf, 0, sizeof *buf);
+	return true;
+}
+
+/* queues a durability point: everything submitted before it is written and fdatasync'd
+ * before anything submitted after it is written. doesn't wait; the callback sees it as a 0-length write.
+ */
+HARBOL_EXPORT bool harbol_filewriter_barrier(struct HarbolFileWriter *const fw)
+{
+	if( !fw || !fw->MaxQueued )
+		return false;
+	
+	struct HarbolFileWriterReq *const req = calloc(1, sizeof *req);
+	if( !req )
+		return false;
+	
+	pthread_mutex_lock(&fw->Lock);
+	req->Barrier = true;
+	req->Offset = fw->Offset;
+	_harbol_filewriter_enqueue(fw, req);
+	pthread_mutex_unlock(&fw->Lock);
+	return true;
+}
+
+/* waits until everything submitted so far has been written (and synced first when 'durable').
+ * false if any write so far has failed.
+ */
+HARBOL_EXPORT bool harbol_filewriter_flush(struct HarbolFileWriter *const fw, const bool durable)
+{
+	if( !fw || !fw->MaxQueued || (durable && !harbol_filewriter_barrier(fw)) )
+		return false;
+	
+	pthread_mutex_lock(&fw->Lock);
+	const uint64_t ticket = fw->Submitted;
+	while( fw->Completed < ticket )
+		pthread_cond_wait(&fw->Done, &fw->Lock);
+	const bool ok = !fw->Err;
+	pthread_mutex_unlock(&fw->Lock);
+	return ok;
+}
+
+/* the first errno a write or sync failed with, or 0. */
+HARBOL_EXPORT int harbol_filewriter_get_error(struct HarbolFileWriter *const fw)
+{
+	if( !fw || !fw->MaxQueued )
+		return 0;
+	
+	pthread_mutex_lock(&fw->Lock);
+	const int err = fw->Err;
+	pthread_mutex_unlock(&fw->Lock);
+	return err;
+}
+
+HARBOL_EXPORT size_t harbol_filewriter_get_queued(struct HarbolFileWriter *const fw)
+{
+	if( !fw || !fw->MaxQueued )
+		return 0;
+	
+	pthread_mutex_lock(&fw->Lock);
+	const size_t queued = fw->Queued;
+	pthread_mutex_unlock(&fw->Lock);
+	return queued;
+}
+
+/* the file offset the next submitted buffer will be written at. */
+HARBOL_EXPORT uint64_t harbol_filewriter_get_offset(struct HarbolFileWriter *const fw)
+{
+	if( !fw || !fw->MaxQueued )
+		return 0;
+	
+	pthread_mutex_lock(&fw->Lock);
+	const uint64_t offset = fw->Offset;
+	pthread_mutex_unlock(&fw->Lock);
+	return offset;
+}
+#endif
@@ -0,0 +1,398 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolFrozenMap {
+	uint8_t *Block;
+	struct HarbolFrozenSlot *Slots;
+	int32_t *Seeds;
+	char *Keys;
+	size_t Count, Buckets, ArenaSize;
+	uint64_t Salt;
+} HarbolFrozenMap;
+*/
+
+/* CHD (compress, hash & displace): keys are grouped into buckets of about this many,
+ * then each bucket searches for a seed that scatters all its keys into free slots.
+ */
+#define HARBOL_FROZENMAP_BUCKET_SIZE    4
+#define HARBOL_FROZENMAP_MAX_SEEDS    (1 << 20)
+#define HARBOL_FROZENMAP_MAX_SALTS    16
+#define HARBOL_FROZENMAP_MAGIC    0x5A524648u /* "HFRZ" */
+#define HARBOL_FROZENMAP_HEADER_SIZE    (sizeof(uint32_t) + sizeof(uint64_t) * 4)
+
+struct HarbolFrozenKey {
+	const char *Key;
+	size_t Len;
+	union HarbolValue Val;
+	uint64_t Hash;
+};
+
+struct HarbolFrozenBucket {
+	size_t Size, Index;
+};
+
+static inline uint64_t _harbol_frozenmap_mix(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/* hashes the key and reports its length in the same pass. */
+static uint64_t _harbol_frozenmap_hash(const char key[restrict], const uint64_t salt, size_t *const restrict lenref)
+{
+	uint64_t h = 14695981039346656037ULL ^ salt;
+	const char *iter = key;
+	for( ; *iter; iter++ ) {
+		h ^= (uint8_t)*iter;
+		h *= 1099511628211ULL;
+	}
+	*lenref = iter - key;
+	return _harbol_frozenmap_mix(h);
+}
+
+static inline size_t _harbol_frozenmap_slot(const uint64_t hash, const int32_t seed, const size_t count)
+{
+	// negative seeds are a direct slot index, used for buckets holding a single key.
+	if( seed < 0 )
+		return (size_t)(-(int64_t)seed - 1);
+	return _harbol_frozenmap_mix(hash + (uint64_t)seed * 0x9E3779B97F4A7C15ULL) % count;
+}
+
+static size_t _harbol_frozenmap_block_size(const size_t count, const size_t buckets, const size_t arena)
+{
+	return sizeof(struct HarbolFrozenSlot) * count + sizeof(int32_t) * buckets + arena;
+}
+
+/* everything lives in one block, ordered by alignment: slots, seeds then the key arena. */
+static void _harbol_frozenmap_set_pointers(struct HarbolFrozenMap *const fm)
+{
+	uint8_t *iter = fm->Block;
+	fm->Slots = (struct HarbolFrozenSlot *)iter;
+	iter += sizeof *fm->Slots * fm->Count;
+	fm->Seeds = (int32_t *)iter;
+	iter += sizeof *fm->Seeds * fm->Buckets;
+	fm->Keys = (char *)iter;
+}
+
+static int _harbol_frozenmap_bucket_cmp(const void *const a, const void *const b)
+{
+	const struct HarbolFrozenBucket *const x = a, *const y = b;
+	// biggest buckets go first while the table is still mostly empty.
+	return ( x->Size < y->Size ) - ( x->Size > y->Size );
+}
+
+static bool _harbol_frozenmap_place(struct HarbolFrozenMap *const restrict fm, struct HarbolFrozenKey *const restrict keys, size_t slot_key[restrict])
+{
+	const size_t count = fm->Count, buckets = fm->Buckets;
+	size_t *const bucket_start = calloc(buckets + 1, sizeof *bucket_start);
+	size_t *const by_bucket = malloc(sizeof *by_bucket * count);
+	size_t *const trial = malloc(sizeof *trial * count);
+	struct HarbolFrozenBucket *const sorted = malloc(sizeof *sorted * buckets);
+	bool result = false;
+	if( !bucket_start || !by_bucket || !trial || !sorted )
+		goto harbol_frozenmap_place_done;
+	
+	for( size_t i=0; i<count; i++ ) {
+		keys[i].Hash = _harbol_frozenmap_hash(keys[i].Key, fm->Salt, &keys[i].Len);
+		bucket_start[keys[i].Hash % buckets + 1]++;
+	}
+	for( size_t i=0; i<buckets; i++ ) {
+		sorted[i] = (struct HarbolFrozenBucket){ .Size = bucket_start[i+1], .Index = i };
+		bucket_start[i+1] += bucket_start[i];
+	}
+	// 'trial' doubles as the fill cursor of each bucket while grouping.
+	memcpy(trial, bucket_start, sizeof *trial * buckets);
+	for( size_t i=0; i<count; i++ )
+		by_bucket[trial[keys[i].Hash % buckets]++] = i;
+	qsort(sorted, buckets, sizeof *sorted, _harbol_frozenmap_bucket_cmp);
+	
+	for( size_t i=0; i<count; i++ )
+		slot_key[i] = SIZE_MAX;
+	memset(fm->Seeds, 0, sizeof *fm->Seeds * buckets);
+	
+	size_t b = 0;
+	for( ; b<buckets && sorted[b].Size > 1; b++ ) {
+		const size_t *const members = by_bucket + bucket_start[sorted[b].Index];
+		bool placed = false;
+		for( int32_t seed=0; seed<HARBOL_FROZENMAP_MAX_SEEDS && !placed; seed++ ) {
+			size_t k = 0;
+			for( ; k<sorted[b].Size; k++ ) {
+				const size_t slot = _harbol_frozenmap_slot(keys[members[k]].Hash, seed, count);
+				if( slot_key[slot] != SIZE_MAX )
+					break;
+				slot_key[slot] = members[k];
+				trial[k] = slot;
+			}
+			if( k==sorted[b].Size ) {
+				fm->Seeds[sorted[b].Index] = seed;
+				placed = true;
+			} else {
+				while( k-- )
+					slot_key[trial[k]] = SIZE_MAX;
+			}
+		}
+		if( !placed )
+			goto harbol_frozenmap_place_done;
+	}
+	
+	// singletons don't need a search, they go straight into whatever slots are left.
+	size_t free_slot = 0;
+	for( ; b<buckets && sorted[b].Size==1; b++ ) {
+		while( slot_key[free_slot] != SIZE_MAX )
+			free_slot++;
+		slot_key[free_slot] = by_bucket[bucket_start[sorted[b].Index]];
+		fm->Seeds[sorted[b].Index] = -(int32_t)free_slot - 1;
+	}
+	result = true;
+	
+harbol_frozenmap_place_done:
+	free(bucket_start);
+	free(by_bucket);
+	free(trial);
+	free(sorted);
+	return result;
+}
+
+static bool _harbol_frozenmap_build(struct HarbolFrozenMap *const restrict fm, struct HarbolFrozenKey *const restrict keys, const size_t count)
+{
+	harbol_frozenmap_del(fm);
+	size_t arena = 0;
+	for( size_t i=0; i<count; i++ )
+		arena += strlen(keys[i].Key) + 1;
+	if( arena > UINT32_MAX || count > INT32_MAX )
+		return false;
+	
+	fm->Count = count;
+	fm->Buckets = count ? (count + HARBOL_FROZENMAP_BUCKET_SIZE - 1) / HARBOL_FROZENMAP_BUCKET_SIZE : 0;
+	fm->ArenaSize = arena;
+	fm->Block = calloc(1, _harbol_frozenmap_block_size(count, fm->Buckets, arena));
+	if( !fm->Block ) {
+		memset(fm, 0, sizeof *fm);
+		return false;
+	}
+	_harbol_frozenmap_set_pointers(fm);
+	if( !count )
+		return true;
+	
+	size_t *const slot_key = malloc(sizeof *slot_key * count);
+	bool built = false;
+	// a failed placement (or two keys whose full hashes collide) just needs a differently salted hash.
+	for( uint64_t salt=0; slot_key && salt<HARBOL_FROZENMAP_MAX_SALTS && !built; salt++ ) {
+		fm->Salt = salt;
+		built = _harbol_frozenmap_place(fm, keys, slot_key);
+	}
+	if( !built ) {
+		free(slot_key);
+		harbol_frozenmap_del(fm);
+		return false;
+	}
+	
+	uint32_t offset = 0;
+	for( size_t slot=0; slot<count; slot++ ) {
+		const struct HarbolFrozenKey *const key = keys + slot_key[slot];
+		fm->Slots[slot] = (struct HarbolFrozenSlot){ .Data = key->Val, .KeyOffset = offset, .KeyLen = key->Len };
+		memcpy(fm->Keys + offset, key->Key, key->Len + 1);
+		offset += key->Len + 1;
+	}
+	free(slot_key);
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolFrozenMap *harbol_frozenmap_new_from_hashmap(const struct HarbolHashMap *const map)
+{
+	if( !map )
+		return NULL;
+	
+	struct HarbolFrozenMap *fm = calloc(1, sizeof *fm);
+	if( fm && !harbol_frozenmap_from_hashmap(fm, map) )
+		free(fm), fm=NULL;
+	return fm;
+}
+
+HARBOL_EXPORT struct HarbolFrozenMap *harbol_frozenmap_new_from_linkmap(const struct HarbolLinkMap *const map)
+{
+	if( !map )
+		return NULL;
+	
+	struct HarbolFrozenMap *fm = calloc(1, sizeof *fm);
+	if( fm && !harbol_frozenmap_from_linkmap(fm, map) )
+		free(fm), fm=NULL;
+	return fm;
+}
+
+HARBOL_EXPORT void harbol_frozenmap_del(struct HarbolFrozenMap *const fm)
+{
+	if( !fm )
+		return;
+	
+	free(fm->Block);
+	memset(fm, 0, sizeof *fm);
+}
+
+HARBOL_EXPORT void harbol_frozenmap_free(struct HarbolFrozenMap **fmref)
+{
+	if( !fmref || !*fmref )
+		return;
+	
+	harbol_frozenmap_del(*fmref);
+	free(*fmref), *fmref=NULL;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_from_hashmap(struct HarbolFrozenMap *const restrict fm, const struct HarbolHashMap *const restrict map)
+{
+	if( !fm || !map )
+		return false;
+	
+	struct HarbolFrozenKey *const keys = malloc(sizeof *keys * (map->Count ? map->Count : 1));
+	if( !keys )
+		return false;
+	
+	size_t n = 0;
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		const struct HarbolVector *const vec = harbol_hashmap_get_bucket(map, i);
+		for( size_t a=0; a<harbol_vector_get_count(vec); a++ ) {
+			const struct HarbolKeyValPair *const kv = vec->Table[a].Ptr;
+			keys[n++] = (struct HarbolFrozenKey){ .Key = kv->KeyName.CStr, .Val = kv->Data };
+		}
+	}
+	const bool result = _harbol_frozenmap_build(fm, keys, n);
+	free(keys);
+	return result;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_from_linkmap(struct HarbolFrozenMap *const restrict fm, const struct HarbolLinkMap *const restrict map)
+{
+	if( !fm || !map )
+		return false;
+	
+	struct HarbolFrozenKey *const keys = malloc(sizeof *keys * (map->Order.Count ? map->Order.Count : 1));
+	if( !keys )
+		return false;
+	
+	size_t n = 0;
+	for( size_t i=0; i<map->Order.Count; i++ ) {
+		const struct HarbolKeyValPair *const kv = map->Order.Table[i].KvPairPtr;
+		if( kv )
+			keys[n++] = (struct HarbolFrozenKey){ .Key = kv->KeyName.CStr, .Val = kv->Data };
+	}
+	const bool result = _harbol_frozenmap_build(fm, keys, n);
+	free(keys);
+	return result;
+}
+
+static size_t _harbol_frozenmap_find(const struct HarbolFrozenMap *const restrict fm, const char key[restrict])
+{
+	if( !fm || !key || !fm->Count )
+		return SIZE_MAX;
+	
+	size_t len = 0;
+	const uint64_t hash = _harbol_frozenmap_hash(key, fm->Salt, &len);
+	const size_t index = _harbol_frozenmap_slot(hash, fm->Seeds[hash % fm->Buckets], fm->Count);
+	const struct HarbolFrozenSlot *const slot = fm->Slots + index;
+	return ( slot->KeyLen==len && !memcmp(fm->Keys + slot->KeyOffset, key, len) ) ? index : SIZE_MAX;
+}
+
+HARBOL_EXPORT union HarbolValue harbol_frozenmap_get(const struct HarbolFrozenMap *const restrict fm, const char key[restrict])
+{
+	const size_t slot = _harbol_frozenmap_find(fm, key);
+	return ( slot==SIZE_MAX ) ? (union HarbolValue){0} : fm->Slots[slot].Data;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_has_key(const struct HarbolFrozenMap *const restrict fm, const char key[restrict])
+{
+	return _harbol_frozenmap_find(fm, key) != SIZE_MAX;
+}
+
+HARBOL_EXPORT size_t harbol_frozenmap_get_index(const struct HarbolFrozenMap *const restrict fm, const char key[restrict])
+{
+	return _harbol_frozenmap_find(fm, key);
+}
+
+HARBOL_EXPORT size_t harbol_frozenmap_get_count(const struct HarbolFrozenMap *const fm)
+{
+	return fm ? fm->Count : 0;
+}
+
+HARBOL_EXPORT const char *harbol_frozenmap_get_key_by_index(const struct HarbolFrozenMap *const fm, const size_t index)
+{
+	return ( !fm || index >= fm->Count ) ? NULL : fm->Keys + fm->Slots[index].KeyOffset;
+}
+
+HARBOL_EXPORT union HarbolValue harbol_frozenmap_get_by_index(const struct HarbolFrozenMap *const fm, const size_t index)
+{
+	return ( !fm || index >= fm->Count ) ? (union HarbolValue){0} : fm->Slots[index].Data;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_to_bytebuffer(const struct HarbolFrozenMap *const restrict fm, struct HarbolByteBuffer *const restrict buf)
+{
+	if( !fm || !buf || !fm->Block )
+		return false;
+	
+	harbol_bytebuffer_insert_integer(buf, HARBOL_FROZENMAP_MAGIC, sizeof(uint32_t));
+	harbol_bytebuffer_insert_integer(buf, fm->Count, sizeof(uint64_t));
+	harbol_bytebuffer_insert_integer(buf, fm->Buckets, sizeof(uint64_t));
+	harbol_bytebuffer_insert_integer(buf, fm->Salt, sizeof(uint64_t));
+	harbol_bytebuffer_insert_integer(buf, fm->ArenaSize, sizeof(uint64_t));
+	harbol_bytebuffer_insert_obj(buf, fm->Block, _harbol_frozenmap_block_size(fm->Count, fm->Buckets, fm->ArenaSize));
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_from_bytebuffer(struct HarbolFrozenMap *const restrict fm, const struct HarbolByteBuffer *const restrict buf)
+{
+	if( !fm || !buf || buf->Count < HARBOL_FROZENMAP_HEADER_SIZE )
+		return false;
+	
+	const uint8_t *iter = buf->Buffer;
+	uint32_t magic = 0;
+	uint64_t header[4] = {0};
+	memcpy(&magic, iter, sizeof magic);
+	memcpy(header, iter + sizeof magic, sizeof header);
+	const uint64_t count = header[0], buckets = header[1], arena = header[3];
+	if( magic != HARBOL_FROZENMAP_MAGIC || count > INT32_MAX || arena > UINT32_MAX || (count && !buckets) || buckets > count )
+		return false;
+	
+	const size_t block_size = _harbol_frozenmap_block_size(count, buckets, arena);
+	if( buf->Count - HARBOL_FROZENMAP_HEADER_SIZE < block_size )
+		return false;
+	
+	harbol_frozenmap_del(fm);
+	fm->Block = malloc(block_size);
+	if( !fm->Block )
+		return false;
+	
+	memcpy(fm->Block, iter + HARBOL_FROZENMAP_HEADER_SIZE, block_size);
+	fm->Count = count;
+	fm->Buckets = buckets;
+	fm->Salt = header[2];
+	fm->ArenaSize = arena;
+	_harbol_frozenmap_set_pointers(fm);
+	
+	// lookups trust the offsets and seeds blindly, so make sure they can't point outside the block.
+	bool valid = true;
+	for( size_t i=0; valid && i<count; i++ )
+		valid = (size_t)fm->Slots[i].KeyOffset + fm->Slots[i].KeyLen < arena && fm->Keys[fm->Slots[i].KeyOffset + fm->Slots[i].KeyLen]==0;
+	for( size_t i=0; valid && i<buckets; i++ )
+		valid = fm->Seeds[i] >= 0 || (size_t)(-(int64_t)fm->Seeds[i] - 1) < count;
+	if( !valid )
+		harbol_frozenmap_del(fm);
+	return valid;
+}
+
+HARBOL_EXPORT struct HarbolFrozenMap *harbol_frozenmap_new_from_bytebuffer(const struct HarbolByteBuffer *const buf)
+{
+	if( !buf )
+		return NULL;
+	
+	struct HarbolFrozenMap *fm = calloc(1, sizeof *fm);
+	if( fm && !harbol_frozenmap_from_bytebuffer(fm, buf) )
+		free(fm), fm=NULL;
+	return fm;
+}
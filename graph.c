@@ -401,8 +401,8 @@ HARBOL_EXPORT void harbol_graph_from_hashmap(struct HarbolGraph *const graph, co
 	if( !graph || !map )
 		return;
 	
-	for( size_t i=0; i<map->Len; i++ ) {
-		struct HarbolVector *vec = map->Table + i;
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		struct HarbolVector *vec = harbol_hashmap_get_bucket(map, i);
 		for( size_t n=0; n<harbol_vector_get_count(vec); n++ ) {
 			struct HarbolKeyValPair *kv = vec->Table[n].Ptr;
 			harbol_graph_insert_val(graph, kv->Data);
@@ -435,6 +435,8 @@ HARBOL_EXPORT void harbol_graph_from_linkmap(struct HarbolGraph *const graph, co
 	
 	for( size_t i=0; i<map->Order.Count; i++ ) {
 		struct HarbolKeyValPair *kv = map->Order.Table[i].Ptr;
+		if( !kv )
+			continue;
 		harbol_graph_insert_val(graph, kv->Data);
 	}
 }
@@ -159,6 +159,7 @@ extern "C" {
 
 /* includes, duh. */
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -189,6 +190,7 @@ struct HarbolKeyValPair;
 struct HarbolHashMap;
 struct HarbolUniList;
 struct HarbolBiList;
+struct HarbolUnrolledList;
 struct HarbolByteBuffer;
 struct HarbolTuple;
 struct HarbolGraphEdge;
@@ -197,6 +199,8 @@ struct HarbolGraph;
 struct HarbolTree;
 struct HarbolLinkMap;
 struct HarbolMemoryPool;
+struct HarbolHashSet;
+struct HarbolBPTree;
 
 typedef union HarbolValue {
 	bool Bool, BoolArray[8], *BoolPtr;
@@ -235,6 +239,9 @@ typedef union HarbolValue {
 	struct HarbolLinkMap *LinkMapPtr;
 } HarbolValue;
 
+/* negative, zero or positive like 'strcmp'. */
+typedef int fnHarbolValueCmp(union HarbolValue a, union HarbolValue b);
+
 #ifdef C11
 #	ifndef harbol_value_set_val
 #		define harbol_value_set_val(val, data) \
@@ -385,22 +392,61 @@ HARBOL_EXPORT void harbol_vector_copy(struct HarbolVector *vecA, const struct Ha
 
 HARBOL_EXPORT void harbol_vector_from_unilist(struct HarbolVector *vec, const struct HarbolUniList *list);
 HARBOL_EXPORT void harbol_vector_from_bilist(struct HarbolVector *vec, const struct HarbolBiList *list);
+HARBOL_EXPORT void harbol_vector_from_unrolled(struct HarbolVector *vec, const struct HarbolUnrolledList *list);
 HARBOL_EXPORT void harbol_vector_from_hashmap(struct HarbolVector *vec, const struct HarbolHashMap *map);
 HARBOL_EXPORT void harbol_vector_from_graph(struct HarbolVector *vec, const struct HarbolGraph *graph);
 HARBOL_EXPORT void harbol_vector_from_linkmap(struct HarbolVector *vec, const struct HarbolLinkMap *map);
+HARBOL_EXPORT void harbol_vector_from_hashset(struct HarbolVector *vec, const struct HarbolHashSet *set);
+HARBOL_EXPORT void harbol_vector_from_bptree(struct HarbolVector *vec, const struct HarbolBPTree *tree);
 
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_unilist(const struct HarbolUniList *list);
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_bilist(const struct HarbolBiList *list);
+HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_unrolled(const struct HarbolUnrolledList *list);
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_hashmap(const struct HarbolHashMap *map);
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_graph(const struct HarbolGraph *graph);
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_linkmap(const struct HarbolLinkMap *map);
+HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_hashset(const struct HarbolHashSet *set);
+HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_bptree(const struct HarbolBPTree *tree);
+/***************/
+
+
+/************* Fixed-size Object Pool (objpool.c) *************/
+/* hands out equally sized objects from chunks and recycles them through an intrusive freelist.
+ * 'Sorted' keeps the chunks ordered by address so 'harbol_objpool_owns' is a binary search.
+ */
+struct HarbolObjPoolChunk;
+typedef struct HarbolObjPool {
+	struct HarbolObjPoolChunk *Chunks, **Sorted;
+	void *FreeList;
+	uint8_t *Bump, *BumpEnd;
+	size_t ObjSize, ChunkObjs, Count, ChunkCount;
+} HarbolObjPool;
+
+HARBOL_EXPORT struct HarbolObjPool *harbol_objpool_new(size_t objsize);
+HARBOL_EXPORT void harbol_objpool_init(struct HarbolObjPool *pool, size_t objsize);
+HARBOL_EXPORT void harbol_objpool_del(struct HarbolObjPool *pool);
+HARBOL_EXPORT void harbol_objpool_free(struct HarbolObjPool **poolref);
+HARBOL_EXPORT void *harbol_objpool_alloc(struct HarbolObjPool *pool);
+HARBOL_EXPORT void harbol_objpool_dealloc(struct HarbolObjPool *pool, void *ptr);
+HARBOL_EXPORT bool harbol_objpool_owns(const struct HarbolObjPool *pool, const void *ptr);
+HARBOL_EXPORT size_t harbol_objpool_get_count(const struct HarbolObjPool *pool);
+HARBOL_EXPORT size_t harbol_objpool_get_obj_size(const struct HarbolObjPool *pool);
+HARBOL_EXPORT size_t harbol_objpool_get_total_bytes(const struct HarbolObjPool *pool);
 /***************/
 
 
 /************* String Key Hashmap (hashmap.c) *************/
+/* nodes made by 'harbol_kvpair_new_strval' or by a map keep their key bytes in 'KeyBuf',
+ * right after the node itself, and 'KeyName.CStr' points there.
+ * Because of the flexible array member, a node can't be embedded by value in another struct.
+ */
 typedef struct HarbolKeyValPair {
 	struct HarbolString KeyName;
 	union HarbolValue Data;
+	size_t Hash;
+	size_t Index; /* slot in the owning linkmap's 'Order' vector, unused by plain hashmaps. */
+	uint8_t PoolClass; /* 0 for heap nodes, otherwise 1 + index of the owning map's node pool. */
+	char KeyBuf[];
 } HarbolKeyValPair;
 
 HARBOL_EXPORT struct HarbolKeyValPair *harbol_kvpair_new(void);
@@ -410,12 +456,67 @@ HARBOL_EXPORT void harbol_kvpair_del(struct HarbolKeyValPair *kv, fnHarbolDestru
 HARBOL_EXPORT void harbol_kvpair_free(struct HarbolKeyValPair **kvref, fnHarbolDestructor *dtor);
 
 
+#ifndef HARBOL_KVPAIR_POOL_CLASSES
+#	define HARBOL_KVPAIR_POOL_CLASSES    4
+#endif
+#ifndef HARBOL_KVPAIR_POOL_STEP
+#	define HARBOL_KVPAIR_POOL_STEP    64
+#endif
+
 typedef struct HarbolHashMap {
 	struct HarbolVector *Table; /* a vector of vectors! */
 	size_t Len, Count;
+	
+	/* incremental rehashing: while 'OldTable' is live, its buckets are migrated into 'Table' a few at a time.
+	 * 'Count' covers the nodes of both tables.
+	 */
+	struct HarbolVector *OldTable;
+	size_t OldLen, MigrateIndex;
+	bool Incremental : 1;
+	
+	/* slabs for nodes whose key fits, sized in steps of 'HARBOL_KVPAIR_POOL_STEP' bytes. */
+	struct HarbolObjPool NodePools[HARBOL_KVPAIR_POOL_CLASSES];
+	
+	size_t Rehashes;
+	/* op counters, only allocated and counted when the library is built with 'HARBOL_STATS'.
+	 * They're relaxed atomics in their own block so const lookups can count from any thread.
+	 */
+	struct HarbolHashMapCounters *Counters;
 } HarbolHashMap;
 
+/* a snapshot of the op counters. */
+typedef struct HarbolHashMapOps {
+	size_t Inserts, Deletes, Lookups, Probes;
+} HarbolHashMapOps;
+
+#ifndef HARBOL_HASHMAP_STATS_MAX_CHAIN
+#	define HARBOL_HASHMAP_STATS_MAX_CHAIN    8
+#endif
+
+/* a snapshot of how well a map is hashing and how much memory it's holding.
+ * 'AvgProbeLen' is the mean number of nodes compared by a successful lookup.
+ * 'NodeBytes' includes inline keys and slab slack. 'KeyBytes' is just the key text, for judging node overhead.
+ */
+typedef struct HarbolHashMapStats {
+	size_t Count, Buckets, UsedBuckets, MaxChainLen, Rehashes;
+	size_t ChainHistogram[HARBOL_HASHMAP_STATS_MAX_CHAIN + 1]; /* the last entry collects every longer chain. */
+	double LoadFactor, AvgChainLen, AvgProbeLen;
+	size_t TableBytes, NodeBytes, KeyBytes, TotalBytes;
+	struct HarbolHashMapOps Ops;
+} HarbolHashMapStats;
+
+/* how many old buckets get migrated per mutating operation during an incremental rehash. */
+#ifndef HARBOL_HASHMAP_MIGRATE_STEP
+#	define HARBOL_HASHMAP_MIGRATE_STEP    8
+#endif
+
 HARBOL_EXPORT size_t generic_hash(const char key[]);
+HARBOL_EXPORT uint32_t int32_hash(uint32_t a);
+HARBOL_EXPORT uint64_t int64_hash(uint64_t a);
+HARBOL_EXPORT size_t generic_int_hash(size_t a);
+HARBOL_EXPORT size_t ptr_hash(const void *p);
+HARBOL_EXPORT size_t float32_hash(float fval);
+HARBOL_EXPORT uint64_t float64_hash(double dbl);
 HARBOL_EXPORT struct HarbolHashMap *harbol_hashmap_new(void);
 HARBOL_EXPORT void harbol_hashmap_init(struct HarbolHashMap *map);
 HARBOL_EXPORT void harbol_hashmap_del(struct HarbolHashMap *map, fnHarbolDestructor *dtor);
@@ -423,7 +524,14 @@ HARBOL_EXPORT void harbol_hashmap_free(struct HarbolHashMap **mapref, fnHarbolDe
 HARBOL_EXPORT size_t harbol_hashmap_get_count(const struct HarbolHashMap *map);
 HARBOL_EXPORT size_t harbol_hashmap_get_len(const struct HarbolHashMap *map);
 HARBOL_EXPORT bool harbol_hashmap_rehash(struct HarbolHashMap *map);
-
+HARBOL_EXPORT bool harbol_hashmap_reserve(struct HarbolHashMap *map, size_t count);
+HARBOL_EXPORT void harbol_hashmap_set_incremental(struct HarbolHashMap *map, bool incremental);
+HARBOL_EXPORT bool harbol_hashmap_is_rehashing(const struct HarbolHashMap *map);
+HARBOL_EXPORT bool harbol_hashmap_rehash_step(struct HarbolHashMap *map, size_t buckets);
+HARBOL_EXPORT void harbol_hashmap_finish_rehash(struct HarbolHashMap *map);
+
+HARBOL_EXPORT struct HarbolKeyValPair *harbol_hashmap_alloc_node(struct HarbolHashMap *map, const char key[], union HarbolValue val);
+HARBOL_EXPORT void harbol_hashmap_free_node(struct HarbolHashMap *map, struct HarbolKeyValPair **kvref, fnHarbolDestructor *dtor);
 HARBOL_EXPORT bool harbol_hashmap_insert_node(struct HarbolHashMap *map, struct HarbolKeyValPair *kv);
 HARBOL_EXPORT bool harbol_hashmap_insert(struct HarbolHashMap *map, const char key[], union HarbolValue val);
 
@@ -433,7 +541,15 @@ HARBOL_EXPORT void harbol_hashmap_set(struct HarbolHashMap *map, const char key[
 HARBOL_EXPORT void harbol_hashmap_delete(struct HarbolHashMap *map, const char key[], fnHarbolDestructor *dtor);
 HARBOL_EXPORT bool harbol_hashmap_has_key(const struct HarbolHashMap *map, const char key[]);
 HARBOL_EXPORT struct HarbolKeyValPair *harbol_hashmap_get_node(const struct HarbolHashMap *map, const char key[]);
+/* only the current table; while a rehash is in progress, buckets not yet migrated are still in 'OldTable'.
+ * '_get_bucket' reaches every bucket of both tables, indices past 'Len' being the old table's.
+ */
 struct HarbolVector *harbol_hashmap_get_buckets(const struct HarbolHashMap *map);
+HARBOL_EXPORT size_t harbol_hashmap_get_bucket_count(const struct HarbolHashMap *map);
+HARBOL_EXPORT struct HarbolVector *harbol_hashmap_get_bucket(const struct HarbolHashMap *map, size_t index);
+HARBOL_EXPORT bool harbol_hashmap_get_stats(const struct HarbolHashMap *map, struct HarbolHashMapStats *stats);
+HARBOL_EXPORT void harbol_hashmap_reset_ops(struct HarbolHashMap *map);
+HARBOL_EXPORT void harbol_hashmap_stats_to_file(const struct HarbolHashMapStats *stats, FILE *file);
 
 HARBOL_EXPORT void harbol_hashmap_from_unilist(struct HarbolHashMap *map, const struct HarbolUniList *list);
 HARBOL_EXPORT void harbol_hashmap_from_bilist(struct HarbolHashMap *map, const struct HarbolBiList *list);
@@ -449,6 +565,54 @@ HARBOL_EXPORT struct HarbolHashMap *harbol_hashmap_new_from_linkmap(const struct
 /***************/
 
 
+/************* Hash Set (hashset.c) *************/
+typedef enum HarbolHashSetKeyType {
+	HarbolSetKeyStr=0,
+	HarbolSetKeyInt,
+	HarbolSetKeyPtr
+} HarbolHashSetKeyType;
+
+typedef struct HarbolHashSetSlot {
+	union HarbolValue Key;
+	size_t Hash; /* 0 marks an empty slot. */
+} HarbolHashSetSlot;
+
+/* an open-addressed set of bare keys, hashed the same way as the maps.
+ * String keys are copied in ('Key.Ptr' is the set's own copy), integer keys use 'Key.Int64'.
+ */
+typedef struct HarbolHashSet {
+	struct HarbolHashSetSlot *Table;
+	size_t Len, Count;
+	enum HarbolHashSetKeyType KeyType;
+} HarbolHashSet;
+
+HARBOL_EXPORT struct HarbolHashSet *harbol_hashset_new(enum HarbolHashSetKeyType type);
+HARBOL_EXPORT void harbol_hashset_init(struct HarbolHashSet *set, enum HarbolHashSetKeyType type);
+HARBOL_EXPORT void harbol_hashset_del(struct HarbolHashSet *set);
+HARBOL_EXPORT void harbol_hashset_free(struct HarbolHashSet **setref);
+HARBOL_EXPORT size_t harbol_hashset_get_count(const struct HarbolHashSet *set);
+HARBOL_EXPORT size_t harbol_hashset_get_len(const struct HarbolHashSet *set);
+HARBOL_EXPORT bool harbol_hashset_reserve(struct HarbolHashSet *set, size_t count);
+HARBOL_EXPORT void harbol_hashset_clear(struct HarbolHashSet *set);
+
+HARBOL_EXPORT bool harbol_hashset_insert(struct HarbolHashSet *set, union HarbolValue key);
+HARBOL_EXPORT bool harbol_hashset_has(const struct HarbolHashSet *set, union HarbolValue key);
+HARBOL_EXPORT bool harbol_hashset_remove(struct HarbolHashSet *set, union HarbolValue key);
+HARBOL_EXPORT bool harbol_hashset_insert_cstr(struct HarbolHashSet *set, const char key[]);
+HARBOL_EXPORT bool harbol_hashset_has_cstr(const struct HarbolHashSet *set, const char key[]);
+HARBOL_EXPORT bool harbol_hashset_remove_cstr(struct HarbolHashSet *set, const char key[]);
+HARBOL_EXPORT bool harbol_hashset_next(const struct HarbolHashSet *set, size_t *iter, union HarbolValue *key);
+
+HARBOL_EXPORT bool harbol_hashset_union(struct HarbolHashSet *dest, const struct HarbolHashSet *a, const struct HarbolHashSet *b);
+HARBOL_EXPORT bool harbol_hashset_intersection(struct HarbolHashSet *dest, const struct HarbolHashSet *a, const struct HarbolHashSet *b);
+HARBOL_EXPORT bool harbol_hashset_difference(struct HarbolHashSet *dest, const struct HarbolHashSet *a, const struct HarbolHashSet *b);
+HARBOL_EXPORT bool harbol_hashset_is_subset(const struct HarbolHashSet *a, const struct HarbolHashSet *b);
+
+HARBOL_EXPORT void harbol_hashset_from_vector(struct HarbolHashSet *set, const struct HarbolVector *vec);
+HARBOL_EXPORT struct HarbolHashSet *harbol_hashset_new_from_vector(const struct HarbolVector *vec, enum HarbolHashSetKeyType type);
+/***************/
+
+
 /************* Singly Linked List (unilist.c) *************/
 typedef struct HarbolUniListNode {
 	union HarbolValue Data;
@@ -463,9 +627,13 @@ HARBOL_EXPORT struct HarbolUniListNode *harbol_unilistnode_get_next_node(const s
 HARBOL_EXPORT union HarbolValue harbol_unilistnode_get_val(const struct HarbolUniListNode *node);
 
 
+/* a list given a 'Pool' (which can be shared between lists) makes its nodes from it rather than one heap allocation each.
+ * The pool has to outlive the list. Nodes from 'harbol_unilistnode_new' can still be inserted and are freed normally.
+ */
 typedef struct HarbolUniList {
 	struct HarbolUniListNode *Head, *Tail;
 	size_t Len;
+	struct HarbolObjPool *Pool;
 } HarbolUniList;
 
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new(void);
@@ -473,6 +641,9 @@ HARBOL_EXPORT void harbol_unilist_del(struct HarbolUniList *list, fnHarbolDestru
 HARBOL_EXPORT void harbol_unilist_free(struct HarbolUniList **listref, fnHarbolDestructor *dtor);
 HARBOL_EXPORT void harbol_unilist_init(struct HarbolUniList *list);
 
+HARBOL_EXPORT bool harbol_unilist_set_pool(struct HarbolUniList *list, struct HarbolObjPool *pool);
+HARBOL_EXPORT struct HarbolObjPool *harbol_unilist_get_pool(const struct HarbolUniList *list);
+
 HARBOL_EXPORT size_t harbol_unilist_get_len(const struct HarbolUniList *list);
 HARBOL_EXPORT bool harbol_unilist_insert_node_at_head(struct HarbolUniList *list, struct HarbolUniListNode *node);
 HARBOL_EXPORT bool harbol_unilist_insert_node_at_tail(struct HarbolUniList *list, struct HarbolUniListNode *node);
@@ -491,13 +662,20 @@ HARBOL_EXPORT bool harbol_unilist_del_node_by_ref(struct HarbolUniList *list, st
 HARBOL_EXPORT struct HarbolUniListNode *harbol_unilist_get_head_node(const struct HarbolUniList *list);
 HARBOL_EXPORT struct HarbolUniListNode *harbol_unilist_get_tail_node(const struct HarbolUniList *list);
 
+HARBOL_EXPORT bool harbol_unilist_splice_after(struct HarbolUniList *dst, struct HarbolUniListNode *pos, struct HarbolUniList *src, struct HarbolUniListNode *before_first, struct HarbolUniListNode *last, size_t count);
+HARBOL_EXPORT bool harbol_unilist_concat(struct HarbolUniList *dst, struct HarbolUniList *src);
+HARBOL_EXPORT bool harbol_unilist_split_after(struct HarbolUniList *list, struct HarbolUniListNode *node, struct HarbolUniList *tail);
+HARBOL_EXPORT bool harbol_unilist_sort(struct HarbolUniList *list, fnHarbolValueCmp *cmp);
+
 HARBOL_EXPORT void harbol_unilist_from_bilist(struct HarbolUniList *list, const struct HarbolBiList *bilist);
+HARBOL_EXPORT void harbol_unilist_from_unrolled(struct HarbolUniList *list, const struct HarbolUnrolledList *unrolled);
 HARBOL_EXPORT void harbol_unilist_from_hashmap(struct HarbolUniList *list, const struct HarbolHashMap *map);
 HARBOL_EXPORT void harbol_unilist_from_vector(struct HarbolUniList *list, const struct HarbolVector *vec);
 HARBOL_EXPORT void harbol_unilist_from_graph(struct HarbolUniList *list, const struct HarbolGraph *graph);
 HARBOL_EXPORT void harbol_unilist_from_linkmap(struct HarbolUniList *list, const struct HarbolLinkMap *map);
 
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_bilist(const struct HarbolBiList *bilist);
+HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_unrolled(const struct HarbolUnrolledList *unrolled);
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_hashmap(const struct HarbolHashMap *map);
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_vector(const struct HarbolVector *vec);
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_graph(const struct HarbolGraph *graph);
@@ -520,9 +698,11 @@ HARBOL_EXPORT struct HarbolBiListNode *harbol_bilist_node_get_prev_node(const st
 HARBOL_EXPORT union HarbolValue harbol_bilist_node_get_val(const struct HarbolBiListNode *node);
 
 
+/* pooling works the same as it does for 'HarbolUniList'. */
 typedef struct HarbolBiList {
 	struct HarbolBiListNode *Head, *Tail;
 	size_t Len;
+	struct HarbolObjPool *Pool;
 } HarbolBiList;
 
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new(void);
@@ -530,6 +710,9 @@ HARBOL_EXPORT void harbol_bilist_del(struct HarbolBiList *list, fnHarbolDestruct
 HARBOL_EXPORT void harbol_bilist_free(struct HarbolBiList **listref, fnHarbolDestructor *dtor);
 HARBOL_EXPORT void harbol_bilist_init(struct HarbolBiList *list);
 
+HARBOL_EXPORT bool harbol_bilist_set_pool(struct HarbolBiList *list, struct HarbolObjPool *pool);
+HARBOL_EXPORT struct HarbolObjPool *harbol_bilist_get_pool(const struct HarbolBiList *list);
+
 HARBOL_EXPORT size_t harbol_bilist_get_len(const struct HarbolBiList *list);
 HARBOL_EXPORT bool harbol_bilist_insert_node_at_head(struct HarbolBiList *list, struct HarbolBiListNode *node);
 HARBOL_EXPORT bool harbol_bilist_insert_node_at_tail(struct HarbolBiList *list, struct HarbolBiListNode *node);
@@ -548,13 +731,20 @@ HARBOL_EXPORT bool harbol_bilist_del_node_by_ref(struct HarbolBiList *list, stru
 HARBOL_EXPORT struct HarbolBiListNode *harbol_bilist_get_head_node(const struct HarbolBiList *list);
 HARBOL_EXPORT struct HarbolBiListNode *harbol_bilist_get_tail_node(const struct HarbolBiList *list);
 
+HARBOL_EXPORT bool harbol_bilist_splice(struct HarbolBiList *dst, struct HarbolBiListNode *pos, struct HarbolBiList *src, struct HarbolBiListNode *first, struct HarbolBiListNode *last, size_t count);
+HARBOL_EXPORT bool harbol_bilist_concat(struct HarbolBiList *dst, struct HarbolBiList *src);
+HARBOL_EXPORT bool harbol_bilist_split(struct HarbolBiList *list, struct HarbolBiListNode *node, struct HarbolBiList *tail);
+HARBOL_EXPORT bool harbol_bilist_sort(struct HarbolBiList *list, fnHarbolValueCmp *cmp);
+
 HARBOL_EXPORT void harbol_bilist_from_unilist(struct HarbolBiList *bilist, const struct HarbolUniList *unilist);
+HARBOL_EXPORT void harbol_bilist_from_unrolled(struct HarbolBiList *bilist, const struct HarbolUnrolledList *unrolled);
 HARBOL_EXPORT void harbol_bilist_from_hashmap(struct HarbolBiList *bilist, const struct HarbolHashMap *map);
 HARBOL_EXPORT void harbol_bilist_from_vector(struct HarbolBiList *bilist, const struct HarbolVector *vec);
 HARBOL_EXPORT void harbol_bilist_from_graph(struct HarbolBiList *bilist, const struct HarbolGraph *graph);
 HARBOL_EXPORT void harbol_bilist_from_linkmap(struct HarbolBiList *bilist, const struct HarbolLinkMap *linkmap);
 
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_unilist(const struct HarbolUniList *unilist);
+HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_unrolled(const struct HarbolUnrolledList *unrolled);
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_hashmap(const struct HarbolHashMap *map);
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_vector(const struct HarbolVector *vec);
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_graph(const struct HarbolGraph *graph);
@@ -562,12 +752,117 @@ HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new_from_linkmap(const struct H
 /***************/
 
 
+/************* Unrolled Linked List (unrolled.c) *************/
+/* each node is one 128-byte, 128-aligned block holding up to 14 values,
+ * so walking the list touches two cache lines per 14 values and index lookups hop whole nodes.
+ */
+#define HARBOL_UNROLLED_NODE_VALS    14
+
+typedef struct HarbolUnrolledNode {
+	struct HarbolUnrolledNode *Next;
+	size_t Count;
+	union HarbolValue Vals[HARBOL_UNROLLED_NODE_VALS];
+} HarbolUnrolledNode;
+
+typedef struct HarbolUnrolledList {
+	struct HarbolUnrolledNode *Head, *Tail;
+	size_t Len, Nodes;
+} HarbolUnrolledList;
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new(void);
+HARBOL_EXPORT void harbol_unrolled_init(struct HarbolUnrolledList *list);
+HARBOL_EXPORT void harbol_unrolled_del(struct HarbolUnrolledList *list, fnHarbolDestructor *dtor);
+HARBOL_EXPORT void harbol_unrolled_free(struct HarbolUnrolledList **listref, fnHarbolDestructor *dtor);
+
+HARBOL_EXPORT size_t harbol_unrolled_get_len(const struct HarbolUnrolledList *list);
+HARBOL_EXPORT size_t harbol_unrolled_get_node_count(const struct HarbolUnrolledList *list);
+HARBOL_EXPORT bool harbol_unrolled_insert_at_head(struct HarbolUnrolledList *list, union HarbolValue val);
+HARBOL_EXPORT bool harbol_unrolled_insert_at_tail(struct HarbolUnrolledList *list, union HarbolValue val);
+HARBOL_EXPORT bool harbol_unrolled_insert_at_index(struct HarbolUnrolledList *list, union HarbolValue val, size_t index);
+
+HARBOL_EXPORT union HarbolValue harbol_unrolled_get_val(const struct HarbolUnrolledList *list, size_t index);
+HARBOL_EXPORT void harbol_unrolled_set_val(struct HarbolUnrolledList *list, size_t index, union HarbolValue val);
+HARBOL_EXPORT size_t harbol_unrolled_get_index_by_val(const struct HarbolUnrolledList *list, union HarbolValue val);
+HARBOL_EXPORT bool harbol_unrolled_del_by_index(struct HarbolUnrolledList *list, size_t index, fnHarbolDestructor *dtor);
+
+HARBOL_EXPORT struct HarbolUnrolledNode *harbol_unrolled_get_head_node(const struct HarbolUnrolledList *list);
+HARBOL_EXPORT struct HarbolUnrolledNode *harbol_unrolled_get_tail_node(const struct HarbolUnrolledList *list);
+
+HARBOL_EXPORT void harbol_unrolled_from_unilist(struct HarbolUnrolledList *list, const struct HarbolUniList *unilist);
+HARBOL_EXPORT void harbol_unrolled_from_bilist(struct HarbolUnrolledList *list, const struct HarbolBiList *bilist);
+HARBOL_EXPORT void harbol_unrolled_from_hashmap(struct HarbolUnrolledList *list, const struct HarbolHashMap *map);
+HARBOL_EXPORT void harbol_unrolled_from_vector(struct HarbolUnrolledList *list, const struct HarbolVector *vec);
+HARBOL_EXPORT void harbol_unrolled_from_graph(struct HarbolUnrolledList *list, const struct HarbolGraph *graph);
+HARBOL_EXPORT void harbol_unrolled_from_linkmap(struct HarbolUnrolledList *list, const struct HarbolLinkMap *map);
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_unilist(const struct HarbolUniList *unilist);
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_bilist(const struct HarbolBiList *bilist);
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_hashmap(const struct HarbolHashMap *map);
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_vector(const struct HarbolVector *vec);
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_graph(const struct HarbolGraph *graph);
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_linkmap(const struct HarbolLinkMap *map);
+/***************/
+
+
+/************* Lock-Free Stack and Queue (lockfree.c) *************/
+/* multi-producer/multi-consumer containers built on 'HarbolUniListNode' and C11 atomics.
+ * the fields are tagged pointers and should only be touched through these functions.
+ * nodes are recycled internally rather than freed, so memory is only given back by 'del',
+ * which, like 'init', must not race with any other call on the same container.
+ */
+#define HARBOL_LF_LINE    64
+
+typedef struct HarbolLFStack {
+	alignas(8) uint64_t Top, Spares;
+} HarbolLFStack;
+
+HARBOL_EXPORT struct HarbolLFStack *harbol_lfstack_new(void);
+HARBOL_EXPORT void harbol_lfstack_init(struct HarbolLFStack *stack);
+HARBOL_EXPORT void harbol_lfstack_del(struct HarbolLFStack *stack, fnHarbolDestructor *dtor);
+HARBOL_EXPORT void harbol_lfstack_free(struct HarbolLFStack **stackref, fnHarbolDestructor *dtor);
+
+HARBOL_EXPORT bool harbol_lfstack_push(struct HarbolLFStack *stack, union HarbolValue val);
+HARBOL_EXPORT bool harbol_lfstack_pop(struct HarbolLFStack *stack, union HarbolValue *val);
+HARBOL_EXPORT bool harbol_lfstack_is_empty(const struct HarbolLFStack *stack);
+
+
+/* 'Head' and 'Tail' sit on separate cache lines so producers and consumers don't false-share. */
+typedef struct HarbolLFQueue {
+	alignas(8) uint64_t Head;
+	uint8_t HeadPad[HARBOL_LF_LINE - sizeof(uint64_t)];
+	alignas(8) uint64_t Tail;
+	uint8_t TailPad[HARBOL_LF_LINE - sizeof(uint64_t)];
+	alignas(8) uint64_t Spares;
+} HarbolLFQueue;
+
+HARBOL_EXPORT struct HarbolLFQueue *harbol_lfqueue_new(void);
+HARBOL_EXPORT bool harbol_lfqueue_init(struct HarbolLFQueue *queue);
+HARBOL_EXPORT void harbol_lfqueue_del(struct HarbolLFQueue *queue, fnHarbolDestructor *dtor);
+HARBOL_EXPORT void harbol_lfqueue_free(struct HarbolLFQueue **queueref, fnHarbolDestructor *dtor);
+
+HARBOL_EXPORT bool harbol_lfqueue_enqueue(struct HarbolLFQueue *queue, union HarbolValue val);
+HARBOL_EXPORT bool harbol_lfqueue_dequeue(struct HarbolLFQueue *queue, union HarbolValue *val);
+HARBOL_EXPORT bool harbol_lfqueue_is_empty(const struct HarbolLFQueue *queue);
+/***************/
+
+
 /************* Byte Buffer (bytebuffer.c) *************/
+/* 'Len' is the allocated capacity and 'Count' the bytes in use; capacity doubles as inserts need it.
+ * a buffer made by '_map_file' is a read-only view of a file and can't grow or shrink.
+ */
+#define HARBOL_BYTEBUFFER_DEFAULT_SIZE    64
+
 typedef struct HarbolByteBuffer {
 	uint8_t *Buffer;
 	size_t Len, Count;
+	size_t MapLen; /* non-zero for a mapped view; the length to unmap. */
 } HarbolByteBuffer;
 
+/* access pattern hints for mapped views, OR'd together. */
+typedef enum HarbolMapHint {
+	HarbolMapNormal=0, HarbolMapSequential=1, HarbolMapWillNeed=2, HarbolMapHugePage=4,
+} HarbolMapHint;
+
 HARBOL_EXPORT struct HarbolByteBuffer *harbol_bytebuffer_new(void);
 HARBOL_EXPORT void harbol_bytebuffer_init(struct HarbolByteBuffer *buf);
 HARBOL_EXPORT void harbol_bytebuffer_del(struct HarbolByteBuffer *buf);
@@ -575,6 +870,11 @@ HARBOL_EXPORT void harbol_bytebuffer_free(struct HarbolByteBuffer **bufref);
 HARBOL_EXPORT size_t harbol_bytebuffer_get_len(const struct HarbolByteBuffer *buf);
 HARBOL_EXPORT size_t harbol_bytebuffer_get_count(const struct HarbolByteBuffer *buf);
 HARBOL_EXPORT uint8_t *harbol_bytebuffer_get_raw_buffer(const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_bytebuffer_reserve(struct HarbolByteBuffer *buf, size_t len);
+HARBOL_EXPORT uint8_t *harbol_bytebuffer_prepare(struct HarbolByteBuffer *buf, size_t size);
+HARBOL_EXPORT bool harbol_bytebuffer_commit(struct HarbolByteBuffer *buf, size_t size);
+HARBOL_EXPORT size_t harbol_bytebuffer_get_spare(const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT void harbol_bytebuffer_clear(struct HarbolByteBuffer *buf);
 HARBOL_EXPORT void harbol_bytebuffer_insert_byte(struct HarbolByteBuffer *buf, uint8_t byte);
 HARBOL_EXPORT void harbol_bytebuffer_insert_integer(struct HarbolByteBuffer *buf, uint64_t integer, size_t size);
 HARBOL_EXPORT void harbol_bytebuffer_insert_float32(struct HarbolByteBuffer *buf, float flt);
@@ -587,6 +887,165 @@ HARBOL_EXPORT void harbol_bytebuffer_resize(struct HarbolByteBuffer *buf);
 HARBOL_EXPORT void harbol_bytebuffer_to_file(const struct HarbolByteBuffer *buf, FILE *file);
 HARBOL_EXPORT size_t harbol_bytebuffer_read_from_file(struct HarbolByteBuffer *buf, FILE *file);
 HARBOL_EXPORT void harbol_bytebuffer_append(struct HarbolByteBuffer *bufA, struct HarbolByteBuffer *bufB);
+
+HARBOL_EXPORT bool harbol_bytebuffer_map_file(struct HarbolByteBuffer *buf, const char filename[], int hints);
+HARBOL_EXPORT bool harbol_bytebuffer_is_mapped(const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_bytebuffer_advise(const struct HarbolByteBuffer *buf, int hints);
+/***************/
+
+
+/************* Byte Buffer Cursors (bytecursor.c) *************/
+/* a writer appends to a byte buffer; a reader walks any span of bytes with bounds checks.
+ * fixed-width values come in an explicit byte order, varints are LEB128 (zigzag for signed),
+ * and blobs/strings are a varint length followed by the bytes.
+ * both latch the first failure, so a run of calls can be checked once at the end with '_ok'.
+ */
+typedef struct HarbolByteWriter {
+	struct HarbolByteBuffer *Buf;
+	bool Failed;
+} HarbolByteWriter;
+
+HARBOL_EXPORT void harbol_bytewriter_init(struct HarbolByteWriter *w, struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_bytewriter_ok(const struct HarbolByteWriter *w);
+
+HARBOL_EXPORT bool harbol_bytewriter_put_u8(struct HarbolByteWriter *w, uint8_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_u16_le(struct HarbolByteWriter *w, uint16_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_u16_be(struct HarbolByteWriter *w, uint16_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_u32_le(struct HarbolByteWriter *w, uint32_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_u32_be(struct HarbolByteWriter *w, uint32_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_u64_le(struct HarbolByteWriter *w, uint64_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_u64_be(struct HarbolByteWriter *w, uint64_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_f32_le(struct HarbolByteWriter *w, float val);
+HARBOL_EXPORT bool harbol_bytewriter_put_f32_be(struct HarbolByteWriter *w, float val);
+HARBOL_EXPORT bool harbol_bytewriter_put_f64_le(struct HarbolByteWriter *w, double val);
+HARBOL_EXPORT bool harbol_bytewriter_put_f64_be(struct HarbolByteWriter *w, double val);
+HARBOL_EXPORT bool harbol_bytewriter_put_uvarint(struct HarbolByteWriter *w, uint64_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_svarint(struct HarbolByteWriter *w, int64_t val);
+HARBOL_EXPORT bool harbol_bytewriter_put_bytes(struct HarbolByteWriter *w, const void *data, size_t size);
+HARBOL_EXPORT bool harbol_bytewriter_put_blob(struct HarbolByteWriter *w, const void *data, size_t size);
+HARBOL_EXPORT bool harbol_bytewriter_put_str(struct HarbolByteWriter *w, const char cstr[], size_t len);
+
+
+/* views handed out by a reader point straight into 'Data'. */
+typedef struct HarbolByteReader {
+	const uint8_t *Data;
+	size_t Len, Pos;
+	bool Failed;
+} HarbolByteReader;
+
+HARBOL_EXPORT void harbol_bytereader_init(struct HarbolByteReader *r, const uint8_t *data, size_t len);
+HARBOL_EXPORT void harbol_bytereader_init_buffer(struct HarbolByteReader *r, const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_bytereader_ok(const struct HarbolByteReader *r);
+HARBOL_EXPORT size_t harbol_bytereader_get_pos(const struct HarbolByteReader *r);
+HARBOL_EXPORT size_t harbol_bytereader_get_remaining(const struct HarbolByteReader *r);
+HARBOL_EXPORT bool harbol_bytereader_skip(struct HarbolByteReader *r, size_t size);
+
+HARBOL_EXPORT bool harbol_bytereader_get_u8(struct HarbolByteReader *r, uint8_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_u16_le(struct HarbolByteReader *r, uint16_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_u16_be(struct HarbolByteReader *r, uint16_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_u32_le(struct HarbolByteReader *r, uint32_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_u32_be(struct HarbolByteReader *r, uint32_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_u64_le(struct HarbolByteReader *r, uint64_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_u64_be(struct HarbolByteReader *r, uint64_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_f32_le(struct HarbolByteReader *r, float *val);
+HARBOL_EXPORT bool harbol_bytereader_get_f32_be(struct HarbolByteReader *r, float *val);
+HARBOL_EXPORT bool harbol_bytereader_get_f64_le(struct HarbolByteReader *r, double *val);
+HARBOL_EXPORT bool harbol_bytereader_get_f64_be(struct HarbolByteReader *r, double *val);
+HARBOL_EXPORT bool harbol_bytereader_get_uvarint(struct HarbolByteReader *r, uint64_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_svarint(struct HarbolByteReader *r, int64_t *val);
+HARBOL_EXPORT bool harbol_bytereader_get_bytes(struct HarbolByteReader *r, size_t size, const uint8_t **view);
+HARBOL_EXPORT bool harbol_bytereader_get_blob(struct HarbolByteReader *r, const uint8_t **view, size_t *size);
+HARBOL_EXPORT bool harbol_bytereader_get_str(struct HarbolByteReader *r, const char **view, size_t *len);
+/***************/
+
+
+/************* LZ Compression (lz.c) *************/
+/* a self-contained LZ77 block compressor using LZ4's sequence layout (greedy, single-probe hash, 64KB window),
+ * plus a framed stream of independently compressed blocks for data that doesn't fit in memory.
+ * blocks that don't shrink are stored as-is.
+ */
+#define HARBOL_LZ_BLOCK_SIZE        (4u * 1024u * 1024u)
+#define HARBOL_LZ_MAX_BLOCK_SIZE    (1u << 30)
+
+typedef struct HarbolLZEncoder {
+	struct HarbolByteBuffer Pending;
+	size_t BlockSize;
+	bool Started;
+} HarbolLZEncoder;
+
+typedef struct HarbolLZDecoder {
+	struct HarbolByteBuffer Pending;
+	size_t BlockSize;
+	bool Started, Done, Failed;
+} HarbolLZDecoder;
+
+HARBOL_EXPORT size_t harbol_lz_compress_bound(size_t len);
+HARBOL_EXPORT bool harbol_lz_compress_block(const void *src, size_t len, struct HarbolByteBuffer *dst);
+HARBOL_EXPORT bool harbol_lz_decompress_block(const void *src, size_t len, size_t raw_len, struct HarbolByteBuffer *dst);
+
+HARBOL_EXPORT void harbol_lz_encoder_init(struct HarbolLZEncoder *enc, size_t block_size);
+HARBOL_EXPORT void harbol_lz_encoder_del(struct HarbolLZEncoder *enc);
+HARBOL_EXPORT bool harbol_lz_encoder_write(struct HarbolLZEncoder *enc, const void *data, size_t len, struct HarbolByteBuffer *out);
+HARBOL_EXPORT bool harbol_lz_encoder_finish(struct HarbolLZEncoder *enc, struct HarbolByteBuffer *out);
+
+HARBOL_EXPORT void harbol_lz_decoder_init(struct HarbolLZDecoder *dec);
+HARBOL_EXPORT void harbol_lz_decoder_del(struct HarbolLZDecoder *dec);
+HARBOL_EXPORT bool harbol_lz_decoder_is_done(const struct HarbolLZDecoder *dec);
+HARBOL_EXPORT bool harbol_lz_decoder_write(struct HarbolLZDecoder *dec, const void *data, size_t len, struct HarbolByteBuffer *out);
+
+HARBOL_EXPORT bool harbol_lz_compress_buffer(const struct HarbolByteBuffer *src, struct HarbolByteBuffer *dst, size_t block_size);
+HARBOL_EXPORT bool harbol_lz_decompress_buffer(const struct HarbolByteBuffer *src, struct HarbolByteBuffer *dst);
+HARBOL_EXPORT bool harbol_lz_compress_file(FILE *in, FILE *out, size_t block_size);
+HARBOL_EXPORT bool harbol_lz_decompress_file(FILE *in, FILE *out);
+/***************/
+
+
+/************* Checksums (checksum.c) *************/
+/* CRC32C runs on the SSE4.2 crc32 instruction over 3 interleaved streams when the CPU has it,
+ * and on slicing-by-8 tables otherwise; the choice is made once, at the first call.
+ * XXH64 is a fast 64-bit non-cryptographic digest with the same output as the reference xxHash.
+ * both can be fed incrementally: the crc by passing the last result back in, XXH64 through a state.
+ */
+typedef struct HarbolXXH64 {
+	uint64_t Acc[4], Seed, Total;
+	uint8_t Mem[32];
+	size_t MemLen;
+} HarbolXXH64;
+
+HARBOL_EXPORT uint32_t harbol_crc32c(uint32_t crc, const void *data, size_t len);
+HARBOL_EXPORT uint32_t harbol_crc32c_sw(uint32_t crc, const void *data, size_t len);
+HARBOL_EXPORT uint32_t harbol_crc32c_bytebuffer(uint32_t crc, const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT uint32_t harbol_crc32c_string(uint32_t crc, const struct HarbolString *str);
+HARBOL_EXPORT bool harbol_crc32c_is_hw(void);
+
+HARBOL_EXPORT void harbol_xxh64_init(struct HarbolXXH64 *state, uint64_t seed);
+HARBOL_EXPORT bool harbol_xxh64_update(struct HarbolXXH64 *state, const void *data, size_t len);
+HARBOL_EXPORT bool harbol_xxh64_update_bytebuffer(struct HarbolXXH64 *state, const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_xxh64_update_string(struct HarbolXXH64 *state, const struct HarbolString *str);
+HARBOL_EXPORT uint64_t harbol_xxh64_digest(const struct HarbolXXH64 *state);
+HARBOL_EXPORT uint64_t harbol_xxh64(const void *data, size_t len, uint64_t seed);
+/***************/
+
+
+/************* Base64 and Hex Text Encodings (encoding.c) *************/
+/* encoders append to a string or byte buffer, sized exactly up front; decoders append to a byte buffer.
+ * SSSE3 paths are picked at runtime on x86, with scalar code for tails and other CPUs.
+ * a failed decode appends nothing and reports the offset of the first bad character.
+ */
+typedef enum HarbolBase64Alphabet {
+	HarbolBase64Std=0, /* '+' and '/' */
+	HarbolBase64URL,   /* '-' and '_' */
+} HarbolBase64Alphabet;
+
+HARBOL_EXPORT size_t harbol_hex_encoded_len(size_t len);
+HARBOL_EXPORT bool harbol_hex_encode_to_string(struct HarbolString *str, const void *data, size_t len, bool upper);
+HARBOL_EXPORT bool harbol_hex_encode_to_bytebuffer(struct HarbolByteBuffer *buf, const void *data, size_t len, bool upper);
+HARBOL_EXPORT bool harbol_hex_decode(struct HarbolByteBuffer *buf, const char text[], size_t len, size_t *bad_offset);
+
+HARBOL_EXPORT size_t harbol_base64_encoded_len(size_t len, bool pad);
+HARBOL_EXPORT bool harbol_base64_encode_to_string(struct HarbolString *str, const void *data, size_t len, enum HarbolBase64Alphabet alphabet, bool pad);
+HARBOL_EXPORT bool harbol_base64_encode_to_bytebuffer(struct HarbolByteBuffer *buf, const void *data, size_t len, enum HarbolBase64Alphabet alphabet, bool pad);
+HARBOL_EXPORT bool harbol_base64_decode(struct HarbolByteBuffer *buf, const char text[], size_t len, enum HarbolBase64Alphabet alphabet, size_t *bad_offset);
 /***************/
 
 
@@ -612,6 +1071,124 @@ HARBOL_EXPORT void *harbol_tuple_set_field(const struct HarbolTuple *tuple, size
 HARBOL_EXPORT size_t harbol_tuple_get_field_size(const struct HarbolTuple *tuple, size_t index);
 HARBOL_EXPORT bool harbol_tuple_is_packed(const struct HarbolTuple *tuple);
 HARBOL_EXPORT bool harbol_tuple_to_struct(const struct HarbolTuple *tuple, void *struc);
+
+
+/* a schema is a tuple layout computed once and shared, read-only, by any number of instances.
+ * an instance is just the schema pointer and the tuple's data, in one allocation.
+ * '_init' keeps the classic tuple layout; '_init_layout' uses natural or explicit alignments and can reorder fields to cut padding.
+ */
+typedef enum HarbolTupleLayoutFlags {
+	HarbolTuplePacked=1,   /* no padding at all. */
+	HarbolTupleOptimize=2, /* place fields by descending alignment; indexes don't change. */
+} HarbolTupleLayoutFlags;
+
+typedef struct HarbolTupleField {
+	uint32_t Offset, Size, Align;
+} HarbolTupleField;
+
+typedef struct HarbolTupleSchema {
+	struct HarbolTupleField *Fields; /* in index order, whatever order the offsets are in. */
+	size_t Count, Len, Align; /* 'Len' is the size of one instance's data. */
+	bool Packed : 1;
+} HarbolTupleSchema;
+
+typedef struct HarbolTupleInst {
+	const struct HarbolTupleSchema *Schema;
+	alignas(max_align_t) uint8_t Datum[];
+} HarbolTupleInst;
+
+HARBOL_EXPORT struct HarbolTupleSchema *harbol_tuple_schema_new(size_t member_count, const size_t sizes[], bool packed);
+HARBOL_EXPORT bool harbol_tuple_schema_init(struct HarbolTupleSchema *schema, size_t member_count, const size_t sizes[], bool packed);
+HARBOL_EXPORT struct HarbolTupleSchema *harbol_tuple_schema_new_layout(size_t member_count, const size_t sizes[], const size_t aligns[], int flags);
+HARBOL_EXPORT bool harbol_tuple_schema_init_layout(struct HarbolTupleSchema *schema, size_t member_count, const size_t sizes[], const size_t aligns[], int flags);
+HARBOL_EXPORT void harbol_tuple_schema_del(struct HarbolTupleSchema *schema);
+HARBOL_EXPORT bool harbol_tuple_schema_free(struct HarbolTupleSchema **schemaref);
+HARBOL_EXPORT size_t harbol_tuple_schema_get_len(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT size_t harbol_tuple_schema_get_count(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT size_t harbol_tuple_schema_get_field_offset(const struct HarbolTupleSchema *schema, size_t index);
+HARBOL_EXPORT size_t harbol_tuple_schema_get_field_size(const struct HarbolTupleSchema *schema, size_t index);
+HARBOL_EXPORT size_t harbol_tuple_schema_get_align(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT size_t harbol_tuple_schema_get_padding(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT struct HarbolTuple *harbol_tuple_new_from_schema(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT bool harbol_tuple_init_from_schema(struct HarbolTuple *tuple, const struct HarbolTupleSchema *schema);
+
+HARBOL_EXPORT struct HarbolTupleInst *harbol_tuple_inst_new(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT bool harbol_tuple_inst_free(struct HarbolTupleInst **instref);
+HARBOL_EXPORT size_t harbol_tuple_inst_get_len(const struct HarbolTupleInst *inst);
+HARBOL_EXPORT void *harbol_tuple_inst_get_field(struct HarbolTupleInst *inst, size_t index);
+HARBOL_EXPORT void *harbol_tuple_inst_set_field(struct HarbolTupleInst *inst, size_t index, const void *value);
+HARBOL_EXPORT size_t harbol_tuple_inst_get_field_size(const struct HarbolTupleInst *inst, size_t index);
+HARBOL_EXPORT bool harbol_tuple_inst_to_struct(const struct HarbolTupleInst *inst, void *struc);
+
+/* N rows of one schema stored back to back, which can be written out in one piece
+ * and read back as a view that points into the serialized bytes (a received or mapped buffer) instead of copying them.
+ */
+typedef struct HarbolTupleArray {
+	struct HarbolTupleSchema OwnSchema; /* filled in by '_view'. */
+	const struct HarbolTupleSchema *Schema;
+	uint8_t *Rows;
+	size_t Count, Cap;
+	bool View : 1; /* 'Rows' belongs to someone else and is read-only. */
+} HarbolTupleArray;
+
+HARBOL_EXPORT struct HarbolTupleArray *harbol_tuple_array_new(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT bool harbol_tuple_array_init(struct HarbolTupleArray *arr, const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT void harbol_tuple_array_del(struct HarbolTupleArray *arr);
+HARBOL_EXPORT bool harbol_tuple_array_free(struct HarbolTupleArray **arrref);
+HARBOL_EXPORT size_t harbol_tuple_array_get_count(const struct HarbolTupleArray *arr);
+HARBOL_EXPORT bool harbol_tuple_array_is_view(const struct HarbolTupleArray *arr);
+HARBOL_EXPORT bool harbol_tuple_array_reserve(struct HarbolTupleArray *arr, size_t count);
+HARBOL_EXPORT void *harbol_tuple_array_append(struct HarbolTupleArray *arr, const void *datum);
+HARBOL_EXPORT void *harbol_tuple_array_get_row(const struct HarbolTupleArray *arr, size_t row);
+HARBOL_EXPORT void *harbol_tuple_array_get_field(const struct HarbolTupleArray *arr, size_t row, size_t index);
+HARBOL_EXPORT void *harbol_tuple_array_set_field(struct HarbolTupleArray *arr, size_t row, size_t index, const void *value);
+HARBOL_EXPORT bool harbol_tuple_array_serialize(const struct HarbolTupleArray *arr, struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_tuple_array_view(struct HarbolTupleArray *arr, const void *data, size_t len, size_t *used);
+HARBOL_EXPORT bool harbol_tuple_array_view_bytebuffer(struct HarbolTupleArray *arr, const struct HarbolByteBuffer *buf);
+/***************/
+
+
+/************* Columnar Table (coltable.c) *************/
+/* a struct-of-arrays record store: one contiguous array per field of a tuple schema,
+ * so scanning a field reads only that field. rows go in and come back out in the schema's layout.
+ * filters produce selection lists of row numbers, which later filters can narrow and sums can read.
+ */
+typedef enum HarbolColType {
+	HarbolColI8=0, HarbolColI16, HarbolColI32, HarbolColI64,
+	HarbolColU8, HarbolColU16, HarbolColU32, HarbolColU64,
+	HarbolColF32, HarbolColF64,
+} HarbolColType;
+
+typedef enum HarbolColOp {
+	HarbolColLT=0, HarbolColLE, HarbolColEQ, HarbolColNE, HarbolColGE, HarbolColGT,
+} HarbolColOp;
+
+typedef struct HarbolColTable {
+	const struct HarbolTupleSchema *Schema;
+	uint8_t **Columns;
+	size_t Rows, Cap;
+} HarbolColTable;
+
+HARBOL_EXPORT struct HarbolColTable *harbol_coltable_new(const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT bool harbol_coltable_init(struct HarbolColTable *table, const struct HarbolTupleSchema *schema);
+HARBOL_EXPORT void harbol_coltable_del(struct HarbolColTable *table);
+HARBOL_EXPORT void harbol_coltable_free(struct HarbolColTable **tableref);
+HARBOL_EXPORT size_t harbol_coltable_get_rows(const struct HarbolColTable *table);
+HARBOL_EXPORT bool harbol_coltable_reserve(struct HarbolColTable *table, size_t rows);
+
+HARBOL_EXPORT bool harbol_coltable_append_row(struct HarbolColTable *table, const void *datum);
+HARBOL_EXPORT bool harbol_coltable_append_inst(struct HarbolColTable *table, const struct HarbolTupleInst *inst);
+HARBOL_EXPORT bool harbol_coltable_append_tuple(struct HarbolColTable *table, const struct HarbolTuple *tup);
+
+HARBOL_EXPORT void *harbol_coltable_get_column(const struct HarbolColTable *table, size_t col);
+HARBOL_EXPORT void *harbol_coltable_get_cell(const struct HarbolColTable *table, size_t row, size_t col);
+HARBOL_EXPORT bool harbol_coltable_get_row(const struct HarbolColTable *table, size_t row, void *datum);
+HARBOL_EXPORT bool harbol_coltable_row_to_inst(const struct HarbolColTable *table, size_t row, struct HarbolTupleInst *inst);
+HARBOL_EXPORT bool harbol_coltable_row_to_tuple(const struct HarbolColTable *table, size_t row, struct HarbolTuple *tup);
+
+HARBOL_EXPORT size_t harbol_coltable_filter(const struct HarbolColTable *table, size_t col, enum HarbolColType type, enum HarbolColOp op, const void *value, uint32_t rows[]);
+HARBOL_EXPORT size_t harbol_coltable_filter_refine(const struct HarbolColTable *table, size_t col, enum HarbolColType type, enum HarbolColOp op, const void *value, uint32_t rows[], size_t count);
+HARBOL_EXPORT bool harbol_coltable_sum(const struct HarbolColTable *table, size_t col, enum HarbolColType type, const uint32_t rows[], size_t count, void *result);
 /***************/
 
 
@@ -768,10 +1345,188 @@ HARBOL_EXPORT size_t harbol_tree_get_children_count(const struct HarbolTree *tre
 /***************/
 
 
+/************* Intrusive Lists and Tree (intrusive.c) *************/
+/* link structs meant to be embedded inside the caller's own structs, so linking never allocates.
+ * The containers don't own anything; 'harbol_container_of' turns a link back into its object.
+ * Removal is O(1) everywhere except 'harbol_iunilist_remove', which has to find the predecessor.
+ */
+#define harbol_container_of(ptr, type, member)    ((type *)((uint8_t *)(ptr) - offsetof(type, member)))
+
+typedef struct HarbolIUniLink {
+	struct HarbolIUniLink *Next;
+} HarbolIUniLink;
+
+typedef struct HarbolIUniList {
+	struct HarbolIUniLink *Head, *Tail;
+	size_t Len;
+} HarbolIUniList;
+
+HARBOL_EXPORT void harbol_iunilist_init(struct HarbolIUniList *list);
+HARBOL_EXPORT size_t harbol_iunilist_get_len(const struct HarbolIUniList *list);
+HARBOL_EXPORT bool harbol_iunilist_push_head(struct HarbolIUniList *list, struct HarbolIUniLink *link);
+HARBOL_EXPORT bool harbol_iunilist_push_tail(struct HarbolIUniList *list, struct HarbolIUniLink *link);
+HARBOL_EXPORT bool harbol_iunilist_insert_after(struct HarbolIUniList *list, struct HarbolIUniLink *pos, struct HarbolIUniLink *link);
+HARBOL_EXPORT struct HarbolIUniLink *harbol_iunilist_remove_after(struct HarbolIUniList *list, struct HarbolIUniLink *pos);
+HARBOL_EXPORT struct HarbolIUniLink *harbol_iunilist_pop_head(struct HarbolIUniList *list);
+HARBOL_EXPORT bool harbol_iunilist_remove(struct HarbolIUniList *list, struct HarbolIUniLink *link);
+
+
+typedef struct HarbolIBiLink {
+	struct HarbolIBiLink *Next, *Prev;
+} HarbolIBiLink;
+
+typedef struct HarbolIBiList {
+	struct HarbolIBiLink *Head, *Tail;
+	size_t Len;
+} HarbolIBiList;
+
+HARBOL_EXPORT void harbol_ibilist_init(struct HarbolIBiList *list);
+HARBOL_EXPORT size_t harbol_ibilist_get_len(const struct HarbolIBiList *list);
+HARBOL_EXPORT bool harbol_ibilist_push_head(struct HarbolIBiList *list, struct HarbolIBiLink *link);
+HARBOL_EXPORT bool harbol_ibilist_push_tail(struct HarbolIBiList *list, struct HarbolIBiLink *link);
+HARBOL_EXPORT bool harbol_ibilist_insert_before(struct HarbolIBiList *list, struct HarbolIBiLink *pos, struct HarbolIBiLink *link);
+HARBOL_EXPORT bool harbol_ibilist_insert_after(struct HarbolIBiList *list, struct HarbolIBiLink *pos, struct HarbolIBiLink *link);
+HARBOL_EXPORT bool harbol_ibilist_remove(struct HarbolIBiList *list, struct HarbolIBiLink *link);
+HARBOL_EXPORT struct HarbolIBiLink *harbol_ibilist_pop_head(struct HarbolIBiList *list);
+HARBOL_EXPORT struct HarbolIBiLink *harbol_ibilist_pop_tail(struct HarbolIBiList *list);
+
+
+/* every node is its own subtree root; there's no separate tree object. */
+typedef struct HarbolITree {
+	struct HarbolITree *Parent, *FirstChild, *LastChild, *PrevSibling, *NextSibling;
+	size_t ChildCount;
+} HarbolITree;
+
+HARBOL_EXPORT void harbol_itree_init(struct HarbolITree *node);
+HARBOL_EXPORT size_t harbol_itree_get_children_count(const struct HarbolITree *node);
+HARBOL_EXPORT bool harbol_itree_insert_child_before(struct HarbolITree *parent, struct HarbolITree *pos, struct HarbolITree *child);
+HARBOL_EXPORT bool harbol_itree_append_child(struct HarbolITree *parent, struct HarbolITree *child);
+HARBOL_EXPORT bool harbol_itree_prepend_child(struct HarbolITree *parent, struct HarbolITree *child);
+HARBOL_EXPORT bool harbol_itree_unlink(struct HarbolITree *node);
+HARBOL_EXPORT struct HarbolITree *harbol_itree_next_preorder(const struct HarbolITree *node, const struct HarbolITree *root);
+HARBOL_EXPORT size_t harbol_itree_get_depth(const struct HarbolITree *node);
+/***************/
+
+/************* Scatter-Gather Buffer Chain (bufchain.c) *************/
+/* a byte stream made of segments that are never copied to build it:
+ * byte buffers are adopted whole, and borrowed regions are released through their callback once nothing refers to them.
+ * splitting inside a segment shares it between both chains.
+ * on POSIX, '_writev' flushes it with one writev per IOV_MAX segments and '_readv' fills pre-sized segments.
+ */
+typedef void fnHarbolBufRelease(void *ctx, void *data, size_t len);
+
+typedef struct HarbolBufBacking {
+	size_t Refs;
+	fnHarbolBufRelease *Release; /* NULL means nothing to release. */
+	void *Ctx, *Mem;
+	size_t MemLen;
+} HarbolBufBacking;
+
+typedef struct HarbolBufSegment {
+	struct HarbolIBiLink Link;
+	struct HarbolBufBacking *Backing;
+	uint8_t *Data;
+	size_t Len, Cap; /* 'Cap' past 'Len' is room for '_readv'. */
+} HarbolBufSegment;
+
+typedef struct HarbolBufChain {
+	struct HarbolIBiList Segments;
+	size_t Len;
+} HarbolBufChain;
+
+HARBOL_EXPORT struct HarbolBufChain *harbol_bufchain_new(void);
+HARBOL_EXPORT void harbol_bufchain_init(struct HarbolBufChain *chain);
+HARBOL_EXPORT void harbol_bufchain_del(struct HarbolBufChain *chain);
+HARBOL_EXPORT void harbol_bufchain_free(struct HarbolBufChain **chainref);
+HARBOL_EXPORT size_t harbol_bufchain_get_len(const struct HarbolBufChain *chain);
+HARBOL_EXPORT size_t harbol_bufchain_get_segment_count(const struct HarbolBufChain *chain);
+HARBOL_EXPORT struct HarbolBufSegment *harbol_bufchain_get_head_segment(const struct HarbolBufChain *chain);
+HARBOL_EXPORT struct HarbolBufSegment *harbol_bufchain_get_next_segment(const struct HarbolBufSegment *seg);
+
+HARBOL_EXPORT bool harbol_bufchain_append_buffer(struct HarbolBufChain *chain, struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_bufchain_prepend_buffer(struct HarbolBufChain *chain, struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_bufchain_append_region(struct HarbolBufChain *chain, const void *data, size_t len, fnHarbolBufRelease *release, void *ctx);
+HARBOL_EXPORT bool harbol_bufchain_prepend_region(struct HarbolBufChain *chain, const void *data, size_t len, fnHarbolBufRelease *release, void *ctx);
+HARBOL_EXPORT bool harbol_bufchain_append_space(struct HarbolBufChain *chain, size_t cap);
+HARBOL_EXPORT bool harbol_bufchain_append_chain(struct HarbolBufChain *dst, struct HarbolBufChain *src);
+HARBOL_EXPORT bool harbol_bufchain_split(struct HarbolBufChain *chain, size_t offset, struct HarbolBufChain *tail);
+HARBOL_EXPORT size_t harbol_bufchain_consume(struct HarbolBufChain *chain, size_t amount);
+HARBOL_EXPORT bool harbol_bufchain_to_bytebuffer(const struct HarbolBufChain *chain, struct HarbolByteBuffer *buf);
+
+#ifndef OS_WINDOWS
+HARBOL_EXPORT bool harbol_bufchain_writev(struct HarbolBufChain *chain, int fd, size_t *written);
+HARBOL_EXPORT bool harbol_bufchain_readv(struct HarbolBufChain *chain, int fd, size_t *got);
+#endif
+/***************/
+
+
+/************* Asynchronous File Writer (filewriter.c) *************/
+/* byte buffers handed to the writer become its own and are written, in order, by a dedicated I/O thread
+ * with one pwritev per batch of queued buffers. submitting waits (or fails) while 'MaxQueued' bytes are queued,
+ * flushing waits for everything submitted so far, and a barrier makes everything before it durable before anything after it is written.
+ * the callback runs on the I/O thread for each buffer once it's written or has failed.
+ * POSIX only; the fd must be seekable.
+ */
+#ifndef OS_WINDOWS
+#	ifndef HARBOL_FILEWRITER_MAX_QUEUED
+#		define HARBOL_FILEWRITER_MAX_QUEUED    (64u * 1024u * 1024u)
+#	endif
+
+typedef enum HarbolFileWriterFlags {
+	HarbolFileWriterSync=1,   /* fdatasync after every batch. */
+	HarbolFileWriterAppend=2, /* '_open' keeps what the file has and writes after it. */
+} HarbolFileWriterFlags;
+
+/* 'err' is 0 or the errno of the first failed write or sync; barriers report a 0 'len'. */
+typedef void fnHarbolFileWriterDone(void *ctx, uint64_t offset, size_t len, int err);
+
+typedef struct HarbolFileWriterReq {
+	struct HarbolFileWriterReq *Next;
+	struct HarbolByteBuffer Buf;
+	uint64_t Offset;
+	bool Barrier;
+} HarbolFileWriterReq;
+
+typedef struct HarbolFileWriter {
+	pthread_mutex_t Lock;
+	pthread_cond_t Wake, Room, Done;
+	pthread_t Thread;
+	struct HarbolFileWriterReq *Head, *Tail;
+	fnHarbolFileWriterDone *OnDone;
+	void *Ctx;
+	uint64_t Offset, Submitted, Completed;
+	size_t Queued, MaxQueued; /* bytes. */
+	int Fd, Flags, Err;
+	bool Stop, OwnsFd;
+} HarbolFileWriter;
+
+HARBOL_EXPORT struct HarbolFileWriter *harbol_filewriter_new(int fd, int flags, size_t max_queued, fnHarbolFileWriterDone *on_done, void *ctx);
+HARBOL_EXPORT bool harbol_filewriter_init(struct HarbolFileWriter *fw, int fd, int flags, size_t max_queued, fnHarbolFileWriterDone *on_done, void *ctx);
+HARBOL_EXPORT bool harbol_filewriter_open(struct HarbolFileWriter *fw, const char filename[], int flags, size_t max_queued, fnHarbolFileWriterDone *on_done, void *ctx);
+HARBOL_EXPORT void harbol_filewriter_del(struct HarbolFileWriter *fw);
+HARBOL_EXPORT void harbol_filewriter_free(struct HarbolFileWriter **fwref);
+
+HARBOL_EXPORT bool harbol_filewriter_submit(struct HarbolFileWriter *fw, struct HarbolByteBuffer *buf, bool block);
+HARBOL_EXPORT bool harbol_filewriter_barrier(struct HarbolFileWriter *fw);
+HARBOL_EXPORT bool harbol_filewriter_flush(struct HarbolFileWriter *fw, bool durable);
+HARBOL_EXPORT int harbol_filewriter_get_error(struct HarbolFileWriter *fw);
+HARBOL_EXPORT size_t harbol_filewriter_get_queued(struct HarbolFileWriter *fw);
+HARBOL_EXPORT uint64_t harbol_filewriter_get_offset(struct HarbolFileWriter *fw);
+#endif
+/***************/
+
+
 /************* Ordered String Key Hash Map (preserves insertion order) (linkmap.c) *************/
+/* deleting leaves a NULL tombstone in 'Order' so it stays O(1).
+ * Tombstones are compacted away once they're half of 'Order', when 'harbol_linkmap_compact' is called,
+ * or by the first index or iterator function called after a deletion in the middle.
+ * Those functions therefore take a mutable map, and the range they give out never holds tombstones.
+ * Only code reading 'Order' itself has to skip NULL entries.
+ */
 typedef struct HarbolLinkMap {
 	struct HarbolHashMap Map;
 	struct HarbolVector Order;
+	size_t Holes, Front; /* 'Front' is the first live slot of 'Order'. */
 } HarbolLinkMap;
 
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new(void);
@@ -781,28 +1536,33 @@ HARBOL_EXPORT void harbol_linkmap_free(struct HarbolLinkMap **linkmapref, fnHarb
 HARBOL_EXPORT size_t harbol_linkmap_get_count(const struct HarbolLinkMap *linkmap);
 HARBOL_EXPORT size_t harbol_linkmap_get_len(const struct HarbolLinkMap *linkmap);
 HARBOL_EXPORT bool harbol_linkmap_rehash(struct HarbolLinkMap *linkmap);
+HARBOL_EXPORT bool harbol_linkmap_reserve(struct HarbolLinkMap *linkmap, size_t count);
+HARBOL_EXPORT void harbol_linkmap_compact(struct HarbolLinkMap *linkmap);
+HARBOL_EXPORT bool harbol_linkmap_move_to_end(struct HarbolLinkMap *linkmap, const char key[]);
+HARBOL_EXPORT bool harbol_linkmap_move_node_to_end(struct HarbolLinkMap *linkmap, struct HarbolKeyValPair *kv);
 
 HARBOL_EXPORT bool harbol_linkmap_insert(struct HarbolLinkMap *linkmap, const char key[], union HarbolValue val);
 HARBOL_EXPORT bool harbol_linkmap_insert_node(struct HarbolLinkMap *linkmap, struct HarbolKeyValPair *kv);
 
-HARBOL_EXPORT struct HarbolKeyValPair *harbol_linkmap_get_node_by_index(const struct HarbolLinkMap *linkmap, size_t index);
+HARBOL_EXPORT struct HarbolKeyValPair *harbol_linkmap_get_node_by_index(struct HarbolLinkMap *linkmap, size_t index);
 HARBOL_EXPORT union HarbolValue harbol_linkmap_get(const struct HarbolLinkMap *linkmap, const char key[]);
 HARBOL_EXPORT void harbol_linkmap_set(struct HarbolLinkMap *linkmap, const char key[], union HarbolValue val);
-HARBOL_EXPORT union HarbolValue harbol_linkmap_get_by_index(const struct HarbolLinkMap *linkmap, size_t index);
+HARBOL_EXPORT union HarbolValue harbol_linkmap_get_by_index(struct HarbolLinkMap *linkmap, size_t index);
 HARBOL_EXPORT void harbol_linkmap_set_by_index(struct HarbolLinkMap *linkmap, size_t index, union HarbolValue val);
 
 HARBOL_EXPORT void harbol_linkmap_delete(struct HarbolLinkMap *linkmap, const char key[], fnHarbolDestructor *dtor);
 HARBOL_EXPORT void harbol_linkmap_delete_by_index(struct HarbolLinkMap *linkmap, size_t, fnHarbolDestructor *dtor);
 HARBOL_EXPORT bool harbol_linkmap_has_key(const struct HarbolLinkMap *, const char key[]);
 HARBOL_EXPORT struct HarbolKeyValPair *harbol_linkmap_get_node_by_key(const struct HarbolLinkMap *linkmap, const char key[]);
-HARBOL_EXPORT struct HarbolVector *harbol_linkmap_get_buckets(const struct HarbolLinkMap *linkmap);
+HARBOL_EXPORT struct HarbolVector *harbol_linkmap_get_buckets(const struct HarbolLinkMap *linkmap); /* see 'harbol_hashmap_get_buckets'. */
+HARBOL_EXPORT bool harbol_linkmap_get_stats(const struct HarbolLinkMap *linkmap, struct HarbolHashMapStats *stats);
 
-HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter(const struct HarbolLinkMap *linkmap);
-HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_len(const struct HarbolLinkMap *linkmap);
-HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_count(const struct HarbolLinkMap *linkmap);
+HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter(struct HarbolLinkMap *linkmap);
+HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_len(struct HarbolLinkMap *linkmap);
+HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_count(struct HarbolLinkMap *linkmap);
 
-HARBOL_EXPORT size_t harbol_linkmap_get_index_by_name(const struct HarbolLinkMap *linkmap, const char key[]);
-HARBOL_EXPORT size_t harbol_linkmap_get_index_by_node(const struct HarbolLinkMap *linkmap, struct HarbolKeyValPair *kv);
+HARBOL_EXPORT size_t harbol_linkmap_get_index_by_name(struct HarbolLinkMap *linkmap, const char key[]);
+HARBOL_EXPORT size_t harbol_linkmap_get_index_by_node(struct HarbolLinkMap *linkmap, struct HarbolKeyValPair *kv);
 HARBOL_EXPORT size_t harbol_linkmap_get_index_by_val(const struct HarbolLinkMap *linkmap, union HarbolValue val);
 
 HARBOL_EXPORT void harbol_linkmap_from_hashmap(struct HarbolLinkMap *linkmap, const struct HarbolHashMap *map);
@@ -810,12 +1570,176 @@ HARBOL_EXPORT void harbol_linkmap_from_unilist(struct HarbolLinkMap *linkmap, co
 HARBOL_EXPORT void harbol_linkmap_from_bilist(struct HarbolLinkMap *linkmap, const struct HarbolBiList *list);
 HARBOL_EXPORT void harbol_linkmap_from_vector(struct HarbolLinkMap *linkmap, const struct HarbolVector *vec);
 HARBOL_EXPORT void harbol_linkmap_from_graph(struct HarbolLinkMap *linkmap, const struct HarbolGraph *graph);
+HARBOL_EXPORT void harbol_linkmap_from_bptree(struct HarbolLinkMap *linkmap, const struct HarbolBPTree *tree);
 
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_hashmap(const struct HarbolHashMap *map);
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_unilist(const struct HarbolUniList *list);
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_bilist(const struct HarbolBiList *list);
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_vector(const struct HarbolVector *vec);
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_graph(const struct HarbolGraph *graph);
+HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_bptree(const struct HarbolBPTree *tree);
+/***************/
+
+
+/************* Frozen Perfect-Hash Map (frozenmap.c) *************/
+/* an immutable snapshot of a hashmap or linkmap built around a minimal perfect hash.
+ * A lookup is one hash, one probe and one key comparison.
+ * Values are stored as-is, so pointer values only survive serialization within the same process.
+ * The serialized format uses native byte order.
+ */
+typedef struct HarbolFrozenSlot {
+	union HarbolValue Data;
+	uint32_t KeyOffset, KeyLen; /* where the slot's key sits in the key arena. */
+} HarbolFrozenSlot;
+
+typedef struct HarbolFrozenMap {
+	uint8_t *Block; /* single allocation backing every array below. */
+	struct HarbolFrozenSlot *Slots;
+	int32_t *Seeds; /* one per bucket; negative values are a direct slot. */
+	char *Keys; /* NUL-terminated keys packed back-to-back in slot order. */
+	size_t Count, Buckets, ArenaSize;
+	uint64_t Salt;
+} HarbolFrozenMap;
+
+HARBOL_EXPORT struct HarbolFrozenMap *harbol_frozenmap_new_from_hashmap(const struct HarbolHashMap *map);
+HARBOL_EXPORT struct HarbolFrozenMap *harbol_frozenmap_new_from_linkmap(const struct HarbolLinkMap *map);
+HARBOL_EXPORT struct HarbolFrozenMap *harbol_frozenmap_new_from_bytebuffer(const struct HarbolByteBuffer *buf);
+HARBOL_EXPORT void harbol_frozenmap_del(struct HarbolFrozenMap *fm);
+HARBOL_EXPORT void harbol_frozenmap_free(struct HarbolFrozenMap **fmref);
+
+HARBOL_EXPORT bool harbol_frozenmap_from_hashmap(struct HarbolFrozenMap *fm, const struct HarbolHashMap *map);
+HARBOL_EXPORT bool harbol_frozenmap_from_linkmap(struct HarbolFrozenMap *fm, const struct HarbolLinkMap *map);
+
+HARBOL_EXPORT union HarbolValue harbol_frozenmap_get(const struct HarbolFrozenMap *fm, const char key[]);
+HARBOL_EXPORT bool harbol_frozenmap_has_key(const struct HarbolFrozenMap *fm, const char key[]);
+HARBOL_EXPORT size_t harbol_frozenmap_get_index(const struct HarbolFrozenMap *fm, const char key[]);
+HARBOL_EXPORT size_t harbol_frozenmap_get_count(const struct HarbolFrozenMap *fm);
+HARBOL_EXPORT const char *harbol_frozenmap_get_key_by_index(const struct HarbolFrozenMap *fm, size_t index);
+HARBOL_EXPORT union HarbolValue harbol_frozenmap_get_by_index(const struct HarbolFrozenMap *fm, size_t index);
+
+HARBOL_EXPORT bool harbol_frozenmap_to_bytebuffer(const struct HarbolFrozenMap *fm, struct HarbolByteBuffer *buf);
+HARBOL_EXPORT bool harbol_frozenmap_from_bytebuffer(struct HarbolFrozenMap *fm, const struct HarbolByteBuffer *buf);
+/***************/
+
+
+/************* Bounded String Key Cache (cache.c) *************/
+/* a capacity-bounded cache sitting on a linkmap, whose order is kept as the recency list.
+ * Every entry has a caller-given weight; puts evict until the total weight fits 'Capacity'.
+ * The cache owns its values: evicted, replaced, removed or rejected values go to 'OnEvict'.
+ * TinyLFU is LRU with a frequency sketch in front that turns away newcomers less popular than the victim.
+ */
+typedef enum HarbolCachePolicy {
+	HarbolCacheLRU=0, HarbolCacheCLOCK, HarbolCacheTinyLFU,
+} HarbolCachePolicy;
+
+typedef struct HarbolCacheEntry {
+	union HarbolValue Data;
+	size_t Weight;
+	bool Referenced; /* CLOCK's second-chance bit. */
+} HarbolCacheEntry;
+
+typedef struct HarbolCacheStats {
+	size_t Hits, Misses, Evictions, Rejections;
+} HarbolCacheStats;
+
+typedef struct HarbolCache {
+	struct HarbolLinkMap Map; /* values point at entries in 'Entries'. */
+	struct HarbolObjPool Entries;
+	fnHarbolDestructor *OnEvict;
+	struct HarbolKeyValPair *Hand; /* CLOCK hand. */
+	uint8_t *Sketch; /* TinyLFU count-min sketch, 4-bit counters. */
+	size_t SketchWidth, SketchSamples;
+	size_t Capacity, Weight;
+	struct HarbolCacheStats Stats;
+	enum HarbolCachePolicy Policy;
+} HarbolCache;
+
+HARBOL_EXPORT struct HarbolCache *harbol_cache_new(enum HarbolCachePolicy policy, size_t capacity, fnHarbolDestructor *on_evict);
+HARBOL_EXPORT bool harbol_cache_init(struct HarbolCache *cache, enum HarbolCachePolicy policy, size_t capacity, fnHarbolDestructor *on_evict);
+HARBOL_EXPORT void harbol_cache_del(struct HarbolCache *cache);
+HARBOL_EXPORT void harbol_cache_free(struct HarbolCache **cacheref);
+HARBOL_EXPORT void harbol_cache_clear(struct HarbolCache *cache);
+
+HARBOL_EXPORT bool harbol_cache_get(struct HarbolCache *cache, const char key[], union HarbolValue *val);
+HARBOL_EXPORT bool harbol_cache_peek(const struct HarbolCache *cache, const char key[], union HarbolValue *val);
+HARBOL_EXPORT bool harbol_cache_touch(struct HarbolCache *cache, const char key[]);
+HARBOL_EXPORT bool harbol_cache_put(struct HarbolCache *cache, const char key[], union HarbolValue val, size_t weight);
+HARBOL_EXPORT bool harbol_cache_remove(struct HarbolCache *cache, const char key[]);
+
+HARBOL_EXPORT void harbol_cache_set_capacity(struct HarbolCache *cache, size_t capacity);
+HARBOL_EXPORT size_t harbol_cache_get_count(const struct HarbolCache *cache);
+HARBOL_EXPORT size_t harbol_cache_get_weight(const struct HarbolCache *cache);
+HARBOL_EXPORT size_t harbol_cache_get_capacity(const struct HarbolCache *cache);
+HARBOL_EXPORT struct HarbolCacheStats harbol_cache_get_stats(const struct HarbolCache *cache);
+HARBOL_EXPORT void harbol_cache_reset_stats(struct HarbolCache *cache);
+/***************/
+
+
+/************* Sorted Ordered Map (B+Tree) (bptree.c) *************/
+/* keys are strings, 64-bit ints or doubles and are kept in sorted order.
+ * Nodes are cache-line aligned, and a node's count plus its keys fill exactly two cache lines.
+ * Values only live in the leaves, which are linked both ways for range iteration.
+ * String keys are copied; NaN isn't a valid double key.
+ */
+#define HARBOL_BPTREE_LINE    64
+#define HARBOL_BPTREE_ORDER    15 /* max keys per node. */
+
+typedef enum HarbolBPTreeKeyType {
+	HarbolBPKeyStr=0, HarbolBPKeyInt, HarbolBPKeyDouble,
+} HarbolBPTreeKeyType;
+
+typedef struct HarbolBPNode {
+	uint16_t Count;
+	bool Leaf;
+	union HarbolValue Keys[HARBOL_BPTREE_ORDER];
+	union {
+		union HarbolValue Vals[HARBOL_BPTREE_ORDER]; /* leaves. */
+		struct HarbolBPNode *Kids[HARBOL_BPTREE_ORDER + 1]; /* interior nodes. */
+	};
+	struct HarbolBPNode *Prev, *Next; /* sibling leaves. */
+} HarbolBPNode;
+
+typedef struct HarbolBPTree {
+	struct HarbolBPNode *Root, *First, *Last;
+	size_t Count, Height;
+	enum HarbolBPTreeKeyType KeyType;
+} HarbolBPTree;
+
+/* a position inside a leaf. Iterators are invalidated by any insert or delete. */
+typedef struct HarbolBPTreeIter {
+	struct HarbolBPNode *Leaf;
+	size_t Slot;
+} HarbolBPTreeIter;
+
+HARBOL_EXPORT struct HarbolBPTree *harbol_bptree_new(enum HarbolBPTreeKeyType type);
+HARBOL_EXPORT void harbol_bptree_init(struct HarbolBPTree *tree, enum HarbolBPTreeKeyType type);
+HARBOL_EXPORT void harbol_bptree_del(struct HarbolBPTree *tree, fnHarbolDestructor *dtor);
+HARBOL_EXPORT void harbol_bptree_free(struct HarbolBPTree **treeref, fnHarbolDestructor *dtor);
+HARBOL_EXPORT size_t harbol_bptree_get_count(const struct HarbolBPTree *tree);
+HARBOL_EXPORT size_t harbol_bptree_get_height(const struct HarbolBPTree *tree);
+
+HARBOL_EXPORT bool harbol_bptree_insert(struct HarbolBPTree *tree, union HarbolValue key, union HarbolValue val);
+HARBOL_EXPORT bool harbol_bptree_set(struct HarbolBPTree *tree, union HarbolValue key, union HarbolValue val);
+HARBOL_EXPORT union HarbolValue harbol_bptree_get(const struct HarbolBPTree *tree, union HarbolValue key);
+HARBOL_EXPORT bool harbol_bptree_has_key(const struct HarbolBPTree *tree, union HarbolValue key);
+HARBOL_EXPORT bool harbol_bptree_delete(struct HarbolBPTree *tree, union HarbolValue key, fnHarbolDestructor *dtor);
+HARBOL_EXPORT bool harbol_bptree_bulk_load(struct HarbolBPTree *tree, const union HarbolValue keys[], const union HarbolValue vals[], size_t count);
+
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_first(const struct HarbolBPTree *tree);
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_last(const struct HarbolBPTree *tree);
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_lower_bound(const struct HarbolBPTree *tree, union HarbolValue key);
+HARBOL_EXPORT struct HarbolBPTreeIter harbol_bptree_upper_bound(const struct HarbolBPTree *tree, union HarbolValue key);
+HARBOL_EXPORT bool harbol_bptree_iter_valid(const struct HarbolBPTreeIter *iter);
+HARBOL_EXPORT bool harbol_bptree_iter_next(struct HarbolBPTreeIter *iter);
+HARBOL_EXPORT bool harbol_bptree_iter_prev(struct HarbolBPTreeIter *iter);
+HARBOL_EXPORT union HarbolValue harbol_bptree_iter_key(const struct HarbolBPTreeIter *iter);
+HARBOL_EXPORT union HarbolValue harbol_bptree_iter_val(const struct HarbolBPTreeIter *iter);
+
+HARBOL_EXPORT void harbol_bptree_from_linkmap(struct HarbolBPTree *tree, const struct HarbolLinkMap *map);
+HARBOL_EXPORT void harbol_bptree_from_vector(struct HarbolBPTree *tree, const struct HarbolVector *vec);
+
+HARBOL_EXPORT struct HarbolBPTree *harbol_bptree_new_from_linkmap(const struct HarbolLinkMap *map, enum HarbolBPTreeKeyType type);
+HARBOL_EXPORT struct HarbolBPTree *harbol_bptree_new_from_vector(const struct HarbolVector *vec, enum HarbolBPTreeKeyType type);
 /***************/
 
 
@@ -865,6 +1789,7 @@ typedef union HarbolVec4D {
 
 HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_from_file(const char filename[]);
 HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_parse_cstr(const char cstr[]);
+HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_parse_bytebuffer(const struct HarbolByteBuffer *buf);
 HARBOL_EXPORT bool harbol_cfg_free(struct HarbolLinkMap **cfgref);
 HARBOL_EXPORT bool harbol_cfg_to_str(const struct HarbolLinkMap *cfg, struct HarbolString *str);
 
@@ -932,7 +1857,7 @@ HARBOL_EXPORT bool harbol_plugin_manager_del(struct HarbolPluginManager *manager
 HARBOL_EXPORT bool harbol_plugin_manager_free(struct HarbolPluginManager **managerref, fnHarbolPluginEvent *unload_cb);
 
 HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_manager_get_plugin_by_name(const struct HarbolPluginManager *manager, const char plugin_name[]);
-HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_manager_get_plugin_by_index(const struct HarbolPluginManager *manager, size_t index);
+HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_manager_get_plugin_by_index(struct HarbolPluginManager *manager, size_t index);
 
 HARBOL_EXPORT size_t harbol_plugin_manager_get_plugin_count(const struct HarbolPluginManager *manager);
 HARBOL_EXPORT const char *harbol_plugin_manager_get_plugin_dir(const struct HarbolPluginManager *manager);
@@ -1,3 +1,6 @@
+#include <stddef.h>
+#include <stdatomic.h>
+
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
 #endif
@@ -10,12 +13,33 @@ HARBOL_EXPORT struct HarbolKeyValPair *harbol_kvpair_new(void)
 	return calloc(1, sizeof(struct HarbolKeyValPair));
 }
 
+static inline size_t _harbol_kvpair_size(const size_t keylen)
+{
+	return offsetof(struct HarbolKeyValPair, KeyBuf) + keylen + 1;
+}
+
+/* sets up the inline key of a node that was allocated with room for it. */
+static struct HarbolKeyValPair *_harbol_kvpair_init_inline(struct HarbolKeyValPair *const restrict n, const char cstr[restrict], const size_t keylen, const union HarbolValue val)
+{
+	memcpy(n->KeyBuf, cstr, keylen+1);
+	n->KeyName.CStr = n->KeyBuf;
+	n->KeyName.Len = keylen;
+	n->Data = val;
+	n->Hash = generic_hash(cstr);
+	return n;
+}
+
 HARBOL_EXPORT struct HarbolKeyValPair *harbol_kvpair_new_strval(const char cstr[restrict], const union HarbolValue val)
 {
-	struct HarbolKeyValPair *restrict n = harbol_kvpair_new();
+	if( !cstr )
+		return NULL;
+	
+	const size_t keylen = strlen(cstr);
+	struct HarbolKeyValPair *restrict n = malloc(_harbol_kvpair_size(keylen));
 	if( n ) {
-		harbol_string_init_cstr(&n->KeyName, cstr);
-		n->Data = val;
+		// the block can be smaller than the struct's padded size for short keys.
+		memset(n, 0, offsetof(struct HarbolKeyValPair, KeyBuf));
+		_harbol_kvpair_init_inline(n, cstr, keylen, val);
 	}
 	return n;
 }
@@ -25,7 +49,10 @@ HARBOL_EXPORT void harbol_kvpair_del(struct HarbolKeyValPair *const n, fnHarbolD
 	if( !n )
 		return;
 	
-	harbol_string_del(&n->KeyName);
+	// inline keys go away with the node itself.
+	if( n->KeyName.CStr != n->KeyBuf )
+		harbol_string_del(&n->KeyName);
+	else memset(&n->KeyName, 0, sizeof n->KeyName);
 	if( dtor )
 		(*dtor)(&n->Data.Ptr);
 }
@@ -51,7 +78,7 @@ HARBOL_EXPORT size_t generic_hash(const char cstr[restrict])
 	return h;
 }
 
-uint32_t int32_hash(uint32_t a)
+HARBOL_EXPORT uint32_t int32_hash(uint32_t a)
 {
 	a = (a+0x7ed55d16) + (a<<12);
 	a = (a^0xc761c23c) ^ (a>>19);
@@ -62,7 +89,7 @@ uint32_t int32_hash(uint32_t a)
 	return a;
 }
 
-uint64_t int64_hash(uint64_t a)
+HARBOL_EXPORT uint64_t int64_hash(uint64_t a)
 {
 	a = (~a) + (a << 21);
 	a = a ^ (a >> 24);
@@ -74,18 +101,18 @@ uint64_t int64_hash(uint64_t a)
 	return a;
 }
 
-size_t generic_int_hash(size_t a)
+HARBOL_EXPORT size_t generic_int_hash(size_t a)
 {
 	return sizeof(size_t)==4 ? int32_hash(a) : sizeof(size_t)==8 ? int64_hash(a) : 0;
 }
 
-size_t ptr_hash(const void *const p)
+HARBOL_EXPORT size_t ptr_hash(const void *const p)
 {
 	size_t y = (size_t)p;
 	return (y >> 4u) | (y << (8u * sizeof(void *) - 4u));
 }
 
-size_t float32_hash(const float fval)
+HARBOL_EXPORT size_t float32_hash(const float fval)
 {
 	union {
 		float f;
@@ -94,7 +121,7 @@ size_t float32_hash(const float fval)
 	return generic_int_hash(conv.s);
 }
 
-uint64_t float64_hash(const double dbl)
+HARBOL_EXPORT uint64_t float64_hash(const double dbl)
 {
 	union {
 		double d;
@@ -104,6 +131,17 @@ uint64_t float64_hash(const double dbl)
 }
 
 
+/* the counters pointer stays in the struct either way so the layout doesn't depend on the build flags. */
+#ifdef HARBOL_STATS
+struct HarbolHashMapCounters {
+	atomic_size_t Inserts, Deletes, Lookups, Probes;
+};
+#	define HARBOL_HASHMAP_COUNT_OP(map, op, n)    ( (map)->Counters ? (void)atomic_fetch_add_explicit(&(map)->Counters->op, (n), memory_order_relaxed) : (void)0 )
+#else
+#	define HARBOL_HASHMAP_COUNT_OP(map, op, n)    ((void)0)
+#endif
+
+
 HARBOL_EXPORT struct HarbolHashMap *harbol_hashmap_new(void)
 {
 	struct HarbolHashMap *map = calloc(1, sizeof *map);
@@ -118,20 +156,33 @@ HARBOL_EXPORT void harbol_hashmap_init(struct HarbolHashMap *const map)
 	memset(map, 0, sizeof *map);
 }
 
-HARBOL_EXPORT void harbol_hashmap_del(struct HarbolHashMap *const map, fnHarbolDestructor *const dtor)
+static void _harbol_hashmap_del_table(struct HarbolVector *const table, const size_t len, fnHarbolDestructor *const dtor)
 {
-	if( !map || !map->Table )
-		return;
-	
-	for( size_t i=0; i<map->Len; i++ ) {
-		const union HarbolValue *const end = harbol_vector_get_iter_end_len(map->Table+i);
-		for( union HarbolValue *iter=harbol_vector_get_iter(map->Table+i); iter && iter != end; iter++ ) {
+	for( size_t i=0; i<len; i++ ) {
+		const union HarbolValue *const end = harbol_vector_get_iter_end_count(table+i);
+		for( union HarbolValue *iter=harbol_vector_get_iter(table+i); iter && iter != end; iter++ ) {
 			struct HarbolKeyValPair *kv = iter->Ptr;
-			harbol_kvpair_free(&kv, dtor);
+			// pooled nodes are released all at once with their slabs.
+			if( kv->PoolClass )
+				harbol_kvpair_del(kv, dtor);
+			else harbol_kvpair_free(&kv, dtor);
 		}
-		harbol_vector_del(map->Table+i, NULL);
+		harbol_vector_del(table+i, NULL);
 	}
-	free(map->Table), map->Table=NULL;
+	free(table);
+}
+
+HARBOL_EXPORT void harbol_hashmap_del(struct HarbolHashMap *const map, fnHarbolDestructor *const dtor)
+{
+	if( !map )
+		return;
+	
+	_harbol_hashmap_del_table(map->Table, map->Len, dtor);
+	if( map->OldTable )
+		_harbol_hashmap_del_table(map->OldTable, map->OldLen, dtor);
+	for( size_t i=0; i<HARBOL_KVPAIR_POOL_CLASSES; i++ )
+		harbol_objpool_del(map->NodePools+i);
+	free(map->Counters);
 	memset(map, 0, sizeof *map);
 }
 
@@ -154,60 +205,213 @@ HARBOL_EXPORT size_t harbol_hashmap_get_len(const struct HarbolHashMap *const ma
 	return map ? map->Len : 0;
 }
 
+/* finds a node in a single table, optionally giving back the bucket and the node's index in it. */
+static struct HarbolKeyValPair *_harbol_hashmap_find_in(struct HarbolVector *const table, const size_t len, const char strkey[restrict], const size_t hash, struct HarbolVector **const bucketref, size_t *const indexref, size_t *const probesref)
+{
+	if( !table || !len )
+		return NULL;
+	
+	struct HarbolVector *const bucket = table + (hash % len);
+	for( size_t i=0; i<bucket->Count; i++ ) {
+		struct HarbolKeyValPair *const kv = bucket->Table[i].Ptr;
+		++*probesref;
+		if( kv->Hash==hash && !harbol_string_cmpcstr(&kv->KeyName, strkey) ) {
+			if( bucketref )
+				*bucketref = bucket;
+			if( indexref )
+				*indexref = i;
+			return kv;
+		}
+	}
+	return NULL;
+}
+
+/* looks through the new table first then whatever hasn't been migrated out of the old table yet. */
+static struct HarbolKeyValPair *_harbol_hashmap_find(const struct HarbolHashMap *const map, const char strkey[restrict], struct HarbolVector **const bucketref, size_t *const indexref)
+{
+	if( !map || !map->Table || !strkey )
+		return NULL;
+	
+	const size_t hash = generic_hash(strkey);
+	size_t probes = 0;
+	struct HarbolKeyValPair *kv = _harbol_hashmap_find_in(map->Table, map->Len, strkey, hash, bucketref, indexref, &probes);
+	if( !kv && map->OldTable && (hash % map->OldLen) >= map->MigrateIndex )
+		kv = _harbol_hashmap_find_in(map->OldTable, map->OldLen, strkey, hash, bucketref, indexref, &probes);
+	HARBOL_HASHMAP_COUNT_OP(map, Lookups, 1);
+	HARBOL_HASHMAP_COUNT_OP(map, Probes, probes);
+	return kv;
+}
+
+static inline bool _harbol_hashmap_bucket_insert(struct HarbolVector *const table, const size_t len, struct HarbolKeyValPair *const node)
+{
+	return harbol_vector_insert(table + (node->Hash % len), (union HarbolValue){.Ptr=node});
+}
+
+/* moves every node into a freshly allocated table of 'newlen' buckets in one go. */
+static bool _harbol_hashmap_resize(struct HarbolHashMap *const map, const size_t newlen)
+{
+	struct HarbolVector *const newtable = calloc(newlen, sizeof *newtable);
+	if( !newtable )
+		return false;
+	
+	harbol_hashmap_finish_rehash(map);
+	for( size_t i=0; i<map->Len; i++ ) {
+		struct HarbolVector *const bucket = map->Table+i;
+		for( size_t n=0; n<bucket->Count; n++ )
+			_harbol_hashmap_bucket_insert(newtable, newlen, bucket->Table[n].Ptr);
+		harbol_vector_del(bucket, NULL);
+	}
+	free(map->Table);
+	map->Table = newtable;
+	map->Len = newlen;
+	map->Rehashes++;
+	return true;
+}
+
 HARBOL_EXPORT bool harbol_hashmap_rehash(struct HarbolHashMap *const map)
 {
 	if( !map || !map->Table )
 		return false;
+	else if( !map->Incremental )
+		return _harbol_hashmap_resize(map, map->Len << 1);
+	
+	// can't have two migrations going at once, drain the current one.
+	harbol_hashmap_finish_rehash(map);
+	struct HarbolVector *const newtable = calloc(map->Len << 1, sizeof *newtable);
+	if( !newtable )
+		return false;
 	
-	const size_t old_size = map->Len;
+	map->OldTable = map->Table;
+	map->OldLen = map->Len;
+	map->MigrateIndex = 0;
+	map->Table = newtable;
 	map->Len <<= 1;
-	map->Count = 0;
-	
-	struct HarbolVector
-		*curr = NULL,
-		*temp = calloc(map->Len, sizeof *temp)
-	;
-	if( !temp ) {
-		//puts("**** Memory Allocation Error **** harbol_hashmap_rehash::temp is NULL\n");
-		map->Len = 0;
+	map->Rehashes++;
+	harbol_hashmap_rehash_step(map, HARBOL_HASHMAP_MIGRATE_STEP);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashmap_reserve(struct HarbolHashMap *const map, const size_t count)
+{
+	if( !map )
 		return false;
+	
+	size_t newlen = 8;
+	while( newlen < count )
+		newlen <<= 1;
+	
+	if( !map->Table ) {
+		map->Table = calloc(newlen, sizeof *map->Table);
+		if( !map->Table )
+			return false;
+		map->Len = newlen;
+		return true;
 	}
+	// bulk loads want the table sized upfront, so this never goes through the incremental path.
+	return newlen <= map->Len ? true : _harbol_hashmap_resize(map, newlen);
+}
+
+HARBOL_EXPORT void harbol_hashmap_set_incremental(struct HarbolHashMap *const map, const bool incremental)
+{
+	if( !map )
+		return;
 	
-	curr = map->Table;
-	map->Table = temp;
+	if( !incremental )
+		harbol_hashmap_finish_rehash(map);
+	map->Incremental = incremental;
+}
+
+HARBOL_EXPORT bool harbol_hashmap_is_rehashing(const struct HarbolHashMap *const map)
+{
+	return map && map->OldTable;
+}
+
+HARBOL_EXPORT bool harbol_hashmap_rehash_step(struct HarbolHashMap *const map, size_t buckets)
+{
+	if( !map || !map->OldTable )
+		return false;
 	
-	for( size_t i=0; i<old_size; i++ ) {
-		const union HarbolValue *const end = harbol_vector_get_iter_end_count(curr+i);
-		for( union HarbolValue *iter=harbol_vector_get_iter(curr+i); iter && iter != end; iter++ ) {
-			struct HarbolKeyValPair *node = iter->Ptr;
-			harbol_hashmap_insert_node(map, node);
+	while( buckets-- > 0 && map->OldTable ) {
+		struct HarbolVector *const bucket = map->OldTable + map->MigrateIndex;
+		for( size_t n=0; n<bucket->Count; n++ )
+			_harbol_hashmap_bucket_insert(map->Table, map->Len, bucket->Table[n].Ptr);
+		harbol_vector_del(bucket, NULL);
+		
+		if( ++map->MigrateIndex >= map->OldLen ) {
+			free(map->OldTable), map->OldTable=NULL;
+			map->OldLen = map->MigrateIndex = 0;
 		}
-		harbol_vector_del(curr+i, NULL);
 	}
-	free(curr), curr=NULL;
-	return true;
+	return map->OldTable != NULL;
+}
+
+HARBOL_EXPORT void harbol_hashmap_finish_rehash(struct HarbolHashMap *const map)
+{
+	if( !map || !map->OldTable )
+		return;
+	harbol_hashmap_rehash_step(map, map->OldLen - map->MigrateIndex);
+}
+
+HARBOL_EXPORT struct HarbolKeyValPair *harbol_hashmap_alloc_node(struct HarbolHashMap *const restrict map, const char strkey[restrict], const union HarbolValue val)
+{
+	if( !map || !strkey )
+		return NULL;
+	
+	const size_t keylen = strlen(strkey);
+	const size_t size_class = (_harbol_kvpair_size(keylen) + HARBOL_KVPAIR_POOL_STEP - 1) / HARBOL_KVPAIR_POOL_STEP;
+	// keys too long for the biggest slab get their own allocation.
+	if( size_class > HARBOL_KVPAIR_POOL_CLASSES )
+		return harbol_kvpair_new_strval(strkey, val);
+	
+	struct HarbolObjPool *const pool = map->NodePools + size_class - 1;
+	if( !harbol_objpool_get_obj_size(pool) )
+		harbol_objpool_init(pool, size_class * HARBOL_KVPAIR_POOL_STEP);
+	
+	struct HarbolKeyValPair *const restrict n = harbol_objpool_alloc(pool);
+	if( !n )
+		return NULL;
+	
+	n->PoolClass = size_class;
+	return _harbol_kvpair_init_inline(n, strkey, keylen, val);
+}
+
+HARBOL_EXPORT void harbol_hashmap_free_node(struct HarbolHashMap *const map, struct HarbolKeyValPair **const kvref, fnHarbolDestructor *const dtor)
+{
+	if( !map || !kvref || !*kvref )
+		return;
+	
+	struct HarbolKeyValPair *const kv = *kvref;
+	if( kv->PoolClass ) {
+		harbol_kvpair_del(kv, dtor);
+		harbol_objpool_dealloc(map->NodePools + kv->PoolClass - 1, kv);
+		*kvref = NULL;
+	}
+	else harbol_kvpair_free(kvref, dtor);
 }
 
 HARBOL_EXPORT bool harbol_hashmap_insert_node(struct HarbolHashMap *const map, struct HarbolKeyValPair *node)
 {
 	if( !map || !node || !node->KeyName.CStr )
 		return false;
-	else if( !map->Len ) {
-		map->Len = 8;
-		map->Table = calloc(map->Len, sizeof *map->Table);
-		if( !map->Table ) {
-			map->Len = 0;
-			return false;
-		}
-	}
+	else if( !map->Table && !harbol_hashmap_reserve(map, 8) )
+		return false;
+#ifdef HARBOL_STATS
+	// the counters are only made on a mutable path, lookups on a map nothing was inserted into find nothing anyway.
+	if( !map->Counters )
+		map->Counters = calloc(1, sizeof *map->Counters);
+#endif
+	
+	// the key might've been set after the node was made, so the cached hash can't be trusted here.
+	node->Hash = generic_hash(node->KeyName.CStr);
+	harbol_hashmap_rehash_step(map, HARBOL_HASHMAP_MIGRATE_STEP);
+	if( _harbol_hashmap_find(map, node->KeyName.CStr, NULL, NULL) )
+		return false;
 	else if( map->Count >= map->Len )
 		harbol_hashmap_rehash(map);
-	else if( harbol_hashmap_has_key(map, node->KeyName.CStr) )
-		return false;
 	
-	const size_t hash = generic_hash(node->KeyName.CStr) % map->Len;
-	harbol_vector_insert(map->Table + hash, (union HarbolValue){.Ptr=node});
+	_harbol_hashmap_bucket_insert(map->Table, map->Len, node);
 	++map->Count;
+	HARBOL_HASHMAP_COUNT_OP(map, Inserts, 1);
 	return true;
 }
 
@@ -216,93 +420,162 @@ HARBOL_EXPORT bool harbol_hashmap_insert(struct HarbolHashMap *const restrict ma
 	if( !map || !strkey )
 		return false;
 	
-	struct HarbolKeyValPair *node = harbol_kvpair_new_strval(strkey, val);
+	struct HarbolKeyValPair *node = harbol_hashmap_alloc_node(map, strkey, val);
 	bool b = harbol_hashmap_insert_node(map, node);
 	if( !b )
-		harbol_kvpair_free(&node, NULL);
+		harbol_hashmap_free_node(map, &node, NULL);
 	return b;
 }
 
 HARBOL_EXPORT union HarbolValue harbol_hashmap_get(const struct HarbolHashMap *const restrict map, const char strkey[restrict])
 {
-	if( !map || !map->Table || !harbol_hashmap_has_key(map, strkey) )
-		return (union HarbolValue){0};
-	
-	const size_t hash = generic_hash(strkey) % map->Len;
-	const union HarbolValue *const end = harbol_vector_get_iter_end_count(map->Table+hash);
-	for( union HarbolValue *iter=harbol_vector_get_iter(map->Table+hash); iter && iter != end; iter++ ) {
-		const struct HarbolKeyValPair *const restrict kv = iter->Ptr;
-		if( !harbol_string_cmpcstr(&kv->KeyName, strkey) )
-			return kv->Data;
-	}
-	return (union HarbolValue){0};
+	const struct HarbolKeyValPair *const restrict kv = _harbol_hashmap_find(map, strkey, NULL, NULL);
+	return kv ? kv->Data : (union HarbolValue){0};
 }
 
 HARBOL_EXPORT void harbol_hashmap_set(struct HarbolHashMap *const restrict map, const char strkey[restrict], const union HarbolValue val)
 {
-	if( !map || !harbol_hashmap_has_key(map, strkey) )
-		return;
-	
-	const size_t hash = generic_hash(strkey) % map->Len;
-	const union HarbolValue *const end = harbol_vector_get_iter_end_count(map->Table+hash);
-	for( union HarbolValue *iter=harbol_vector_get_iter(map->Table+hash); iter && iter != end; iter++ ) {
-		struct HarbolKeyValPair *const restrict kv = iter->Ptr;
-		if( !harbol_string_cmpcstr(&kv->KeyName, strkey) )
-			kv->Data = val;
-	}
+	struct HarbolKeyValPair *const restrict kv = _harbol_hashmap_find(map, strkey, NULL, NULL);
+	if( kv )
+		kv->Data = val;
 }
 
 HARBOL_EXPORT void harbol_hashmap_delete(struct HarbolHashMap *const restrict map, const char strkey[restrict], fnHarbolDestructor *const dtor)
 {
-	if( !map || !map->Table || !harbol_hashmap_has_key(map, strkey) )
+	if( !map || !map->Table )
 		return;
 	
-	const size_t hash = generic_hash(strkey) % map->Len;
-	struct HarbolVector *restrict vec = map->Table+hash;
-	for( size_t i=0; i<vec->Count; i++ ) {
-		struct HarbolKeyValPair *kv = vec->Table[i].Ptr;
-		if( !harbol_string_cmpcstr(&kv->KeyName, strkey) ) {
-			harbol_kvpair_del(kv, dtor);
-			harbol_vector_delete(vec, i, NULL);
-			map->Count--;
-			break;
-		}
-	}
+	harbol_hashmap_rehash_step(map, HARBOL_HASHMAP_MIGRATE_STEP);
+	struct HarbolVector *bucket = NULL;
+	size_t index = 0;
+	struct HarbolKeyValPair *kv = _harbol_hashmap_find(map, strkey, &bucket, &index);
+	if( !kv )
+		return;
+	
+	harbol_vector_delete(bucket, index, NULL);
+	harbol_hashmap_free_node(map, &kv, dtor);
+	map->Count--;
+	HARBOL_HASHMAP_COUNT_OP(map, Deletes, 1);
 }
 
 HARBOL_EXPORT bool harbol_hashmap_has_key(const struct HarbolHashMap *const restrict map, const char strkey[restrict])
 {
-	if( !map || !map->Table )
+	return _harbol_hashmap_find(map, strkey, NULL, NULL) != NULL;
+}
+
+HARBOL_EXPORT struct HarbolKeyValPair *harbol_hashmap_get_node(const struct HarbolHashMap *const restrict map, const char strkey[restrict])
+{
+	return _harbol_hashmap_find(map, strkey, NULL, NULL);
+}
+
+HARBOL_EXPORT struct HarbolVector *harbol_hashmap_get_buckets(const struct HarbolHashMap *const map)
+{
+	return map ? map->Table : NULL;
+}
+
+HARBOL_EXPORT size_t harbol_hashmap_get_bucket_count(const struct HarbolHashMap *const map)
+{
+	return map ? map->Len + map->OldLen : 0;
+}
+
+HARBOL_EXPORT struct HarbolVector *harbol_hashmap_get_bucket(const struct HarbolHashMap *const map, const size_t index)
+{
+	if( !map )
+		return NULL;
+	else if( index < map->Len )
+		return map->Table + index;
+	return ( index - map->Len < map->OldLen ) ? map->OldTable + (index - map->Len) : NULL;
+}
+
+HARBOL_EXPORT bool harbol_hashmap_get_stats(const struct HarbolHashMap *const restrict map, struct HarbolHashMapStats *const restrict stats)
+{
+	if( !map || !stats )
 		return false;
 	
-	const size_t hash = generic_hash(strkey) % map->Len;
-	const union HarbolValue *const end = harbol_vector_get_iter_end_count(map->Table+hash);
-	for( union HarbolValue *iter=harbol_vector_get_iter(map->Table+hash); iter && iter != end; iter++ ) {
-		const struct HarbolKeyValPair *const restrict kv = iter->Ptr;
-		if( !harbol_string_cmpcstr(&kv->KeyName, strkey) )
-			return true;
+	memset(stats, 0, sizeof *stats);
+	stats->Count = map->Count;
+	stats->Buckets = map->Len + map->OldLen;
+	stats->Rehashes = map->Rehashes;
+#ifdef HARBOL_STATS
+	if( map->Counters ) {
+		stats->Ops = (struct HarbolHashMapOps){
+			.Inserts = atomic_load_explicit(&map->Counters->Inserts, memory_order_relaxed),
+			.Deletes = atomic_load_explicit(&map->Counters->Deletes, memory_order_relaxed),
+			.Lookups = atomic_load_explicit(&map->Counters->Lookups, memory_order_relaxed),
+			.Probes = atomic_load_explicit(&map->Counters->Probes, memory_order_relaxed),
+		};
+		stats->TotalBytes += sizeof *map->Counters;
+	}
+#endif
+	stats->TableBytes = sizeof *map->Table * stats->Buckets;
+	
+	size_t probe_total = 0;
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		const struct HarbolVector *const vec = harbol_hashmap_get_bucket(map, i);
+		const size_t chain = vec->Count;
+		stats->TableBytes += sizeof *vec->Table * vec->Len;
+		stats->ChainHistogram[chain < HARBOL_HASHMAP_STATS_MAX_CHAIN ? chain : HARBOL_HASHMAP_STATS_MAX_CHAIN]++;
+		if( !chain )
+			continue;
+		
+		stats->UsedBuckets++;
+		if( chain > stats->MaxChainLen )
+			stats->MaxChainLen = chain;
+		// finding the n-th node of a chain compares n nodes.
+		probe_total += chain * (chain + 1) / 2;
+		for( size_t n=0; n<chain; n++ ) {
+			const struct HarbolKeyValPair *const kv = vec->Table[n].Ptr;
+			stats->KeyBytes += kv->KeyName.Len + 1;
+			if( kv->PoolClass )
+				continue;
+			else if( kv->KeyName.CStr==kv->KeyBuf )
+				stats->NodeBytes += offsetof(struct HarbolKeyValPair, KeyBuf) + kv->KeyName.Len + 1;
+			else stats->NodeBytes += sizeof *kv + kv->KeyName.Len + 1;
+		}
 	}
-	return false;
+	for( size_t i=0; i<HARBOL_KVPAIR_POOL_CLASSES; i++ )
+		stats->NodeBytes += harbol_objpool_get_total_bytes(map->NodePools+i);
+	
+	if( stats->Buckets )
+		stats->LoadFactor = (double)stats->Count / stats->Buckets;
+	if( stats->UsedBuckets )
+		stats->AvgChainLen = (double)stats->Count / stats->UsedBuckets;
+	if( stats->Count )
+		stats->AvgProbeLen = (double)probe_total / stats->Count;
+	stats->TotalBytes += sizeof *map + stats->TableBytes + stats->NodeBytes;
+	return true;
 }
 
-HARBOL_EXPORT struct HarbolKeyValPair *harbol_hashmap_get_node(const struct HarbolHashMap *const restrict map, const char strkey[restrict])
+HARBOL_EXPORT void harbol_hashmap_reset_ops(struct HarbolHashMap *const map)
 {
-	if( !map || !strkey || !map->Table )
-		return NULL;
+	if( !map )
+		return;
 	
-	const size_t hash = generic_hash(strkey) % map->Len;
-	const union HarbolValue *const end = harbol_vector_get_iter_end_count(map->Table+hash);
-	for( union HarbolValue *iter=harbol_vector_get_iter(map->Table+hash); iter && iter != end; iter++ ) {
-		struct HarbolKeyValPair *restrict kv = iter->Ptr;
-		if( !harbol_string_cmpcstr(&kv->KeyName, strkey) )
-			return kv;
+#ifdef HARBOL_STATS
+	if( map->Counters ) {
+		atomic_store_explicit(&map->Counters->Inserts, 0, memory_order_relaxed);
+		atomic_store_explicit(&map->Counters->Deletes, 0, memory_order_relaxed);
+		atomic_store_explicit(&map->Counters->Lookups, 0, memory_order_relaxed);
+		atomic_store_explicit(&map->Counters->Probes, 0, memory_order_relaxed);
 	}
-	return NULL;
+#endif
 }
 
-HARBOL_EXPORT struct HarbolVector *harbol_hashmap_get_buckets(const struct HarbolHashMap *const map)
+HARBOL_EXPORT void harbol_hashmap_stats_to_file(const struct HarbolHashMapStats *const restrict stats, FILE *const restrict file)
 {
-	return map ? map->Table : NULL;
+	if( !stats || !file )
+		return;
+	
+	fprintf(file, "count: %zu | buckets: %zu (%zu used) | load factor: %.3f | rehashes: %zu\n", stats->Count, stats->Buckets, stats->UsedBuckets, stats->LoadFactor, stats->Rehashes);
+	fprintf(file, "chain len avg: %.3f | max: %zu | avg probe len: %.3f\n", stats->AvgChainLen, stats->MaxChainLen, stats->AvgProbeLen);
+	fputs("chain histogram:", file);
+	for( size_t i=0; i<=HARBOL_HASHMAP_STATS_MAX_CHAIN; i++ )
+		fprintf(file, " [%zu%s]=%zu", i, i==HARBOL_HASHMAP_STATS_MAX_CHAIN ? "+" : "", stats->ChainHistogram[i]);
+	fputs("\n", file);
+	fprintf(file, "bytes - table: %zu | nodes: %zu | keys: %zu | total: %zu\n", stats->TableBytes, stats->NodeBytes, stats->KeyBytes, stats->TotalBytes);
+#ifdef HARBOL_STATS
+	fprintf(file, "ops - inserts: %zu | deletes: %zu | lookups: %zu | probes: %zu\n", stats->Ops.Inserts, stats->Ops.Deletes, stats->Ops.Lookups, stats->Ops.Probes);
+#endif
 }
 
 HARBOL_EXPORT void harbol_hashmap_from_unilist(struct HarbolHashMap *const map, const struct HarbolUniList *const list)
@@ -365,7 +638,8 @@ HARBOL_EXPORT void harbol_hashmap_from_linkmap(struct HarbolHashMap *const map,
 	
 	for( size_t i=0; i<linkmap->Order.Count; i++ ) {
 		struct HarbolKeyValPair *n = linkmap->Order.Table[i].Ptr;
-		harbol_hashmap_insert_node(map, harbol_kvpair_new_strval(n->KeyName.CStr, n->Data));
+		if( n )
+			harbol_hashmap_insert(map, n->KeyName.CStr, n->Data);
 	}
 }
 
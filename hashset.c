@@ -0,0 +1,318 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolHashSet {
+	struct HarbolHashSetSlot *Table;
+	size_t Len, Count;
+	enum HarbolHashSetKeyType KeyType;
+} HarbolHashSet;
+*/
+
+/* keys live directly in an open-addressed, linearly probed table. A slot with a zero hash is empty. */
+
+static inline size_t _harbol_hashset_hash(const enum HarbolHashSetKeyType type, const union HarbolValue key)
+{
+	size_t h = 0;
+	switch( type ) {
+		case HarbolSetKeyStr: h = generic_hash(key.Ptr); break;
+		case HarbolSetKeyInt: h = int64_hash(key.UInt64); break;
+		case HarbolSetKeyPtr: h = ptr_hash(key.Ptr); break;
+	}
+	return h ? h : 1;
+}
+
+static inline bool _harbol_hashset_key_eq(const enum HarbolHashSetKeyType type, const union HarbolValue a, const union HarbolValue b)
+{
+	return ( type==HarbolSetKeyStr ) ? !strcmp(a.Ptr, b.Ptr) : a.UInt64==b.UInt64;
+}
+
+HARBOL_EXPORT struct HarbolHashSet *harbol_hashset_new(const enum HarbolHashSetKeyType type)
+{
+	struct HarbolHashSet *set = calloc(1, sizeof *set);
+	harbol_hashset_init(set, type);
+	return set;
+}
+
+HARBOL_EXPORT void harbol_hashset_init(struct HarbolHashSet *const set, const enum HarbolHashSetKeyType type)
+{
+	if( !set )
+		return;
+	
+	memset(set, 0, sizeof *set);
+	set->KeyType = type;
+}
+
+HARBOL_EXPORT void harbol_hashset_del(struct HarbolHashSet *const set)
+{
+	if( !set )
+		return;
+	
+	harbol_hashset_clear(set);
+	free(set->Table);
+	harbol_hashset_init(set, set->KeyType);
+}
+
+HARBOL_EXPORT void harbol_hashset_free(struct HarbolHashSet **setref)
+{
+	if( !setref || !*setref )
+		return;
+	
+	harbol_hashset_del(*setref);
+	free(*setref), *setref=NULL;
+}
+
+HARBOL_EXPORT size_t harbol_hashset_get_count(const struct HarbolHashSet *const set)
+{
+	return set ? set->Count : 0;
+}
+
+HARBOL_EXPORT size_t harbol_hashset_get_len(const struct HarbolHashSet *const set)
+{
+	return set ? set->Len : 0;
+}
+
+/* gives back the key's slot, or the empty slot where it would go. */
+static size_t _harbol_hashset_probe(const struct HarbolHashSet *const set, const union HarbolValue key, const size_t hash)
+{
+	const size_t mask = set->Len - 1;
+	size_t i = hash & mask;
+	while( set->Table[i].Hash && (set->Table[i].Hash != hash || !_harbol_hashset_key_eq(set->KeyType, set->Table[i].Key, key)) )
+		i = (i + 1) & mask;
+	return i;
+}
+
+static bool _harbol_hashset_resize(struct HarbolHashSet *const set, const size_t newlen)
+{
+	struct HarbolHashSetSlot *const newtable = calloc(newlen, sizeof *newtable);
+	if( !newtable )
+		return false;
+	
+	for( size_t i=0; i<set->Len; i++ ) {
+		if( !set->Table[i].Hash )
+			continue;
+		size_t n = set->Table[i].Hash & (newlen - 1);
+		while( newtable[n].Hash )
+			n = (n + 1) & (newlen - 1);
+		newtable[n] = set->Table[i];
+	}
+	free(set->Table);
+	set->Table = newtable;
+	set->Len = newlen;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashset_reserve(struct HarbolHashSet *const set, const size_t count)
+{
+	if( !set )
+		return false;
+	
+	// linear probing falls apart past about 3/4 full.
+	size_t newlen = 8;
+	while( newlen / 4 * 3 < count )
+		newlen <<= 1;
+	return newlen <= set->Len ? true : _harbol_hashset_resize(set, newlen);
+}
+
+HARBOL_EXPORT bool harbol_hashset_insert(struct HarbolHashSet *const set, const union HarbolValue key)
+{
+	if( !set || (set->KeyType==HarbolSetKeyStr && !key.Ptr) )
+		return false;
+	else if( !harbol_hashset_reserve(set, set->Count + 1) )
+		return false;
+	
+	const size_t hash = _harbol_hashset_hash(set->KeyType, key);
+	const size_t i = _harbol_hashset_probe(set, key, hash);
+	if( set->Table[i].Hash )
+		return false;
+	
+	union HarbolValue stored = key;
+	if( set->KeyType==HarbolSetKeyStr ) {
+		const size_t len = strlen(key.Ptr);
+		stored.Ptr = malloc(len + 1);
+		if( !stored.Ptr )
+			return false;
+		memcpy(stored.Ptr, key.Ptr, len + 1);
+	}
+	set->Table[i] = (struct HarbolHashSetSlot){ .Key = stored, .Hash = hash };
+	set->Count++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashset_has(const struct HarbolHashSet *const set, const union HarbolValue key)
+{
+	if( !set || !set->Count || (set->KeyType==HarbolSetKeyStr && !key.Ptr) )
+		return false;
+	
+	return set->Table[_harbol_hashset_probe(set, key, _harbol_hashset_hash(set->KeyType, key))].Hash != 0;
+}
+
+HARBOL_EXPORT bool harbol_hashset_remove(struct HarbolHashSet *const set, const union HarbolValue key)
+{
+	if( !set || !set->Count || (set->KeyType==HarbolSetKeyStr && !key.Ptr) )
+		return false;
+	
+	size_t i = _harbol_hashset_probe(set, key, _harbol_hashset_hash(set->KeyType, key));
+	if( !set->Table[i].Hash )
+		return false;
+	
+	if( set->KeyType==HarbolSetKeyStr )
+		free(set->Table[i].Key.Ptr);
+	
+	// backward-shift the rest of the cluster so lookups never need tombstones.
+	const size_t mask = set->Len - 1;
+	for( size_t n = (i + 1) & mask; set->Table[n].Hash; n = (n + 1) & mask ) {
+		const size_t home = set->Table[n].Hash & mask;
+		const bool stays = ( i <= n ) ? (i < home && home <= n) : (i < home || home <= n);
+		if( stays )
+			continue;
+		set->Table[i] = set->Table[n];
+		i = n;
+	}
+	set->Table[i] = (struct HarbolHashSetSlot){0};
+	set->Count--;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashset_insert_cstr(struct HarbolHashSet *const restrict set, const char key[restrict])
+{
+	return harbol_hashset_insert(set, (union HarbolValue){.Ptr=(void *)key});
+}
+
+HARBOL_EXPORT bool harbol_hashset_has_cstr(const struct HarbolHashSet *const restrict set, const char key[restrict])
+{
+	return harbol_hashset_has(set, (union HarbolValue){.Ptr=(void *)key});
+}
+
+HARBOL_EXPORT bool harbol_hashset_remove_cstr(struct HarbolHashSet *const restrict set, const char key[restrict])
+{
+	return harbol_hashset_remove(set, (union HarbolValue){.Ptr=(void *)key});
+}
+
+HARBOL_EXPORT bool harbol_hashset_next(const struct HarbolHashSet *const restrict set, size_t *const restrict iter, union HarbolValue *const restrict key)
+{
+	if( !set || !iter )
+		return false;
+	
+	while( *iter < set->Len ) {
+		const struct HarbolHashSetSlot *const slot = set->Table + (*iter)++;
+		if( slot->Hash ) {
+			if( key )
+				*key = slot->Key;
+			return true;
+		}
+	}
+	return false;
+}
+
+HARBOL_EXPORT void harbol_hashset_clear(struct HarbolHashSet *const set)
+{
+	if( !set || !set->Table )
+		return;
+	
+	if( set->KeyType==HarbolSetKeyStr )
+		for( size_t i=0; i<set->Len; i++ )
+			if( set->Table[i].Hash )
+				free(set->Table[i].Key.Ptr);
+	memset(set->Table, 0, sizeof *set->Table * set->Len);
+	set->Count = 0;
+}
+
+static bool _harbol_hashset_copy_into(struct HarbolHashSet *const restrict dest, const struct HarbolHashSet *const restrict src)
+{
+	union HarbolValue key;
+	for( size_t iter=0; harbol_hashset_next(src, &iter, &key); )
+		if( !harbol_hashset_insert(dest, key) && !harbol_hashset_has(dest, key) )
+			return false;
+	return true;
+}
+
+/* the set algebra functions clear 'dest' first; it may not alias either operand. */
+static bool _harbol_hashset_prep_dest(struct HarbolHashSet *const dest, const struct HarbolHashSet *const a, const struct HarbolHashSet *const b)
+{
+	if( !dest || !a || !b || a->KeyType != b->KeyType || dest==a || dest==b )
+		return false;
+	
+	harbol_hashset_del(dest);
+	dest->KeyType = a->KeyType;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashset_union(struct HarbolHashSet *const dest, const struct HarbolHashSet *const a, const struct HarbolHashSet *const b)
+{
+	if( !_harbol_hashset_prep_dest(dest, a, b) )
+		return false;
+	
+	const struct HarbolHashSet *const larger = a->Count >= b->Count ? a : b;
+	const struct HarbolHashSet *const smaller = larger==a ? b : a;
+	harbol_hashset_reserve(dest, larger->Count + smaller->Count);
+	return _harbol_hashset_copy_into(dest, larger) && _harbol_hashset_copy_into(dest, smaller);
+}
+
+HARBOL_EXPORT bool harbol_hashset_intersection(struct HarbolHashSet *const dest, const struct HarbolHashSet *const a, const struct HarbolHashSet *const b)
+{
+	if( !_harbol_hashset_prep_dest(dest, a, b) )
+		return false;
+	
+	const struct HarbolHashSet *const smaller = a->Count <= b->Count ? a : b;
+	const struct HarbolHashSet *const larger = smaller==a ? b : a;
+	union HarbolValue key;
+	for( size_t iter=0; harbol_hashset_next(smaller, &iter, &key); )
+		if( harbol_hashset_has(larger, key) && !harbol_hashset_insert(dest, key) )
+			return false;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashset_difference(struct HarbolHashSet *const dest, const struct HarbolHashSet *const a, const struct HarbolHashSet *const b)
+{
+	if( !_harbol_hashset_prep_dest(dest, a, b) )
+		return false;
+	
+	union HarbolValue key;
+	if( a->Count <= b->Count ) {
+		for( size_t iter=0; harbol_hashset_next(a, &iter, &key); )
+			if( !harbol_hashset_has(b, key) && !harbol_hashset_insert(dest, key) )
+				return false;
+		return true;
+	}
+	// 'b' is the smaller one, so copy 'a' and knock out whatever 'b' has.
+	if( !_harbol_hashset_copy_into(dest, a) )
+		return false;
+	for( size_t iter=0; harbol_hashset_next(b, &iter, &key); )
+		harbol_hashset_remove(dest, key);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_hashset_is_subset(const struct HarbolHashSet *const a, const struct HarbolHashSet *const b)
+{
+	if( !a || !b || a->KeyType != b->KeyType || a->Count > b->Count )
+		return false;
+	
+	union HarbolValue key;
+	for( size_t iter=0; harbol_hashset_next(a, &iter, &key); )
+		if( !harbol_hashset_has(b, key) )
+			return false;
+	return true;
+}
+
+HARBOL_EXPORT void harbol_hashset_from_vector(struct HarbolHashSet *const restrict set, const struct HarbolVector *const restrict vec)
+{
+	if( !set || !vec )
+		return;
+	
+	harbol_hashset_reserve(set, set->Count + vec->Count);
+	for( size_t i=0; i<vec->Count; i++ )
+		harbol_hashset_insert(set, vec->Table[i]);
+}
+
+HARBOL_EXPORT struct HarbolHashSet *harbol_hashset_new_from_vector(const struct HarbolVector *const vec, const enum HarbolHashSetKeyType type)
+{
+	if( !vec )
+		return NULL;
+	struct HarbolHashSet *set = harbol_hashset_new(type);
+	harbol_hashset_from_vector(set, vec);
+	return set;
+}
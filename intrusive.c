@@ -0,0 +1,265 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolIBiLink {
+	struct HarbolIBiLink *Next, *Prev;
+} HarbolIBiLink;
+
+typedef struct HarbolITree {
+	struct HarbolITree *Parent, *FirstChild, *LastChild, *PrevSibling, *NextSibling;
+	size_t ChildCount;
+} HarbolITree;
+ */
+
+/* Intrusive Singly Linked List code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_iunilist_init(struct HarbolIUniList *const list)
+{
+	if( !list )
+		return;
+	
+	memset(list, 0, sizeof *list);
+}
+
+HARBOL_EXPORT size_t harbol_iunilist_get_len(const struct HarbolIUniList *const list)
+{
+	return list ? list->Len : 0;
+}
+
+HARBOL_EXPORT bool harbol_iunilist_push_head(struct HarbolIUniList *const restrict list, struct HarbolIUniLink *const restrict link)
+{
+	if( !list || !link )
+		return false;
+	
+	link->Next = list->Head;
+	list->Head = link;
+	if( !list->Tail )
+		list->Tail = link;
+	list->Len++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_iunilist_push_tail(struct HarbolIUniList *const restrict list, struct HarbolIUniLink *const restrict link)
+{
+	if( !list || !link )
+		return false;
+	
+	link->Next = NULL;
+	if( list->Tail )
+		list->Tail->Next = link;
+	else list->Head = link;
+	list->Tail = link;
+	list->Len++;
+	return true;
+}
+
+/* 'pos' being NULL means at the head. */
+HARBOL_EXPORT bool harbol_iunilist_insert_after(struct HarbolIUniList *const restrict list, struct HarbolIUniLink *const pos, struct HarbolIUniLink *const link)
+{
+	if( !list || !link )
+		return false;
+	else if( !pos )
+		return harbol_iunilist_push_head(list, link);
+	
+	link->Next = pos->Next;
+	pos->Next = link;
+	if( list->Tail==pos )
+		list->Tail = link;
+	list->Len++;
+	return true;
+}
+
+/* unlinks whatever follows 'pos', or the head if 'pos' is NULL. */
+HARBOL_EXPORT struct HarbolIUniLink *harbol_iunilist_remove_after(struct HarbolIUniList *const restrict list, struct HarbolIUniLink *const pos)
+{
+	if( !list )
+		return NULL;
+	
+	struct HarbolIUniLink *const link = pos ? pos->Next : list->Head;
+	if( !link )
+		return NULL;
+	
+	pos ? (pos->Next = link->Next) : (list->Head = link->Next);
+	if( list->Tail==link )
+		list->Tail = pos;
+	link->Next = NULL;
+	list->Len--;
+	return link;
+}
+
+HARBOL_EXPORT struct HarbolIUniLink *harbol_iunilist_pop_head(struct HarbolIUniList *const list)
+{
+	return harbol_iunilist_remove_after(list, NULL);
+}
+
+/* a singly linked list has to walk to find the predecessor, so this one is O(n). */
+HARBOL_EXPORT bool harbol_iunilist_remove(struct HarbolIUniList *const restrict list, struct HarbolIUniLink *const link)
+{
+	if( !list || !link )
+		return false;
+	
+	struct HarbolIUniLink *prev = NULL;
+	for( struct HarbolIUniLink *n = list->Head; n; prev = n, n = n->Next )
+		if( n==link )
+			return harbol_iunilist_remove_after(list, prev) != NULL;
+	return false;
+}
+/////////////////////////////////////////
+
+
+/* Intrusive Doubly Linked List code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_ibilist_init(struct HarbolIBiList *const list)
+{
+	if( !list )
+		return;
+	
+	memset(list, 0, sizeof *list);
+}
+
+HARBOL_EXPORT size_t harbol_ibilist_get_len(const struct HarbolIBiList *const list)
+{
+	return list ? list->Len : 0;
+}
+
+/* 'pos' being NULL means at the tail. */
+HARBOL_EXPORT bool harbol_ibilist_insert_before(struct HarbolIBiList *const restrict list, struct HarbolIBiLink *const pos, struct HarbolIBiLink *const link)
+{
+	if( !list || !link )
+		return false;
+	
+	link->Next = pos;
+	link->Prev = pos ? pos->Prev : list->Tail;
+	link->Prev ? (link->Prev->Next = link) : (list->Head = link);
+	pos ? (pos->Prev = link) : (list->Tail = link);
+	list->Len++;
+	return true;
+}
+
+/* 'pos' being NULL means at the head. */
+HARBOL_EXPORT bool harbol_ibilist_insert_after(struct HarbolIBiList *const restrict list, struct HarbolIBiLink *const pos, struct HarbolIBiLink *const link)
+{
+	if( !list || !link )
+		return false;
+	
+	return harbol_ibilist_insert_before(list, pos ? pos->Next : list->Head, link);
+}
+
+HARBOL_EXPORT bool harbol_ibilist_push_head(struct HarbolIBiList *const restrict list, struct HarbolIBiLink *const link)
+{
+	return harbol_ibilist_insert_before(list, list ? list->Head : NULL, link);
+}
+
+HARBOL_EXPORT bool harbol_ibilist_push_tail(struct HarbolIBiList *const restrict list, struct HarbolIBiLink *const link)
+{
+	return harbol_ibilist_insert_before(list, NULL, link);
+}
+
+HARBOL_EXPORT bool harbol_ibilist_remove(struct HarbolIBiList *const restrict list, struct HarbolIBiLink *const link)
+{
+	if( !list || !link || !list->Len )
+		return false;
+	
+	link->Prev ? (link->Prev->Next = link->Next) : (list->Head = link->Next);
+	link->Next ? (link->Next->Prev = link->Prev) : (list->Tail = link->Prev);
+	link->Next = link->Prev = NULL;
+	list->Len--;
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolIBiLink *harbol_ibilist_pop_head(struct HarbolIBiList *const list)
+{
+	struct HarbolIBiLink *const link = list ? list->Head : NULL;
+	harbol_ibilist_remove(list, link);
+	return link;
+}
+
+HARBOL_EXPORT struct HarbolIBiLink *harbol_ibilist_pop_tail(struct HarbolIBiList *const list)
+{
+	struct HarbolIBiLink *const link = list ? list->Tail : NULL;
+	harbol_ibilist_remove(list, link);
+	return link;
+}
+/////////////////////////////////////////
+
+
+/* Intrusive N-ary Tree code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_itree_init(struct HarbolITree *const node)
+{
+	if( !node )
+		return;
+	
+	memset(node, 0, sizeof *node);
+}
+
+HARBOL_EXPORT size_t harbol_itree_get_children_count(const struct HarbolITree *const node)
+{
+	return node ? node->ChildCount : 0;
+}
+
+/* 'pos' being NULL means as the last child. 'child' has to be detached already and must not be an ancestor of 'parent'. */
+HARBOL_EXPORT bool harbol_itree_insert_child_before(struct HarbolITree *const restrict parent, struct HarbolITree *const pos, struct HarbolITree *const child)
+{
+	if( !parent || !child || child->Parent || child==parent || (pos && pos->Parent != parent) )
+		return false;
+	
+	child->Parent = parent;
+	child->NextSibling = pos;
+	child->PrevSibling = pos ? pos->PrevSibling : parent->LastChild;
+	child->PrevSibling ? (child->PrevSibling->NextSibling = child) : (parent->FirstChild = child);
+	pos ? (pos->PrevSibling = child) : (parent->LastChild = child);
+	parent->ChildCount++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_itree_append_child(struct HarbolITree *const restrict parent, struct HarbolITree *const child)
+{
+	return harbol_itree_insert_child_before(parent, NULL, child);
+}
+
+HARBOL_EXPORT bool harbol_itree_prepend_child(struct HarbolITree *const restrict parent, struct HarbolITree *const child)
+{
+	return harbol_itree_insert_child_before(parent, parent ? parent->FirstChild : NULL, child);
+}
+
+/* detaches 'node' and its whole subtree from its parent. */
+HARBOL_EXPORT bool harbol_itree_unlink(struct HarbolITree *const node)
+{
+	if( !node || !node->Parent )
+		return false;
+	
+	struct HarbolITree *const parent = node->Parent;
+	node->PrevSibling ? (node->PrevSibling->NextSibling = node->NextSibling) : (parent->FirstChild = node->NextSibling);
+	node->NextSibling ? (node->NextSibling->PrevSibling = node->PrevSibling) : (parent->LastChild = node->PrevSibling);
+	node->Parent = node->PrevSibling = node->NextSibling = NULL;
+	parent->ChildCount--;
+	return true;
+}
+
+/* pre-order successor of 'node' without leaving the subtree under 'root'; walks without recursion or a stack. */
+HARBOL_EXPORT struct HarbolITree *harbol_itree_next_preorder(const struct HarbolITree *const node, const struct HarbolITree *const root)
+{
+	if( !node )
+		return NULL;
+	else if( node->FirstChild )
+		return node->FirstChild;
+	
+	for( const struct HarbolITree *n = node; n && n != root; n = n->Parent )
+		if( n->NextSibling )
+			return n->NextSibling;
+	return NULL;
+}
+
+HARBOL_EXPORT size_t harbol_itree_get_depth(const struct HarbolITree *const node)
+{
+	size_t depth = 0;
+	for( const struct HarbolITree *n = node ? node->Parent : NULL; n; n = n->Parent )
+		depth++;
+	return depth;
+}
+/////////////////////////////////////////
@@ -23,15 +23,7 @@ HARBOL_EXPORT void harbol_linkmap_del(struct HarbolLinkMap *const map, fnHarbolD
 	if( !map || !map->Map.Table )
 		return;
 	
-	for( size_t i=0; i<map->Map.Len; i++ ) {
-		struct HarbolVector *vec = map->Map.Table+i;
-		for( size_t i=0; i<vec->Len; i++ ) {
-			struct HarbolKeyValPair *kv = vec->Table[i].Ptr;
-			harbol_kvpair_free(&kv, dtor);
-		}
-		harbol_vector_del(vec, NULL);
-	}
-	free(map->Map.Table), map->Map.Table=NULL;
+	harbol_hashmap_del(&map->Map, dtor);
 	harbol_vector_del(&map->Order, NULL);
 	memset(map, 0, sizeof *map);
 }
@@ -60,29 +52,87 @@ HARBOL_EXPORT bool harbol_linkmap_rehash(struct HarbolLinkMap *const map)
 	return ( !map || !map->Map.Table ) ? false : harbol_hashmap_rehash(&map->Map);
 }
 
-HARBOL_EXPORT bool harbol_linkmap_insert_node(struct HarbolLinkMap *const map, struct HarbolKeyValPair *node)
+HARBOL_EXPORT bool harbol_linkmap_reserve(struct HarbolLinkMap *const map, const size_t count)
 {
-	if( !map || !node || !node->KeyName.CStr )
+	if( !map || !harbol_hashmap_reserve(&map->Map, count) )
 		return false;
 	
-	else if( !map->Map.Len ) {
-		map->Map.Len = 8;
-		map->Map.Table = calloc(map->Map.Len, sizeof *map->Map.Table);
-		if( !map->Map.Table ) {
-			//puts("**** Memory Allocation Error **** harbol_hashmap_insert_node::map->Map.Table is NULL\n");
-			map->Map.Len = 0;
-			return false;
-		}
+	if( map->Order.Len < count )
+		harbol_generic_vector_resizer(&map->Order, count, sizeof *map->Order.Table);
+	return map->Order.Len >= count;
+}
+
+HARBOL_EXPORT void harbol_linkmap_compact(struct HarbolLinkMap *const map)
+{
+	if( !map || !map->Holes )
+		return;
+	
+	size_t live = 0;
+	for( size_t i=0; i<map->Order.Count; i++ ) {
+		struct HarbolKeyValPair *const kv = map->Order.Table[i].KvPairPtr;
+		if( !kv )
+			continue;
+		kv->Index = live;
+		map->Order.Table[live++].KvPairPtr = kv;
 	}
-	else if( map->Map.Count >= map->Map.Len )
-		harbol_linkmap_rehash(map);
-	else if( harbol_linkmap_has_key(map, node->KeyName.CStr) )
+	map->Order.Count = live;
+	map->Holes = map->Front = 0;
+}
+
+/* the public side of 'Order' is dense: anything handing out indices or iterators compacts away tombstones left in the middle first.
+ * Tombstones at the front don't need it, they're stepped over by 'Front'.
+ */
+static void _harbol_linkmap_settle(struct HarbolLinkMap *const map)
+{
+	if( map->Holes > map->Front )
+		harbol_linkmap_compact(map);
+}
+
+/* tombstones the node's slot, the node itself is still owned by the hashmap. */
+static void _harbol_linkmap_unlink(struct HarbolLinkMap *const map, const struct HarbolKeyValPair *const kv)
+{
+	map->Order.Table[kv->Index].Ptr = NULL;
+	map->Holes++;
+	// trailing tombstones can just be popped off.
+	while( map->Order.Count && !map->Order.Table[map->Order.Count-1].Ptr ) {
+		map->Order.Count--;
+		map->Holes--;
+	}
+	if( map->Front > map->Order.Count )
+		map->Front = map->Order.Count;
+	else if( map->Front==kv->Index )
+		while( map->Front < map->Order.Count && !map->Order.Table[map->Front].Ptr )
+			map->Front++;
+	
+	if( map->Holes > map->Order.Count / 2 )
+		harbol_linkmap_compact(map);
+}
+
+HARBOL_EXPORT bool harbol_linkmap_move_node_to_end(struct HarbolLinkMap *const map, struct HarbolKeyValPair *const node)
+{
+	if( !map || !node || node->Index >= map->Order.Count || map->Order.Table[node->Index].Ptr != node )
 		return false;
+	else if( node->Index==map->Order.Count-1 )
+		return true;
 	
-	const size_t hash = generic_hash(node->KeyName.CStr) % map->Map.Len;
-	harbol_vector_insert(map->Map.Table + hash, (union HarbolValue){.Ptr=node});
+	_harbol_linkmap_unlink(map, node);
+	node->Index = map->Order.Count;
+	harbol_vector_insert(&map->Order, (union HarbolValue){.Ptr=node});
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_linkmap_move_to_end(struct HarbolLinkMap *const restrict map, const char strkey[restrict])
+{
+	return ( !map ) ? false : harbol_linkmap_move_node_to_end(map, harbol_hashmap_get_node(&map->Map, strkey));
+}
+
+HARBOL_EXPORT bool harbol_linkmap_insert_node(struct HarbolLinkMap *const map, struct HarbolKeyValPair *node)
+{
+	if( !map || !harbol_hashmap_insert_node(&map->Map, node) )
+		return false;
+	
+	node->Index = map->Order.Count;
 	harbol_vector_insert(&map->Order, (union HarbolValue){.Ptr=node});
-	++map->Map.Count;
 	return true;
 }
 
@@ -91,16 +141,20 @@ HARBOL_EXPORT bool harbol_linkmap_insert(struct HarbolLinkMap *const restrict ma
 	if( !map || !strkey )
 		return false;
 	
-	struct HarbolKeyValPair *node = harbol_kvpair_new_strval(strkey, val);
+	struct HarbolKeyValPair *node = harbol_hashmap_alloc_node(&map->Map, strkey, val);
 	bool b = harbol_linkmap_insert_node(map, node);
 	if( !b )
-		harbol_kvpair_free(&node, NULL);
+		harbol_hashmap_free_node(&map->Map, &node, NULL);
 	return b;
 }
 
-HARBOL_EXPORT struct HarbolKeyValPair *harbol_linkmap_get_node_by_index(const struct HarbolLinkMap *const map, const size_t index)
+HARBOL_EXPORT struct HarbolKeyValPair *harbol_linkmap_get_node_by_index(struct HarbolLinkMap *const map, const size_t index)
 {
-	return ( !map || !map->Map.Table ) ? NULL : harbol_vector_get(&map->Order, index).Ptr;
+	if( !map || !map->Map.Table )
+		return NULL;
+	
+	_harbol_linkmap_settle(map);
+	return ( index < map->Order.Count - map->Front ) ? map->Order.Table[map->Front + index].Ptr : NULL;
 }
 
 HARBOL_EXPORT union HarbolValue harbol_linkmap_get(const struct HarbolLinkMap *const restrict map, const char strkey[restrict])
@@ -116,7 +170,7 @@ HARBOL_EXPORT void harbol_linkmap_set(struct HarbolLinkMap *const restrict map,
 	harbol_hashmap_set(&map->Map, strkey, val);
 }
 
-HARBOL_EXPORT union HarbolValue harbol_linkmap_get_by_index(const struct HarbolLinkMap *const map, const size_t index)
+HARBOL_EXPORT union HarbolValue harbol_linkmap_get_by_index(struct HarbolLinkMap *const map, const size_t index)
 {
 	if( !map || !map->Map.Table )
 		return (union HarbolValue){0};
@@ -137,12 +191,15 @@ HARBOL_EXPORT void harbol_linkmap_set_by_index(struct HarbolLinkMap *const map,
 
 HARBOL_EXPORT void harbol_linkmap_delete(struct HarbolLinkMap *const restrict map, const char strkey[restrict], fnHarbolDestructor *const dtor)
 {
-	if( !map || !map->Map.Table || !harbol_linkmap_has_key(map, strkey) )
+	if( !map || !map->Map.Table )
+		return;
+	
+	const struct HarbolKeyValPair *const kv = harbol_hashmap_get_node(&map->Map, strkey);
+	if( !kv )
 		return;
 	
-	const size_t index = harbol_linkmap_get_index_by_name(map, strkey);
+	_harbol_linkmap_unlink(map, kv);
 	harbol_hashmap_delete(&map->Map, strkey, dtor);
-	harbol_vector_delete(&map->Order, index, NULL);
 }
 
 HARBOL_EXPORT void harbol_linkmap_delete_by_index(struct HarbolLinkMap *const map, const size_t index, fnHarbolDestructor *const dtor)
@@ -154,8 +211,8 @@ HARBOL_EXPORT void harbol_linkmap_delete_by_index(struct HarbolLinkMap *const ma
 	if( !kv )
 		return;
 	
+	_harbol_linkmap_unlink(map, kv);
 	harbol_hashmap_delete(&map->Map, kv->KeyName.CStr, dtor);
-	harbol_vector_delete(&map->Order, index, NULL);
 }
 
 HARBOL_EXPORT bool harbol_linkmap_has_key(const struct HarbolLinkMap *const restrict map, const char strkey[restrict])
@@ -176,43 +233,65 @@ HARBOL_EXPORT struct HarbolVector *harbol_linkmap_get_buckets(const struct Harbo
 	return map ? map->Map.Table : NULL;
 }
 
-HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter(const struct HarbolLinkMap *const map)
+HARBOL_EXPORT bool harbol_linkmap_get_stats(const struct HarbolLinkMap *const restrict map, struct HarbolHashMapStats *const restrict stats)
 {
-	return map ? map->Order.Table : NULL;
+	if( !map || !harbol_hashmap_get_stats(&map->Map, stats) )
+		return false;
+	
+	// the order vector counts as table overhead.
+	const size_t order_bytes = sizeof *map->Order.Table * map->Order.Len;
+	stats->TableBytes += order_bytes;
+	stats->TotalBytes += order_bytes + sizeof *map - sizeof map->Map;
+	return true;
 }
 
-HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_len(const struct HarbolLinkMap *const map)
+HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter(struct HarbolLinkMap *const map)
 {
-	return map ? map->Order.Table + map->Order.Len : NULL;
+	if( !map || !map->Order.Table )
+		return NULL;
+	
+	_harbol_linkmap_settle(map);
+	return map->Order.Table + map->Front;
 }
 
-HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_count(const struct HarbolLinkMap *const map)
+HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_len(struct HarbolLinkMap *const map)
 {
-	return map ? map->Order.Table + map->Order.Count : NULL;
+	if( !map )
+		return NULL;
+	
+	_harbol_linkmap_settle(map);
+	return map->Order.Table + map->Order.Len;
 }
 
-HARBOL_EXPORT size_t harbol_linkmap_get_index_by_name(const struct HarbolLinkMap *const restrict map, const char strkey[restrict])
+HARBOL_EXPORT union HarbolValue *harbol_linkmap_get_iter_end_count(struct HarbolLinkMap *const map)
+{
+	if( !map )
+		return NULL;
+	
+	_harbol_linkmap_settle(map);
+	return map->Order.Table + map->Order.Count;
+}
+
+HARBOL_EXPORT size_t harbol_linkmap_get_index_by_name(struct HarbolLinkMap *const restrict map, const char strkey[restrict])
 {
 	if( !map || !strkey )
 		return SIZE_MAX;
 	
-	for( size_t i=0; i<map->Order.Count; i++ ) {
-		if( !harbol_string_cmpcstr(&map->Order.Table[i].KvPairPtr->KeyName, strkey) )
-			return i;
-	}
-	return SIZE_MAX;
+	const struct HarbolKeyValPair *const kv = harbol_hashmap_get_node(&map->Map, strkey);
+	if( !kv )
+		return SIZE_MAX;
+	
+	_harbol_linkmap_settle(map);
+	return kv->Index - map->Front;
 }
 
-HARBOL_EXPORT size_t harbol_linkmap_get_index_by_node(const struct HarbolLinkMap *const map, struct HarbolKeyValPair *const node)
+HARBOL_EXPORT size_t harbol_linkmap_get_index_by_node(struct HarbolLinkMap *const map, struct HarbolKeyValPair *const node)
 {
-	if( !map || !node )
+	if( !map || !node || node->Index >= map->Order.Count || map->Order.Table[node->Index].KvPairPtr != node )
 		return SIZE_MAX;
 	
-	for( size_t i=0; i<map->Order.Count; i++ ) {
-		if( map->Order.Table[i].KvPairPtr==node )
-			return i;
-	}
-	return SIZE_MAX;
+	_harbol_linkmap_settle(map);
+	return node->Index - map->Front;
 }
 
 HARBOL_EXPORT size_t harbol_linkmap_get_index_by_val(const struct HarbolLinkMap *const map, const union HarbolValue val)
@@ -220,9 +299,13 @@ HARBOL_EXPORT size_t harbol_linkmap_get_index_by_val(const struct HarbolLinkMap
 	if( !map )
 		return SIZE_MAX;
 	
-	for( size_t i=0; i<map->Order.Count; i++ ) {
-		if( map->Order.Table[i].KvPairPtr->Data.UInt64 == val.UInt64 )
-			return i;
+	for( size_t i=0, index=0; i<map->Order.Count; i++ ) {
+		const struct HarbolKeyValPair *const kv = map->Order.Table[i].KvPairPtr;
+		if( !kv )
+			continue;
+		else if( kv->Data.UInt64 == val.UInt64 )
+			return index;
+		index++;
 	}
 	return SIZE_MAX;
 }
@@ -232,11 +315,11 @@ HARBOL_EXPORT void harbol_linkmap_from_hashmap(struct HarbolLinkMap *const linkm
 	if( !linkmap || !map )
 		return;
 	
-	for( size_t i=0; i<map->Len; i++ ) {
-		struct HarbolVector *vec = map->Table + i;
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		struct HarbolVector *vec = harbol_hashmap_get_bucket(map, i);
 		for( size_t n=0; n<harbol_vector_get_count(vec); n++ ) {
 			struct HarbolKeyValPair *kv = vec->Table[n].Ptr;
-			harbol_linkmap_insert_node(linkmap, harbol_kvpair_new_strval(kv->KeyName.CStr, kv->Data));
+			harbol_linkmap_insert(linkmap, kv->KeyName.CStr, kv->Data);
 		}
 	}
 }
@@ -294,6 +377,23 @@ HARBOL_EXPORT void harbol_linkmap_from_graph(struct HarbolLinkMap *const map, co
 	}
 }
 
+HARBOL_EXPORT void harbol_linkmap_from_bptree(struct HarbolLinkMap *const map, const struct HarbolBPTree *const tree)
+{
+	if( !map || !tree )
+		return;
+	
+	for( struct HarbolBPTreeIter iter = harbol_bptree_first(tree); harbol_bptree_iter_valid(&iter); harbol_bptree_iter_next(&iter) ) {
+		const union HarbolValue key = harbol_bptree_iter_key(&iter);
+		char cstrkey[32] = {0};
+		switch( tree->KeyType ) {
+			case HarbolBPKeyStr: harbol_linkmap_insert(map, key.Ptr, harbol_bptree_iter_val(&iter)); continue;
+			case HarbolBPKeyInt: sprintf(cstrkey, "%" PRIi64 "", key.Int64); break;
+			case HarbolBPKeyDouble: sprintf(cstrkey, "%.17g", key.Double); break;
+		}
+		harbol_linkmap_insert(map, cstrkey, harbol_bptree_iter_val(&iter));
+	}
+}
+
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_hashmap(const struct HarbolHashMap *const map)
 {
 	if( !map )
@@ -343,3 +443,13 @@ HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_graph(const struct H
 	harbol_linkmap_from_graph(map, graph);
 	return map;
 }
+
+HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new_from_bptree(const struct HarbolBPTree *const tree)
+{
+	if( !tree )
+		return NULL;
+	
+	struct HarbolLinkMap *map = harbol_linkmap_new();
+	harbol_linkmap_from_bptree(map, tree);
+	return map;
+}
@@ -0,0 +1,310 @@
+#include <stdatomic.h>
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolLFStack {
+	alignas(8) uint64_t Top, Spares;
+} HarbolLFStack;
+
+typedef struct HarbolLFQueue {
+	alignas(8) uint64_t Head;
+	uint8_t HeadPad[HARBOL_LF_LINE - sizeof(uint64_t)];
+	alignas(8) uint64_t Tail;
+	uint8_t TailPad[HARBOL_LF_LINE - sizeof(uint64_t)];
+	alignas(8) uint64_t Spares;
+} HarbolLFQueue;
+ */
+
+/* a tagged word is a node pointer with a modification count packed above it, so a CAS against a
+ * node that got popped and pushed back in between (ABA) still fails because the count moved on.
+ * 64-bit targets have 48 bits of user address space, leaving 16 bits of count; 32-bit targets get 32.
+ *
+ * nodes are never handed back to malloc while the container lives. Retired nodes go onto the
+ * container's own 'Spares' list and get reused, so a thread holding a stale pointer always reads
+ * memory that's still a node, and the tag makes whatever it then tries to CAS fail.
+ * everything is released in 'del', which must only run once no other thread is using the container.
+ *
+ * 'HarbolUniListNode' fields aren't declared atomic, so they're only accessed through these casts.
+ */
+#if UINTPTR_MAX > UINT32_MAX
+#	define HARBOL_LF_PTR_BITS    48
+#else
+#	define HARBOL_LF_PTR_BITS    32
+#endif
+#define HARBOL_LF_PTR_MASK    ((UINT64_C(1) << HARBOL_LF_PTR_BITS) - 1)
+
+#define _harbol_lf_word(ptr)    ((_Atomic uint64_t *)(ptr))
+#define _harbol_lf_link(node)   ((_Atomic(struct HarbolUniListNode *) *)&(node)->Next)
+#define _harbol_lf_data(node)   ((_Atomic uint64_t *)&(node)->Data)
+
+static inline uint64_t _harbol_lf_pack(const struct HarbolUniListNode *const node, const uint64_t tag)
+{
+	return ((uint64_t)(uintptr_t)node & HARBOL_LF_PTR_MASK) | (tag << HARBOL_LF_PTR_BITS);
+}
+
+static inline struct HarbolUniListNode *_harbol_lf_ptr(const uint64_t word)
+{
+	return (struct HarbolUniListNode *)(uintptr_t)(word & HARBOL_LF_PTR_MASK);
+}
+
+static inline uint64_t _harbol_lf_tag(const uint64_t word)
+{
+	return word >> HARBOL_LF_PTR_BITS;
+}
+
+static inline union HarbolValue _harbol_lf_load_data(const struct HarbolUniListNode *const node)
+{
+	return (union HarbolValue){ .UInt64 = atomic_load_explicit(_harbol_lf_data(node), memory_order_relaxed) };
+}
+
+/* the spares list links through 'Data' rather than 'Next': a stale queue operation may still CAS a spare's 'Next'. */
+static void _harbol_lf_spare_push(uint64_t *const spares, struct HarbolUniListNode *const node)
+{
+	uint64_t top = atomic_load(_harbol_lf_word(spares));
+	do {
+		atomic_store_explicit(_harbol_lf_data(node), (uint64_t)(uintptr_t)_harbol_lf_ptr(top), memory_order_relaxed);
+	} while( !atomic_compare_exchange_weak(_harbol_lf_word(spares), &top, _harbol_lf_pack(node, _harbol_lf_tag(top) + 1)) );
+}
+
+static struct HarbolUniListNode *_harbol_lf_node_get(uint64_t *const spares)
+{
+	uint64_t top = atomic_load(_harbol_lf_word(spares));
+	while( _harbol_lf_ptr(top) ) {
+		struct HarbolUniListNode *const node = _harbol_lf_ptr(top);
+		const uint64_t next = atomic_load_explicit(_harbol_lf_data(node), memory_order_relaxed);
+		if( atomic_compare_exchange_weak(_harbol_lf_word(spares), &top, _harbol_lf_pack((struct HarbolUniListNode *)(uintptr_t)next, _harbol_lf_tag(top) + 1)) )
+			return node;
+	}
+	struct HarbolUniListNode *const node = harbol_unilistnode_new();
+	// addresses above the packed range can't be stored in a tagged word.
+	if( node && ((uintptr_t)node & ~(uintptr_t)HARBOL_LF_PTR_MASK) ) {
+		free(node);
+		return NULL;
+	}
+	return node;
+}
+
+static void _harbol_lf_spares_del(uint64_t *const spares)
+{
+	for( struct HarbolUniListNode *node = _harbol_lf_ptr(*spares); node; ) {
+		struct HarbolUniListNode *const next = (struct HarbolUniListNode *)(uintptr_t)node->Data.UInt64;
+		free(node);
+		node = next;
+	}
+	*spares = 0;
+}
+
+
+/* Lock-Free Stack code */
+/////////////////////////////////////////
+HARBOL_EXPORT struct HarbolLFStack *harbol_lfstack_new(void)
+{
+	struct HarbolLFStack *stack = calloc(1, sizeof *stack);
+	return stack;
+}
+
+HARBOL_EXPORT void harbol_lfstack_init(struct HarbolLFStack *const stack)
+{
+	if( !stack )
+		return;
+	
+	memset(stack, 0, sizeof *stack);
+}
+
+HARBOL_EXPORT void harbol_lfstack_del(struct HarbolLFStack *const stack, fnHarbolDestructor *const dtor)
+{
+	if( !stack )
+		return;
+	
+	for( struct HarbolUniListNode *node = _harbol_lf_ptr(stack->Top); node; ) {
+		struct HarbolUniListNode *const next = node->Next;
+		if( dtor )
+			(*dtor)(&node->Data.Ptr);
+		free(node);
+		node = next;
+	}
+	stack->Top = 0;
+	_harbol_lf_spares_del(&stack->Spares);
+}
+
+HARBOL_EXPORT void harbol_lfstack_free(struct HarbolLFStack **stackref, fnHarbolDestructor *const dtor)
+{
+	if( !*stackref )
+		return;
+	
+	harbol_lfstack_del(*stackref, dtor);
+	free(*stackref), *stackref=NULL;
+}
+
+HARBOL_EXPORT bool harbol_lfstack_push(struct HarbolLFStack *const stack, const union HarbolValue val)
+{
+	if( !stack )
+		return false;
+	
+	struct HarbolUniListNode *const node = _harbol_lf_node_get(&stack->Spares);
+	if( !node )
+		return false;
+	
+	atomic_store_explicit(_harbol_lf_data(node), val.UInt64, memory_order_relaxed);
+	uint64_t top = atomic_load(_harbol_lf_word(&stack->Top));
+	do {
+		atomic_store_explicit(_harbol_lf_link(node), _harbol_lf_ptr(top), memory_order_relaxed);
+	} while( !atomic_compare_exchange_weak(_harbol_lf_word(&stack->Top), &top, _harbol_lf_pack(node, _harbol_lf_tag(top) + 1)) );
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_lfstack_pop(struct HarbolLFStack *const restrict stack, union HarbolValue *const restrict val)
+{
+	if( !stack )
+		return false;
+	
+	uint64_t top = atomic_load(_harbol_lf_word(&stack->Top));
+	while( _harbol_lf_ptr(top) ) {
+		struct HarbolUniListNode *const node = _harbol_lf_ptr(top);
+		// 'node' may already be recycled; then 'next' is junk but the tag check below throws it away.
+		struct HarbolUniListNode *const next = atomic_load_explicit(_harbol_lf_link(node), memory_order_relaxed);
+		if( atomic_compare_exchange_weak(_harbol_lf_word(&stack->Top), &top, _harbol_lf_pack(next, _harbol_lf_tag(top) + 1)) ) {
+			if( val )
+				*val = _harbol_lf_load_data(node);
+			_harbol_lf_spare_push(&stack->Spares, node);
+			return true;
+		}
+	}
+	return false;
+}
+
+/* only a snapshot when other threads are pushing or popping. */
+HARBOL_EXPORT bool harbol_lfstack_is_empty(const struct HarbolLFStack *const stack)
+{
+	return !stack || !_harbol_lf_ptr(atomic_load(_harbol_lf_word(&stack->Top)));
+}
+/////////////////////////////////////////
+
+
+/* Lock-Free Queue code */
+/////////////////////////////////////////
+/* Michael-Scott queue: 'Head' always points at a dummy node whose successor holds the front value. */
+HARBOL_EXPORT struct HarbolLFQueue *harbol_lfqueue_new(void)
+{
+	struct HarbolLFQueue *queue = calloc(1, sizeof *queue);
+	if( queue && !harbol_lfqueue_init(queue) )
+		free(queue), queue=NULL;
+	return queue;
+}
+
+HARBOL_EXPORT bool harbol_lfqueue_init(struct HarbolLFQueue *const queue)
+{
+	if( !queue )
+		return false;
+	
+	memset(queue, 0, sizeof *queue);
+	struct HarbolUniListNode *const dummy = _harbol_lf_node_get(&queue->Spares);
+	if( !dummy )
+		return false;
+	
+	queue->Head = queue->Tail = _harbol_lf_pack(dummy, 0);
+	return true;
+}
+
+HARBOL_EXPORT void harbol_lfqueue_del(struct HarbolLFQueue *const queue, fnHarbolDestructor *const dtor)
+{
+	if( !queue )
+		return;
+	
+	struct HarbolUniListNode *node = _harbol_lf_ptr(queue->Head);
+	// the dummy's value was already handed out.
+	if( node ) {
+		struct HarbolUniListNode *const next = node->Next;
+		free(node);
+		node = next;
+	}
+	while( node ) {
+		struct HarbolUniListNode *const next = node->Next;
+		if( dtor )
+			(*dtor)(&node->Data.Ptr);
+		free(node);
+		node = next;
+	}
+	queue->Head = queue->Tail = 0;
+	_harbol_lf_spares_del(&queue->Spares);
+}
+
+HARBOL_EXPORT void harbol_lfqueue_free(struct HarbolLFQueue **queueref, fnHarbolDestructor *const dtor)
+{
+	if( !*queueref )
+		return;
+	
+	harbol_lfqueue_del(*queueref, dtor);
+	free(*queueref), *queueref=NULL;
+}
+
+HARBOL_EXPORT bool harbol_lfqueue_enqueue(struct HarbolLFQueue *const queue, const union HarbolValue val)
+{
+	if( !queue )
+		return false;
+	
+	struct HarbolUniListNode *const node = _harbol_lf_node_get(&queue->Spares);
+	if( !node )
+		return false;
+	
+	atomic_store_explicit(_harbol_lf_data(node), val.UInt64, memory_order_relaxed);
+	atomic_store_explicit(_harbol_lf_link(node), NULL, memory_order_relaxed);
+	for( ;; ) {
+		uint64_t tail = atomic_load(_harbol_lf_word(&queue->Tail));
+		struct HarbolUniListNode *const last = _harbol_lf_ptr(tail);
+		struct HarbolUniListNode *next = atomic_load(_harbol_lf_link(last));
+		if( tail != atomic_load(_harbol_lf_word(&queue->Tail)) )
+			continue;
+		else if( next ) {
+			// 'Tail' is lagging behind, help move it along.
+			atomic_compare_exchange_strong(_harbol_lf_word(&queue->Tail), &tail, _harbol_lf_pack(next, _harbol_lf_tag(tail) + 1));
+		} else if( atomic_compare_exchange_strong(_harbol_lf_link(last), &next, node) ) {
+			atomic_compare_exchange_strong(_harbol_lf_word(&queue->Tail), &tail, _harbol_lf_pack(node, _harbol_lf_tag(tail) + 1));
+			return true;
+		}
+	}
+}
+
+HARBOL_EXPORT bool harbol_lfqueue_dequeue(struct HarbolLFQueue *const restrict queue, union HarbolValue *const restrict val)
+{
+	if( !queue )
+		return false;
+	
+	for( ;; ) {
+		uint64_t head = atomic_load(_harbol_lf_word(&queue->Head));
+		uint64_t tail = atomic_load(_harbol_lf_word(&queue->Tail));
+		struct HarbolUniListNode *const first = _harbol_lf_ptr(head);
+		struct HarbolUniListNode *const next = atomic_load(_harbol_lf_link(first));
+		if( head != atomic_load(_harbol_lf_word(&queue->Head)) )
+			continue;
+		else if( first==_harbol_lf_ptr(tail) ) {
+			if( !next )
+				return false;
+			atomic_compare_exchange_strong(_harbol_lf_word(&queue->Tail), &tail, _harbol_lf_pack(next, _harbol_lf_tag(tail) + 1));
+		} else if( next ) {
+			// read before the CAS: once 'Head' moves, another dequeue can retire 'next'.
+			const union HarbolValue front = _harbol_lf_load_data(next);
+			if( atomic_compare_exchange_strong(_harbol_lf_word(&queue->Head), &head, _harbol_lf_pack(next, _harbol_lf_tag(head) + 1)) ) {
+				if( val )
+					*val = front;
+				// a stale enqueue can't append to a retired node whose 'Next' isn't NULL.
+				atomic_store_explicit(_harbol_lf_link(first), first, memory_order_relaxed);
+				_harbol_lf_spare_push(&queue->Spares, first);
+				return true;
+			}
+		}
+	}
+}
+
+/* only a snapshot when other threads are enqueuing or dequeuing. */
+HARBOL_EXPORT bool harbol_lfqueue_is_empty(const struct HarbolLFQueue *const queue)
+{
+	const struct HarbolUniListNode *const first = queue ? _harbol_lf_ptr(atomic_load(_harbol_lf_word(&queue->Head))) : NULL;
+	return !first || !atomic_load(_harbol_lf_link(first));
+}
+/////////////////////////////////////////
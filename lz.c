@@ -0,0 +1,553 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolLZEncoder {
+	struct HarbolByteBuffer Pending;
+	size_t BlockSize;
+	bool Started;
+} HarbolLZEncoder;
+
+typedef struct HarbolLZDecoder {
+	struct HarbolByteBuffer Pending;
+	size_t BlockSize;
+	bool Started, Done, Failed;
+} HarbolLZDecoder;
+ */
+
+/* Block format (the same sequence layout LZ4 uses):
+ *	sequence = token [literal length bytes] literals [offset (u16 le) [match length bytes]] ;
+ *	token = high nibble literal length, low nibble match length - 4 ; 15 means more length bytes follow, each adding up to 255.
+ *	the last sequence is literals only; the last 5 bytes are always literals and no match starts in the last 12.
+ *
+ * Frame format:
+ *	frame = magic (u32 le) block size (u32 le) { stored size (u32 le) raw size (u32 le) bytes } end mark (u32 le 0) ;
+ *	a stored size with the top bit set means the block is kept uncompressed.
+ */
+#define HARBOL_LZ_MAGIC          0x315A4C48u /* "HLZ1" */
+#define HARBOL_LZ_HASH_LOG       12
+#define HARBOL_LZ_MIN_MATCH      4
+#define HARBOL_LZ_LAST_LITERALS  5
+#define HARBOL_LZ_MF_LIMIT       12
+#define HARBOL_LZ_MAX_OFFSET     65535
+#define HARBOL_LZ_SKIP_TRIGGER   6
+#define HARBOL_LZ_RAW_FLAG       0x80000000u
+
+
+static inline uint32_t _harbol_lz_read32(const uint8_t *const p)
+{
+	uint32_t v; memcpy(&v, p, sizeof v);
+	return v;
+}
+
+static inline uint32_t _harbol_lz_hash(const uint8_t *const p)
+{
+	return (_harbol_lz_read32(p) * 2654435761u) >> (32 - HARBOL_LZ_HASH_LOG);
+}
+
+static inline void _harbol_lz_put_u32(uint8_t *const p, const uint32_t v)
+{
+	p[0] = (uint8_t)v, p[1] = (uint8_t)(v >> 8), p[2] = (uint8_t)(v >> 16), p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t _harbol_lz_get_u32(const uint8_t *const p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/* how many bytes match from 'a' and 'b' onwards, not reading 'a' past 'limit'. */
+static inline size_t _harbol_lz_count(const uint8_t *a, const uint8_t *b, const uint8_t *const limit)
+{
+	const uint8_t *const start = a;
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__) && __BYTE_ORDER__==__ORDER_LITTLE_ENDIAN__
+	while( limit - a >= 8 ) {
+		uint64_t x, y;
+		memcpy(&x, a, sizeof x), memcpy(&y, b, sizeof y);
+		const uint64_t diff = x ^ y;
+		if( diff )
+			return (size_t)(a - start) + ((size_t)__builtin_ctzll(diff) >> 3);
+		a += 8, b += 8;
+	}
+#endif
+	while( a < limit && *a==*b )
+		a++, b++;
+	return (size_t)(a - start);
+}
+
+static inline uint8_t *_harbol_lz_put_len(uint8_t *op, size_t len)
+{
+	for(; len >= 255; len -= 255 )
+		*op++ = 255;
+	*op++ = (uint8_t)len;
+	return op;
+}
+
+
+/* LZ Block code */
+/////////////////////////////////////////
+HARBOL_EXPORT size_t harbol_lz_compress_bound(const size_t len)
+{
+	return ( len > SIZE_MAX / 2 ) ? 0 : len + len / 255 + 16;
+}
+
+static size_t _harbol_lz_compress_block(const uint8_t *const restrict src, const size_t len, uint8_t *const restrict dst)
+{
+	const uint8_t *ip = src, *anchor = src;
+	const uint8_t *const iend = src + len;
+	uint8_t *op = dst;
+	
+	if( len >= HARBOL_LZ_MF_LIMIT + 1 ) {
+		const uint8_t *const mflimit = iend - HARBOL_LZ_MF_LIMIT;
+		const uint8_t *const matchlimit = iend - HARBOL_LZ_LAST_LITERALS;
+		// positions relative to 'src'; a stale or zeroed entry just fails the byte compare.
+		uint32_t table[1 << HARBOL_LZ_HASH_LOG] = {0};
+		ip++;
+		
+		while( ip < mflimit ) {
+			// find a match, striding further the longer nothing turns up so incompressible data goes by quickly.
+			const uint8_t *ref;
+			size_t attempts = (size_t)1 << HARBOL_LZ_SKIP_TRIGGER;
+			for( ;; ) {
+				const uint32_t h = _harbol_lz_hash(ip);
+				ref = src + table[h];
+				table[h] = (uint32_t)(ip - src);
+				if( ip - ref <= HARBOL_LZ_MAX_OFFSET && _harbol_lz_read32(ref)==_harbol_lz_read32(ip) )
+					break;
+				
+				ip += attempts++ >> HARBOL_LZ_SKIP_TRIGGER;
+				if( ip >= mflimit )
+					goto last_literals;
+			}
+			while( ip > anchor && ref > src && ip[-1]==ref[-1] )
+				ip--, ref--;
+			
+			const size_t litlen = (size_t)(ip - anchor);
+			const size_t matchlen = HARBOL_LZ_MIN_MATCH + _harbol_lz_count(ip + HARBOL_LZ_MIN_MATCH, ref + HARBOL_LZ_MIN_MATCH, matchlimit);
+			const size_t offset = (size_t)(ip - ref);
+			
+			uint8_t *const token = op++;
+			*token = (uint8_t)(( litlen >= 15 ? 15 : litlen ) << 4);
+			if( litlen >= 15 )
+				op = _harbol_lz_put_len(op, litlen - 15);
+			memcpy(op, anchor, litlen);
+			op += litlen;
+			
+			*op++ = (uint8_t)offset, *op++ = (uint8_t)(offset >> 8);
+			const size_t mcode = matchlen - HARBOL_LZ_MIN_MATCH;
+			*token |= (uint8_t)( mcode >= 15 ? 15 : mcode );
+			if( mcode >= 15 )
+				op = _harbol_lz_put_len(op, mcode - 15);
+			
+			ip += matchlen;
+			anchor = ip;
+			if( ip < mflimit )
+				table[_harbol_lz_hash(ip - 2)] = (uint32_t)(ip - 2 - src);
+		}
+	}
+last_literals:;
+	const size_t litlen = (size_t)(iend - anchor);
+	*op++ = (uint8_t)(( litlen >= 15 ? 15 : litlen ) << 4);
+	if( litlen >= 15 )
+		op = _harbol_lz_put_len(op, litlen - 15);
+	if( litlen )
+		memcpy(op, anchor, litlen);
+	op += litlen;
+	return (size_t)(op - dst);
+}
+
+/* returns how many bytes were written to 'dst', which must hold 'raw_len', or 0 for malformed input. */
+static size_t _harbol_lz_decompress_block(const uint8_t *const restrict src, const size_t len, uint8_t *const restrict dst, const size_t raw_len)
+{
+	const uint8_t *ip = src;
+	const uint8_t *const iend = src + len;
+	uint8_t *op = dst;
+	uint8_t *const oend = dst + raw_len;
+	
+	while( ip < iend ) {
+		const uint8_t token = *ip++;
+		size_t litlen = token >> 4;
+		// short literal runs copy a fixed 16 bytes when there's room; the extra gets overwritten next.
+		if( litlen < 15 && iend - ip >= 16 && oend - op >= 16 ) {
+			memcpy(op, ip, 16);
+			op += litlen, ip += litlen;
+			goto match;
+		} else if( litlen==15 ) {
+			uint8_t b;
+			do {
+				if( ip >= iend )
+					return 0;
+				b = *ip++;
+				litlen += b;
+			} while( b==255 );
+		}
+		if( litlen > (size_t)(iend - ip) || litlen > (size_t)(oend - op) )
+			return 0;
+		
+		memcpy(op, ip, litlen);
+		op += litlen, ip += litlen;
+		if( ip==iend )
+			break;
+	match:
+		if( iend - ip < 2 )
+			return 0;
+		
+		const size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+		ip += 2;
+		if( !offset || offset > (size_t)(op - dst) )
+			return 0;
+		
+		size_t matchlen = token & 15;
+		if( matchlen==15 ) {
+			uint8_t b;
+			do {
+				if( ip >= iend )
+					return 0;
+				b = *ip++;
+				matchlen += b;
+			} while( b==255 );
+		}
+		matchlen += HARBOL_LZ_MIN_MATCH;
+		if( matchlen > (size_t)(oend - op) )
+			return 0;
+		
+		const uint8_t *ref = op - offset;
+		uint8_t *const end = op + matchlen;
+		if( offset < 8 ) {
+			// lay down the repeating pattern until it spans 8 bytes, then copy from that far back instead.
+			const size_t period = offset * ((8 + offset - 1) / offset);
+			for( const uint8_t *const stop = op + ( period < matchlen ? period : matchlen ); op < stop; )
+				*op++ = *ref++;
+			ref = op - period;
+		}
+		// 8 bytes at a time is safe even though the ranges overlap, since each chunk only reads what's already written.
+		if( oend - end >= 8 ) {
+			for(; op < end; op += 8, ref += 8 )
+				memcpy(op, ref, 8);
+			op = end;
+		} else {
+			for(; end - op >= 8; op += 8, ref += 8 )
+				memcpy(op, ref, 8);
+			while( op < end )
+				*op++ = *ref++;
+		}
+	}
+	return ( op==oend ) ? raw_len : 0;
+}
+
+/* appends one compressed block to 'dst'; pair it with the original length to decompress. */
+HARBOL_EXPORT bool harbol_lz_compress_block(const void *const restrict src, const size_t len, struct HarbolByteBuffer *const restrict dst)
+{
+	if( !dst || (!src && len) || len > UINT32_MAX )
+		return false;
+	
+	uint8_t *const out = harbol_bytebuffer_prepare(dst, harbol_lz_compress_bound(len));
+	return out && harbol_bytebuffer_commit(dst, _harbol_lz_compress_block(src, len, out));
+}
+
+/* appends exactly 'raw_len' decompressed bytes to 'dst', or nothing if 'src' is malformed. */
+HARBOL_EXPORT bool harbol_lz_decompress_block(const void *const restrict src, const size_t len, const size_t raw_len, struct HarbolByteBuffer *const restrict dst)
+{
+	if( !dst || !src || !len )
+		return false;
+	// an empty block is still one token byte.
+	else if( !raw_len )
+		return len==1 && !*(const uint8_t *)src;
+	
+	uint8_t *const out = harbol_bytebuffer_prepare(dst, raw_len);
+	return out && _harbol_lz_decompress_block(src, len, out, raw_len)==raw_len && harbol_bytebuffer_commit(dst, raw_len);
+}
+/////////////////////////////////////////
+
+
+/* LZ Frame Encoder code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_lz_encoder_init(struct HarbolLZEncoder *const enc, const size_t block_size)
+{
+	if( !enc )
+		return;
+	
+	memset(enc, 0, sizeof *enc);
+	enc->BlockSize = ( !block_size ) ? HARBOL_LZ_BLOCK_SIZE : ( block_size > HARBOL_LZ_MAX_BLOCK_SIZE ) ? HARBOL_LZ_MAX_BLOCK_SIZE : block_size;
+}
+
+HARBOL_EXPORT void harbol_lz_encoder_del(struct HarbolLZEncoder *const enc)
+{
+	if( !enc )
+		return;
+	
+	harbol_bytebuffer_del(&enc->Pending);
+	memset(enc, 0, sizeof *enc);
+}
+
+static bool _harbol_lz_encoder_start(struct HarbolLZEncoder *const restrict enc, struct HarbolByteBuffer *const restrict out)
+{
+	if( enc->Started )
+		return true;
+	
+	uint8_t *const hdr = harbol_bytebuffer_prepare(out, 8);
+	if( !hdr )
+		return false;
+	
+	_harbol_lz_put_u32(hdr, HARBOL_LZ_MAGIC);
+	_harbol_lz_put_u32(hdr + 4, (uint32_t)enc->BlockSize);
+	enc->Started = true;
+	return harbol_bytebuffer_commit(out, 8);
+}
+
+static bool _harbol_lz_emit_block(const uint8_t *const restrict src, const size_t len, struct HarbolByteBuffer *const restrict out)
+{
+	uint8_t *const hdr = harbol_bytebuffer_prepare(out, 8 + harbol_lz_compress_bound(len));
+	if( !hdr )
+		return false;
+	
+	size_t stored = _harbol_lz_compress_block(src, len, hdr + 8);
+	uint32_t code = (uint32_t)stored;
+	if( stored >= len ) {
+		memcpy(hdr + 8, src, len);
+		stored = len;
+		code = (uint32_t)len | HARBOL_LZ_RAW_FLAG;
+	}
+	_harbol_lz_put_u32(hdr, code);
+	_harbol_lz_put_u32(hdr + 4, (uint32_t)len);
+	return harbol_bytebuffer_commit(out, 8 + stored);
+}
+
+/* appends frame bytes for every full block to 'out'; drain 'out' between calls to keep memory flat. */
+HARBOL_EXPORT bool harbol_lz_encoder_write(struct HarbolLZEncoder *const restrict enc, const void *const restrict data, size_t len, struct HarbolByteBuffer *const restrict out)
+{
+	if( !enc || !enc->BlockSize || !out || (!data && len) || !_harbol_lz_encoder_start(enc, out) )
+		return false;
+	
+	const uint8_t *iter = data;
+	// top up a partial block first.
+	if( enc->Pending.Count ) {
+		const size_t pending = enc->Pending.Count;
+		const size_t take = ( len < enc->BlockSize - pending ) ? len : enc->BlockSize - pending;
+		harbol_bytebuffer_insert_obj(&enc->Pending, iter, take);
+		if( enc->Pending.Count != pending + take )
+			return false;
+		else if( enc->Pending.Count < enc->BlockSize )
+			return true;
+		
+		iter += take, len -= take;
+		if( !_harbol_lz_emit_block(enc->Pending.Buffer, enc->Pending.Count, out) )
+			return false;
+		harbol_bytebuffer_clear(&enc->Pending);
+	}
+	// whole blocks come straight from the caller's memory.
+	for(; len >= enc->BlockSize; iter += enc->BlockSize, len -= enc->BlockSize )
+		if( !_harbol_lz_emit_block(iter, enc->BlockSize, out) )
+			return false;
+	
+	if( len ) {
+		harbol_bytebuffer_insert_obj(&enc->Pending, iter, len);
+		return enc->Pending.Count==len;
+	}
+	return true;
+}
+
+/* flushes the last partial block and ends the frame. */
+HARBOL_EXPORT bool harbol_lz_encoder_finish(struct HarbolLZEncoder *const restrict enc, struct HarbolByteBuffer *const restrict out)
+{
+	if( !enc || !enc->BlockSize || !out || !_harbol_lz_encoder_start(enc, out) )
+		return false;
+	else if( enc->Pending.Count && !_harbol_lz_emit_block(enc->Pending.Buffer, enc->Pending.Count, out) )
+		return false;
+	
+	harbol_bytebuffer_clear(&enc->Pending);
+	uint8_t *const end = harbol_bytebuffer_prepare(out, 4);
+	if( !end )
+		return false;
+	
+	_harbol_lz_put_u32(end, 0);
+	enc->Started = false;
+	return harbol_bytebuffer_commit(out, 4);
+}
+/////////////////////////////////////////
+
+
+/* LZ Frame Decoder code */
+/////////////////////////////////////////
+HARBOL_EXPORT void harbol_lz_decoder_init(struct HarbolLZDecoder *const dec)
+{
+	if( !dec )
+		return;
+	
+	memset(dec, 0, sizeof *dec);
+}
+
+HARBOL_EXPORT void harbol_lz_decoder_del(struct HarbolLZDecoder *const dec)
+{
+	if( !dec )
+		return;
+	
+	harbol_bytebuffer_del(&dec->Pending);
+	memset(dec, 0, sizeof *dec);
+}
+
+HARBOL_EXPORT bool harbol_lz_decoder_is_done(const struct HarbolLZDecoder *const dec)
+{
+	return dec && dec->Done;
+}
+
+/* decodes whatever complete blocks are available into 'out', keeping a partial block for the next call.
+ * fails on a malformed frame or data after the end mark.
+ */
+static bool _harbol_lz_decoder_step(struct HarbolLZDecoder *const restrict dec, const uint8_t *const restrict in, const size_t len, size_t *const restrict used, struct HarbolByteBuffer *const restrict out)
+{
+	size_t pos = 0;
+	if( !dec->Started ) {
+		if( len < 8 )
+			return true;
+		else if( _harbol_lz_get_u32(in) != HARBOL_LZ_MAGIC )
+			return false;
+		
+		dec->BlockSize = _harbol_lz_get_u32(in + 4);
+		if( !dec->BlockSize || dec->BlockSize > HARBOL_LZ_MAX_BLOCK_SIZE )
+			return false;
+		dec->Started = true;
+		pos = 8;
+	}
+	while( !dec->Done && len - pos >= 4 ) {
+		const uint32_t code = _harbol_lz_get_u32(in + pos);
+		if( !code ) {
+			dec->Done = true;
+			pos += 4;
+			break;
+		}
+		else if( len - pos < 8 )
+			break;
+		
+		const size_t stored = code & ~HARBOL_LZ_RAW_FLAG, raw = _harbol_lz_get_u32(in + pos + 4);
+		if( raw > dec->BlockSize || stored > harbol_lz_compress_bound(dec->BlockSize) || ((code & HARBOL_LZ_RAW_FLAG) && stored != raw) )
+			return false;
+		else if( len - pos - 8 < stored )
+			break;
+		
+		const uint8_t *const block = in + pos + 8;
+		if( code & HARBOL_LZ_RAW_FLAG ) {
+			const size_t written = out->Count;
+			harbol_bytebuffer_insert_obj(out, block, raw);
+			if( out->Count != written + raw )
+				return false;
+		}
+		else if( !harbol_lz_decompress_block(block, stored, raw, out) )
+			return false;
+		pos += 8 + stored;
+	}
+	*used = pos;
+	return !(dec->Done && pos < len);
+}
+
+HARBOL_EXPORT bool harbol_lz_decoder_write(struct HarbolLZDecoder *const restrict dec, const void *const restrict data, const size_t len, struct HarbolByteBuffer *const restrict out)
+{
+	if( !dec || dec->Failed || !out || (!data && len) )
+		return false;
+	else if( dec->Done )
+		return !len;
+	
+	size_t used = 0;
+	if( !dec->Pending.Count ) {
+		// decode straight out of the caller's memory and only keep the leftover tail.
+		if( !_harbol_lz_decoder_step(dec, data, len, &used, out) ) {
+			dec->Failed = true;
+			return false;
+		}
+		if( used < len ) {
+			harbol_bytebuffer_insert_obj(&dec->Pending, (const uint8_t *)data + used, len - used);
+			if( dec->Pending.Count != len - used ) {
+				dec->Failed = true;
+				return false;
+			}
+		}
+		return true;
+	}
+	const size_t pending = dec->Pending.Count;
+	harbol_bytebuffer_insert_obj(&dec->Pending, data, len);
+	if( dec->Pending.Count != pending + len || !_harbol_lz_decoder_step(dec, dec->Pending.Buffer, dec->Pending.Count, &used, out) ) {
+		dec->Failed = true;
+		return false;
+	}
+	
+	memmove(dec->Pending.Buffer, dec->Pending.Buffer + used, dec->Pending.Count - used);
+	dec->Pending.Count -= used;
+	return true;
+}
+/////////////////////////////////////////
+
+
+/* LZ Frame helper code */
+/////////////////////////////////////////
+/* compresses a whole buffer into one frame appended to 'dst'. */
+HARBOL_EXPORT bool harbol_lz_compress_buffer(const struct HarbolByteBuffer *const restrict src, struct HarbolByteBuffer *const restrict dst, const size_t block_size)
+{
+	if( !src || !dst )
+		return false;
+	
+	struct HarbolLZEncoder enc;
+	harbol_lz_encoder_init(&enc, block_size);
+	const bool res = harbol_lz_encoder_write(&enc, src->Buffer, src->Count, dst) && harbol_lz_encoder_finish(&enc, dst);
+	harbol_lz_encoder_del(&enc);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_lz_decompress_buffer(const struct HarbolByteBuffer *const restrict src, struct HarbolByteBuffer *const restrict dst)
+{
+	if( !src || !dst )
+		return false;
+	
+	struct HarbolLZDecoder dec;
+	harbol_lz_decoder_init(&dec);
+	const bool res = harbol_lz_decoder_write(&dec, src->Buffer, src->Count, dst) && harbol_lz_decoder_is_done(&dec);
+	harbol_lz_decoder_del(&dec);
+	return res;
+}
+
+/* streams 'in' to 'out' one block at a time, so neither has to fit in memory. */
+HARBOL_EXPORT bool harbol_lz_compress_file(FILE *const restrict in, FILE *const restrict out, const size_t block_size)
+{
+	if( !in || !out )
+		return false;
+	
+	struct HarbolLZEncoder enc;
+	harbol_lz_encoder_init(&enc, block_size);
+	struct HarbolByteBuffer chunk = (struct HarbolByteBuffer){0}, frame = (struct HarbolByteBuffer){0};
+	bool res = harbol_bytebuffer_reserve(&chunk, enc.BlockSize);
+	while( res ) {
+		chunk.Count = fread(chunk.Buffer, 1, enc.BlockSize, in);
+		if( !chunk.Count )
+			break;
+		
+		res = harbol_lz_encoder_write(&enc, chunk.Buffer, chunk.Count, &frame) && fwrite(frame.Buffer, 1, frame.Count, out)==frame.Count;
+		harbol_bytebuffer_clear(&frame);
+	}
+	res = res && !ferror(in) && harbol_lz_encoder_finish(&enc, &frame) && fwrite(frame.Buffer, 1, frame.Count, out)==frame.Count;
+	harbol_bytebuffer_del(&chunk);
+	harbol_bytebuffer_del(&frame);
+	harbol_lz_encoder_del(&enc);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_lz_decompress_file(FILE *const restrict in, FILE *const restrict out)
+{
+	if( !in || !out )
+		return false;
+	
+	struct HarbolLZDecoder dec;
+	harbol_lz_decoder_init(&dec);
+	uint8_t chunk[1 << 16];
+	struct HarbolByteBuffer raw = (struct HarbolByteBuffer){0};
+	bool res = true;
+	for( size_t got = fread(chunk, 1, sizeof chunk, in); res && got; got = fread(chunk, 1, sizeof chunk, in) ) {
+		res = harbol_lz_decoder_write(&dec, chunk, got, &raw) && fwrite(raw.Buffer, 1, raw.Count, out)==raw.Count;
+		harbol_bytebuffer_clear(&raw);
+	}
+	res = res && !ferror(in) && harbol_lz_decoder_is_done(&dec);
+	harbol_bytebuffer_del(&raw);
+	harbol_lz_decoder_del(&dec);
+	return res;
+}
+/////////////////////////////////////////
@@ -0,0 +1,168 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolObjPool {
+	struct HarbolObjPoolChunk *Chunks, **Sorted;
+	void *FreeList;
+	uint8_t *Bump, *BumpEnd;
+	size_t ObjSize, ChunkObjs, Count, ChunkCount;
+} HarbolObjPool;
+*/
+
+/* chunks start small so tiny containers don't pay for a big slab, then double up to this many bytes. */
+#define HARBOL_OBJPOOL_FIRST_CHUNK    8
+#define HARBOL_OBJPOOL_MAX_CHUNK_BYTES    (64 * 1024)
+
+struct HarbolObjPoolChunk {
+	struct HarbolObjPoolChunk *Next;
+	size_t Size; /* bytes of object space following this header. */
+};
+
+static inline size_t _harbol_objpool_header_size(void)
+{
+	return harbol_align_size(sizeof(struct HarbolObjPoolChunk), sizeof(union HarbolValue));
+}
+
+HARBOL_EXPORT struct HarbolObjPool *harbol_objpool_new(const size_t objsize)
+{
+	struct HarbolObjPool *pool = calloc(1, sizeof *pool);
+	harbol_objpool_init(pool, objsize);
+	return pool;
+}
+
+HARBOL_EXPORT void harbol_objpool_init(struct HarbolObjPool *const pool, const size_t objsize)
+{
+	if( !pool )
+		return;
+	
+	memset(pool, 0, sizeof *pool);
+	// every object must be able to hold the freelist link and stay aligned for any HarbolValue member.
+	pool->ObjSize = harbol_align_size(objsize < sizeof(void *) ? sizeof(void *) : objsize, sizeof(union HarbolValue));
+	pool->ChunkObjs = HARBOL_OBJPOOL_FIRST_CHUNK;
+}
+
+HARBOL_EXPORT void harbol_objpool_del(struct HarbolObjPool *const pool)
+{
+	if( !pool )
+		return;
+	
+	for( struct HarbolObjPoolChunk *chunk = pool->Chunks; chunk; ) {
+		struct HarbolObjPoolChunk *const next = chunk->Next;
+		free(chunk);
+		chunk = next;
+	}
+	free(pool->Sorted);
+	const size_t objsize = pool->ObjSize;
+	harbol_objpool_init(pool, objsize);
+}
+
+HARBOL_EXPORT void harbol_objpool_free(struct HarbolObjPool **poolref)
+{
+	if( !poolref || !*poolref )
+		return;
+	
+	harbol_objpool_del(*poolref);
+	free(*poolref), *poolref=NULL;
+}
+
+static bool _harbol_objpool_add_chunk(struct HarbolObjPool *const pool)
+{
+	const size_t size = pool->ObjSize * pool->ChunkObjs;
+	struct HarbolObjPoolChunk **const sorted = realloc(pool->Sorted, (pool->ChunkCount + 1) * sizeof *sorted);
+	if( !sorted )
+		return false;
+	pool->Sorted = sorted;
+	
+	struct HarbolObjPoolChunk *const chunk = malloc(_harbol_objpool_header_size() + size);
+	if( !chunk )
+		return false;
+	
+	size_t i = pool->ChunkCount++;
+	for( ; i>0 && (uintptr_t)sorted[i-1] > (uintptr_t)chunk; i-- )
+		sorted[i] = sorted[i-1];
+	sorted[i] = chunk;
+	
+	chunk->Size = size;
+	chunk->Next = pool->Chunks;
+	pool->Chunks = chunk;
+	pool->Bump = (uint8_t *)chunk + _harbol_objpool_header_size();
+	pool->BumpEnd = pool->Bump + size;
+	if( (pool->ChunkObjs << 1) * pool->ObjSize <= HARBOL_OBJPOOL_MAX_CHUNK_BYTES )
+		pool->ChunkObjs <<= 1;
+	return true;
+}
+
+HARBOL_EXPORT void *harbol_objpool_alloc(struct HarbolObjPool *const pool)
+{
+	if( !pool || !pool->ObjSize )
+		return NULL;
+	
+	void *obj = NULL;
+	if( pool->FreeList ) {
+		obj = pool->FreeList;
+		pool->FreeList = *(void **)obj;
+	} else {
+		if( pool->Bump==pool->BumpEnd && !_harbol_objpool_add_chunk(pool) )
+			return NULL;
+		obj = pool->Bump;
+		pool->Bump += pool->ObjSize;
+	}
+	pool->Count++;
+	return memset(obj, 0, pool->ObjSize);
+}
+
+HARBOL_EXPORT void harbol_objpool_dealloc(struct HarbolObjPool *const restrict pool, void *const ptr)
+{
+	if( !pool || !ptr )
+		return;
+	
+	*(void **)ptr = pool->FreeList;
+	pool->FreeList = ptr;
+	pool->Count--;
+}
+
+HARBOL_EXPORT bool harbol_objpool_owns(const struct HarbolObjPool *const restrict pool, const void *const ptr)
+{
+	if( !pool || !ptr )
+		return false;
+	
+	// find the last chunk starting at or below 'ptr', then see if 'ptr' falls inside it.
+	size_t lo = 0, hi = pool->ChunkCount;
+	while( lo < hi ) {
+		const size_t mid = (lo + hi) >> 1;
+		if( (uintptr_t)pool->Sorted[mid] <= (uintptr_t)ptr )
+			lo = mid + 1;
+		else hi = mid;
+	}
+	if( !lo )
+		return false;
+	
+	const struct HarbolObjPoolChunk *const chunk = pool->Sorted[lo - 1];
+	const uintptr_t start = (uintptr_t)chunk + _harbol_objpool_header_size();
+	return (uintptr_t)ptr >= start && (uintptr_t)ptr < start + chunk->Size;
+}
+
+HARBOL_EXPORT size_t harbol_objpool_get_count(const struct HarbolObjPool *const pool)
+{
+	return pool ? pool->Count : 0;
+}
+
+HARBOL_EXPORT size_t harbol_objpool_get_obj_size(const struct HarbolObjPool *const pool)
+{
+	return pool ? pool->ObjSize : 0;
+}
+
+HARBOL_EXPORT size_t harbol_objpool_get_total_bytes(const struct HarbolObjPool *const pool)
+{
+	if( !pool )
+		return 0;
+	
+	size_t total = 0;
+	for( const struct HarbolObjPoolChunk *chunk = pool->Chunks; chunk; chunk = chunk->Next )
+		total += _harbol_objpool_header_size() + chunk->Size;
+	return total;
+}
@@ -185,7 +185,7 @@ dir_iter_loop:;
 			break;
 	}
 	tinydir_close(dir);
-	return manager->Plugins.Order.Count > 0;
+	return harbol_linkmap_get_count(&manager->Plugins) > 0;
 }
 
 static bool _recursive_scan_by_name(struct HarbolPluginManager *const restrict manager, tinydir_dir *const restrict dir, const char plugin_name[restrict], fnHarbolPluginEvent *const load_cb)
@@ -217,7 +217,7 @@ dir_iter_loop:;
 			break;
 	}
 	tinydir_close(dir);
-	return manager->Plugins.Order.Count > 0;
+	return harbol_linkmap_get_count(&manager->Plugins) > 0;
 }
 
 HARBOL_EXPORT bool harbol_plugin_manager_init(struct HarbolPluginManager *const restrict manager, const char directory[restrict], const bool load_plugins, fnHarbolPluginEvent *const load_cb)
@@ -269,9 +269,9 @@ HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_manager_get_plugin_by_name(cons
 	return !manager ? NULL : harbol_linkmap_get(&manager->Plugins, plugin_name).Ptr;
 }
 
-HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_manager_get_plugin_by_index(const struct HarbolPluginManager *const manager, const size_t index)
+HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_manager_get_plugin_by_index(struct HarbolPluginManager *const manager, const size_t index)
 {
-	return !manager || index >= manager->Plugins.Order.Count ? NULL : manager->Plugins.Order.Table[index].Ptr;
+	return !manager ? NULL : harbol_linkmap_get_by_index(&manager->Plugins, index).Ptr;
 }
 
 HARBOL_EXPORT const char *harbol_plugin_manager_get_plugin_dir(const struct HarbolPluginManager *manager)
@@ -281,7 +281,7 @@ HARBOL_EXPORT const char *harbol_plugin_manager_get_plugin_dir(const struct Harb
 
 HARBOL_EXPORT size_t harbol_plugin_manager_get_plugin_count(const struct HarbolPluginManager *manager)
 {
-	return !manager ? 0 : manager->Plugins.Order.Count;
+	return !manager ? 0 : harbol_linkmap_get_count(&manager->Plugins);
 }
 
 HARBOL_EXPORT bool harbol_plugin_manager_load_plugin_by_name(struct HarbolPluginManager *const restrict manager, const char plugin_name[restrict], fnHarbolPluginEvent *const load_cb)
@@ -349,8 +349,9 @@ HARBOL_EXPORT bool harbol_plugin_manager_unload_plugins(struct HarbolPluginManag
 	if( !manager )
 		return false;
 	else {
-		for( size_t i=0; i<manager->Plugins.Order.Count; i++ ) {
-			struct HarbolPlugin *plugin = harbol_plugin_manager_get_plugin_by_index(manager, i);
+		const union HarbolValue *const end = harbol_linkmap_get_iter_end_count(&manager->Plugins);
+		for( const union HarbolValue *iter = harbol_linkmap_get_iter(&manager->Plugins); iter && iter<end; iter++ ) {
+			struct HarbolPlugin *plugin = iter->KvPairPtr->Data.Ptr;
 			if( unload_cb )
 				(*unload_cb)(manager, &plugin);
 		}
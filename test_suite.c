@@ -1,18 +1,39 @@
 #include <assert.h>
 #include <stdalign.h>
+#include <stdatomic.h>
 #include "harbol.h"
+#ifndef OS_WINDOWS
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
 
 void test_harbol_string(void);
 void test_harbol_vector(void);
 void test_harbol_hashmap(void);
+void test_harbol_hashset(void);
 void test_harbol_unilist(void);
 void test_harbol_bilist(void);
+void test_harbol_unrolled(void);
+void test_harbol_lockfree(void);
 void test_harbol_bytebuffer(void);
+void test_harbol_bytecursor(void);
+void test_harbol_lz(void);
+void test_harbol_checksum(void);
+void test_harbol_encoding(void);
 void test_harbol_tuple(void);
+void test_harbol_coltable(void);
 void test_harbol_mempool(void);
+void test_harbol_objpool(void);
 void test_harbol_graph(void);
 void test_harbol_tree(void);
+void test_harbol_intrusive(void);
+void test_harbol_bufchain(void);
+void test_harbol_filewriter(void);
 void test_harbol_linkmap(void);
+void test_harbol_frozenmap(void);
+void test_harbol_cache(void);
+void test_harbol_bptree(void);
 void test_conversions(void);
 void test_harbol_cfg(void);
 void test_harbol_plugins(void);
@@ -30,14 +51,29 @@ int main()
 	test_harbol_string();
 	test_harbol_vector();
 	test_harbol_hashmap();
+	test_harbol_hashset();
 	test_harbol_unilist();
 	test_harbol_bilist();
+	test_harbol_unrolled();
+	test_harbol_lockfree();
 	test_harbol_bytebuffer();
+	test_harbol_bytecursor();
+	test_harbol_lz();
+	test_harbol_checksum();
+	test_harbol_encoding();
 	test_harbol_tuple();
+	test_harbol_coltable();
 	test_harbol_mempool();
+	test_harbol_objpool();
 	test_harbol_graph();
 	test_harbol_tree();
+	test_harbol_intrusive();
+	test_harbol_bufchain();
+	test_harbol_filewriter();
 	test_harbol_linkmap();
+	test_harbol_frozenmap();
+	test_harbol_cache();
+	test_harbol_bptree();
 	test_conversions();
 	test_harbol_cfg();
 	test_harbol_plugins();
@@ -231,6 +267,12 @@ void test_harbol_hashmap(void)
 	
 	struct HarbolHashMap i = (struct HarbolHashMap){0};
 	
+	// standalone nodes with short keys are smaller than the struct's padded size.
+	struct HarbolKeyValPair *kv = harbol_kvpair_new_strval("a", (union HarbolValue){.Int64=1});
+	assert( kv && kv->KeyName.Len==1 && !strcmp(kv->KeyName.CStr, "a") && !kv->PoolClass && kv->Data.Int64==1 );
+	harbol_kvpair_free(&kv, NULL);
+	assert( !kv );
+	
 	// test insertion
 	fputs("hashmap :: test insertion.", g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
@@ -263,6 +305,121 @@ void test_harbol_hashmap(void)
 	harbol_hashmap_delete(p, "2", NULL);
 	fprintf(g_harbol_debug_stream, "ptr[\"2\"] == %" PRIi64 "\n", harbol_hashmap_get(p, "2").Int64);
 	
+	// test incremental rehashing.
+	fputs("hashmap :: test incremental rehashing.", g_harbol_debug_stream);
+	fputs("\n", g_harbol_debug_stream);
+	{
+		struct HarbolHashMap inc = (struct HarbolHashMap){0};
+		harbol_hashmap_set_incremental(&inc, true);
+		size_t rehashes = 0;
+		for( int64_t n=0; n<1000; n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			assert( harbol_hashmap_insert(&inc, key, (union HarbolValue){.Int64=n}) );
+			rehashes += harbol_hashmap_is_rehashing(&inc);
+			// duplicates must be rejected even when the insert is the one growing the table.
+			assert( !harbol_hashmap_insert(&inc, key, (union HarbolValue){.Int64=-1}) );
+		}
+		for( int64_t n=0; n<1000; n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			assert( harbol_hashmap_get(&inc, key).Int64==n );
+		}
+		fprintf(g_harbol_debug_stream, "inserts that saw a migration in flight: '%zu' | count: '%zu' | len: '%zu'\n", rehashes, harbol_hashmap_get_count(&inc), harbol_hashmap_get_len(&inc));
+		
+		struct HarbolVector values = (struct HarbolVector){0};
+		harbol_vector_from_hashmap(&values, &inc);
+		assert( values.Count==1000 );
+		harbol_vector_del(&values, NULL);
+		
+		// every node is reachable through '_get_bucket' while a migration is in flight.
+		for( int64_t n=1000; !harbol_hashmap_is_rehashing(&inc); n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			assert( n < 100000 && harbol_hashmap_insert(&inc, key, (union HarbolValue){.Int64=n}) );
+		}
+		size_t nodes = 0;
+		for( size_t i=0; i<harbol_hashmap_get_bucket_count(&inc); i++ )
+			nodes += harbol_hashmap_get_bucket(&inc, i)->Count;
+		assert( nodes==harbol_hashmap_get_count(&inc) && !harbol_hashmap_get_bucket(&inc, harbol_hashmap_get_bucket_count(&inc)) );
+		
+		harbol_hashmap_finish_rehash(&inc);
+		assert( !harbol_hashmap_is_rehashing(&inc) );
+		harbol_hashmap_del(&inc, NULL);
+		
+		// reserving upfront means a bulk load never rehashes.
+		harbol_hashmap_reserve(&inc, 1000);
+		const size_t reserved_len = harbol_hashmap_get_len(&inc);
+		for( int64_t n=0; n<1000; n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			harbol_hashmap_insert(&inc, key, (union HarbolValue){.Int64=n});
+		}
+		fprintf(g_harbol_debug_stream, "reserved len: '%zu' | len after bulk load: '%zu'\n", reserved_len, harbol_hashmap_get_len(&inc));
+		assert( reserved_len==harbol_hashmap_get_len(&inc) );
+		harbol_hashmap_del(&inc, NULL);
+	}
+	
+	// test pooled nodes with inline keys.
+	fputs("hashmap :: test pooled nodes.", g_harbol_debug_stream);
+	fputs("\n", g_harbol_debug_stream);
+	{
+		struct HarbolHashMap pooled = (struct HarbolHashMap){0};
+		harbol_hashmap_insert(&pooled, "short", (union HarbolValue){.Int64=1});
+		struct HarbolKeyValPair *const kv = harbol_hashmap_get_node(&pooled, "short");
+		assert( kv->KeyName.CStr==kv->KeyBuf );
+		assert( kv->PoolClass==1 );
+		assert( harbol_objpool_owns(pooled.NodePools, kv) );
+		
+		// a deleted node's slot is the next one handed out for the same size class.
+		harbol_hashmap_delete(&pooled, "short", NULL);
+		harbol_hashmap_insert(&pooled, "other", (union HarbolValue){.Int64=2});
+		assert( harbol_hashmap_get_node(&pooled, "other")==kv );
+		
+		// keys too big for any size class fall back to their own allocation.
+		char longkey[HARBOL_KVPAIR_POOL_CLASSES * HARBOL_KVPAIR_POOL_STEP + 1];
+		memset(longkey, 'k', sizeof longkey - 1);
+		longkey[sizeof longkey - 1] = 0;
+		harbol_hashmap_insert(&pooled, longkey, (union HarbolValue){.Int64=3});
+		const struct HarbolKeyValPair *const big = harbol_hashmap_get_node(&pooled, longkey);
+		assert( big->PoolClass==0 && big->KeyName.Len==sizeof longkey - 1 );
+		fprintf(g_harbol_debug_stream, "pooled nodes: '%zu' | pool obj size: '%zu'\n", harbol_objpool_get_count(pooled.NodePools), harbol_objpool_get_obj_size(pooled.NodePools));
+		harbol_hashmap_del(&pooled, NULL);
+	}
+	
+	// test stats.
+	fputs("hashmap :: test stats.", g_harbol_debug_stream);
+	fputs("\n", g_harbol_debug_stream);
+	{
+		struct HarbolHashMap counted = (struct HarbolHashMap){0};
+		for( int64_t n=0; n<100; n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			harbol_hashmap_insert(&counted, key, (union HarbolValue){.Int64=n});
+		}
+		harbol_hashmap_reset_ops(&counted);
+		harbol_hashmap_get(&counted, "50");
+		harbol_hashmap_delete(&counted, "50", NULL);
+		
+		struct HarbolHashMapStats stats;
+		assert( harbol_hashmap_get_stats(&counted, &stats) );
+		harbol_hashmap_stats_to_file(&stats, g_harbol_debug_stream);
+		size_t buckets = 0, nodes = 0;
+		for( size_t n=0; n<=HARBOL_HASHMAP_STATS_MAX_CHAIN; n++ ) {
+			buckets += stats.ChainHistogram[n];
+			nodes += stats.ChainHistogram[n] * n;
+		}
+		assert( stats.Count==99 && buckets==stats.Buckets && buckets==harbol_hashmap_get_len(&counted) );
+		assert( stats.MaxChainLen > HARBOL_HASHMAP_STATS_MAX_CHAIN || nodes==stats.Count );
+		assert( stats.Rehashes > 0 && stats.AvgProbeLen >= 1.0 && stats.NodeBytes > stats.KeyBytes );
+#ifdef HARBOL_STATS
+		assert( stats.Ops.Lookups==2 && stats.Ops.Deletes==1 && stats.Ops.Inserts==0 );
+#else
+		assert( !counted.Counters && !stats.Ops.Lookups && !stats.Ops.Deletes );
+#endif
+		harbol_hashmap_del(&counted, NULL);
+	}
+	
 	// free data
 	fputs("hashmap :: test destruction.", g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
@@ -275,6 +432,104 @@ void test_harbol_hashmap(void)
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
 }
 
+void test_harbol_hashset(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test allocation and initializations
+	fputs("hashset :: test allocation/initialization.\n", g_harbol_debug_stream);
+	struct HarbolHashSet i = (struct HarbolHashSet){0};
+	harbol_hashset_init(&i, HarbolSetKeyInt);
+	struct HarbolHashSet *p = harbol_hashset_new(HarbolSetKeyStr);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// test insertion, membership & removal
+	fputs("hashset :: test insertion, membership & removal.\n", g_harbol_debug_stream);
+	for( int64_t n=0; n<1000; n++ )
+		assert( harbol_hashset_insert(&i, (union HarbolValue){.Int64=n * 3}) );
+	assert( !harbol_hashset_insert(&i, (union HarbolValue){.Int64=3}) );
+	for( int64_t n=0; n<3000; n++ )
+		assert( harbol_hashset_has(&i, (union HarbolValue){.Int64=n}) == !(n % 3) );
+	// removing every other key exercises the backward shift within probe clusters.
+	for( int64_t n=0; n<1000; n += 2 )
+		assert( harbol_hashset_remove(&i, (union HarbolValue){.Int64=n * 3}) );
+	assert( !harbol_hashset_remove(&i, (union HarbolValue){.Int64=0}) );
+	for( int64_t n=0; n<1000; n++ )
+		assert( harbol_hashset_has(&i, (union HarbolValue){.Int64=n * 3}) == (n & 1) );
+	fprintf(g_harbol_debug_stream, "i count: '%zu' | len: '%zu'\n", harbol_hashset_get_count(&i), harbol_hashset_get_len(&i));
+	
+	char key[] = "harbol";
+	harbol_hashset_insert_cstr(p, key);
+	harbol_hashset_insert_cstr(p, "hash");
+	harbol_hashset_insert_cstr(p, "set");
+	key[0] = 'H';
+	// string keys are copied, so changing the original doesn't touch the set.
+	assert( harbol_hashset_has_cstr(p, "harbol") && !harbol_hashset_has_cstr(p, key) );
+	assert( harbol_hashset_remove_cstr(p, "hash") && !harbol_hashset_has_cstr(p, "hash") );
+	
+	union HarbolValue k;
+	for( size_t iter=0; harbol_hashset_next(p, &iter, &k); )
+		fprintf(g_harbol_debug_stream, "p key: '%s'\n", (const char *)k.Ptr);
+	
+	// test pointer keys
+	int x = 0, y = 0;
+	struct HarbolHashSet ptrs = (struct HarbolHashSet){0};
+	harbol_hashset_init(&ptrs, HarbolSetKeyPtr);
+	harbol_hashset_insert(&ptrs, (union HarbolValue){.Ptr=&x});
+	assert( harbol_hashset_has(&ptrs, (union HarbolValue){.Ptr=&x}) && !harbol_hashset_has(&ptrs, (union HarbolValue){.Ptr=&y}) );
+	harbol_hashset_del(&ptrs);
+	
+	// test set algebra
+	fputs("hashset :: test set algebra.\n", g_harbol_debug_stream);
+	struct HarbolVector evens = (struct HarbolVector){0}, threes = (struct HarbolVector){0};
+	for( int64_t n=0; n<30; n += 2 )
+		harbol_vector_insert(&evens, (union HarbolValue){.Int64=n});
+	for( int64_t n=0; n<30; n += 3 )
+		harbol_vector_insert(&threes, (union HarbolValue){.Int64=n});
+	struct HarbolHashSet *a = harbol_hashset_new_from_vector(&evens, HarbolSetKeyInt);
+	struct HarbolHashSet *b = harbol_hashset_new_from_vector(&threes, HarbolSetKeyInt);
+	struct HarbolHashSet result = (struct HarbolHashSet){0};
+	
+	assert( harbol_hashset_union(&result, a, b) );
+	fprintf(g_harbol_debug_stream, "union count: '%zu'\n", harbol_hashset_get_count(&result));
+	assert( harbol_hashset_get_count(&result)==20 && harbol_hashset_is_subset(a, &result) && harbol_hashset_is_subset(b, &result) );
+	
+	assert( harbol_hashset_intersection(&result, a, b) );
+	fprintf(g_harbol_debug_stream, "intersection count: '%zu'\n", harbol_hashset_get_count(&result));
+	assert( harbol_hashset_get_count(&result)==5 && harbol_hashset_has(&result, (union HarbolValue){.Int64=18}) );
+	
+	// difference both ways round, since each direction takes a different path.
+	assert( harbol_hashset_difference(&result, a, b) );
+	assert( harbol_hashset_get_count(&result)==10 && !harbol_hashset_has(&result, (union HarbolValue){.Int64=6}) );
+	assert( harbol_hashset_difference(&result, b, a) );
+	assert( harbol_hashset_get_count(&result)==5 && harbol_hashset_has(&result, (union HarbolValue){.Int64=9}) );
+	assert( !harbol_hashset_union(&result, a, p) );
+	
+	struct HarbolVector *values = harbol_vector_new_from_hashset(&result);
+	assert( harbol_vector_get_count(values)==5 );
+	harbol_vector_free(&values, NULL);
+	harbol_vector_del(&evens, NULL);
+	harbol_vector_del(&threes, NULL);
+	harbol_hashset_free(&a);
+	harbol_hashset_free(&b);
+	harbol_hashset_del(&result);
+	
+	// free data
+	fputs("hashset :: test destruction.\n", g_harbol_debug_stream);
+	harbol_hashset_del(&i);
+	fprintf(g_harbol_debug_stream, "i's table is null? '%s'\n", i.Table ? "no" : "yes");
+	harbol_hashset_free(&p);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+}
+
+/* compares only the tens so equal keys keep showing whether a sort was stable. */
+static int _test_cmp_tens(const union HarbolValue a, const union HarbolValue b)
+{
+	const int64_t x = a.Int64 / 10, y = b.Int64 / 10;
+	return ( x > y ) - ( x < y );
+}
+
 void test_harbol_unilist(void)
 {
 	// Test allocation and initializations
@@ -398,6 +653,89 @@ void test_harbol_unilist(void)
 	fprintf(g_harbol_debug_stream, "p's Head is null? '%s', but is p null? '%s'\n", p->Head ? "no" : "yes", p ? "no" : "yes");
 	harbol_unilist_free(&p, NULL);
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// test node pooling, with two lists sharing one pool.
+	fputs("unilist :: test pooled nodes.\n", g_harbol_debug_stream);
+	struct HarbolObjPool pool = (struct HarbolObjPool){0};
+	harbol_objpool_init(&pool, sizeof(struct HarbolUniListNode));
+	struct HarbolUniList a = (struct HarbolUniList){0}, b = (struct HarbolUniList){0};
+	assert( harbol_unilist_set_pool(&a, &pool) && harbol_unilist_set_pool(&b, &pool) );
+	for( int64_t n=0; n<100000; n++ )
+		harbol_unilist_insert_at_tail(( n & 1 ) ? &b : &a, (union HarbolValue){.Int64=n});
+	// a heap-made node can still go in a pooled list.
+	harbol_unilist_insert_node_at_head(&a, harbol_unilistnode_new_val((union HarbolValue){.Int64=-1}));
+	assert( harbol_unilist_get_len(&a)==50001 && harbol_unilist_get_len(&b)==50000 );
+	fprintf(g_harbol_debug_stream, "pooled nodes: '%zu' | pool bytes: '%zu'\n", harbol_objpool_get_count(&pool), harbol_objpool_get_total_bytes(&pool));
+	assert( harbol_objpool_get_count(&pool)==100000 );
+	// a list can't switch pools while it holds nodes.
+	assert( !harbol_unilist_set_pool(&a, NULL) );
+	harbol_unilist_del_node_by_index(&a, 0, NULL);
+	harbol_unilist_del_node_by_index(&a, 0, NULL);
+	assert( harbol_unilist_get_val(&a, 0).Int64==2 && harbol_objpool_get_count(&pool)==99999 );
+	// freed nodes get recycled before the pool grows.
+	const size_t pool_bytes = harbol_objpool_get_total_bytes(&pool);
+	harbol_unilist_insert_at_head(&a, (union HarbolValue){.Int64=0});
+	assert( harbol_objpool_get_total_bytes(&pool)==pool_bytes );
+	harbol_unilist_del(&a, NULL);
+	assert( harbol_unilist_get_pool(&a)==&pool && harbol_objpool_get_count(&pool)==50000 );
+	harbol_unilist_del(&b, NULL);
+	assert( !harbol_objpool_get_count(&pool) );
+	harbol_objpool_del(&pool);
+	
+	// test splicing, concatenating, splitting and sorting.
+	fputs("unilist :: test splice/concat/split/sort.\n", g_harbol_debug_stream);
+	for( int64_t n=0; n<10; n++ ) {
+		harbol_unilist_insert_at_tail(&a, (union HarbolValue){.Int64=n});
+		harbol_unilist_insert_at_tail(&b, (union HarbolValue){.Int64=100 + n});
+	}
+	// move a's [3..5] to right after b's first node.
+	{
+		struct HarbolUniListNode *const before = harbol_unilist_get_node_by_index(&a, 2);
+		struct HarbolUniListNode *const last = harbol_unilist_get_node_by_index(&a, 5);
+		assert( harbol_unilist_splice_after(&b, b.Head, &a, before, last, 3) );
+	}
+	assert( harbol_unilist_get_len(&a)==7 && harbol_unilist_get_len(&b)==13 );
+	assert( harbol_unilist_get_val(&a, 3).Int64==6 && harbol_unilist_get_val(&b, 1).Int64==3 && harbol_unilist_get_val(&b, 4).Int64==101 );
+	// moving a's tail (counted for us) onto b's tail keeps both tails right.
+	assert( harbol_unilist_splice_after(&b, b.Tail, &a, harbol_unilist_get_node_by_index(&a, 5), a.Tail, 0) );
+	assert( a.Tail->Data.Int64==8 && b.Tail->Data.Int64==9 && !b.Tail->Next && harbol_unilist_get_len(&b)==14 );
+	assert( harbol_unilist_concat(&a, &b) );
+	assert( !b.Head && !b.Tail && !harbol_unilist_get_len(&b) && harbol_unilist_get_len(&a)==20 && a.Tail->Data.Int64==9 );
+	assert( harbol_unilist_split_after(&a, harbol_unilist_get_node_by_index(&a, 5), &b) );
+	assert( harbol_unilist_get_len(&a)==6 && harbol_unilist_get_len(&b)==14 && a.Tail->Data.Int64==8 && !a.Tail->Next );
+	assert( harbol_unilist_concat(&a, &b) );
+	{
+		// a failed split leaves the target list on its own pool.
+		struct HarbolObjPool other = (struct HarbolObjPool){0};
+		struct HarbolUniList empty = { .Pool = &other };
+		struct HarbolUniListNode stray = (struct HarbolUniListNode){0};
+		assert( !harbol_unilist_split_after(&a, &stray, &empty) && empty.Pool==&other && !empty.Head );
+	}
+	{
+		struct HarbolUniList heap_list = (struct HarbolUniList){0};
+		harbol_unilist_insert_at_tail(&heap_list, (union HarbolValue){.Int64=0});
+		// the nodes would end up released to the wrong allocator.
+		assert( !harbol_unilist_concat(&heap_list, &a) );
+		harbol_unilist_del(&heap_list, NULL);
+	}
+	harbol_unilist_sort(&a, _test_cmp_tens);
+	{
+		// stable: values with equal tens keep the order the splices left them in.
+		const int64_t expected[] = {0,1,2,6,7,8,3,4,5,9};
+		struct HarbolUniListNode *n = a.Head;
+		for( size_t k=0; k<10; k++, n=n->Next )
+			assert( n->Data.Int64==expected[k] );
+		for( ; n && n->Next; n=n->Next )
+			assert( n->Data.Int64 < n->Next->Data.Int64 );
+	}
+	assert( harbol_unilist_get_len(&a)==20 && a.Tail->Data.Int64 >= 100 && !a.Tail->Next );
+	fputs("sorted: ", g_harbol_debug_stream);
+	for( struct HarbolUniListNode *n=a.Head; n; n=n->Next )
+		fprintf(g_harbol_debug_stream, "%" PRIi64 " ", n->Data.Int64);
+	fputs("\n", g_harbol_debug_stream);
+	harbol_unilist_del(&a, NULL);
+	harbol_unilist_del(&b, NULL);
+	harbol_objpool_del(&pool);
 }
 
 void test_harbol_bilist(void)
@@ -509,6 +847,276 @@ void test_harbol_bilist(void)
 	fprintf(g_harbol_debug_stream, "p's Head is null? '%s', but is p null? '%s'\n", p->Head ? "no" : "yes", p ? "no" : "yes");
 	harbol_bilist_free(&p, NULL);
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// test node pooling, with two lists sharing one pool.
+	fputs("bilist :: test pooled nodes.\n", g_harbol_debug_stream);
+	struct HarbolObjPool pool = (struct HarbolObjPool){0};
+	harbol_objpool_init(&pool, sizeof(struct HarbolBiListNode));
+	struct HarbolBiList a = (struct HarbolBiList){0}, b = (struct HarbolBiList){0};
+	assert( harbol_bilist_set_pool(&a, &pool) && harbol_bilist_set_pool(&b, &pool) );
+	for( int64_t n=0; n<100000; n++ )
+		harbol_bilist_insert_at_tail(( n & 1 ) ? &b : &a, (union HarbolValue){.Int64=n});
+	// a heap-made node can still go in a pooled list.
+	harbol_bilist_insert_node_at_head(&a, harbol_bilist_node_new_val((union HarbolValue){.Int64=-1}));
+	assert( harbol_bilist_get_len(&a)==50001 && harbol_bilist_get_len(&b)==50000 );
+	fprintf(g_harbol_debug_stream, "pooled nodes: '%zu' | pool bytes: '%zu'\n", harbol_objpool_get_count(&pool), harbol_objpool_get_total_bytes(&pool));
+	assert( harbol_objpool_get_count(&pool)==100000 );
+	// a list can't switch pools while it holds nodes.
+	assert( !harbol_bilist_set_pool(&a, NULL) );
+	harbol_bilist_del_node_by_index(&a, 0, NULL);
+	harbol_bilist_del_node_by_index(&a, 0, NULL);
+	assert( harbol_bilist_get_val(&a, 0).Int64==2 && harbol_objpool_get_count(&pool)==99999 );
+	// freed nodes get recycled before the pool grows.
+	const size_t pool_bytes = harbol_objpool_get_total_bytes(&pool);
+	harbol_bilist_insert_at_head(&a, (union HarbolValue){.Int64=0});
+	assert( harbol_objpool_get_total_bytes(&pool)==pool_bytes );
+	harbol_bilist_del(&a, NULL);
+	assert( harbol_bilist_get_pool(&a)==&pool && harbol_objpool_get_count(&pool)==50000 );
+	harbol_bilist_del(&b, NULL);
+	assert( !harbol_objpool_get_count(&pool) );
+	harbol_objpool_del(&pool);
+	
+	// test splicing, concatenating, splitting and sorting.
+	fputs("bilist :: test splice/concat/split/sort.\n", g_harbol_debug_stream);
+	for( int64_t n=0; n<10; n++ ) {
+		harbol_bilist_insert_at_tail(&a, (union HarbolValue){.Int64=n});
+		harbol_bilist_insert_at_tail(&b, (union HarbolValue){.Int64=100 + n});
+	}
+	// move a's [3..5] in front of b's second node.
+	assert( harbol_bilist_splice(&b, b.Head->Next, &a, harbol_bilist_get_node_by_index(&a, 3), harbol_bilist_get_node_by_index(&a, 5), 3) );
+	assert( harbol_bilist_get_len(&a)==7 && harbol_bilist_get_len(&b)==13 );
+	assert( harbol_bilist_get_val(&a, 3).Int64==6 && harbol_bilist_get_val(&b, 1).Int64==3 && harbol_bilist_get_val(&b, 4).Int64==101 );
+	// splicing within one list: a's head to its tail.
+	assert( harbol_bilist_splice(&a, NULL, &a, a.Head, a.Head, 0) );
+	assert( a.Head->Data.Int64==1 && a.Tail->Data.Int64==0 && harbol_bilist_get_len(&a)==7 );
+	assert( harbol_bilist_concat(&a, &b) );
+	assert( !b.Head && !b.Tail && !harbol_bilist_get_len(&b) && harbol_bilist_get_len(&a)==20 && a.Tail->Data.Int64==109 );
+	assert( harbol_bilist_split(&a, harbol_bilist_get_node_by_index(&a, 7), &b) );
+	assert( harbol_bilist_get_len(&a)==7 && harbol_bilist_get_len(&b)==13 && !a.Tail->Next && !b.Head->Prev && b.Head->Data.Int64==100 );
+	assert( harbol_bilist_concat(&a, &b) );
+	{
+		// a failed split leaves the target list on its own pool.
+		struct HarbolObjPool other = (struct HarbolObjPool){0};
+		struct HarbolBiList empty = { .Pool = &other };
+		struct HarbolBiListNode stray = (struct HarbolBiListNode){0};
+		assert( !harbol_bilist_split(&a, &stray, &empty) && empty.Pool==&other && !empty.Head );
+	}
+	harbol_bilist_sort(&a, _test_cmp_tens);
+	size_t count = 0;
+	for( struct HarbolBiListNode *n=a.Head; n; n=n->Next, count++ ) {
+		assert( n->Next ? n->Next->Prev==n : a.Tail==n );
+		if( n->Next ) {
+			assert( _test_cmp_tens(n->Data, n->Next->Data) <= 0 );
+			// stable: 1 was put before 0 by the splice, so it has to stay there.
+			assert( n->Data.Int64 != 0 || n->Next->Data.Int64 != 1 );
+		}
+	}
+	assert( count==20 && !a.Head->Prev );
+	fputs("sorted: ", g_harbol_debug_stream);
+	for( struct HarbolBiListNode *n=a.Head; n; n=n->Next )
+		fprintf(g_harbol_debug_stream, "%" PRIi64 " ", n->Data.Int64);
+	fputs("\n", g_harbol_debug_stream);
+	harbol_bilist_del(&a, NULL);
+	harbol_bilist_del(&b, NULL);
+	harbol_objpool_del(&pool);
+}
+
+void test_harbol_unrolled(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test allocation and initializations
+	fputs("unrolled :: test allocation/initialization.\n", g_harbol_debug_stream);
+	struct HarbolUnrolledList *p = harbol_unrolled_new();
+	assert( p );
+	fprintf(g_harbol_debug_stream, "p's len is zero? '%s'\n", !harbol_unrolled_get_len(p) ? "yes" : "no");
+	fprintf(g_harbol_debug_stream, "node size: '%zu' | values per node: '%i'\n", sizeof(struct HarbolUnrolledNode), HARBOL_UNROLLED_NODE_VALS);
+	assert( sizeof(struct HarbolUnrolledNode)==128 );
+	
+	// test appending packs nodes full.
+	fputs("unrolled :: test insertion.\n", g_harbol_debug_stream);
+	for( int64_t i=0; i<140; i++ )
+		harbol_unrolled_insert_at_tail(p, (union HarbolValue){.Int64=i});
+	assert( harbol_unrolled_get_len(p)==140 && harbol_unrolled_get_node_count(p)==10 );
+	for( size_t i=0; i<140; i++ )
+		assert( harbol_unrolled_get_val(p, i).Int64==(int64_t)i );
+	
+	// middle inserts split nodes, head inserts go into a fresh head.
+	harbol_unrolled_insert_at_index(p, (union HarbolValue){.Int64=-1}, 70);
+	harbol_unrolled_insert_at_head(p, (union HarbolValue){.Int64=-2});
+	assert( harbol_unrolled_get_val(p, 0).Int64==-2 && harbol_unrolled_get_val(p, 71).Int64==-1 && harbol_unrolled_get_val(p, 72).Int64==70 );
+	assert( harbol_unrolled_get_index_by_val(p, (union HarbolValue){.Int64=-1})==71 );
+	fprintf(g_harbol_debug_stream, "len: '%zu' | nodes: '%zu'\n", harbol_unrolled_get_len(p), harbol_unrolled_get_node_count(p));
+	
+	// test random inserts and deletes against a vector doing the same thing.
+	fputs("unrolled :: test against a vector.\n", g_harbol_debug_stream);
+	struct HarbolVector mirror = (struct HarbolVector){0};
+	harbol_vector_from_unrolled(&mirror, p);
+	uint64_t seed = 12345;
+	for( int round=0; round<20000; round++ ) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		const size_t r = (size_t)(seed >> 33);
+		const size_t len = harbol_unrolled_get_len(p);
+		if( (r & 3) != 0 || !len ) {
+			const size_t index = len ? (r >> 2) % (len + 1) : 0;
+			harbol_unrolled_insert_at_index(p, (union HarbolValue){.UInt64=r}, index);
+			harbol_vector_insert(&mirror, (union HarbolValue){0});
+			memmove(mirror.Table + index + 1, mirror.Table + index, (mirror.Count - index - 1) * sizeof *mirror.Table);
+			mirror.Table[index].UInt64 = r;
+		} else {
+			const size_t index = (r >> 2) % len;
+			assert( harbol_unrolled_del_by_index(p, index, NULL) );
+			harbol_vector_delete(&mirror, index, NULL);
+		}
+	}
+	assert( harbol_unrolled_get_len(p)==harbol_vector_get_count(&mirror) );
+	size_t index = 0;
+	for( struct HarbolUnrolledNode *n=harbol_unrolled_get_head_node(p); n; n = n->Next )
+		for( size_t i=0; i<n->Count; i++ )
+			assert( n->Vals[i].UInt64==mirror.Table[index++].UInt64 );
+	fprintf(g_harbol_debug_stream, "len: '%zu' | nodes: '%zu'\n", harbol_unrolled_get_len(p), harbol_unrolled_get_node_count(p));
+	
+	// drain it from the front.
+	while( harbol_unrolled_get_len(p) )
+		harbol_unrolled_del_by_index(p, 0, NULL);
+	assert( !harbol_unrolled_get_node_count(p) && !harbol_unrolled_get_head_node(p) && !harbol_unrolled_get_tail_node(p) );
+	harbol_vector_del(&mirror, NULL);
+	
+	// test conversions.
+	fputs("unrolled :: test conversions.\n", g_harbol_debug_stream);
+	struct HarbolBiList bilist = (struct HarbolBiList){0};
+	for( int64_t i=0; i<30; i++ )
+		harbol_bilist_insert_at_tail(&bilist, (union HarbolValue){.Int64=i});
+	harbol_unrolled_from_bilist(p, &bilist);
+	struct HarbolUniList *unilist = harbol_unilist_new_from_unrolled(p);
+	struct HarbolVector *vec = harbol_vector_new_from_unrolled(p);
+	assert( harbol_unilist_get_len(unilist)==30 && harbol_vector_get_count(vec)==30 );
+	assert( harbol_unilist_get_val(unilist, 29).Int64==29 && vec->Table[15].Int64==15 );
+	harbol_unilist_free(&unilist, NULL);
+	harbol_vector_free(&vec, NULL);
+	harbol_bilist_del(&bilist, NULL);
+	
+	harbol_unrolled_free(&p, NULL);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+}
+
+#ifndef OS_WINDOWS
+#	define TEST_LF_THREADS    4
+#	define TEST_LF_ITEMS      100000
+
+struct TestLFShared {
+	struct HarbolLFStack Stack;
+	struct HarbolLFQueue Queue;
+	int64_t Sums[TEST_LF_THREADS];
+	size_t Counts[TEST_LF_THREADS];
+	_Atomic size_t Done;
+};
+
+struct TestLFWorker {
+	struct TestLFShared *Shared;
+	size_t Id;
+};
+
+/* every worker produces its own range and consumes whatever it can grab, so values cross threads. */
+static void *_test_lf_worker(void *const arg)
+{
+	struct TestLFWorker *const w = arg;
+	struct TestLFShared *const s = w->Shared;
+	for( int64_t n=0; n<TEST_LF_ITEMS; n++ ) {
+		const union HarbolValue v = {.Int64 = (int64_t)w->Id * TEST_LF_ITEMS + n + 1};
+		const bool queued = harbol_lfqueue_enqueue(&s->Queue, v);
+		const bool pushed = harbol_lfstack_push(&s->Stack, v);
+		assert( queued && pushed );
+		union HarbolValue out;
+		if( harbol_lfqueue_dequeue(&s->Queue, &out) )
+			s->Sums[w->Id] += out.Int64, s->Counts[w->Id]++;
+		if( harbol_lfstack_pop(&s->Stack, &out) )
+			s->Sums[w->Id] += out.Int64, s->Counts[w->Id]++;
+	}
+	atomic_fetch_add(&s->Done, 1);
+	return NULL;
+}
+#endif
+
+void test_harbol_lockfree(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test single-threaded ordering.
+	fputs("lockfree :: test stack and queue order.\n", g_harbol_debug_stream);
+	struct HarbolLFStack *stack = harbol_lfstack_new();
+	struct HarbolLFQueue *queue = harbol_lfqueue_new();
+	assert( stack && queue );
+	assert( harbol_lfstack_is_empty(stack) && harbol_lfqueue_is_empty(queue) );
+	for( int64_t n=0; n<10; n++ ) {
+		harbol_lfstack_push(stack, (union HarbolValue){.Int64=n});
+		harbol_lfqueue_enqueue(queue, (union HarbolValue){.Int64=n});
+	}
+	union HarbolValue val;
+	for( int64_t n=0; n<5; n++ ) {
+		const bool popped = harbol_lfstack_pop(stack, &val);
+		assert( popped && val.Int64==9-n );
+		const bool dequeued = harbol_lfqueue_dequeue(queue, &val);
+		assert( dequeued && val.Int64==n );
+	}
+	fprintf(g_harbol_debug_stream, "stack top after 5 pops: '%" PRIi64 "'\n", (harbol_lfstack_pop(stack, &val), val.Int64));
+	harbol_lfstack_push(stack, val);
+	// remaining values are freed with the containers.
+	harbol_lfstack_free(&stack, NULL);
+	harbol_lfqueue_free(&queue, NULL);
+	assert( !stack && !queue );
+	
+	// emptying out and refilling recycles nodes instead of freeing them.
+	struct HarbolLFQueue q = (struct HarbolLFQueue){0};
+	const bool q_ready = harbol_lfqueue_init(&q);
+	assert( q_ready );
+	for( size_t round=0; round<3; round++ ) {
+		for( int64_t n=0; n<100; n++ )
+			harbol_lfqueue_enqueue(&q, (union HarbolValue){.Int64=n});
+		for( int64_t n=0; n<100; n++ ) {
+			const bool dequeued = harbol_lfqueue_dequeue(&q, &val);
+			assert( dequeued && val.Int64==n );
+		}
+		const bool overdrawn = harbol_lfqueue_dequeue(&q, &val);
+		assert( !overdrawn && harbol_lfqueue_is_empty(&q) );
+	}
+	harbol_lfqueue_enqueue(&q, (union HarbolValue){.StrObjPtr=harbol_string_new_cstr("left over")});
+	harbol_lfqueue_del(&q, (fnHarbolDestructor *)harbol_string_free);
+	
+#ifndef OS_WINDOWS
+	// Test concurrent producers and consumers.
+	fputs("\nlockfree :: test concurrent push/pop and enqueue/dequeue.\n", g_harbol_debug_stream);
+	struct TestLFShared *const shared = calloc(1, sizeof *shared);
+	harbol_lfstack_init(&shared->Stack);
+	const bool shared_ready = harbol_lfqueue_init(&shared->Queue);
+	assert( shared_ready );
+	pthread_t threads[TEST_LF_THREADS];
+	struct TestLFWorker workers[TEST_LF_THREADS];
+	for( size_t t=0; t<TEST_LF_THREADS; t++ ) {
+		workers[t] = (struct TestLFWorker){shared, t};
+		pthread_create(&threads[t], NULL, _test_lf_worker, &workers[t]);
+	}
+	for( size_t t=0; t<TEST_LF_THREADS; t++ )
+		pthread_join(threads[t], NULL);
+	
+	// drain what the workers left behind, then every value must have come out exactly once.
+	int64_t sum = 0;
+	size_t count = 0;
+	for( size_t t=0; t<TEST_LF_THREADS; t++ )
+		sum += shared->Sums[t], count += shared->Counts[t];
+	while( harbol_lfqueue_dequeue(&shared->Queue, &val) )
+		sum += val.Int64, count++;
+	while( harbol_lfstack_pop(&shared->Stack, &val) )
+		sum += val.Int64, count++;
+	const int64_t total = (int64_t)TEST_LF_THREADS * TEST_LF_ITEMS;
+	fprintf(g_harbol_debug_stream, "values out: '%zu' | expected: '%" PRIi64 "'\n", count, 2 * total);
+	assert( count==(size_t)(2 * total) && sum==total * (total + 1) && atomic_load(&shared->Done)==TEST_LF_THREADS );
+	harbol_lfstack_del(&shared->Stack, NULL);
+	harbol_lfqueue_del(&shared->Queue, NULL);
+	free(shared);
+#endif
 }
 
 void test_harbol_bytebuffer(void)
@@ -554,6 +1162,37 @@ void test_harbol_bytebuffer(void)
 	for( size_t n=0; n<harbol_bytebuffer_get_count(p); n++ )
 		fprintf(g_harbol_debug_stream, "bytebuffer value : %zu\n", harbol_bytebuffer_get_raw_buffer(&i)[n]);
 	
+	// test amortized growth, reserving and writing into spare capacity.
+	fputs("bytebuffer :: test growth, reserve and prepare/commit.\n", g_harbol_debug_stream);
+	harbol_bytebuffer_del(&i);
+	size_t growths = 0;
+	for( size_t n=0; n<100000; n++ ) {
+		const size_t cap = harbol_bytebuffer_get_len(&i);
+		harbol_bytebuffer_insert_byte(&i, (uint8_t)n);
+		growths += cap != harbol_bytebuffer_get_len(&i);
+	}
+	fprintf(g_harbol_debug_stream, "bytes: '%zu' | capacity: '%zu' | growths: '%zu'\n", harbol_bytebuffer_get_count(&i), harbol_bytebuffer_get_len(&i), growths);
+	assert( growths <= 12 );
+	assert( harbol_bytebuffer_get_count(&i)==100000 && i.Buffer[99999]==(uint8_t)99999 );
+	// capacity only ever doubles, so it stays within twice the contents.
+	assert( harbol_bytebuffer_get_len(&i) < 2 * 100000 && harbol_bytebuffer_get_len(&i) % HARBOL_BYTEBUFFER_DEFAULT_SIZE==0 );
+	harbol_bytebuffer_clear(&i);
+	assert( !harbol_bytebuffer_get_count(&i) && harbol_bytebuffer_get_len(&i) >= 100000 );
+	harbol_bytebuffer_del(&i);
+	
+	assert( harbol_bytebuffer_reserve(&i, 1000) && harbol_bytebuffer_get_len(&i)==1000 && !harbol_bytebuffer_get_count(&i) );
+	const uint8_t *const reserved = i.Buffer;
+	for( size_t n=0; n<1000; n++ )
+		harbol_bytebuffer_insert_byte(&i, 0xAA);
+	assert( i.Buffer==reserved && !harbol_bytebuffer_get_spare(&i) );
+	
+	uint8_t *const spare = harbol_bytebuffer_prepare(&i, 256);
+	assert( spare && harbol_bytebuffer_get_spare(&i) >= 256 );
+	const int written = snprintf((char *)spare, 256, "written in place %d", 42);
+	assert( harbol_bytebuffer_commit(&i, (size_t)written) && harbol_bytebuffer_get_count(&i)==1000 + (size_t)written );
+	assert( !memcmp(i.Buffer + 1000, "written in place 42", (size_t)written) );
+	// can't commit more than what's been prepared.
+	assert( !harbol_bytebuffer_commit(&i, harbol_bytebuffer_get_spare(&i) + 1) );
 	
 	// free data
 	fputs("bytebuffer :: test destruction.", g_harbol_debug_stream);
@@ -565,6 +1204,374 @@ void test_harbol_bytebuffer(void)
 	fprintf(g_harbol_debug_stream, "p's buffer is null? '%s'\n", p->Buffer ? "no" : "yes");
 	harbol_bytebuffer_free(&p);
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// Test mapping a file as a read-only view; one exactly 4096 bytes long still gets its 0 byte after the end.
+	fputs("bytebuffer :: test mapped file view.\n", g_harbol_debug_stream);
+	FILE *mapfile = fopen("bytebuffer_map_test.bin", "wb");
+	assert( mapfile );
+	for( size_t n=0; n<4096; n++ )
+		fputc('a' + (int)(n % 26), mapfile);
+	fclose(mapfile);
+	struct HarbolByteBuffer view = (struct HarbolByteBuffer){0};
+	harbol_bytebuffer_insert_byte(&view, 1);
+	assert( harbol_bytebuffer_map_file(&view, "bytebuffer_map_test.bin", HarbolMapSequential | HarbolMapWillNeed | HarbolMapHugePage) );
+	assert( harbol_bytebuffer_get_count(&view)==4096 && view.Buffer[0]=='a' && view.Buffer[4095]=='a' + 4095 % 26 && view.Buffer[4096]==0 );
+#ifndef OS_WINDOWS
+	assert( harbol_bytebuffer_is_mapped(&view) && harbol_bytebuffer_advise(&view, HarbolMapNormal) );
+	harbol_bytebuffer_insert_byte(&view, 0);
+	harbol_bytebuffer_delete_byte(&view, 0);
+	assert( harbol_bytebuffer_get_count(&view)==4096 && !harbol_bytebuffer_prepare(&view, 1) && !harbol_bytebuffer_reserve(&view, 8192) );
+#endif
+	fprintf(g_harbol_debug_stream, "view is mapped? '%s', first bytes: '%.8s'\n", harbol_bytebuffer_is_mapped(&view) ? "yes" : "no", view.Buffer);
+	harbol_bytebuffer_del(&view);
+	assert( !view.Buffer && !view.MapLen );
+	assert( !harbol_bytebuffer_map_file(&view, "bytebuffer_map_test_missing.bin", HarbolMapNormal) );
+	remove("bytebuffer_map_test.bin");
+}
+
+void test_harbol_bytecursor(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test writing a message.
+	fputs("bytecursor :: test writing.\n", g_harbol_debug_stream);
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	struct HarbolByteWriter w;
+	harbol_bytewriter_init(&w, &buf);
+	harbol_bytewriter_put_u16_be(&w, 0x1234);
+	harbol_bytewriter_put_u32_le(&w, 0xDEADBEEF);
+	harbol_bytewriter_put_u64_be(&w, 0x0102030405060708);
+	harbol_bytewriter_put_f32_le(&w, 1.5f);
+	harbol_bytewriter_put_f64_be(&w, -2.25);
+	harbol_bytewriter_put_uvarint(&w, 300);
+	harbol_bytewriter_put_svarint(&w, -3);
+	harbol_bytewriter_put_uvarint(&w, UINT64_MAX);
+	harbol_bytewriter_put_svarint(&w, INT64_MIN);
+	harbol_bytewriter_put_str(&w, "hello", 5);
+	harbol_bytewriter_put_blob(&w, NULL, 0);
+	harbol_bytewriter_put_u8(&w, 0xFF);
+	assert( harbol_bytewriter_ok(&w) );
+	fprintf(g_harbol_debug_stream, "message size: '%zu'\n", harbol_bytebuffer_get_count(&buf));
+	// 2+4+8+4+8 fixed, 2+1+10+10 varints, 1+5 string, 1 empty blob, 1 byte.
+	assert( harbol_bytebuffer_get_count(&buf)==57 );
+	
+	// the byte order is explicit, not whatever the host uses.
+	const uint8_t expected_head[] = { 0x12,0x34, 0xEF,0xBE,0xAD,0xDE, 1,2,3,4,5,6,7,8 };
+	assert( !memcmp(buf.Buffer, expected_head, sizeof expected_head) );
+	// 300 -> AC 02, -3 -> zigzag 5.
+	assert( buf.Buffer[26]==0xAC && buf.Buffer[27]==0x02 && buf.Buffer[28]==0x05 );
+	
+	// Test reading it back.
+	fputs("\nbytecursor :: test reading.\n", g_harbol_debug_stream);
+	struct HarbolByteReader r;
+	harbol_bytereader_init_buffer(&r, &buf);
+	uint16_t u16; uint32_t u32; uint64_t u64, uv, umax; int64_t sv, smin;
+	float f32; double f64;
+	harbol_bytereader_get_u16_be(&r, &u16);
+	harbol_bytereader_get_u32_le(&r, &u32);
+	harbol_bytereader_get_u64_be(&r, &u64);
+	harbol_bytereader_get_f32_le(&r, &f32);
+	harbol_bytereader_get_f64_be(&r, &f64);
+	harbol_bytereader_get_uvarint(&r, &uv);
+	harbol_bytereader_get_svarint(&r, &sv);
+	harbol_bytereader_get_uvarint(&r, &umax);
+	harbol_bytereader_get_svarint(&r, &smin);
+	assert( harbol_bytereader_ok(&r) );
+	assert( u16==0x1234 && u32==0xDEADBEEF && u64==0x0102030405060708 && f32==1.5f && f64==-2.25 );
+	assert( uv==300 && sv==-3 && umax==UINT64_MAX && smin==INT64_MIN );
+	
+	const char *str = NULL;
+	size_t len = 0;
+	assert( harbol_bytereader_get_str(&r, &str, &len) && len==5 && !memcmp(str, "hello", 5) );
+	// the view is zero-copy.
+	assert( (const uint8_t *)str > buf.Buffer && (const uint8_t *)str < buf.Buffer + buf.Count );
+	const uint8_t *view = NULL;
+	assert( harbol_bytereader_get_blob(&r, &view, &len) && !len );
+	uint8_t u8;
+	assert( harbol_bytereader_get_u8(&r, &u8) && u8==0xFF && !harbol_bytereader_get_remaining(&r) );
+	
+	// reading past the end fails, doesn't move the cursor, and stays failed.
+	const size_t end = harbol_bytereader_get_pos(&r);
+	assert( !harbol_bytereader_get_u32_le(&r, &u32) && harbol_bytereader_get_pos(&r)==end && !harbol_bytereader_ok(&r) );
+	harbol_bytereader_init(&r, buf.Buffer, 4);
+	assert( !harbol_bytereader_get_u64_le(&r, &u64) && !harbol_bytereader_get_u8(&r, &u8) && !harbol_bytereader_get_pos(&r) );
+	
+	// Test malformed input.
+	fputs("\nbytecursor :: test malformed input.\n", g_harbol_debug_stream);
+	{
+		// a length prefix claiming more than is left.
+		const uint8_t bad_blob[] = { 0x10, 'a', 'b' };
+		harbol_bytereader_init(&r, bad_blob, sizeof bad_blob);
+		assert( !harbol_bytereader_get_blob(&r, &view, &len) && !harbol_bytereader_get_pos(&r) );
+		// a varint that never terminates.
+		const uint8_t runaway[] = { 0x80, 0x80, 0x80 };
+		harbol_bytereader_init(&r, runaway, sizeof runaway);
+		assert( !harbol_bytereader_get_uvarint(&r, &uv) );
+		// eleven bytes, or a tenth byte that overflows 64 bits.
+		const uint8_t too_long[] = { 0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x02 };
+		harbol_bytereader_init(&r, too_long, sizeof too_long);
+		assert( !harbol_bytereader_get_uvarint(&r, &uv) );
+		// zero padded, non-canonical encodings of 0 and 1; a lone 0 byte is fine.
+		const uint8_t overlong[] = { 0x80, 0x00, 0x81, 0x80, 0x00, 0x00 };
+		harbol_bytereader_init(&r, overlong, 2);
+		assert( !harbol_bytereader_get_uvarint(&r, &uv) );
+		harbol_bytereader_init(&r, overlong + 2, 3);
+		assert( !harbol_bytereader_get_uvarint(&r, &uv) );
+		harbol_bytereader_init(&r, overlong + 5, 1);
+		assert( harbol_bytereader_get_uvarint(&r, &uv) && !uv );
+	}
+	harbol_bytebuffer_del(&buf);
+}
+
+void test_harbol_lz(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test a single block round trip over repetitive text.
+	fputs("lz :: test block compression.\n", g_harbol_debug_stream);
+	static const char *const words[] = { "harbol ", "buffer ", "config ", "section ", "value ", "key ", "tree ", "\n" };
+	struct HarbolByteBuffer text = (struct HarbolByteBuffer){0}, packed = (struct HarbolByteBuffer){0}, unpacked = (struct HarbolByteBuffer){0};
+	uint32_t seed = 12345;
+	for( size_t n=0; n<20000; n++ ) {
+		seed = seed * 1103515245u + 12345u;
+		const char *const w = words[(seed >> 16) % (sizeof words / sizeof words[0])];
+		harbol_bytebuffer_insert_obj(&text, w, strlen(w));
+	}
+	assert( harbol_lz_compress_block(text.Buffer, text.Count, &packed) );
+	fprintf(g_harbol_debug_stream, "block: %zu -> %zu bytes\n", text.Count, packed.Count);
+	assert( packed.Count < text.Count / 2 && packed.Count <= harbol_lz_compress_bound(text.Count) );
+	assert( harbol_lz_decompress_block(packed.Buffer, packed.Count, text.Count, &unpacked) );
+	assert( unpacked.Count==text.Count && !memcmp(unpacked.Buffer, text.Buffer, text.Count) );
+	
+	// corrupt input has to fail without writing anything.
+	harbol_bytebuffer_clear(&unpacked);
+	assert( !harbol_lz_decompress_block(packed.Buffer, packed.Count, text.Count - 1, &unpacked) && !unpacked.Count );
+	assert( !harbol_lz_decompress_block(packed.Buffer, packed.Count / 2, text.Count, &unpacked) && !unpacked.Count );
+	
+	// tiny and empty inputs.
+	for( size_t len=0; len<20; len++ ) {
+		harbol_bytebuffer_clear(&packed), harbol_bytebuffer_clear(&unpacked);
+		assert( harbol_lz_compress_block("aaaaaaaaaaaaaaaaaaaa", len, &packed) );
+		assert( harbol_lz_decompress_block(packed.Buffer, packed.Count, len, &unpacked) );
+		assert( unpacked.Count==len && (!len || !memcmp(unpacked.Buffer, "aaaaaaaaaaaaaaaaaaaa", len)) );
+	}
+	
+	// Test framed buffers, with a small block size so there are several blocks and a partial last one.
+	fputs("lz :: test frames.\n", g_harbol_debug_stream);
+	for( size_t n=0; n<4096; n++ ) {
+		seed = seed * 1103515245u + 12345u;
+		harbol_bytebuffer_insert_byte(&text, (uint8_t)(seed >> 24)); // some incompressible noise at the end.
+	}
+	harbol_bytebuffer_clear(&packed), harbol_bytebuffer_clear(&unpacked);
+	assert( harbol_lz_compress_buffer(&text, &packed, 10000) );
+	assert( harbol_lz_decompress_buffer(&packed, &unpacked) );
+	assert( unpacked.Count==text.Count && !memcmp(unpacked.Buffer, text.Buffer, text.Count) );
+	fprintf(g_harbol_debug_stream, "frame: %zu -> %zu bytes\n", text.Count, packed.Count);
+	
+	// feeding the decoder a byte at a time gives the same result.
+	struct HarbolLZDecoder dec;
+	harbol_lz_decoder_init(&dec);
+	harbol_bytebuffer_clear(&unpacked);
+	for( size_t n=0; n<packed.Count; n++ )
+		assert( harbol_lz_decoder_write(&dec, packed.Buffer + n, 1, &unpacked) );
+	assert( harbol_lz_decoder_is_done(&dec) && unpacked.Count==text.Count && !memcmp(unpacked.Buffer, text.Buffer, text.Count) );
+	assert( !harbol_lz_decoder_write(&dec, "x", 1, &unpacked) );
+	harbol_lz_decoder_del(&dec);
+	
+	// a truncated frame never finishes.
+	harbol_bytebuffer_clear(&unpacked);
+	packed.Count -= 4;
+	assert( !harbol_lz_decompress_buffer(&packed, &unpacked) );
+	
+#ifndef OS_WINDOWS
+	// a raw block that can't land in the output fails the frame instead of being skipped.
+	FILE *mapfile = fopen("lz_map_test.bin", "wb");
+	assert( mapfile );
+	fputs("mapped", mapfile);
+	fclose(mapfile);
+	struct HarbolByteBuffer noise = (struct HarbolByteBuffer){0}, mapped = (struct HarbolByteBuffer){0};
+	for( size_t n=0; n<1024; n++ ) {
+		seed = seed * 1103515245u + 12345u;
+		harbol_bytebuffer_insert_byte(&noise, (uint8_t)(seed >> 24));
+	}
+	harbol_bytebuffer_clear(&packed);
+	assert( harbol_lz_compress_buffer(&noise, &packed, 4096) );
+	assert( harbol_bytebuffer_map_file(&mapped, "lz_map_test.bin", HarbolMapNormal) );
+	assert( !harbol_lz_decompress_buffer(&packed, &mapped) && mapped.Count==6 );
+	harbol_lz_decoder_init(&dec);
+	assert( !harbol_lz_decoder_write(&dec, packed.Buffer, packed.Count, &mapped) && !harbol_lz_decoder_is_done(&dec) );
+	harbol_bytebuffer_clear(&unpacked);
+	assert( !harbol_lz_decoder_write(&dec, packed.Buffer, packed.Count, &unpacked) && !unpacked.Count );
+	harbol_lz_decoder_del(&dec);
+	harbol_bytebuffer_del(&mapped);
+	harbol_bytebuffer_del(&noise);
+	remove("lz_map_test.bin");
+#endif
+	
+	// Test streaming through files.
+	fputs("lz :: test file streaming.\n", g_harbol_debug_stream);
+	FILE *raw = tmpfile(), *frame = tmpfile(), *back = tmpfile();
+	assert( raw && frame && back );
+	harbol_bytebuffer_to_file(&text, raw);
+	rewind(raw);
+	assert( harbol_lz_compress_file(raw, frame, 4096) );
+	rewind(frame);
+	assert( harbol_lz_decompress_file(frame, back) );
+	harbol_bytebuffer_clear(&unpacked);
+	assert( harbol_bytebuffer_read_from_file(&unpacked, back)==text.Count && !memcmp(unpacked.Buffer, text.Buffer, text.Count) );
+	fclose(raw), fclose(frame), fclose(back);
+	
+	harbol_bytebuffer_del(&text);
+	harbol_bytebuffer_del(&packed);
+	harbol_bytebuffer_del(&unpacked);
+}
+
+void test_harbol_checksum(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test the standard check values.
+	fputs("checksum :: test known values.\n", g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "crc32c uses the crc32 instruction? '%s'\n", harbol_crc32c_is_hw() ? "yes" : "no");
+	assert( harbol_crc32c(0, "123456789", 9)==0xE3069283u && harbol_crc32c_sw(0, "123456789", 9)==0xE3069283u );
+	assert( harbol_crc32c(0, NULL, 0)==0 );
+	assert( harbol_xxh64("", 0, 0)==0xEF46DB3751D8E999ull );
+	assert( harbol_xxh64("abc", 3, 0)==0x44BC2CF5AD770999ull );
+	assert( harbol_xxh64("Nobody inspects the spammish repetition", 39, 0)==0xFBCEA83C8A378BF1ull );
+	
+	// Test that the hardware path (with its 3-way split) and the table path agree, and that running updates match one-shot.
+	fputs("checksum :: test incremental updates.\n", g_harbol_debug_stream);
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	uint32_t seed = 2463534242u;
+	for( size_t n=0; n<100003; n++ ) {
+		seed ^= seed << 13, seed ^= seed >> 17, seed ^= seed << 5;
+		harbol_bytebuffer_insert_byte(&buf, (uint8_t)seed);
+	}
+	const uint32_t crc = harbol_crc32c_bytebuffer(0, &buf);
+	const uint64_t digest = harbol_xxh64(buf.Buffer, buf.Count, 99);
+	assert( crc==harbol_crc32c_sw(0, buf.Buffer, buf.Count) );
+	for( size_t off=1; off<8; off++ )
+		assert( harbol_crc32c(0, buf.Buffer + off, buf.Count - off)==harbol_crc32c_sw(0, buf.Buffer + off, buf.Count - off) );
+	
+	uint32_t running = 0;
+	struct HarbolXXH64 state;
+	harbol_xxh64_init(&state, 99);
+	for( size_t n=0, step=1; n<buf.Count; n += step, step = step * 3 % 1021 + 1 ) {
+		const size_t len = ( step < buf.Count - n ) ? step : buf.Count - n;
+		running = harbol_crc32c(running, buf.Buffer + n, len);
+		assert( harbol_xxh64_update(&state, buf.Buffer + n, len) );
+	}
+	assert( running==crc && harbol_xxh64_digest(&state)==digest );
+	fprintf(g_harbol_debug_stream, "crc32c: %08" PRIx32 ", xxh64: %016" PRIx64 "\n", crc, digest);
+	
+	struct HarbolString str = {NULL, 0};
+	harbol_string_copy_cstr(&str, "123456789");
+	harbol_xxh64_init(&state, 0);
+	assert( harbol_crc32c_string(0, &str)==0xE3069283u && harbol_xxh64_update_string(&state, &str) );
+	assert( harbol_xxh64_digest(&state)==harbol_xxh64("123456789", 9, 0) );
+	harbol_xxh64_init(&state, 99);
+	assert( harbol_xxh64_update_bytebuffer(&state, &buf) && harbol_xxh64_digest(&state)==digest );
+	harbol_string_del(&str);
+	harbol_bytebuffer_del(&buf);
+}
+
+void test_harbol_encoding(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test the RFC 4648 vectors.
+	fputs("encoding :: test known values.\n", g_harbol_debug_stream);
+	const char *const plain[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+	const char *const padded[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+	struct HarbolString str = {NULL, 0};
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	for( size_t i=0; i<sizeof plain / sizeof plain[0]; i++ ) {
+		const size_t len = strlen(plain[i]);
+		harbol_string_del(&str);
+		assert( harbol_base64_encode_to_string(&str, plain[i], len, HarbolBase64Std, true) && !strcmp(str.CStr, padded[i]) );
+		assert( str.Len==harbol_base64_encoded_len(len, true) );
+		harbol_string_del(&str);
+		assert( harbol_base64_encode_to_string(&str, plain[i], len, HarbolBase64URL, false) && str.Len==harbol_base64_encoded_len(len, false) );
+		assert( !strncmp(str.CStr, padded[i], str.Len) );
+		
+		harbol_bytebuffer_clear(&buf);
+		assert( harbol_base64_decode(&buf, padded[i], strlen(padded[i]), HarbolBase64Std, NULL) && buf.Count==len && (!len || !memcmp(buf.Buffer, plain[i], len)) );
+		harbol_bytebuffer_clear(&buf);
+		assert( harbol_base64_decode(&buf, str.CStr, str.Len, HarbolBase64URL, NULL) && buf.Count==len && (!len || !memcmp(buf.Buffer, plain[i], len)) );
+	}
+	harbol_string_del(&str);
+	assert( harbol_hex_encode_to_string(&str, "\x01\xab\xff", 3, false) && !strcmp(str.CStr, "01abff") );
+	assert( harbol_hex_encode_to_string(&str, "\x01\xab\xff", 3, true) && !strcmp(str.CStr, "01abff01ABFF") );
+	harbol_bytebuffer_clear(&buf);
+	assert( harbol_hex_decode(&buf, str.CStr, str.Len, NULL) && buf.Count==6 && !memcmp(buf.Buffer, "\x01\xab\xff\x01\xab\xff", 6) );
+	
+	// Test round trips long enough to take the vector paths, against byte-at-a-time references.
+	fputs("encoding :: test round trips.\n", g_harbol_debug_stream);
+	static const char b64url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+	uint8_t data[1000];
+	uint32_t seed = 2463534242u;
+	for( size_t n=0; n<sizeof data; n++ ) {
+		seed ^= seed << 13, seed ^= seed >> 17, seed ^= seed << 5;
+		data[n] = (uint8_t)seed;
+	}
+	for( size_t len=0; len<=sizeof data; len += ( len < 100 ) ? 1 : 37 ) {
+		harbol_string_del(&str);
+		assert( harbol_hex_encode_to_string(&str, data, len, false) && str.Len==len * 2 );
+		for( size_t n=0; n<len; n++ ) {
+			char pair[3];
+			sprintf(pair, "%02x", data[n]);
+			assert( str.CStr[n * 2]==pair[0] && str.CStr[n * 2 + 1]==pair[1] );
+		}
+		harbol_bytebuffer_clear(&buf);
+		assert( harbol_hex_decode(&buf, str.CStr, str.Len, NULL) && buf.Count==len && (!len || !memcmp(buf.Buffer, data, len)) );
+		
+		harbol_bytebuffer_clear(&buf);
+		assert( harbol_base64_encode_to_bytebuffer(&buf, data, len, HarbolBase64URL, false) && buf.Count==harbol_base64_encoded_len(len, false) );
+		for( size_t n=0; n<len; n++ ) {
+			// the first character that starts inside byte 'n'.
+			const size_t bit = n * 8, ch = (bit + 5) / 6;
+			const uint32_t w = (uint32_t)data[n] << 8 | ( n + 1 < len ? data[n + 1] : 0 );
+			assert( buf.Buffer[ch]==(uint8_t)b64url[(w >> (10 - (ch * 6 - bit))) & 63] );
+		}
+		struct HarbolByteBuffer back = (struct HarbolByteBuffer){0};
+		assert( harbol_base64_decode(&back, (const char *)buf.Buffer, buf.Count, HarbolBase64URL, NULL) && back.Count==len && (!len || !memcmp(back.Buffer, data, len)) );
+		harbol_bytebuffer_del(&back);
+	}
+	
+	// Test that bad input appends nothing and points at the first bad character, wherever it lands.
+	fputs("encoding :: test bad input.\n", g_harbol_debug_stream);
+	harbol_string_del(&str);
+	harbol_base64_encode_to_string(&str, data, 300, HarbolBase64Std, true);
+	for( size_t at=0; at<str.Len; at += 7 ) {
+		const char saved = str.CStr[at];
+		str.CStr[at] = '-';
+		size_t bad = 0;
+		harbol_bytebuffer_clear(&buf);
+		assert( !harbol_base64_decode(&buf, str.CStr, str.Len, HarbolBase64Std, &bad) && bad==at && buf.Count==0 );
+		str.CStr[at] = saved;
+	}
+	size_t bad = 0;
+	assert( !harbol_base64_decode(&buf, "Zm9vY", 5, HarbolBase64Std, &bad) && bad==5 );
+	assert( !harbol_base64_decode(&buf, "A!AAA", 5, HarbolBase64Std, &bad) && bad==1 );
+	assert( !harbol_base64_decode(&buf, "AAAA!AAAA", 9, HarbolBase64Std, &bad) && bad==4 );
+	assert( !harbol_base64_decode(&buf, "Zh==", 4, HarbolBase64Std, &bad) && bad==1 );
+	assert( !harbol_base64_decode(&buf, "Zm=v", 4, HarbolBase64Std, &bad) && bad==2 );
+	assert( !harbol_base64_decode(&buf, "Zm9v+/", 6, HarbolBase64URL, &bad) && bad==4 );
+	harbol_string_del(&str);
+	harbol_hex_encode_to_string(&str, data, 100, false);
+	for( size_t at=0; at<str.Len; at += 5 ) {
+		const char saved = str.CStr[at];
+		str.CStr[at] = 'g';
+		assert( !harbol_hex_decode(&buf, str.CStr, str.Len, &bad) && bad==at && buf.Count==0 );
+		str.CStr[at] = saved;
+	}
+	assert( !harbol_hex_decode(&buf, "abc", 3, &bad) && bad==3 && buf.Count==0 );
+	harbol_string_del(&str);
+	harbol_bytebuffer_del(&buf);
 }
 
 void test_harbol_tuple(void)
@@ -666,6 +1673,263 @@ void test_harbol_tuple(void)
 	fprintf(g_harbol_debug_stream, "p's item is null? '%s'\n", p->Datum ? "no" : "yes");
 	harbol_tuple_free(&p);
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n\n", p ? "no" : "yes");
+	
+	// Test that schemas lay fields out like tuples (and structs) and that instances share them.
+	fputs("tuple :: test shared schemas and instances.\n", g_harbol_debug_stream);
+	const size_t sizes[] = { sizeof(int64_t), sizeof(char), sizeof(int), sizeof(short) };
+	struct TestRecord { int64_t a; char b; int c; short d; };
+	struct HarbolTupleSchema *schema = harbol_tuple_schema_new(4, sizes, false);
+	assert( schema && harbol_tuple_schema_get_count(schema)==4 && harbol_tuple_schema_get_len(schema)==sizeof(struct TestRecord) );
+	assert( harbol_tuple_schema_get_field_offset(schema, 1)==offsetof(struct TestRecord, b) );
+	assert( harbol_tuple_schema_get_field_offset(schema, 2)==offsetof(struct TestRecord, c) );
+	assert( harbol_tuple_schema_get_field_offset(schema, 3)==offsetof(struct TestRecord, d) );
+	assert( harbol_tuple_schema_get_field_offset(schema, 4)==SIZE_MAX && harbol_tuple_schema_get_field_size(schema, 2)==sizeof(int) );
+	p = harbol_tuple_new(4, (size_t[]){ sizeof(int64_t), sizeof(char), sizeof(int), sizeof(short) }, false);
+	assert( p->Len==schema->Len && harbol_tuple_get_field(p, 3)==p->Datum + schema->Fields[3].Offset );
+	harbol_tuple_free(&p);
+	
+	struct HarbolTupleInst *insts[64];
+	for( size_t i=0; i<64; i++ ) {
+		insts[i] = harbol_tuple_inst_new(schema);
+		assert( insts[i] && insts[i]->Schema==schema && (uintptr_t)insts[i]->Datum % alignof(int64_t)==0 );
+		const int64_t a = (int64_t)i * -1000;
+		const char b = (char)('a' + i % 26);
+		const int c = (int)i * 3;
+		const short d = (short)-i;
+		assert( harbol_tuple_inst_set_field(insts[i], 0, &a) && harbol_tuple_inst_set_field(insts[i], 1, &b) );
+		assert( harbol_tuple_inst_set_field(insts[i], 2, &c) && harbol_tuple_inst_set_field(insts[i], 3, &d) );
+	}
+	assert( !harbol_tuple_inst_get_field(insts[0], 4) && !harbol_tuple_inst_set_field(insts[0], 4, &sizes) );
+	for( size_t i=0; i<64; i++ ) {
+		struct TestRecord rec;
+		assert( harbol_tuple_inst_to_struct(insts[i], &rec) && harbol_tuple_inst_get_len(insts[i])==sizeof rec );
+		assert( rec.a==(int64_t)i * -1000 && rec.b==(char)('a' + i % 26) && rec.c==(int)i * 3 && rec.d==(short)-i );
+		assert( *(int *)harbol_tuple_inst_get_field(insts[i], 2)==rec.c && harbol_tuple_inst_get_field_size(insts[i], 3)==sizeof(short) );
+		harbol_tuple_inst_free(&insts[i]);
+		assert( !insts[i] );
+	}
+	harbol_tuple_schema_free(&schema);
+	assert( !schema && !harbol_tuple_schema_new(0, sizes, false) );
+	
+	// Test natural and optimized layouts: reordering only moves offsets, never indexes.
+	fputs("tuple :: test layout optimization.\n", g_harbol_debug_stream);
+	const size_t mixed[] = { sizeof(char), sizeof(int64_t), sizeof(char), sizeof(int64_t) };
+	struct HarbolTupleSchema declared, optimized, packed;
+	assert( harbol_tuple_schema_init_layout(&declared, 4, mixed, NULL, 0) );
+	assert( harbol_tuple_schema_init_layout(&optimized, 4, mixed, NULL, HarbolTupleOptimize) );
+	assert( harbol_tuple_schema_init_layout(&packed, 4, mixed, NULL, HarbolTuplePacked | HarbolTupleOptimize) );
+	struct TestMixed { char a; int64_t b; char c; int64_t d; };
+	assert( declared.Len==sizeof(struct TestMixed) && harbol_tuple_schema_get_field_offset(&declared, 3)==offsetof(struct TestMixed, d) );
+	assert( harbol_tuple_schema_get_padding(&declared)==14 && harbol_tuple_schema_get_align(&declared)==alignof(int64_t) );
+	assert( optimized.Len==24 && harbol_tuple_schema_get_padding(&optimized)==6 );
+	assert( optimized.Fields[1].Offset==0 && optimized.Fields[3].Offset==8 && optimized.Fields[0].Offset==16 && optimized.Fields[2].Offset==17 );
+	assert( packed.Len==18 && harbol_tuple_schema_get_padding(&packed)==0 && packed.Fields[1].Offset==1 );
+	fprintf(g_harbol_debug_stream, "{char, int64, char, int64}: declared %zu bytes (%zu padding), optimized %zu (%zu), packed %zu\n",
+		declared.Len, harbol_tuple_schema_get_padding(&declared), optimized.Len, harbol_tuple_schema_get_padding(&optimized), packed.Len);
+	
+	struct HarbolTupleInst *opt = harbol_tuple_inst_new(&optimized);
+	const int64_t big = -5;
+	const char ch = 'z';
+	assert( harbol_tuple_inst_set_field(opt, 3, &big) && harbol_tuple_inst_set_field(opt, 2, &ch) );
+	assert( *(int64_t *)harbol_tuple_inst_get_field(opt, 3)==-5 && *(char *)harbol_tuple_inst_get_field(opt, 2)=='z' );
+	assert( (uintptr_t)harbol_tuple_inst_get_field(opt, 3) % alignof(int64_t)==0 );
+	harbol_tuple_inst_free(&opt);
+	p = harbol_tuple_new_from_schema(&optimized);
+	assert( p && p->Len==24 && harbol_tuple_get_field(p, 2)==p->Datum + 17 && harbol_tuple_get_field_size(p, 1)==sizeof(int64_t) );
+	harbol_tuple_free(&p);
+	harbol_tuple_schema_del(&declared);
+	harbol_tuple_schema_del(&optimized);
+	harbol_tuple_schema_del(&packed);
+	
+	// Test explicit alignments and sizes that aren't powers of two.
+	assert( harbol_tuple_schema_init_layout(&declared, 3, (size_t[]){ 3, 4, 6 }, NULL, 0) );
+	assert( declared.Fields[1].Offset==4 && declared.Fields[2].Offset==8 && declared.Len==16 && declared.Align==4 );
+	harbol_tuple_schema_del(&declared);
+	assert( harbol_tuple_schema_init_layout(&declared, 2, (size_t[]){ 1, 4 }, (size_t[]){ 0, 16 }, 0) );
+	assert( declared.Fields[1].Offset==16 && declared.Len==32 && declared.Align==16 );
+	opt = harbol_tuple_inst_new(&declared);
+	assert( (uintptr_t)harbol_tuple_inst_get_field(opt, 1) % 16==0 );
+	harbol_tuple_inst_free(&opt);
+	harbol_tuple_schema_del(&declared);
+	assert( !harbol_tuple_schema_init_layout(&declared, 2, (size_t[]){ 1, 4 }, (size_t[]){ 0, 3 }, 0) );
+	assert( !harbol_tuple_schema_init_layout(&declared, 2, (size_t[]){ 1, 4 }, (size_t[]){ 0, alignof(max_align_t) * 2 }, 0) );
+	
+	// Test tuple arrays: bulk serialization and zero-copy views of a buffer and of a mapped file.
+	fputs("tuple :: test tuple arrays and views.\n", g_harbol_debug_stream);
+	assert( harbol_tuple_schema_init_layout(&optimized, 4, mixed, NULL, HarbolTupleOptimize) );
+	struct HarbolTupleArray arr;
+	assert( harbol_tuple_array_init(&arr, &optimized) );
+	for( size_t i=0; i<1000; i++ ) {
+		assert( harbol_tuple_array_append(&arr, NULL) );
+		const char tag = (char)(i % 128);
+		const int64_t val = (int64_t)i * 1000003;
+		assert( harbol_tuple_array_set_field(&arr, i, 0, &tag) && harbol_tuple_array_set_field(&arr, i, 3, &val) );
+	}
+	assert( harbol_tuple_array_get_count(&arr)==1000 && !harbol_tuple_array_get_field(&arr, 1000, 0) && !harbol_tuple_array_get_field(&arr, 0, 4) );
+	
+	struct HarbolByteBuffer wire = (struct HarbolByteBuffer){0};
+	assert( harbol_tuple_array_serialize(&arr, &wire) && harbol_tuple_array_serialize(&arr, &wire) );
+	struct HarbolTupleArray view = {0}, second = {0};
+	size_t used = 0;
+	assert( harbol_tuple_array_view(&view, wire.Buffer, wire.Count, &used) && used==wire.Count / 2 );
+	assert( harbol_tuple_array_view(&second, wire.Buffer + used, wire.Count - used, NULL) );
+	assert( harbol_tuple_array_is_view(&view) && harbol_tuple_array_get_count(&second)==1000 );
+	assert( view.Schema->Len==optimized.Len && view.Schema->Fields[3].Offset==optimized.Fields[3].Offset );
+	assert( (uint8_t *)harbol_tuple_array_get_row(&view, 0) > wire.Buffer && (uint8_t *)harbol_tuple_array_get_row(&view, 0) < wire.Buffer + 256 );
+	for( size_t i=0; i<1000; i++ ) {
+		assert( *(char *)harbol_tuple_array_get_field(&view, i, 0)==(char)(i % 128) );
+		assert( *(int64_t *)harbol_tuple_array_get_field(&second, i, 3)==(int64_t)i * 1000003 );
+	}
+	assert( !harbol_tuple_array_set_field(&view, 0, 0, "x") && !harbol_tuple_array_append(&view, NULL) );
+	harbol_tuple_array_del(&second);
+	
+	// truncated, corrupted or misaligned input is refused.
+	assert( !harbol_tuple_array_view(&second, wire.Buffer, used - 1, NULL) );
+	assert( !harbol_tuple_array_view(&second, wire.Buffer, 20, NULL) );
+	wire.Buffer[0] ^= 0xff;
+	assert( !harbol_tuple_array_view(&second, wire.Buffer, wire.Count, NULL) );
+	wire.Buffer[0] ^= 0xff;
+	struct HarbolByteBuffer shifted = (struct HarbolByteBuffer){0};
+	harbol_bytebuffer_insert_byte(&shifted, 0);
+	harbol_tuple_array_serialize(&arr, &shifted);
+	assert( !harbol_tuple_array_view(&second, shifted.Buffer + 1, shifted.Count - 1, NULL) );
+	harbol_bytebuffer_del(&shifted);
+	
+	// so is a header whose layout would misalign rows or fields: field 1 is an int64 and rows are 24 bytes.
+	uint32_t patched = 0;
+	memcpy(&patched, wire.Buffer + 28 + 12, sizeof patched);
+	patched += 1;
+	memcpy(wire.Buffer + 28 + 12, &patched, sizeof patched);
+	assert( !harbol_tuple_array_view(&second, wire.Buffer, wire.Count, NULL) );
+	patched -= 1;
+	memcpy(wire.Buffer + 28 + 12, &patched, sizeof patched);
+	memcpy(&patched, wire.Buffer + 12, sizeof patched);
+	assert( patched==24 );
+	patched = 28;
+	memcpy(wire.Buffer + 12, &patched, sizeof patched);
+	assert( !harbol_tuple_array_view(&second, wire.Buffer, wire.Count, NULL) );
+	patched = 24;
+	memcpy(wire.Buffer + 12, &patched, sizeof patched);
+	const struct HarbolTupleSchema odd_rows = { .Fields = (struct HarbolTupleField[]){ { 0, 2, 2 }, { 2, 7, 1 } }, .Count = 2, .Len = 9, .Align = 2 };
+	assert( !harbol_tuple_array_init(&second, &odd_rows) );
+	
+	FILE *rows_file = fopen("test_tuple_rows.bin", "wb");
+	harbol_bytebuffer_to_file(&wire, rows_file);
+	fclose(rows_file);
+	struct HarbolByteBuffer mapped = (struct HarbolByteBuffer){0};
+	assert( harbol_bytebuffer_map_file(&mapped, "test_tuple_rows.bin", HarbolMapSequential) );
+	assert( harbol_tuple_array_view_bytebuffer(&second, &mapped) && harbol_tuple_array_get_count(&second)==1000 );
+	assert( *(int64_t *)harbol_tuple_array_get_field(&second, 999, 3)==999 * (int64_t)1000003 );
+	harbol_tuple_array_del(&second);
+	harbol_bytebuffer_del(&mapped);
+	remove("test_tuple_rows.bin");
+	
+	// viewing into an array that already holds rows releases them first.
+	assert( harbol_tuple_array_view(&arr, wire.Buffer, wire.Count, NULL) && harbol_tuple_array_is_view(&arr) );
+	assert( harbol_tuple_array_view(&view, wire.Buffer + used, wire.Count - used, NULL) );
+	
+	harbol_tuple_array_del(&view);
+	harbol_bytebuffer_del(&wire);
+	harbol_tuple_array_del(&arr);
+	harbol_tuple_schema_del(&optimized);
+}
+
+void test_harbol_coltable(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test appending rows from structs, instances and tuples, and getting them back.
+	fputs("coltable :: test appending and projecting rows.\n", g_harbol_debug_stream);
+	struct TestOrder { int64_t id; float price; int32_t qty; uint8_t flags; };
+	const size_t sizes[] = { sizeof(int64_t), sizeof(float), sizeof(int32_t), sizeof(uint8_t) };
+	struct HarbolTupleSchema schema;
+	assert( harbol_tuple_schema_init(&schema, 4, sizes, false) && schema.Len==sizeof(struct TestOrder) );
+	struct HarbolColTable table;
+	assert( harbol_coltable_init(&table, &schema) );
+	
+	const size_t rows = 5000;
+	for( size_t i=0; i<rows; i++ ) {
+		const struct TestOrder order = { .id = (int64_t)i * 7, .price = (float)(i % 100) + 0.5f, .qty = (int32_t)(i % 37) - 18, .flags = (uint8_t)(i & 3) };
+		if( i % 3==0 ) {
+			assert( harbol_coltable_append_row(&table, &order) );
+		} else if( i % 3==1 ) {
+			struct HarbolTupleInst *inst = harbol_tuple_inst_new(&schema);
+			memcpy(inst->Datum, &order, sizeof order);
+			assert( harbol_coltable_append_inst(&table, inst) );
+			harbol_tuple_inst_free(&inst);
+		} else {
+			struct HarbolTuple *tup = harbol_tuple_new(4, (size_t[]){ sizeof(int64_t), sizeof(float), sizeof(int32_t), sizeof(uint8_t) }, false);
+			memcpy(tup->Datum, &order, sizeof order);
+			assert( harbol_coltable_append_tuple(&table, tup) );
+			harbol_tuple_free(&tup);
+		}
+	}
+	assert( harbol_coltable_get_rows(&table)==rows );
+	
+	const int64_t *const ids = harbol_coltable_get_column(&table, 0);
+	const int32_t *const qtys = harbol_coltable_get_column(&table, 2);
+	assert( ids && qtys && !harbol_coltable_get_column(&table, 4) && !harbol_coltable_get_cell(&table, rows, 0) );
+	for( size_t i=0; i<rows; i++ ) {
+		assert( ids[i]==(int64_t)i * 7 && qtys[i]==(int32_t)(i % 37) - 18 );
+		assert( *(const uint8_t *)harbol_coltable_get_cell(&table, i, 3)==(i & 3) );
+	}
+	struct TestOrder back;
+	assert( harbol_coltable_get_row(&table, 1234, &back) && back.id==1234 * 7 && back.price==34.5f && back.qty==(int32_t)(1234 % 37) - 18 && back.flags==2 );
+	struct HarbolTupleInst *inst = harbol_tuple_inst_new(&schema);
+	assert( harbol_coltable_row_to_inst(&table, 99, inst) && *(int64_t *)harbol_tuple_inst_get_field(inst, 0)==99 * 7 );
+	harbol_tuple_inst_free(&inst);
+	struct HarbolTuple *tup = harbol_tuple_new(4, (size_t[]){ sizeof(int64_t), sizeof(float), sizeof(int32_t), sizeof(uint8_t) }, false);
+	assert( harbol_coltable_row_to_tuple(&table, 42, tup) && *(float *)harbol_tuple_get_field(tup, 1)==42.5f );
+	harbol_tuple_free(&tup);
+	tup = harbol_tuple_new(2, (size_t[]){ sizeof(int64_t), sizeof(float) }, false);
+	assert( !harbol_coltable_append_tuple(&table, tup) && !harbol_coltable_row_to_tuple(&table, 0, tup) );
+	harbol_tuple_free(&tup);
+	
+	// Test filters, refinement and sums against plain loops.
+	fputs("coltable :: test filters and sums.\n", g_harbol_debug_stream);
+	uint32_t *const sel = calloc(rows, sizeof *sel);
+	const int32_t zero = 0;
+	const float cheap = 50.0f;
+	const uint8_t flag = 1;
+	size_t count = harbol_coltable_filter(&table, 2, HarbolColI32, HarbolColGT, &zero, sel);
+	size_t expect = 0;
+	for( size_t i=0; i<rows; i++ )
+		if( qtys[i] > 0 )
+			assert( sel[expect++]==i );
+	assert( count==expect );
+	count = harbol_coltable_filter_refine(&table, 1, HarbolColF32, HarbolColLT, &cheap, sel, count);
+	count = harbol_coltable_filter_refine(&table, 3, HarbolColU8, HarbolColNE, &flag, sel, count);
+	int64_t qty_sum = 0, expect_sum = 0;
+	expect = 0;
+	for( size_t i=0; i<rows; i++ ) {
+		struct TestOrder o;
+		harbol_coltable_get_row(&table, i, &o);
+		if( o.qty > 0 && o.price < 50.0f && o.flags != 1 ) {
+			assert( sel[expect++]==i );
+			expect_sum += o.qty;
+		}
+	}
+	assert( count==expect && harbol_coltable_sum(&table, 2, HarbolColI32, sel, count, &qty_sum) && qty_sum==expect_sum );
+	fprintf(g_harbol_debug_stream, "%zu rows pass, qty sum %" PRId64 "\n", count, qty_sum);
+	
+	double price_sum = 0.0;
+	assert( harbol_coltable_sum(&table, 1, HarbolColF32, NULL, 0, &price_sum) && price_sum==50.0 * (4950.0 + 50.0) );
+	const int64_t id = 700;
+	assert( harbol_coltable_filter(&table, 0, HarbolColI64, HarbolColEQ, &id, sel)==1 && sel[0]==100 );
+	assert( harbol_coltable_filter(&table, 0, HarbolColI64, HarbolColGE, &id, sel)==rows - 100 );
+	assert( harbol_coltable_filter(&table, 0, HarbolColI32, HarbolColEQ, &zero, sel)==0 );
+	assert( !harbol_coltable_sum(&table, 0, HarbolColF32, NULL, 0, &price_sum) );
+	free(sel);
+	harbol_coltable_del(&table);
+	
+	// a deleted or zeroed table has no columns to scan.
+	uint32_t none[1] = {0};
+	const struct HarbolColTable zeroed = (struct HarbolColTable){0};
+	assert( !harbol_coltable_filter(&table, 2, HarbolColI32, HarbolColGT, &zero, none) && !harbol_coltable_filter_refine(&table, 2, HarbolColI32, HarbolColGT, &zero, none, 1) );
+	assert( !harbol_coltable_sum(&table, 2, HarbolColI32, NULL, 0, &qty_sum) && !harbol_coltable_sum(&zeroed, 2, HarbolColI32, NULL, 0, &qty_sum) );
+	assert( !harbol_coltable_filter(&zeroed, 0, HarbolColI64, HarbolColEQ, &id, none) );
+	harbol_tuple_schema_del(&schema);
 }
 
 void test_harbol_mempool(void)
@@ -867,6 +2131,51 @@ void test_harbol_mempool(void)
 	fprintf(g_harbol_debug_stream, "i's FreeList is null? '%s'\n", i.FreeList ? "no" : "yes");
 }
 
+void test_harbol_objpool(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test allocation and initializations
+	fputs("objpool :: test allocation/initialization.\n", g_harbol_debug_stream);
+	struct HarbolObjPool i = (struct HarbolObjPool){0};
+	harbol_objpool_init(&i, sizeof(int64_t) * 3);
+	fprintf(g_harbol_debug_stream, "obj size: '%zu'\n", harbol_objpool_get_obj_size(&i));
+	
+	// test giving memory
+	fputs("objpool :: test giving memory.\n", g_harbol_debug_stream);
+	int64_t *objs[100] = {NULL};
+	for( size_t n=0; n<100; n++ ) {
+		objs[n] = harbol_objpool_alloc(&i);
+		assert( objs[n] && !objs[n][2] );
+		objs[n][0] = objs[n][1] = objs[n][2] = n;
+		assert( harbol_objpool_owns(&i, objs[n]) );
+	}
+	fprintf(g_harbol_debug_stream, "count: '%zu' | total bytes: '%zu'\n", harbol_objpool_get_count(&i), harbol_objpool_get_total_bytes(&i));
+	
+	// test releasing memory
+	fputs("objpool :: test releasing & regiving memory.\n", g_harbol_debug_stream);
+	int64_t *const freed = objs[50];
+	harbol_objpool_dealloc(&i, objs[50]), objs[50]=NULL;
+	assert( harbol_objpool_get_count(&i)==99 );
+	objs[50] = harbol_objpool_alloc(&i);
+	fprintf(g_harbol_debug_stream, "reused freed object? '%s'\n", objs[50]==freed ? "yes" : "no");
+	assert( objs[50]==freed && !objs[50][0] );
+	
+	int64_t outside = 0;
+	assert( !harbol_objpool_owns(&i, &outside) );
+	
+	// test destruction
+	fputs("objpool :: test destruction.\n", g_harbol_debug_stream);
+	harbol_objpool_del(&i);
+	fprintf(g_harbol_debug_stream, "count: '%zu' | total bytes: '%zu'\n", harbol_objpool_get_count(&i), harbol_objpool_get_total_bytes(&i));
+	
+	struct HarbolObjPool *p = harbol_objpool_new(sizeof(char));
+	fprintf(g_harbol_debug_stream, "p obj size rounded up to: '%zu'\n", harbol_objpool_get_obj_size(p));
+	harbol_objpool_free(&p);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+}
+
 void test_harbol_graph(void)
 {
 	if( !g_harbol_debug_stream )
@@ -1061,6 +2370,324 @@ void test_harbol_tree(void)
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
 }
 
+struct TestIntrusiveObj {
+	int64_t Val;
+	struct HarbolIUniLink UniLink;
+	struct HarbolIBiLink BiLink;
+	struct HarbolITree TreeLink;
+};
+
+void test_harbol_intrusive(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	struct TestIntrusiveObj objs[8] = {0};
+	for( size_t n=0; n<8; n++ )
+		objs[n].Val = (int64_t)n;
+	
+	// Test the singly linked list.
+	fputs("intrusive :: test singly linked list.\n", g_harbol_debug_stream);
+	struct HarbolIUniList ulist = (struct HarbolIUniList){0};
+	for( size_t n=0; n<4; n++ )
+		harbol_iunilist_push_tail(&ulist, &objs[n].UniLink);
+	harbol_iunilist_push_head(&ulist, &objs[4].UniLink);
+	harbol_iunilist_insert_after(&ulist, &objs[3].UniLink, &objs[5].UniLink);
+	assert( harbol_iunilist_get_len(&ulist)==6 && ulist.Tail==&objs[5].UniLink );
+	assert( harbol_iunilist_remove(&ulist, &objs[2].UniLink) );
+	assert( !harbol_iunilist_remove(&ulist, &objs[2].UniLink) );
+	assert( harbol_iunilist_remove(&ulist, &objs[5].UniLink) && ulist.Tail==&objs[3].UniLink );
+	{
+		const int64_t expected[] = {4,0,1,3};
+		size_t i = 0;
+		for( struct HarbolIUniLink *l=ulist.Head; l; l=l->Next, i++ ) {
+			const struct TestIntrusiveObj *const obj = harbol_container_of(l, struct TestIntrusiveObj, UniLink);
+			fprintf(g_harbol_debug_stream, "unilist obj: '%" PRIi64 "'\n", obj->Val);
+			assert( obj->Val==expected[i] );
+		}
+		assert( i==4 );
+	}
+	while( harbol_iunilist_pop_head(&ulist) );
+	assert( !ulist.Head && !ulist.Tail && !ulist.Len );
+	
+	// Test the doubly linked list.
+	fputs("\nintrusive :: test doubly linked list.\n", g_harbol_debug_stream);
+	struct HarbolIBiList blist = (struct HarbolIBiList){0};
+	for( size_t n=0; n<8; n++ )
+		harbol_ibilist_push_tail(&blist, &objs[n].BiLink);
+	// O(1) unlink from the middle, head and tail.
+	assert( harbol_ibilist_remove(&blist, &objs[3].BiLink) );
+	assert( harbol_ibilist_remove(&blist, &objs[0].BiLink) && blist.Head==&objs[1].BiLink );
+	assert( harbol_ibilist_remove(&blist, &objs[7].BiLink) && blist.Tail==&objs[6].BiLink );
+	harbol_ibilist_insert_before(&blist, &objs[1].BiLink, &objs[7].BiLink);
+	harbol_ibilist_insert_after(&blist, &objs[6].BiLink, &objs[0].BiLink);
+	harbol_ibilist_insert_after(&blist, &objs[2].BiLink, &objs[3].BiLink);
+	{
+		const int64_t expected[] = {7,1,2,3,4,5,6,0};
+		size_t i = 0;
+		for( struct HarbolIBiLink *l=blist.Head; l; l=l->Next, i++ ) {
+			const struct TestIntrusiveObj *const obj = harbol_container_of(l, struct TestIntrusiveObj, BiLink);
+			fprintf(g_harbol_debug_stream, "bilist obj: '%" PRIi64 "'\n", obj->Val);
+			assert( obj->Val==expected[i] );
+		}
+		assert( i==8 && harbol_ibilist_get_len(&blist)==8 );
+		i = 8;
+		for( struct HarbolIBiLink *l=blist.Tail; l; l=l->Prev )
+			assert( harbol_container_of(l, struct TestIntrusiveObj, BiLink)->Val==expected[--i] );
+	}
+	assert( harbol_container_of(harbol_ibilist_pop_tail(&blist), struct TestIntrusiveObj, BiLink)->Val==0 );
+	assert( harbol_container_of(harbol_ibilist_pop_head(&blist), struct TestIntrusiveObj, BiLink)->Val==7 );
+	while( harbol_ibilist_pop_head(&blist) );
+	assert( !blist.Head && !blist.Tail && !blist.Len );
+	
+	// Test the n-ary tree.
+	fputs("\nintrusive :: test n-ary tree.\n", g_harbol_debug_stream);
+	/*      0
+	 *    / | \
+	 *   1  2  3
+	 *  / \    |
+	 * 4   5   6
+	 */
+	struct HarbolITree *const root = &objs[0].TreeLink;
+	harbol_itree_append_child(root, &objs[2].TreeLink);
+	harbol_itree_append_child(root, &objs[3].TreeLink);
+	harbol_itree_prepend_child(root, &objs[1].TreeLink);
+	harbol_itree_append_child(&objs[1].TreeLink, &objs[5].TreeLink);
+	harbol_itree_insert_child_before(&objs[1].TreeLink, &objs[5].TreeLink, &objs[4].TreeLink);
+	harbol_itree_append_child(&objs[3].TreeLink, &objs[6].TreeLink);
+	// already attached nodes must be unlinked first.
+	assert( !harbol_itree_append_child(root, &objs[6].TreeLink) );
+	assert( harbol_itree_get_children_count(root)==3 && harbol_itree_get_depth(&objs[5].TreeLink)==2 );
+	{
+		const int64_t expected[] = {0,1,4,5,2,3,6};
+		size_t i = 0;
+		for( struct HarbolITree *t=root; t; t=harbol_itree_next_preorder(t, root), i++ ) {
+			const struct TestIntrusiveObj *const obj = harbol_container_of(t, struct TestIntrusiveObj, TreeLink);
+			fprintf(g_harbol_debug_stream, "tree obj: '%" PRIi64 "' | depth: '%zu'\n", obj->Val, harbol_itree_get_depth(t));
+			assert( obj->Val==expected[i] );
+		}
+		assert( i==7 );
+		// walking a subtree stays inside it.
+		i = 0;
+		for( struct HarbolITree *t=&objs[1].TreeLink; t; t=harbol_itree_next_preorder(t, &objs[1].TreeLink) )
+			i++;
+		assert( i==3 );
+	}
+	// unlink a subtree and graft it under another node.
+	assert( harbol_itree_unlink(&objs[1].TreeLink) && harbol_itree_get_children_count(root)==2 );
+	assert( root->FirstChild==&objs[2].TreeLink );
+	assert( harbol_itree_append_child(&objs[6].TreeLink, &objs[1].TreeLink) );
+	assert( harbol_itree_get_depth(&objs[4].TreeLink)==4 );
+	{
+		const int64_t expected[] = {0,2,3,6,1,4,5};
+		size_t i = 0;
+		for( struct HarbolITree *t=root; t; t=harbol_itree_next_preorder(t, root), i++ )
+			assert( harbol_container_of(t, struct TestIntrusiveObj, TreeLink)->Val==expected[i] );
+		assert( i==7 );
+	}
+	assert( !harbol_itree_unlink(root) );
+}
+
+static size_t g_test_bufchain_released;
+static void _test_bufchain_release(void *const ctx, void *const data, const size_t len)
+{
+	(void)data; (void)len;
+	g_test_bufchain_released += (size_t)(uintptr_t)ctx;
+}
+
+void test_harbol_bufchain(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test building a chain without copying.
+	fputs("bufchain :: test append/prepend.\n", g_harbol_debug_stream);
+	static const char hello[] = "hello ", world[] = "world";
+	struct HarbolBufChain *p = harbol_bufchain_new();
+	assert( p );
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	memcpy(harbol_bytebuffer_prepare(&buf, 4), "big ", 4);
+	harbol_bytebuffer_commit(&buf, 4);
+	const uint8_t *const adopted = buf.Buffer;
+	assert( harbol_bufchain_append_region(p, world, 5, _test_bufchain_release, (void *)(uintptr_t)1) );
+	assert( harbol_bufchain_prepend_buffer(p, &buf) && !buf.Buffer );
+	assert( harbol_bufchain_prepend_region(p, hello, 6, _test_bufchain_release, (void *)(uintptr_t)10) );
+	assert( harbol_bufchain_get_len(p)==15 && harbol_bufchain_get_segment_count(p)==3 );
+	assert( harbol_bufchain_get_next_segment(harbol_bufchain_get_head_segment(p))->Data==adopted );
+	
+	struct HarbolByteBuffer flat = (struct HarbolByteBuffer){0};
+	assert( harbol_bufchain_to_bytebuffer(p, &flat) );
+	fprintf(g_harbol_debug_stream, "gathered: '%.*s'\n", (int)flat.Count, flat.Buffer);
+	assert( flat.Count==15 && !memcmp(flat.Buffer, "hello big world", 15) );
+	harbol_bytebuffer_clear(&flat);
+	
+	// Test splitting inside a segment and gluing the halves back.
+	fputs("bufchain :: test split/append_chain.\n", g_harbol_debug_stream);
+	struct HarbolBufChain tail = (struct HarbolBufChain){0};
+	assert( harbol_bufchain_split(p, 8, &tail) );
+	assert( harbol_bufchain_get_len(p)==8 && harbol_bufchain_get_len(&tail)==7 );
+	assert( harbol_bufchain_get_segment_count(p)==2 && harbol_bufchain_get_segment_count(&tail)==2 );
+	assert( harbol_bufchain_get_head_segment(&tail)->Backing==harbol_bufchain_get_next_segment(harbol_bufchain_get_head_segment(p))->Backing );
+	assert( !harbol_bufchain_split(p, 100, &tail) );
+	harbol_bufchain_to_bytebuffer(&tail, &flat);
+	assert( !memcmp(flat.Buffer, "g world", 7) );
+	harbol_bytebuffer_clear(&flat);
+	assert( harbol_bufchain_append_chain(p, &tail) && !harbol_bufchain_get_len(&tail) );
+	assert( harbol_bufchain_get_len(p)==15 && harbol_bufchain_get_segment_count(p)==4 );
+	
+	// Test consuming; regions are only released once fully dropped.
+	fputs("bufchain :: test consume.\n", g_harbol_debug_stream);
+	assert( harbol_bufchain_consume(p, 3)==3 && g_test_bufchain_released==0 );
+	assert( harbol_bufchain_consume(p, 5)==5 && g_test_bufchain_released==10 );
+	assert( harbol_bufchain_get_len(p)==7 && harbol_bufchain_get_segment_count(p)==2 );
+	
+#ifndef OS_WINDOWS
+	// Test flushing with writev and reading back with readv through a pipe.
+	fputs("bufchain :: test writev/readv.\n", g_harbol_debug_stream);
+	int fds[2];
+	assert( !pipe(fds) );
+	size_t written = 0;
+	assert( harbol_bufchain_writev(p, fds[1], &written) );
+	assert( written==7 && !harbol_bufchain_get_len(p) && !harbol_bufchain_get_segment_count(p) && g_test_bufchain_released==11 );
+	close(fds[1]);
+	
+	struct HarbolBufChain in = (struct HarbolBufChain){0};
+	assert( harbol_bufchain_append_space(&in, 4) && harbol_bufchain_append_space(&in, 16) );
+	size_t got = 0, total = 0;
+	do {
+		assert( harbol_bufchain_readv(&in, fds[0], &got) );
+		total += got;
+	} while( got );
+	close(fds[0]);
+	assert( total==7 && harbol_bufchain_get_len(&in)==7 );
+	assert( harbol_bufchain_get_head_segment(&in)->Len==4 );
+	harbol_bufchain_to_bytebuffer(&in, &flat);
+	fprintf(g_harbol_debug_stream, "read back: '%.*s'\n", (int)flat.Count, flat.Buffer);
+	assert( !memcmp(flat.Buffer, "g world", 7) );
+	harbol_bytebuffer_del(&flat);
+	harbol_bufchain_del(&in);
+#endif
+	
+	// Test freeing.
+	harbol_bufchain_append_region(p, world, 5, _test_bufchain_release, (void *)(uintptr_t)100);
+	harbol_bufchain_free(&p);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	assert( g_test_bufchain_released==111 );
+	harbol_bytebuffer_del(&flat);
+}
+
+struct TestFileWriterLog {
+	uint64_t NextOffset;
+	size_t Writes, Barriers, Failed;
+};
+
+static void _test_filewriter_done(void *const ctx, const uint64_t offset, const size_t len, const int err)
+{
+	struct TestFileWriterLog *const log = ctx;
+	if( err ) {
+		log->Failed++;
+		return;
+	}
+	// completions arrive in submission order.
+	assert( offset==log->NextOffset );
+	log->NextOffset += len;
+	if( len )
+		log->Writes++;
+	else log->Barriers++;
+}
+
+void test_harbol_filewriter(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+#ifndef OS_WINDOWS
+	// Test that buffers come out in order with a small queue limit forcing submitters to wait.
+	fputs("filewriter :: test ordered writes with backpressure.\n", g_harbol_debug_stream);
+	struct TestFileWriterLog log = {0};
+	struct HarbolFileWriter fw;
+	assert( harbol_filewriter_open(&fw, "test_filewriter.bin", 0, 4096, _test_filewriter_done, &log) );
+	uint8_t expect_sum = 0;
+	size_t total = 0;
+	for( size_t i=0; i<300; i++ ) {
+		struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+		const size_t len = ( i==150 ) ? 10000 : i * 7 % 500 + 1;
+		uint8_t *const p = harbol_bytebuffer_prepare(&buf, len);
+		for( size_t n=0; n<len; n++ )
+			p[n] = (uint8_t)(total + n), expect_sum += p[n];
+		harbol_bytebuffer_commit(&buf, len);
+		assert( harbol_filewriter_submit(&fw, &buf, true) && buf.Buffer==NULL && buf.Count==0 );
+		total += len;
+		if( i==100 )
+			assert( harbol_filewriter_barrier(&fw) );
+	}
+	assert( harbol_filewriter_get_offset(&fw)==total );
+	assert( harbol_filewriter_flush(&fw, true) );
+	assert( harbol_filewriter_get_queued(&fw)==0 && harbol_filewriter_get_error(&fw)==0 );
+	assert( log.Writes==300 && log.Barriers==2 && log.Failed==0 && log.NextOffset==total );
+	fprintf(g_harbol_debug_stream, "wrote %zu bytes in %zu buffers\n", total, log.Writes);
+	
+	// Test that a full queue refuses a non-blocking submit without taking the buffer.
+	struct HarbolByteBuffer big = (struct HarbolByteBuffer){0};
+	harbol_bytebuffer_prepare(&big, 4096);
+	harbol_bytebuffer_commit(&big, 4096);
+	memset(big.Buffer, 0xAA, 4096);
+	struct HarbolByteBuffer more = (struct HarbolByteBuffer){0};
+	harbol_bytebuffer_insert_byte(&more, 0xBB);
+	assert( harbol_filewriter_submit(&fw, &big, false) );
+	if( !harbol_filewriter_submit(&fw, &more, false) ) {
+		assert( more.Count==1 );
+		assert( harbol_filewriter_submit(&fw, &more, true) );
+	}
+	harbol_filewriter_del(&fw);
+	assert( log.Writes==302 );
+	
+	FILE *const file = fopen("test_filewriter.bin", "rb");
+	struct HarbolByteBuffer back = (struct HarbolByteBuffer){0};
+	assert( harbol_bytebuffer_read_from_file(&back, file)==total + 4097 );
+	fclose(file);
+	uint8_t sum = 0;
+	for( size_t n=0; n<total; n++ ) {
+		assert( back.Buffer[n]==(uint8_t)n );
+		sum += back.Buffer[n];
+	}
+	assert( sum==expect_sum && back.Buffer[total]==0xAA && back.Buffer[total + 4096]==0xBB );
+	harbol_bytebuffer_del(&back);
+	
+	// Test appending to an existing file.
+	assert( harbol_filewriter_open(&fw, "test_filewriter.bin", HarbolFileWriterAppend | HarbolFileWriterSync, 0, NULL, NULL) );
+	assert( harbol_filewriter_get_offset(&fw)==total + 4097 );
+	harbol_bytebuffer_insert_byte(&more, 0xCC);
+	assert( harbol_filewriter_submit(&fw, &more, true) && harbol_filewriter_flush(&fw, false) );
+	harbol_filewriter_del(&fw);
+	
+	// Test that a failed write sticks: everything after it reports the error and submitting stops.
+	fputs("filewriter :: test write errors.\n", g_harbol_debug_stream);
+	const int fd = open("test_filewriter.bin", O_RDONLY);
+	log = (struct TestFileWriterLog){0};
+	struct HarbolFileWriter *bad = harbol_filewriter_new(fd, 0, 0, _test_filewriter_done, &log);
+	assert( bad );
+	harbol_bytebuffer_insert_byte(&more, 1);
+	assert( harbol_filewriter_submit(bad, &more, true) );
+	assert( !harbol_filewriter_flush(bad, false) && harbol_filewriter_get_error(bad)==EBADF && log.Failed==1 );
+	harbol_bytebuffer_insert_byte(&more, 2);
+	assert( !harbol_filewriter_submit(bad, &more, true) && more.Count==1 );
+	harbol_filewriter_free(&bad);
+	assert( bad==NULL );
+	close(fd);
+	
+	// a failed init leaves the writer zeroed, so deleting it afterwards is harmless.
+	int pipefds[2];
+	assert( !pipe(pipefds) );
+	memset(&fw, 0xff, sizeof fw);
+	assert( !harbol_filewriter_init(&fw, pipefds[1], 0, 0, NULL, NULL) && fw.MaxQueued==0 );
+	harbol_filewriter_del(&fw);
+	close(pipefds[0]), close(pipefds[1]);
+	harbol_bytebuffer_del(&more);
+	remove("test_filewriter.bin");
+#endif
+}
+
 void test_harbol_linkmap(void)
 {
 	// Test allocation and initializations
@@ -1132,12 +2759,16 @@ void test_harbol_linkmap(void)
 	fputs("\nlinkmap :: looping through all data.\n", g_harbol_debug_stream);
 	for( size_t n=0; n<p->Order.Count; n++ ) {
 		struct HarbolKeyValPair *l = p->Order.Table[n].Ptr;
+		if( !l )
+			continue;
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", l->Data.Int64);
 	}
 	fputs("\nlinkmap :: test item deletion by index.\n", g_harbol_debug_stream);
 	harbol_linkmap_delete_by_index(p, 2, NULL);
 	for( size_t n=0; n<p->Order.Count; n++ ) {
 		struct HarbolKeyValPair *l = p->Order.Table[n].Ptr;
+		if( !l )
+			continue;
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", l->Data.Int64);
 	}
 	// test setting by index
@@ -1145,8 +2776,72 @@ void test_harbol_linkmap(void)
 	harbol_linkmap_set_by_index(p, 2, (union HarbolValue){.Int64=500});
 	for( size_t n=0; n<p->Order.Count; n++ ) {
 		struct HarbolKeyValPair *l = p->Order.Table[n].Ptr;
+		if( !l )
+			continue;
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", l->Data.Int64);
 	}
+	// test that deletion keeps order & indices consistent.
+	fputs("\nlinkmap :: test tombstoned deletion.\n", g_harbol_debug_stream);
+	{
+		struct HarbolLinkMap big = (struct HarbolLinkMap){0};
+		for( int64_t n=0; n<1000; n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			harbol_linkmap_insert(&big, key, (union HarbolValue){.Int64=n});
+		}
+		// deleting from the front and middle leaves tombstones, deleting the tail just pops.
+		for( int64_t n=0; n<1000; n += 4 ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			harbol_linkmap_delete(&big, key, NULL);
+		}
+		harbol_linkmap_delete(&big, "999", NULL);
+		fprintf(g_harbol_debug_stream, "count: '%zu' | order slots: '%zu' | holes: '%zu'\n", harbol_linkmap_get_count(&big), big.Order.Count, big.Holes);
+		assert( harbol_linkmap_get_count(&big)==749 && big.Holes==250 );
+		
+		// the first index lookup compacts, after that the order is dense again.
+		assert( harbol_linkmap_get_by_index(&big, 0).Int64==1 && harbol_linkmap_get_by_index(&big, 3).Int64==5 );
+		assert( !big.Holes && big.Order.Count==749 );
+		const union HarbolValue *const end = harbol_linkmap_get_iter_end_count(&big);
+		size_t index = 0;
+		for( union HarbolValue *iter = harbol_linkmap_get_iter(&big); iter && iter<end; iter++, index++ ) {
+			struct HarbolKeyValPair *l = iter->KvPairPtr;
+			assert( l && l->Data.Int64 % 4 && harbol_linkmap_get_index_by_node(&big, l)==index );
+			assert( harbol_linkmap_get_node_by_index(&big, index)==l );
+			assert( harbol_linkmap_get_index_by_name(&big, l->KeyName.CStr)==index );
+		}
+		assert( index==749 );
+		assert( harbol_linkmap_get_index_by_name(&big, "998")==748 && harbol_linkmap_get_by_index(&big, 748).Int64==998 );
+		
+		// tombstones left at the front don't need a compaction to keep indices right.
+		harbol_linkmap_delete(&big, "1", NULL);
+		harbol_linkmap_delete(&big, "2", NULL);
+		assert( big.Holes==2 && big.Front==2 );
+		assert( harbol_linkmap_get_by_index(&big, 0).Int64==3 && harbol_linkmap_get_index_by_name(&big, "998")==746 && big.Holes==2 );
+		harbol_linkmap_delete(&big, "501", NULL);
+		assert( harbol_linkmap_get_index_by_name(&big, "998")==745 && !big.Holes );
+		
+		harbol_linkmap_compact(&big);
+		assert( !big.Holes && big.Order.Count==746 );
+		
+		// enough tombstones triggers compaction by itself.
+		for( int64_t n=1; n<900; n++ ) {
+			char key[21] = {0};
+			sprintf(key, "%" PRIi64 "", n);
+			harbol_linkmap_delete(&big, key, NULL);
+		}
+		fprintf(g_harbol_debug_stream, "count: '%zu' | order slots: '%zu' | holes: '%zu'\n", harbol_linkmap_get_count(&big), big.Order.Count, big.Holes);
+		assert( big.Order.Count <= 2 * harbol_linkmap_get_count(&big) );
+		harbol_linkmap_del(&big, NULL);
+	}
+	// test stats
+	fputs("\nlinkmap :: test stats.\n", g_harbol_debug_stream);
+	{
+		struct HarbolHashMapStats linkstats, mapstats;
+		assert( harbol_linkmap_get_stats(p, &linkstats) && harbol_hashmap_get_stats(&p->Map, &mapstats) );
+		harbol_hashmap_stats_to_file(&linkstats, g_harbol_debug_stream);
+		assert( linkstats.Count==harbol_linkmap_get_count(p) && linkstats.TotalBytes > mapstats.TotalBytes );
+	}
 	// free data
 	fputs("\nlinkmap :: test destruction.\n", g_harbol_debug_stream);
 	harbol_linkmap_del(&i, NULL);
@@ -1158,6 +2853,319 @@ void test_harbol_linkmap(void)
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
 }
 
+void test_harbol_frozenmap(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test allocation and initializations
+	fputs("frozenmap :: test freezing a hashmap.\n", g_harbol_debug_stream);
+	struct HarbolHashMap map = (struct HarbolHashMap){0};
+	for( int64_t n=0; n<5000; n++ ) {
+		char key[21] = {0};
+		sprintf(key, "key_%" PRIi64 "", n);
+		harbol_hashmap_insert(&map, key, (union HarbolValue){.Int64=n});
+	}
+	struct HarbolFrozenMap *p = harbol_frozenmap_new_from_hashmap(&map);
+	assert( p );
+	fprintf(g_harbol_debug_stream, "frozen count: '%zu' | buckets: '%zu' | key arena: '%zu'\n", harbol_frozenmap_get_count(p), p->Buckets, p->ArenaSize);
+	for( int64_t n=0; n<5000; n++ ) {
+		char key[21] = {0};
+		sprintf(key, "key_%" PRIi64 "", n);
+		assert( harbol_frozenmap_get(p, key).Int64==n );
+		const size_t index = harbol_frozenmap_get_index(p, key);
+		assert( !strcmp(harbol_frozenmap_get_key_by_index(p, index), key) );
+	}
+	assert( !harbol_frozenmap_has_key(p, "key_5000") );
+	assert( !harbol_frozenmap_has_key(p, "key_") );
+	assert( !harbol_frozenmap_has_key(p, "") );
+	harbol_hashmap_del(&map, NULL);
+	
+	// test serialization
+	fputs("frozenmap :: test serialization.\n", g_harbol_debug_stream);
+	struct HarbolByteBuffer buf = (struct HarbolByteBuffer){0};
+	assert( harbol_frozenmap_to_bytebuffer(p, &buf) );
+	struct HarbolFrozenMap loaded = (struct HarbolFrozenMap){0};
+	assert( harbol_frozenmap_from_bytebuffer(&loaded, &buf) );
+	fprintf(g_harbol_debug_stream, "serialized size: '%zu' | loaded count: '%zu'\n", harbol_bytebuffer_get_count(&buf), harbol_frozenmap_get_count(&loaded));
+	assert( harbol_frozenmap_get(&loaded, "key_4321").Int64==4321 );
+	
+	// corrupted data has to be rejected rather than trusted.
+	buf.Buffer[buf.Count - 1] = 'x';
+	assert( !harbol_frozenmap_from_bytebuffer(&loaded, &buf) );
+	buf.Count = 10;
+	assert( !harbol_frozenmap_from_bytebuffer(&loaded, &buf) );
+	harbol_bytebuffer_del(&buf);
+	harbol_frozenmap_del(&loaded);
+	harbol_frozenmap_free(&p);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// test freezing a linkmap.
+	fputs("frozenmap :: test freezing a linkmap.\n", g_harbol_debug_stream);
+	struct HarbolLinkMap linkmap = (struct HarbolLinkMap){0};
+	harbol_linkmap_insert(&linkmap, "a", (union HarbolValue){.Double=1.5});
+	harbol_linkmap_insert(&linkmap, "bb", (union HarbolValue){.Double=2.5});
+	harbol_linkmap_insert(&linkmap, "ccc", (union HarbolValue){.Double=3.5});
+	struct HarbolFrozenMap frozen = (struct HarbolFrozenMap){0};
+	assert( harbol_frozenmap_from_linkmap(&frozen, &linkmap) );
+	for( size_t i=0; i<harbol_frozenmap_get_count(&frozen); i++ )
+		fprintf(g_harbol_debug_stream, "frozen[\"%s\"] == %f\n", harbol_frozenmap_get_key_by_index(&frozen, i), harbol_frozenmap_get_by_index(&frozen, i).Double);
+	assert( harbol_frozenmap_get(&frozen, "bb").Double==2.5 );
+	harbol_linkmap_del(&linkmap, NULL);
+	
+	// empty maps freeze into empty tables.
+	assert( harbol_frozenmap_from_linkmap(&frozen, &linkmap) );
+	assert( !harbol_frozenmap_get_count(&frozen) && !harbol_frozenmap_has_key(&frozen, "a") );
+	harbol_frozenmap_del(&frozen);
+}
+
+static bool _test_cache_free_blob(void *const ptr_ref)
+{
+	void **const blob = ptr_ref;
+	free(*blob), *blob=NULL;
+	return true;
+}
+
+void test_harbol_cache(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test allocation and initializations
+	fputs("cache :: test allocation/initialization.\n", g_harbol_debug_stream);
+	struct HarbolCache *p = harbol_cache_new(HarbolCacheLRU, 3, NULL);
+	assert( p );
+	fprintf(g_harbol_debug_stream, "p's count is zero? '%s'\n", !harbol_cache_get_count(p) ? "yes" : "no");
+	assert( !harbol_cache_new(HarbolCacheLRU, 0, NULL) );
+	
+	// test LRU eviction order.
+	fputs("cache :: test LRU eviction.\n", g_harbol_debug_stream);
+	harbol_cache_put(p, "a", (union HarbolValue){.Int64=1}, 1);
+	harbol_cache_put(p, "b", (union HarbolValue){.Int64=2}, 1);
+	harbol_cache_put(p, "c", (union HarbolValue){.Int64=3}, 1);
+	union HarbolValue val = {0};
+	assert( harbol_cache_get(p, "a", &val) && val.Int64==1 );
+	harbol_cache_put(p, "d", (union HarbolValue){.Int64=4}, 1);
+	// 'b' was the least recently used after 'a' got touched.
+	assert( !harbol_cache_peek(p, "b", NULL) );
+	assert( harbol_cache_peek(p, "a", NULL) && harbol_cache_peek(p, "c", NULL) && harbol_cache_peek(p, "d", NULL) );
+	assert( !harbol_cache_get(p, "b", NULL) );
+	harbol_cache_touch(p, "c");
+	harbol_cache_put(p, "e", (union HarbolValue){.Int64=5}, 1);
+	assert( !harbol_cache_peek(p, "a", NULL) && harbol_cache_peek(p, "c", NULL) );
+	struct HarbolCacheStats stats = harbol_cache_get_stats(p);
+	fprintf(g_harbol_debug_stream, "hits: '%zu' | misses: '%zu' | evictions: '%zu'\n", stats.Hits, stats.Misses, stats.Evictions);
+	assert( stats.Hits==1 && stats.Misses==1 && stats.Evictions==2 );
+	
+	// lots of churn through a small cache; recency order has to hold the whole way.
+	for( int64_t n=0; n<10000; n++ ) {
+		char key[21] = {0};
+		sprintf(key, "key_%" PRIi64 "", n);
+		harbol_cache_put(p, key, (union HarbolValue){.Int64=n}, 1);
+		harbol_cache_get(p, "c", NULL);
+	}
+	assert( harbol_cache_get_count(p)==3 && harbol_cache_peek(p, "c", NULL) );
+	assert( harbol_cache_peek(p, "key_9999", NULL) && harbol_cache_peek(p, "key_9998", NULL) );
+	harbol_cache_free(&p);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// test weighted capacity and the eviction callback.
+	fputs("cache :: test weighted capacity.\n", g_harbol_debug_stream);
+	struct HarbolCache cache = (struct HarbolCache){0};
+	assert( harbol_cache_init(&cache, HarbolCacheLRU, 100, _test_cache_free_blob) );
+	for( int i=0; i<10; i++ ) {
+		char key[21] = {0};
+		sprintf(key, "blob_%i", i);
+		assert( harbol_cache_put(&cache, key, (union HarbolValue){.Ptr=malloc(30)}, 30) );
+		assert( harbol_cache_get_weight(&cache) <= 100 );
+	}
+	assert( harbol_cache_get_count(&cache)==3 && harbol_cache_get_weight(&cache)==90 );
+	// too heavy to ever fit, so it's handed right back to the callback.
+	assert( !harbol_cache_put(&cache, "huge", (union HarbolValue){.Ptr=malloc(1)}, 101) );
+	// replacing a key frees the old value.
+	assert( harbol_cache_put(&cache, "blob_9", (union HarbolValue){.Ptr=malloc(50)}, 50) );
+	assert( harbol_cache_get_weight(&cache)==80 && harbol_cache_get_count(&cache)==2 );
+	harbol_cache_set_capacity(&cache, 60);
+	assert( harbol_cache_get_count(&cache)==1 && harbol_cache_peek(&cache, "blob_9", NULL) );
+	assert( harbol_cache_remove(&cache, "blob_9") && !harbol_cache_get_weight(&cache) );
+	stats = harbol_cache_get_stats(&cache);
+	fprintf(g_harbol_debug_stream, "evictions: '%zu' | rejections: '%zu'\n", stats.Evictions, stats.Rejections);
+	assert( stats.Evictions==9 && stats.Rejections==1 );
+	harbol_cache_put(&cache, "left_over", (union HarbolValue){.Ptr=malloc(8)}, 8);
+	harbol_cache_del(&cache);
+	
+	// test CLOCK's second chance.
+	fputs("cache :: test CLOCK eviction.\n", g_harbol_debug_stream);
+	assert( harbol_cache_init(&cache, HarbolCacheCLOCK, 3, NULL) );
+	harbol_cache_put(&cache, "a", (union HarbolValue){.Int64=1}, 1);
+	harbol_cache_put(&cache, "b", (union HarbolValue){.Int64=2}, 1);
+	harbol_cache_put(&cache, "c", (union HarbolValue){.Int64=3}, 1);
+	harbol_cache_get(&cache, "a", NULL);
+	harbol_cache_put(&cache, "d", (union HarbolValue){.Int64=4}, 1);
+	assert( harbol_cache_peek(&cache, "a", NULL) && !harbol_cache_peek(&cache, "b", NULL) );
+	harbol_cache_get(&cache, "c", NULL);
+	harbol_cache_put(&cache, "e", (union HarbolValue){.Int64=5}, 1);
+	// the hand picks up after "b", so "c" spends its second chance and fresh, unreferenced "d" goes.
+	assert( harbol_cache_peek(&cache, "c", NULL) && harbol_cache_peek(&cache, "a", NULL) && !harbol_cache_peek(&cache, "d", NULL) );
+	for( int64_t n=0; n<10000; n++ ) {
+		char key[21] = {0};
+		sprintf(key, "key_%" PRIi64 "", n);
+		harbol_cache_put(&cache, key, (union HarbolValue){.Int64=n}, 1);
+		if( n & 1 )
+			harbol_cache_remove(&cache, key);
+		assert( harbol_cache_get_count(&cache) <= 3 );
+	}
+	harbol_cache_del(&cache);
+	
+	// test TinyLFU admission keeping a hot set against a one-off scan.
+	fputs("cache :: test TinyLFU admission.\n", g_harbol_debug_stream);
+	assert( harbol_cache_init(&cache, HarbolCacheTinyLFU, 4, NULL) );
+	const char *hot[] = { "h0", "h1", "h2", "h3" };
+	for( int round=0; round<5; round++ )
+		for( size_t i=0; i<4; i++ )
+			if( !harbol_cache_get(&cache, hot[i], NULL) )
+				harbol_cache_put(&cache, hot[i], (union HarbolValue){.UInt64=i}, 1);
+	for( int64_t n=0; n<1000; n++ ) {
+		char key[21] = {0};
+		sprintf(key, "scan_%" PRIi64 "", n);
+		harbol_cache_put(&cache, key, (union HarbolValue){.Int64=n}, 1);
+	}
+	size_t survivors = 0;
+	for( size_t i=0; i<4; i++ )
+		survivors += harbol_cache_peek(&cache, hot[i], NULL);
+	stats = harbol_cache_get_stats(&cache);
+	fprintf(g_harbol_debug_stream, "hot survivors: '%zu' | rejections: '%zu'\n", survivors, stats.Rejections);
+	assert( survivors==4 && stats.Rejections > 0 );
+	harbol_cache_reset_stats(&cache);
+	assert( !harbol_cache_get_stats(&cache).Rejections );
+	harbol_cache_del(&cache);
+}
+
+void test_harbol_bptree(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// Test allocation and initializations
+	fputs("bptree :: test allocation/initialization.\n", g_harbol_debug_stream);
+	struct HarbolBPTree *p = harbol_bptree_new(HarbolBPKeyInt);
+	assert( p );
+	fprintf(g_harbol_debug_stream, "p's count is zero? '%s'\n", !harbol_bptree_get_count(p) ? "yes" : "no");
+	assert( !harbol_bptree_iter_valid(&(struct HarbolBPTreeIter){0}) );
+	
+	// test insertion and deletion in scrambled order.
+	fputs("bptree :: test insertion/deletion.\n", g_harbol_debug_stream);
+	const int64_t total = 10000;
+	for( int64_t i=0; i<total; i++ ) {
+		const int64_t k = (i * 7919) % total;
+		assert( harbol_bptree_insert(p, (union HarbolValue){.Int64=k}, (union HarbolValue){.Int64=k * 2}) );
+	}
+	assert( !harbol_bptree_insert(p, (union HarbolValue){.Int64=42}, (union HarbolValue){.Int64=0}) );
+	assert( harbol_bptree_get(p, (union HarbolValue){.Int64=42}).Int64==84 );
+	fprintf(g_harbol_debug_stream, "count: '%zu' | height: '%zu'\n", harbol_bptree_get_count(p), harbol_bptree_get_height(p));
+	int64_t expect = 0;
+	for( struct HarbolBPTreeIter it = harbol_bptree_first(p); harbol_bptree_iter_valid(&it); harbol_bptree_iter_next(&it) )
+		assert( harbol_bptree_iter_key(&it).Int64==expect++ );
+	assert( expect==total );
+	
+	// delete every odd key, scrambled.
+	for( int64_t i=0; i<total; i++ ) {
+		const int64_t k = (i * 7919) % total;
+		if( k & 1 )
+			assert( harbol_bptree_delete(p, (union HarbolValue){.Int64=k}, NULL) );
+	}
+	assert( !harbol_bptree_delete(p, (union HarbolValue){.Int64=1}, NULL) );
+	assert( harbol_bptree_get_count(p)==(size_t)total / 2 );
+	expect = 0;
+	for( struct HarbolBPTreeIter it = harbol_bptree_first(p); harbol_bptree_iter_valid(&it); harbol_bptree_iter_next(&it), expect += 2 )
+		assert( harbol_bptree_iter_key(&it).Int64==expect && harbol_bptree_iter_val(&it).Int64==expect * 2 );
+	assert( expect==total );
+	
+	// test range queries.
+	fputs("bptree :: test range queries.\n", g_harbol_debug_stream);
+	struct HarbolBPTreeIter it = harbol_bptree_lower_bound(p, (union HarbolValue){.Int64=101});
+	assert( harbol_bptree_iter_key(&it).Int64==102 );
+	it = harbol_bptree_lower_bound(p, (union HarbolValue){.Int64=102});
+	assert( harbol_bptree_iter_key(&it).Int64==102 );
+	it = harbol_bptree_upper_bound(p, (union HarbolValue){.Int64=102});
+	assert( harbol_bptree_iter_key(&it).Int64==104 );
+	// walk [200, 300] backwards starting from the upper bound.
+	it = harbol_bptree_upper_bound(p, (union HarbolValue){.Int64=300});
+	size_t in_range = 0;
+	for( harbol_bptree_iter_prev(&it); harbol_bptree_iter_valid(&it) && harbol_bptree_iter_key(&it).Int64 >= 200; harbol_bptree_iter_prev(&it) )
+		in_range++;
+	fprintf(g_harbol_debug_stream, "keys in [200, 300]: '%zu'\n", in_range);
+	assert( in_range==51 );
+	// past the end gives the end iterator, which steps back onto the last key.
+	it = harbol_bptree_lower_bound(p, (union HarbolValue){.Int64=total});
+	assert( !harbol_bptree_iter_valid(&it) );
+	assert( harbol_bptree_iter_prev(&it) && harbol_bptree_iter_key(&it).Int64==total - 2 );
+	it = harbol_bptree_first(p);
+	assert( !harbol_bptree_iter_prev(&it) );
+	
+	// drain it completely.
+	for( int64_t k=0; k<total; k += 2 )
+		assert( harbol_bptree_delete(p, (union HarbolValue){.Int64=k}, NULL) );
+	assert( !harbol_bptree_get_count(p) && !harbol_bptree_get_height(p) );
+	assert( !harbol_bptree_iter_valid(&(struct HarbolBPTreeIter){harbol_bptree_first(p).Leaf, 0}) );
+	harbol_bptree_free(&p, NULL);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+	
+	// test string keys and bulk loading.
+	fputs("bptree :: test string keys and bulk loading.\n", g_harbol_debug_stream);
+	struct HarbolBPTree tree = (struct HarbolBPTree){0};
+	harbol_bptree_init(&tree, HarbolBPKeyStr);
+	char (*names)[16] = calloc(1000, sizeof *names);
+	union HarbolValue *keys = calloc(1000, sizeof *keys);
+	union HarbolValue *vals = calloc(1000, sizeof *vals);
+	for( size_t i=0; i<1000; i++ ) {
+		sprintf(names[i], "name_%04zu", i);
+		keys[i].Ptr = names[i];
+		vals[i].UInt64 = i;
+	}
+	// out of order input is turned down.
+	keys[500].Ptr = names[10];
+	assert( !harbol_bptree_bulk_load(&tree, keys, vals, 1000) && !harbol_bptree_get_count(&tree) );
+	keys[500].Ptr = names[500];
+	assert( harbol_bptree_bulk_load(&tree, keys, vals, 1000) );
+	assert( !harbol_bptree_bulk_load(&tree, keys, vals, 1000) );
+	fprintf(g_harbol_debug_stream, "bulk loaded count: '%zu' | height: '%zu'\n", harbol_bptree_get_count(&tree), harbol_bptree_get_height(&tree));
+	// keys are copied in, so the source strings can go.
+	free(names), free(keys), free(vals);
+	assert( harbol_bptree_get(&tree, (union HarbolValue){.Ptr="name_0777"}).UInt64==777 );
+	for( size_t i=0; i<1000; i += 3 ) {
+		char key[16] = {0};
+		sprintf(key, "name_%04zu", i);
+		assert( harbol_bptree_delete(&tree, (union HarbolValue){.Ptr=key}, NULL) );
+	}
+	assert( harbol_bptree_insert(&tree, (union HarbolValue){.Ptr="name_0003"}, (union HarbolValue){.UInt64=3}) );
+	assert( harbol_bptree_set(&tree, (union HarbolValue){.Ptr="name_0003"}, (union HarbolValue){.UInt64=33}) );
+	// prefix scan: everything from "name_05" up to but excluding "name_06".
+	size_t prefixed = 0;
+	for( it = harbol_bptree_lower_bound(&tree, (union HarbolValue){.Ptr="name_05"}); harbol_bptree_iter_valid(&it) && strncmp(harbol_bptree_iter_key(&it).Ptr, "name_05", 7)==0; harbol_bptree_iter_next(&it) )
+		prefixed++;
+	fprintf(g_harbol_debug_stream, "keys with prefix 'name_05': '%zu'\n", prefixed);
+	assert( prefixed==67 );
+	
+	// test conversions.
+	fputs("bptree :: test conversions.\n", g_harbol_debug_stream);
+	struct HarbolLinkMap *map = harbol_linkmap_new_from_bptree(&tree);
+	assert( harbol_linkmap_get_count(map)==harbol_bptree_get_count(&tree) );
+	assert( !strcmp(harbol_linkmap_get_node_by_index(map, 0)->KeyName.CStr, "name_0001") );
+	struct HarbolVector *vec = harbol_vector_new_from_bptree(&tree);
+	assert( harbol_vector_get_count(vec)==harbol_bptree_get_count(&tree) && vec->Table[2].UInt64==33 );
+	struct HarbolBPTree *indexed = harbol_bptree_new_from_vector(vec, HarbolBPKeyDouble);
+	assert( harbol_bptree_get(indexed, (union HarbolValue){.Double=2.0}).UInt64==33 );
+	struct HarbolBPTree *copy = harbol_bptree_new_from_linkmap(map, HarbolBPKeyStr);
+	assert( harbol_bptree_get_count(copy)==harbol_linkmap_get_count(map) );
+	assert( !harbol_bptree_has_key(indexed, (union HarbolValue){.Double=0.0 / 0.0}) );
+	harbol_bptree_free(&copy, NULL);
+	harbol_bptree_free(&indexed, NULL);
+	harbol_vector_free(&vec, NULL);
+	harbol_linkmap_free(&map, NULL);
+	harbol_bptree_del(&tree, NULL);
+}
+
 void test_conversions(void)
 {
 	if( !g_harbol_debug_stream )
@@ -1644,6 +3652,26 @@ void test_harbol_cfg(void)
 		fputs("\ncfg :: test building cfg file!\n", g_harbol_debug_stream);
 		fprintf(g_harbol_debug_stream, "\nconfig construction result: '%s'\n", harbol_cfg_build_file(larger_cfg, "large_cfg.ini", true) ? "success" : "failure");
 		
+		{
+			// read a file back through a mapped view.
+			FILE *cfgfile = fopen("mapped_cfg.ini", "w");
+			assert( cfgfile );
+			fprintf(cfgfile, "'root': { 'age': %" PRIi64 " }\n", age);
+			fclose(cfgfile);
+			struct HarbolLinkMap *reloaded = harbol_cfg_from_file("mapped_cfg.ini");
+			remove("mapped_cfg.ini");
+			int64_t reloaded_age = 0;
+			assert( reloaded && harbol_cfg_get_int_by_key(reloaded, "root.age", &reloaded_age) && reloaded_age==age );
+			harbol_cfg_free(&reloaded);
+			
+			struct HarbolByteBuffer unterminated = (struct HarbolByteBuffer){0};
+			harbol_bytebuffer_insert_obj(&unterminated, "'a': 1", 6);
+			reloaded = harbol_cfg_parse_bytebuffer(&unterminated);
+			assert( reloaded && harbol_cfg_get_int_by_key(reloaded, "a", &reloaded_age) && reloaded_age==1 );
+			harbol_cfg_free(&reloaded);
+			harbol_bytebuffer_del(&unterminated);
+		}
+		
 		fputs("\ncfg :: test setting a key back to null\n", g_harbol_debug_stream);
 		harbol_cfg_set_key_to_null(larger_cfg, "root.spouse");
 		{
@@ -35,55 +35,94 @@ HARBOL_EXPORT bool harbol_tuple_free(struct HarbolTuple **tupref)
 	return true;
 }
 
-HARBOL_EXPORT void harbol_tuple_init(struct HarbolTuple *const tup, const size_t array_len, const size_t datasizes[static array_len], const bool packed)
+/* the largest power of two dividing 'size', capped at a pointer's size like the rest of the tuple code. */
+static size_t _harbol_tuple_natural_align(const size_t size)
+{
+	const size_t pow2 = size & -size;
+	return !pow2 ? 1 : ( pow2 > sizeof(intptr_t) ) ? sizeof(intptr_t) : pow2;
+}
+
+/* the layout tuples have always used: each field is padded up to the next one's size
+ * and the total up to the largest field's, both capped at a pointer's size.
+ * returns the total size, or 0 if it doesn't fit the 32-bit offsets.
+ */
+static size_t _harbol_tuple_layout(const size_t array_len, const size_t datasizes[const restrict], const bool packed, struct HarbolTupleField fields[const restrict])
 {
-	if( !tup )
-		return;
-	
-	memset(tup, 0, sizeof *tup);
 	const size_t sizeptr = sizeof(intptr_t);
-	size_t largestmemb=0;
-	// first we find the largest member of the tuple:
-	for( size_t i=0; i<array_len; i++ )
-		if( largestmemb<datasizes[i] )
-			largestmemb=datasizes[i];
-	
-	// next, compute padding and alignment:
-	// we do this by having a next and previous size.
-	size_t
-		totalsize=0,
-		prevsize=0
-	;
+	size_t largestmemb = 0, offset = 0, prevsize = 0;
 	for( size_t i=0; i<array_len; i++ ) {
-		totalsize += datasizes[i];
+		if( datasizes[i] > UINT32_MAX || offset > UINT32_MAX - datasizes[i] )
+			return 0;
+		if( largestmemb < datasizes[i] )
+			largestmemb = datasizes[i];
+		
+		fields[i].Offset = (uint32_t)offset;
+		fields[i].Size = (uint32_t)datasizes[i];
+		fields[i].Align = packed ? 1 : (uint32_t)_harbol_tuple_natural_align(datasizes[i]);
+		offset += datasizes[i];
 		if( packed || array_len==1 )
 			continue;
 		const size_t offalign = (i+1<array_len) ? datasizes[i+1] : prevsize;
-		totalsize = harbol_align_size(totalsize, offalign>=sizeptr ? sizeptr : offalign);
+		offset = harbol_align_size(offset, offalign>=sizeptr ? sizeptr : offalign);
 		prevsize = datasizes[i];
 	}
-	// now do a final size alignment with the largest member.
-	const size_t aligned_total = harbol_align_size(totalsize, largestmemb>=sizeptr ? sizeptr : largestmemb);
+	return packed ? offset : harbol_align_size(offset, largestmemb>=sizeptr ? sizeptr : largestmemb);
+}
+
+HARBOL_EXPORT void harbol_tuple_init(struct HarbolTuple *const tup, const size_t array_len, const size_t datasizes[static array_len], const bool packed)
+{
+	if( !tup )
+		return;
 	
-	tup->Datum = calloc(packed ? totalsize : aligned_total, sizeof *tup->Datum);
-	if( !tup->Datum )
+	memset(tup, 0, sizeof *tup);
+	struct HarbolTupleField local[16], *const fields = ( array_len <= 16 ) ? local : calloc(array_len, sizeof *fields);
+	if( !fields )
 		return;
 	
-	tup->Len = packed ? totalsize : aligned_total;
-	tuple_size_t offset = 0;
-	for( size_t i=0; i<array_len; i++ ) {
+	const size_t len = _harbol_tuple_layout(array_len, datasizes, packed, fields);
+	tup->Datum = len ? calloc(len, sizeof *tup->Datum) : NULL;
+	if( tup->Datum ) {
+		tup->Len = len;
+		tup->Packed = packed;
+		for( size_t i=0; i<array_len; i++ ) {
+			TupleElement field = {0};
+			field.Struc.Size = fields[i].Size;
+			field.Struc.Offset = fields[i].Offset;
+			harbol_vector_insert(&tup->Fields, field.Val);
+		}
+	}
+	if( fields != local )
+		free(fields);
+}
+
+/* a tuple with a schema's layout, e.g. an optimized one. */
+HARBOL_EXPORT bool harbol_tuple_init_from_schema(struct HarbolTuple *const restrict tup, const struct HarbolTupleSchema *const restrict schema)
+{
+	if( !tup || !schema || !schema->Fields )
+		return false;
+	
+	memset(tup, 0, sizeof *tup);
+	tup->Datum = calloc(schema->Len, sizeof *tup->Datum);
+	if( !tup->Datum )
+		return false;
+	
+	tup->Len = schema->Len;
+	tup->Packed = schema->Packed;
+	for( size_t i=0; i<schema->Count; i++ ) {
 		TupleElement field = {0};
-		field.Struc.Size = datasizes[i];
-		field.Struc.Offset = offset;
-		
+		field.Struc.Size = schema->Fields[i].Size;
+		field.Struc.Offset = schema->Fields[i].Offset;
 		harbol_vector_insert(&tup->Fields, field.Val);
-		offset += datasizes[i];
-		if( packed || array_len==1 )
-			continue;
-		const size_t offalign = (i+1<array_len) ? datasizes[i+1] : prevsize;
-		offset = harbol_align_size(offset, offalign>=sizeptr ? sizeptr : offalign);
-		prevsize = datasizes[i];
 	}
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolTuple *harbol_tuple_new_from_schema(const struct HarbolTupleSchema *const schema)
+{
+	struct HarbolTuple *tup = calloc(1, sizeof *tup);
+	if( tup && !harbol_tuple_init_from_schema(tup, schema) )
+		free(tup), tup = NULL;
+	return tup;
 }
 
 HARBOL_EXPORT void harbol_tuple_del(struct HarbolTuple *const tup)
@@ -141,3 +180,468 @@ HARBOL_EXPORT bool harbol_tuple_to_struct(const struct HarbolTuple *const restri
 	memcpy(structptr, tup->Datum, tup->Len);
 	return true;
 }
+
+
+/* Tuple Schema code */
+/////////////////////////////////////////
+HARBOL_EXPORT bool harbol_tuple_schema_init(struct HarbolTupleSchema *const restrict schema, const size_t array_len, const size_t datasizes[restrict], const bool packed)
+{
+	if( !schema || !array_len || !datasizes )
+		return false;
+	
+	memset(schema, 0, sizeof *schema);
+	schema->Fields = calloc(array_len, sizeof *schema->Fields);
+	if( !schema->Fields )
+		return false;
+	
+	schema->Len = _harbol_tuple_layout(array_len, datasizes, packed, schema->Fields);
+	if( !schema->Len ) {
+		harbol_tuple_schema_del(schema);
+		return false;
+	}
+	schema->Count = array_len;
+	schema->Packed = packed;
+	schema->Align = 1;
+	for( size_t i=0; i<array_len; i++ )
+		if( schema->Align < schema->Fields[i].Align )
+			schema->Align = schema->Fields[i].Align;
+	return true;
+}
+
+struct HarbolTupleOrder {
+	size_t Align, Index;
+};
+
+static int _harbol_tuple_order_cmp(const void *const a, const void *const b)
+{
+	const struct HarbolTupleOrder *const x = a, *const y = b;
+	if( x->Align != y->Align )
+		return ( x->Align > y->Align ) ? -1 : 1;
+	return ( x->Index > y->Index ) - ( x->Index < y->Index );
+}
+
+/* lays fields out at their natural alignment (see '_harbol_tuple_natural_align') or the one given in 'aligns',
+ * where a 0 entry (or a NULL 'aligns') means natural; explicit alignments go up to alignof(max_align_t).
+ * with HarbolTupleOptimize, fields are placed by descending alignment (ties keep their declared order),
+ * which leaves no padding between fields whose sizes are multiples of their alignment.
+ * indexes always stay in declared order; only the offsets move.
+ */
+HARBOL_EXPORT bool harbol_tuple_schema_init_layout(struct HarbolTupleSchema *const restrict schema, const size_t array_len, const size_t datasizes[restrict], const size_t aligns[restrict], const int flags)
+{
+	if( !schema || !array_len || !datasizes )
+		return false;
+	
+	const bool packed = flags & HarbolTuplePacked;
+	struct HarbolTupleOrder *const order = calloc(array_len, sizeof *order);
+	if( !order )
+		return false;
+	for( size_t i=0; i<array_len; i++ ) {
+		const size_t align = ( aligns && aligns[i] ) ? aligns[i] : _harbol_tuple_natural_align(datasizes[i]);
+		if( datasizes[i] > UINT32_MAX || (align & (align - 1)) || align > alignof(max_align_t) ) {
+			free(order);
+			return false;
+		}
+		order[i] = (struct HarbolTupleOrder){ packed ? 1 : align, i };
+	}
+	if( (flags & HarbolTupleOptimize) && !packed )
+		qsort(order, array_len, sizeof *order, _harbol_tuple_order_cmp);
+	
+	memset(schema, 0, sizeof *schema);
+	schema->Fields = calloc(array_len, sizeof *schema->Fields);
+	if( !schema->Fields ) {
+		free(order);
+		return false;
+	}
+	
+	size_t offset = 0, maxalign = 1;
+	for( size_t k=0; k<array_len; k++ ) {
+		const size_t i = order[k].Index, align = order[k].Align;
+		offset = harbol_align_size(offset, align);
+		if( offset > UINT32_MAX - datasizes[i] ) {
+			free(order);
+			harbol_tuple_schema_del(schema);
+			return false;
+		}
+		schema->Fields[i] = (struct HarbolTupleField){ (uint32_t)offset, (uint32_t)datasizes[i], (uint32_t)align };
+		offset += datasizes[i];
+		if( maxalign < align )
+			maxalign = align;
+	}
+	free(order);
+	schema->Count = array_len;
+	schema->Len = harbol_align_size(offset, maxalign);
+	schema->Align = maxalign;
+	schema->Packed = packed;
+	if( !schema->Len ) {
+		harbol_tuple_schema_del(schema);
+		return false;
+	}
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolTupleSchema *harbol_tuple_schema_new_layout(const size_t array_len, const size_t datasizes[], const size_t aligns[], const int flags)
+{
+	struct HarbolTupleSchema *schema = calloc(1, sizeof *schema);
+	if( schema && !harbol_tuple_schema_init_layout(schema, array_len, datasizes, aligns, flags) )
+		free(schema), schema = NULL;
+	return schema;
+}
+
+HARBOL_EXPORT struct HarbolTupleSchema *harbol_tuple_schema_new(const size_t array_len, const size_t datasizes[], const bool packed)
+{
+	struct HarbolTupleSchema *schema = calloc(1, sizeof *schema);
+	if( schema && !harbol_tuple_schema_init(schema, array_len, datasizes, packed) )
+		free(schema), schema = NULL;
+	return schema;
+}
+
+HARBOL_EXPORT void harbol_tuple_schema_del(struct HarbolTupleSchema *const schema)
+{
+	if( !schema )
+		return;
+	free(schema->Fields);
+	memset(schema, 0, sizeof *schema);
+}
+
+HARBOL_EXPORT bool harbol_tuple_schema_free(struct HarbolTupleSchema **const schemaref)
+{
+	if( !schemaref || !*schemaref )
+		return false;
+	harbol_tuple_schema_del(*schemaref);
+	free(*schemaref), *schemaref=NULL;
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_schema_get_len(const struct HarbolTupleSchema *const schema)
+{
+	return schema ? schema->Len : 0;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_schema_get_count(const struct HarbolTupleSchema *const schema)
+{
+	return schema ? schema->Count : 0;
+}
+
+/* SIZE_MAX for a bad index. */
+HARBOL_EXPORT size_t harbol_tuple_schema_get_field_offset(const struct HarbolTupleSchema *const schema, const size_t index)
+{
+	return ( !schema || index >= schema->Count ) ? SIZE_MAX : schema->Fields[index].Offset;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_schema_get_field_size(const struct HarbolTupleSchema *const schema, const size_t index)
+{
+	return ( !schema || index >= schema->Count ) ? 0 : schema->Fields[index].Size;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_schema_get_align(const struct HarbolTupleSchema *const schema)
+{
+	return schema ? schema->Align : 0;
+}
+
+/* bytes per instance that aren't any field's: between fields plus the tail. */
+HARBOL_EXPORT size_t harbol_tuple_schema_get_padding(const struct HarbolTupleSchema *const schema)
+{
+	if( !schema )
+		return 0;
+	size_t used = 0;
+	for( size_t i=0; i<schema->Count; i++ )
+		used += schema->Fields[i].Size;
+	return schema->Len - used;
+}
+/////////////////////////////////////////
+
+
+/* Tuple Instance code */
+/////////////////////////////////////////
+/* one allocation: the schema pointer followed by the zeroed data. the schema has to outlive it. */
+HARBOL_EXPORT struct HarbolTupleInst *harbol_tuple_inst_new(const struct HarbolTupleSchema *const schema)
+{
+	if( !schema || !schema->Fields )
+		return NULL;
+	
+	struct HarbolTupleInst *const inst = calloc(1, sizeof *inst + schema->Len);
+	if( inst )
+		inst->Schema = schema;
+	return inst;
+}
+
+HARBOL_EXPORT bool harbol_tuple_inst_free(struct HarbolTupleInst **const instref)
+{
+	if( !instref || !*instref )
+		return false;
+	free(*instref), *instref=NULL;
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_inst_get_len(const struct HarbolTupleInst *const inst)
+{
+	return inst ? inst->Schema->Len : 0;
+}
+
+HARBOL_EXPORT void *harbol_tuple_inst_get_field(struct HarbolTupleInst *const inst, const size_t index)
+{
+	if( !inst || index >= inst->Schema->Count )
+		return NULL;
+	return inst->Datum + inst->Schema->Fields[index].Offset;
+}
+
+HARBOL_EXPORT void *harbol_tuple_inst_set_field(struct HarbolTupleInst *const restrict inst, const size_t index, const void *const restrict value)
+{
+	if( !inst || !value || index >= inst->Schema->Count )
+		return NULL;
+	const struct HarbolTupleField field = inst->Schema->Fields[index];
+	return memcpy(inst->Datum + field.Offset, value, field.Size);
+}
+
+HARBOL_EXPORT size_t harbol_tuple_inst_get_field_size(const struct HarbolTupleInst *const inst, const size_t index)
+{
+	return inst ? harbol_tuple_schema_get_field_size(inst->Schema, index) : 0;
+}
+
+HARBOL_EXPORT bool harbol_tuple_inst_to_struct(const struct HarbolTupleInst *const restrict inst, void *const restrict structptr)
+{
+	if( !inst || !structptr )
+		return false;
+	memcpy(structptr, inst->Datum, inst->Schema->Len);
+	return true;
+}
+/////////////////////////////////////////
+
+
+/* Tuple Array code */
+/////////////////////////////////////////
+/* serialized form, header little-endian:
+ *	u32 magic, u8 version, u8 row byte order (1 little, 2 big), u8 packed, u8 reserved,
+ *	u32 field count, u32 row size, u32 row alignment, u64 row count,
+ *	{u32 offset, u32 size, u32 align} per field,
+ *	zeros up to a 16 byte boundary, then the rows exactly as they sit in memory.
+ */
+#define HARBOL_TUPLE_ARRAY_MAGIC      0x50555448u /* "HTUP" */
+#define HARBOL_TUPLE_ARRAY_VERSION    1
+#define HARBOL_TUPLE_ARRAY_HDR_ALIGN  16
+
+static uint8_t _harbol_tuple_host_order(void)
+{
+	const uint16_t probe = 1;
+	uint8_t first;
+	memcpy(&first, &probe, 1);
+	return first ? 1 : 2;
+}
+
+HARBOL_EXPORT struct HarbolTupleArray *harbol_tuple_array_new(const struct HarbolTupleSchema *const schema)
+{
+	struct HarbolTupleArray *arr = calloc(1, sizeof *arr);
+	if( arr && !harbol_tuple_array_init(arr, schema) )
+		free(arr), arr = NULL;
+	return arr;
+}
+
+/* the schema has to outlive the array. */
+/* rows sit back to back, so every field of every row is only aligned if the row length is a multiple of the row alignment
+ * and each field's offset is a multiple of its own alignment, which can't exceed the row's.
+ */
+static bool _harbol_tuple_schema_rows_aligned(const struct HarbolTupleSchema *const schema)
+{
+	if( !schema->Len || !schema->Align || (schema->Align & (schema->Align - 1)) || schema->Len % schema->Align )
+		return false;
+	
+	for( size_t i=0; i<schema->Count; i++ ) {
+		const struct HarbolTupleField *const field = &schema->Fields[i];
+		if( !field->Align || (field->Align & (field->Align - 1)) || field->Align > schema->Align || field->Offset % field->Align )
+			return false;
+		else if( field->Offset > schema->Len || field->Size > schema->Len - field->Offset )
+			return false;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_tuple_array_init(struct HarbolTupleArray *const restrict arr, const struct HarbolTupleSchema *const restrict schema)
+{
+	if( !arr || !schema || !schema->Fields || !_harbol_tuple_schema_rows_aligned(schema) )
+		return false;
+	
+	memset(arr, 0, sizeof *arr);
+	arr->Schema = schema;
+	return true;
+}
+
+HARBOL_EXPORT void harbol_tuple_array_del(struct HarbolTupleArray *const arr)
+{
+	if( !arr )
+		return;
+	if( !arr->View )
+		free(arr->Rows);
+	harbol_tuple_schema_del(&arr->OwnSchema);
+	memset(arr, 0, sizeof *arr);
+}
+
+HARBOL_EXPORT bool harbol_tuple_array_free(struct HarbolTupleArray **const arrref)
+{
+	if( !arrref || !*arrref )
+		return false;
+	harbol_tuple_array_del(*arrref);
+	free(*arrref), *arrref=NULL;
+	return true;
+}
+
+HARBOL_EXPORT size_t harbol_tuple_array_get_count(const struct HarbolTupleArray *const arr)
+{
+	return arr ? arr->Count : 0;
+}
+
+HARBOL_EXPORT bool harbol_tuple_array_is_view(const struct HarbolTupleArray *const arr)
+{
+	return arr ? arr->View : false;
+}
+
+HARBOL_EXPORT bool harbol_tuple_array_reserve(struct HarbolTupleArray *const arr, const size_t count)
+{
+	if( !arr || !arr->Schema || arr->View || count > SIZE_MAX / arr->Schema->Len )
+		return false;
+	else if( count <= arr->Cap )
+		return true;
+	
+	uint8_t *const rows = realloc(arr->Rows, count * arr->Schema->Len);
+	if( !rows )
+		return false;
+	arr->Rows = rows;
+	arr->Cap = count;
+	return true;
+}
+
+/* copies 'datum' (laid out by the schema) in as a new last row, or zeroes it if 'datum' is NULL. returns the row. */
+HARBOL_EXPORT void *harbol_tuple_array_append(struct HarbolTupleArray *const restrict arr, const void *const restrict datum)
+{
+	if( !arr || !arr->Schema || arr->View )
+		return NULL;
+	else if( arr->Count==arr->Cap && !harbol_tuple_array_reserve(arr, arr->Cap ? arr->Cap << 1 : 16) )
+		return NULL;
+	
+	uint8_t *const row = arr->Rows + arr->Count++ * arr->Schema->Len;
+	if( datum )
+		memcpy(row, datum, arr->Schema->Len);
+	else memset(row, 0, arr->Schema->Len);
+	return row;
+}
+
+HARBOL_EXPORT void *harbol_tuple_array_get_row(const struct HarbolTupleArray *const arr, const size_t row)
+{
+	return ( !arr || row >= arr->Count ) ? NULL : arr->Rows + row * arr->Schema->Len;
+}
+
+HARBOL_EXPORT void *harbol_tuple_array_get_field(const struct HarbolTupleArray *const arr, const size_t row, const size_t index)
+{
+	if( !arr || row >= arr->Count || index >= arr->Schema->Count )
+		return NULL;
+	return arr->Rows + row * arr->Schema->Len + arr->Schema->Fields[index].Offset;
+}
+
+/* views are read-only. */
+HARBOL_EXPORT void *harbol_tuple_array_set_field(struct HarbolTupleArray *const restrict arr, const size_t row, const size_t index, const void *const restrict value)
+{
+	if( !arr || !value || arr->View || row >= arr->Count || index >= arr->Schema->Count )
+		return NULL;
+	const struct HarbolTupleField field = arr->Schema->Fields[index];
+	return memcpy(arr->Rows + row * arr->Schema->Len + field.Offset, value, field.Size);
+}
+
+/* appends the whole array to 'buf': a header describing the schema, then every row in one copy.
+ * rows keep this machine's byte order, and a view can only be made on a machine with the same one.
+ */
+HARBOL_EXPORT bool harbol_tuple_array_serialize(const struct HarbolTupleArray *const restrict arr, struct HarbolByteBuffer *const restrict buf)
+{
+	if( !arr || !buf || !arr->Schema || arr->Schema->Count > UINT32_MAX )
+		return false;
+	
+	const struct HarbolTupleSchema *const schema = arr->Schema;
+	const size_t start = buf->Count;
+	struct HarbolByteWriter w;
+	harbol_bytewriter_init(&w, buf);
+	harbol_bytewriter_put_u32_le(&w, HARBOL_TUPLE_ARRAY_MAGIC);
+	harbol_bytewriter_put_u8(&w, HARBOL_TUPLE_ARRAY_VERSION);
+	harbol_bytewriter_put_u8(&w, _harbol_tuple_host_order());
+	harbol_bytewriter_put_u8(&w, schema->Packed);
+	harbol_bytewriter_put_u8(&w, 0);
+	harbol_bytewriter_put_u32_le(&w, (uint32_t)schema->Count);
+	harbol_bytewriter_put_u32_le(&w, (uint32_t)schema->Len);
+	harbol_bytewriter_put_u32_le(&w, (uint32_t)schema->Align);
+	harbol_bytewriter_put_u64_le(&w, arr->Count);
+	for( size_t i=0; i<schema->Count; i++ ) {
+		harbol_bytewriter_put_u32_le(&w, schema->Fields[i].Offset);
+		harbol_bytewriter_put_u32_le(&w, schema->Fields[i].Size);
+		harbol_bytewriter_put_u32_le(&w, schema->Fields[i].Align);
+	}
+	while( harbol_bytewriter_ok(&w) && (buf->Count - start) % HARBOL_TUPLE_ARRAY_HDR_ALIGN )
+		harbol_bytewriter_put_u8(&w, 0);
+	if( arr->Count )
+		harbol_bytewriter_put_bytes(&w, arr->Rows, arr->Count * schema->Len);
+	return harbol_bytewriter_ok(&w);
+}
+
+/* makes 'arr' a read-only view of an array serialized at 'data', without copying any rows:
+ * the schema is rebuilt from the header and rows are read in place, so 'data' has to stay alive and unchanged while it's used.
+ * 'data' has to be aligned to the rows' alignment (any malloc'd or mapped buffer is).
+ * 'used' (if given) gets the serialized size, so arrays written back to back can be read one after another.
+ * like 'harbol_bytebuffer_map_file', 'arr' has to be zeroed or hold an array, which is deleted once the view succeeds.
+ */
+HARBOL_EXPORT bool harbol_tuple_array_view(struct HarbolTupleArray *const restrict arr, const void *const restrict data, const size_t len, size_t *const restrict used)
+{
+	if( !arr || !data )
+		return false;
+	
+	struct HarbolByteReader r;
+	harbol_bytereader_init(&r, data, len);
+	uint32_t magic = 0, count = 0, rowlen = 0, align = 0;
+	uint8_t version = 0, order = 0, packed = 0, reserved = 0;
+	uint64_t rows = 0;
+	harbol_bytereader_get_u32_le(&r, &magic);
+	harbol_bytereader_get_u8(&r, &version);
+	harbol_bytereader_get_u8(&r, &order);
+	harbol_bytereader_get_u8(&r, &packed);
+	harbol_bytereader_get_u8(&r, &reserved);
+	harbol_bytereader_get_u32_le(&r, &count);
+	harbol_bytereader_get_u32_le(&r, &rowlen);
+	harbol_bytereader_get_u32_le(&r, &align);
+	harbol_bytereader_get_u64_le(&r, &rows);
+	if( !harbol_bytereader_ok(&r) || magic != HARBOL_TUPLE_ARRAY_MAGIC || version != HARBOL_TUPLE_ARRAY_VERSION || order != _harbol_tuple_host_order() )
+		return false;
+	else if( !count || !rowlen || !align || (align & (align - 1)) || align > alignof(max_align_t) || count > harbol_bytereader_get_remaining(&r) / 12 )
+		return false;
+	
+	struct HarbolTupleSchema schema = {0};
+	schema.Fields = calloc(count, sizeof *schema.Fields);
+	if( !schema.Fields )
+		return false;
+	schema.Count = count, schema.Len = rowlen, schema.Align = align, schema.Packed = packed;
+	for( size_t i=0; i<count; i++ ) {
+		struct HarbolTupleField *const field = &schema.Fields[i];
+		harbol_bytereader_get_u32_le(&r, &field->Offset);
+		harbol_bytereader_get_u32_le(&r, &field->Size);
+		harbol_bytereader_get_u32_le(&r, &field->Align);
+	}
+	
+	// the header isn't trusted: a layout that would hand out misaligned row or field pointers is refused.
+	const size_t hdr = harbol_align_size(harbol_bytereader_get_pos(&r), HARBOL_TUPLE_ARRAY_HDR_ALIGN);
+	const uint8_t *const base = (const uint8_t *)data + hdr;
+	if( !harbol_bytereader_ok(&r) || !_harbol_tuple_schema_rows_aligned(&schema) || hdr > len || rows > (len - hdr) / rowlen || (uintptr_t)base % align ) {
+		harbol_tuple_schema_del(&schema);
+		return false;
+	}
+	
+	harbol_tuple_array_del(arr);
+	arr->OwnSchema = schema;
+	arr->Schema = &arr->OwnSchema;
+	arr->Rows = (uint8_t *)base;
+	arr->Count = (size_t)rows;
+	arr->View = true;
+	if( used )
+		*used = hdr + (size_t)rows * rowlen;
+	return true;
+}
+
+/* a view of a serialized array held in 'buf', which can be a mapped file. */
+HARBOL_EXPORT bool harbol_tuple_array_view_bytebuffer(struct HarbolTupleArray *const restrict arr, const struct HarbolByteBuffer *const restrict buf)
+{
+	return buf && harbol_tuple_array_view(arr, buf->Buffer, buf->Count, NULL);
+}
+/////////////////////////////////////////
@@ -54,6 +54,25 @@ HARBOL_EXPORT union HarbolValue harbol_unilistnode_get_val(const struct HarbolUn
 
 /* Singly Linked List code */
 /////////////////////////////////////////
+/* nodes made by a pooled list come out of 'Pool'; anything else the list holds was made with 'harbol_unilistnode_new'. */
+static struct HarbolUniListNode *_harbol_unilist_node_alloc(struct HarbolUniList *const list, const union HarbolValue val)
+{
+	if( !list->Pool )
+		return harbol_unilistnode_new_val(val);
+	
+	struct HarbolUniListNode *const node = harbol_objpool_alloc(list->Pool);
+	if( node )
+		node->Data = val;
+	return node;
+}
+
+static void _harbol_unilist_node_release(struct HarbolUniList *const list, struct HarbolUniListNode *const node)
+{
+	if( list->Pool && harbol_objpool_owns(list->Pool, node) )
+		harbol_objpool_dealloc(list->Pool, node);
+	else free(node);
+}
+
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new(void)
 {
 	struct HarbolUniList *list = calloc(1, sizeof *list);
@@ -65,8 +84,17 @@ HARBOL_EXPORT void harbol_unilist_del(struct HarbolUniList *const list, fnHarbol
 	if( !list )
 		return;
 	
-	harbol_unilistnode_free(&list->Head, dtor);
+	// walked instead of recursing through 'harbol_unilistnode_free' so long lists can't blow the stack.
+	for( struct HarbolUniListNode *node = list->Head; node; ) {
+		struct HarbolUniListNode *const next = node->Next;
+		if( dtor )
+			(*dtor)(&node->Data.Ptr);
+		_harbol_unilist_node_release(list, node);
+		node = next;
+	}
+	struct HarbolObjPool *const pool = list->Pool;
 	memset(list, 0, sizeof *list);
+	list->Pool = pool;
 }
 
 HARBOL_EXPORT void harbol_unilist_free(struct HarbolUniList **listref, fnHarbolDestructor *const dtor)
@@ -86,6 +114,20 @@ HARBOL_EXPORT void harbol_unilist_init(struct HarbolUniList *const list)
 	memset(list, 0, sizeof *list);
 }
 
+HARBOL_EXPORT bool harbol_unilist_set_pool(struct HarbolUniList *const list, struct HarbolObjPool *const pool)
+{
+	if( !list || list->Len || (pool && harbol_objpool_get_obj_size(pool) < sizeof(struct HarbolUniListNode)) )
+		return false;
+	
+	list->Pool = pool;
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolObjPool *harbol_unilist_get_pool(const struct HarbolUniList *const list)
+{
+	return list ? list->Pool : NULL;
+}
+
 HARBOL_EXPORT size_t harbol_unilist_get_len(const struct HarbolUniList *const list)
 {
 	return list ? list->Len : 0;
@@ -154,13 +196,13 @@ HARBOL_EXPORT bool harbol_unilist_insert_at_head(struct HarbolUniList *const lis
 {
 	if( !list )
 		return false;
-	struct HarbolUniListNode *node = harbol_unilistnode_new_val(val);
+	struct HarbolUniListNode *node = _harbol_unilist_node_alloc(list, val);
 	if( !node )
 		return false;
 	
 	const bool result = harbol_unilist_insert_node_at_head(list, node);
 	if( !result )
-		harbol_unilistnode_free(&node, NULL);
+		_harbol_unilist_node_release(list, node);
 	return result;
 }
 
@@ -168,13 +210,13 @@ HARBOL_EXPORT bool harbol_unilist_insert_at_tail(struct HarbolUniList *const lis
 {
 	if( !list )
 		return false;
-	struct HarbolUniListNode *node = harbol_unilistnode_new_val(val);
+	struct HarbolUniListNode *node = _harbol_unilist_node_alloc(list, val);
 	if( !node )
 		return false;
 	
 	const bool result = harbol_unilist_insert_node_at_tail(list, node);
 	if( !result )
-		harbol_unilistnode_free(&node, NULL);
+		_harbol_unilist_node_release(list, node);
 	return result;
 }
 
@@ -182,13 +224,13 @@ HARBOL_EXPORT bool harbol_unilist_insert_at_index(struct HarbolUniList *const li
 {
 	if( !list )
 		return false;
-	struct HarbolUniListNode *node = harbol_unilistnode_new_val(val);
+	struct HarbolUniListNode *node = _harbol_unilist_node_alloc(list, val);
 	if( !node )
 		return false;
 	
 	const bool result = harbol_unilist_insert_node_at_index(list, node, index);
 	if( !result )
-		harbol_unilistnode_free(&node, NULL);
+		_harbol_unilist_node_release(list, node);
 	return result;
 }
 
@@ -293,7 +335,7 @@ HARBOL_EXPORT bool harbol_unilist_del_node_by_index(struct HarbolUniList *const
 	
 	if( dtor )
 		(*dtor)(&node->Data.Ptr);
-	free(node); node=NULL;
+	_harbol_unilist_node_release(list, node); node=NULL;
 	
 	list->Len--;
 	if( !list->Len && list->Tail )
@@ -326,7 +368,7 @@ HARBOL_EXPORT bool harbol_unilist_del_node_by_ref(struct HarbolUniList *const li
 	
 	if( dtor )
 		(*dtor)(&node->Data.Ptr);
-	free(*noderef); *noderef=NULL;
+	_harbol_unilist_node_release(list, node); *noderef=NULL;
 	list->Len--;
 	return true;
 }
@@ -341,6 +383,113 @@ HARBOL_EXPORT struct HarbolUniListNode *harbol_unilist_get_tail_node(const struc
 	return list ? list->Tail : NULL;
 }
 
+/* moves the nodes following 'before_first' (or starting at the head if NULL) through 'last' out of 'src'
+ * and right after 'pos' in 'dst' ('pos' being NULL means at the head, and it can't be inside the range).
+ * 'count' is how many nodes the range holds, which keeps this O(1); pass 0 to have the range counted instead.
+ * both lists need the same pool (or none) since the nodes keep belonging to wherever they were allocated from.
+ */
+HARBOL_EXPORT bool harbol_unilist_splice_after(struct HarbolUniList *const dst, struct HarbolUniListNode *const pos, struct HarbolUniList *const src, struct HarbolUniListNode *const before_first, struct HarbolUniListNode *const last, size_t count)
+{
+	if( !dst || !src || !last || dst->Pool != src->Pool )
+		return false;
+	
+	struct HarbolUniListNode *const first = before_first ? before_first->Next : src->Head;
+	if( !first )
+		return false;
+	else if( !count ) {
+		for( const struct HarbolUniListNode *n = first; n != last; n = n->Next ) {
+			if( !n )
+				return false;
+			count++;
+		}
+		count++;
+	}
+	
+	// already sitting right after 'pos'.
+	if( dst==src && (pos==before_first || pos==last) )
+		return true;
+	
+	before_first ? (before_first->Next = last->Next) : (src->Head = last->Next);
+	if( src->Tail==last )
+		src->Tail = before_first;
+	src->Len -= count;
+	
+	last->Next = pos ? pos->Next : dst->Head;
+	pos ? (pos->Next = first) : (dst->Head = first);
+	if( !last->Next )
+		dst->Tail = last;
+	dst->Len += count;
+	return true;
+}
+
+/* appends every node of 'src' to 'dst', leaving 'src' empty. */
+HARBOL_EXPORT bool harbol_unilist_concat(struct HarbolUniList *const dst, struct HarbolUniList *const src)
+{
+	if( !dst || !src || dst==src || dst->Pool != src->Pool )
+		return false;
+	else if( !src->Head )
+		return true;
+	
+	return harbol_unilist_splice_after(dst, dst->Tail, src, NULL, src->Tail, src->Len);
+}
+
+/* moves everything after 'node' (the whole list if NULL) into the empty list 'tail'; O(n) in the nodes moved to keep both lengths right. */
+HARBOL_EXPORT bool harbol_unilist_split_after(struct HarbolUniList *const list, struct HarbolUniListNode *const node, struct HarbolUniList *const tail)
+{
+	if( !list || !tail || tail==list || tail->Len )
+		return false;
+	
+	// splicing needs both lists on one pool, but a failed split leaves 'tail' as it was.
+	struct HarbolObjPool *const pool = tail->Pool;
+	tail->Pool = list->Pool;
+	if( node==list->Tail || harbol_unilist_splice_after(tail, NULL, list, node, list->Tail, 0) )
+		return true;
+	tail->Pool = pool;
+	return false;
+}
+
+/* stable bottom-up merge sort that only relinks nodes, so it never allocates or recurses. */
+HARBOL_EXPORT bool harbol_unilist_sort(struct HarbolUniList *const list, fnHarbolValueCmp *const cmp)
+{
+	if( !list || !cmp )
+		return false;
+	else if( list->Len < 2 )
+		return true;
+	
+	struct HarbolUniListNode *head = list->Head, *tail = NULL;
+	for( size_t width=1;; width <<= 1 ) {
+		struct HarbolUniListNode *p = head;
+		head = tail = NULL;
+		size_t merges = 0;
+		while( p ) {
+			merges++;
+			struct HarbolUniListNode *q = p;
+			size_t psize = 0, qsize = width;
+			for( ; psize<width && q; psize++ )
+				q = q->Next;
+			
+			while( psize || (qsize && q) ) {
+				struct HarbolUniListNode *e;
+				// taking from the left run on ties is what keeps it stable.
+				if( psize && (!qsize || !q || (*cmp)(p->Data, q->Data) <= 0) ) {
+					e = p, p = p->Next, psize--;
+				} else {
+					e = q, q = q->Next, qsize--;
+				}
+				tail ? (tail->Next = e) : (head = e);
+				tail = e;
+			}
+			p = q;
+		}
+		tail->Next = NULL;
+		if( merges<=1 )
+			break;
+	}
+	list->Head = head;
+	list->Tail = tail;
+	return true;
+}
+
 HARBOL_EXPORT void harbol_unilist_from_bilist(struct HarbolUniList *const unilist, const struct HarbolBiList *const bilist)
 {
 	if( !unilist || !bilist )
@@ -350,13 +499,23 @@ HARBOL_EXPORT void harbol_unilist_from_bilist(struct HarbolUniList *const unilis
 		harbol_unilist_insert_at_tail(unilist, n->Data);
 }
 
+HARBOL_EXPORT void harbol_unilist_from_unrolled(struct HarbolUniList *const unilist, const struct HarbolUnrolledList *const list)
+{
+	if( !unilist || !list )
+		return;
+	
+	for( struct HarbolUnrolledNode *n=list->Head; n; n = n->Next )
+		for( size_t i=0; i<n->Count; i++ )
+			harbol_unilist_insert_at_tail(unilist, n->Vals[i]);
+}
+
 HARBOL_EXPORT void harbol_unilist_from_hashmap(struct HarbolUniList *const unilist, const struct HarbolHashMap *const map)
 {
 	if( !unilist || !map )
 		return;
 	
-	for( size_t i=0; i<map->Len; i++ ) {
-		struct HarbolVector *vec = map->Table + i;
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		struct HarbolVector *vec = harbol_hashmap_get_bucket(map, i);
 		for( size_t n=0; n<harbol_vector_get_count(vec); n++ ) {
 			struct HarbolKeyValPair *node = vec->Table[n].Ptr;
 			harbol_unilist_insert_at_tail(unilist, node->Data);
@@ -391,6 +550,8 @@ HARBOL_EXPORT void harbol_unilist_from_linkmap(struct HarbolUniList *const unili
 	
 	for( size_t i=0; i<map->Order.Count; i++ ) {
 		struct HarbolKeyValPair *n = map->Order.Table[i].Ptr;
+		if( !n )
+			continue;
 		harbol_unilist_insert_at_tail(unilist, n->Data);
 	}
 }
@@ -439,3 +600,12 @@ HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_linkmap(const struct
 	harbol_unilist_from_linkmap(unilist, map);
 	return unilist;
 }
+
+HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new_from_unrolled(const struct HarbolUnrolledList *const list)
+{
+	if( !list )
+		return NULL;
+	struct HarbolUniList *const unilist = harbol_unilist_new();
+	harbol_unilist_from_unrolled(unilist, list);
+	return unilist;
+}
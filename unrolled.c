@@ -0,0 +1,390 @@
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include "harbol.h"
+
+/*
+typedef struct HarbolUnrolledList {
+	struct HarbolUnrolledNode *Head, *Tail;
+	size_t Len, Nodes;
+} HarbolUnrolledList;
+*/
+
+/* a node that drops below this gets topped up from, or merged with, its successor. */
+#define HARBOL_UNROLLED_MIN_VALS    (HARBOL_UNROLLED_NODE_VALS / 2)
+
+static struct HarbolUnrolledNode *_harbol_unrolled_node_new(struct HarbolUnrolledList *const list)
+{
+#ifdef OS_WINDOWS
+	struct HarbolUnrolledNode *const node = _aligned_malloc(sizeof *node, sizeof *node);
+#else
+	struct HarbolUnrolledNode *const node = aligned_alloc(sizeof *node, sizeof *node);
+#endif
+	if( node ) {
+		node->Next = NULL;
+		node->Count = 0;
+		list->Nodes++;
+	}
+	return node;
+}
+
+static void _harbol_unrolled_node_free(struct HarbolUnrolledList *const list, struct HarbolUnrolledNode *const node)
+{
+#ifdef OS_WINDOWS
+	_aligned_free(node);
+#else
+	free(node);
+#endif
+	list->Nodes--;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new(void)
+{
+	struct HarbolUnrolledList *list = calloc(1, sizeof *list);
+	return list;
+}
+
+HARBOL_EXPORT void harbol_unrolled_init(struct HarbolUnrolledList *const list)
+{
+	if( !list )
+		return;
+	
+	memset(list, 0, sizeof *list);
+}
+
+HARBOL_EXPORT void harbol_unrolled_del(struct HarbolUnrolledList *const list, fnHarbolDestructor *const dtor)
+{
+	if( !list )
+		return;
+	
+	for( struct HarbolUnrolledNode *node = list->Head; node; ) {
+		struct HarbolUnrolledNode *const next = node->Next;
+		if( dtor )
+			for( size_t i=0; i<node->Count; i++ )
+				(*dtor)(&node->Vals[i].Ptr);
+		_harbol_unrolled_node_free(list, node);
+		node = next;
+	}
+	memset(list, 0, sizeof *list);
+}
+
+HARBOL_EXPORT void harbol_unrolled_free(struct HarbolUnrolledList **listref, fnHarbolDestructor *const dtor)
+{
+	if( !listref || !*listref )
+		return;
+	
+	harbol_unrolled_del(*listref, dtor);
+	free(*listref), *listref=NULL;
+}
+
+HARBOL_EXPORT size_t harbol_unrolled_get_len(const struct HarbolUnrolledList *const list)
+{
+	return list ? list->Len : 0;
+}
+
+HARBOL_EXPORT size_t harbol_unrolled_get_node_count(const struct HarbolUnrolledList *const list)
+{
+	return list ? list->Nodes : 0;
+}
+
+/* finds the node holding 'index' by hopping whole nodes. 'prev' gets the node before it. */
+static struct HarbolUnrolledNode *_harbol_unrolled_seek(const struct HarbolUnrolledList *const list, size_t index, size_t *const restrict slot, struct HarbolUnrolledNode **const restrict prev)
+{
+	struct HarbolUnrolledNode *before = NULL;
+	struct HarbolUnrolledNode *node = list->Head;
+	// the tail is checked first since appending-style access is the common case.
+	if( list->Tail && index >= list->Len - list->Tail->Count && index < list->Len && !prev ) {
+		*slot = index - (list->Len - list->Tail->Count);
+		return list->Tail;
+	}
+	while( node && index >= node->Count ) {
+		index -= node->Count;
+		before = node;
+		node = node->Next;
+	}
+	*slot = index;
+	if( prev )
+		*prev = before;
+	return node;
+}
+
+/* moves the back half of a full node into a fresh node right after it. */
+static struct HarbolUnrolledNode *_harbol_unrolled_split(struct HarbolUnrolledList *const list, struct HarbolUnrolledNode *const node)
+{
+	struct HarbolUnrolledNode *const right = _harbol_unrolled_node_new(list);
+	if( !right )
+		return NULL;
+	
+	const size_t keep = node->Count / 2;
+	right->Count = node->Count - keep;
+	memcpy(right->Vals, node->Vals + keep, right->Count * sizeof *right->Vals);
+	node->Count = keep;
+	right->Next = node->Next;
+	node->Next = right;
+	if( list->Tail==node )
+		list->Tail = right;
+	return right;
+}
+
+HARBOL_EXPORT bool harbol_unrolled_insert_at_tail(struct HarbolUnrolledList *const list, const union HarbolValue val)
+{
+	if( !list )
+		return false;
+	else if( !list->Tail || list->Tail->Count==HARBOL_UNROLLED_NODE_VALS ) {
+		// appending fills nodes all the way, so a list built from the back is as dense as it gets.
+		struct HarbolUnrolledNode *const node = _harbol_unrolled_node_new(list);
+		if( !node )
+			return false;
+		if( list->Tail )
+			list->Tail->Next = node;
+		else list->Head = node;
+		list->Tail = node;
+	}
+	list->Tail->Vals[list->Tail->Count++] = val;
+	list->Len++;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_unrolled_insert_at_head(struct HarbolUnrolledList *const list, const union HarbolValue val)
+{
+	return harbol_unrolled_insert_at_index(list, val, 0);
+}
+
+/* if index is out of bounds, the value is appended at the tail end. */
+HARBOL_EXPORT bool harbol_unrolled_insert_at_index(struct HarbolUnrolledList *const list, const union HarbolValue val, const size_t index)
+{
+	if( !list )
+		return false;
+	else if( index >= list->Len )
+		return harbol_unrolled_insert_at_tail(list, val);
+	
+	size_t slot = 0;
+	struct HarbolUnrolledNode *node = _harbol_unrolled_seek(list, index, &slot, NULL);
+	if( node==list->Head && !slot && node->Count==HARBOL_UNROLLED_NODE_VALS ) {
+		// prepending to a full head starts a new head instead of splitting, same as appending does at the tail.
+		struct HarbolUnrolledNode *const head = _harbol_unrolled_node_new(list);
+		if( !head )
+			return false;
+		head->Next = node;
+		list->Head = node = head;
+	} else if( node->Count==HARBOL_UNROLLED_NODE_VALS ) {
+		struct HarbolUnrolledNode *const right = _harbol_unrolled_split(list, node);
+		if( !right )
+			return false;
+		if( slot > node->Count ) {
+			slot -= node->Count;
+			node = right;
+		}
+	}
+	memmove(node->Vals + slot + 1, node->Vals + slot, (node->Count - slot) * sizeof *node->Vals);
+	node->Vals[slot] = val;
+	node->Count++;
+	list->Len++;
+	return true;
+}
+
+HARBOL_EXPORT union HarbolValue harbol_unrolled_get_val(const struct HarbolUnrolledList *const list, const size_t index)
+{
+	if( !list || index >= list->Len )
+		return (union HarbolValue){0};
+	
+	size_t slot = 0;
+	const struct HarbolUnrolledNode *const node = _harbol_unrolled_seek(list, index, &slot, NULL);
+	return node->Vals[slot];
+}
+
+HARBOL_EXPORT void harbol_unrolled_set_val(struct HarbolUnrolledList *const list, const size_t index, const union HarbolValue val)
+{
+	if( !list || index >= list->Len )
+		return;
+	
+	size_t slot = 0;
+	struct HarbolUnrolledNode *const node = _harbol_unrolled_seek(list, index, &slot, NULL);
+	node->Vals[slot] = val;
+}
+
+HARBOL_EXPORT size_t harbol_unrolled_get_index_by_val(const struct HarbolUnrolledList *const list, const union HarbolValue val)
+{
+	if( !list )
+		return SIZE_MAX;
+	
+	size_t base = 0;
+	for( const struct HarbolUnrolledNode *node = list->Head; node; base += node->Count, node = node->Next )
+		for( size_t i=0; i<node->Count; i++ )
+			if( !memcmp(&node->Vals[i], &val, sizeof val) )
+				return base + i;
+	return SIZE_MAX;
+}
+
+HARBOL_EXPORT bool harbol_unrolled_del_by_index(struct HarbolUnrolledList *const list, const size_t index, fnHarbolDestructor *const dtor)
+{
+	if( !list || index >= list->Len )
+		return false;
+	
+	size_t slot = 0;
+	struct HarbolUnrolledNode *prev = NULL;
+	struct HarbolUnrolledNode *const node = _harbol_unrolled_seek(list, index, &slot, &prev);
+	if( dtor )
+		(*dtor)(&node->Vals[slot].Ptr);
+	memmove(node->Vals + slot, node->Vals + slot + 1, (node->Count - slot - 1) * sizeof *node->Vals);
+	node->Count--;
+	list->Len--;
+	
+	if( !node->Count ) {
+		prev ? (prev->Next = node->Next) : (list->Head = node->Next);
+		if( list->Tail==node )
+			list->Tail = prev;
+		_harbol_unrolled_node_free(list, node);
+		return true;
+	}
+	
+	struct HarbolUnrolledNode *const next = node->Next;
+	if( node->Count >= HARBOL_UNROLLED_MIN_VALS || !next )
+		return true;
+	else if( node->Count + next->Count <= HARBOL_UNROLLED_NODE_VALS ) {
+		memcpy(node->Vals + node->Count, next->Vals, next->Count * sizeof *next->Vals);
+		node->Count += next->Count;
+		node->Next = next->Next;
+		if( list->Tail==next )
+			list->Tail = node;
+		_harbol_unrolled_node_free(list, next);
+	} else {
+		// the successor has plenty, so borrow just enough to get back to half full.
+		const size_t take = HARBOL_UNROLLED_MIN_VALS - node->Count;
+		memcpy(node->Vals + node->Count, next->Vals, take * sizeof *next->Vals);
+		memmove(next->Vals, next->Vals + take, (next->Count - take) * sizeof *next->Vals);
+		node->Count += take;
+		next->Count -= take;
+	}
+	return true;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledNode *harbol_unrolled_get_head_node(const struct HarbolUnrolledList *const list)
+{
+	return list ? list->Head : NULL;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledNode *harbol_unrolled_get_tail_node(const struct HarbolUnrolledList *const list)
+{
+	return list ? list->Tail : NULL;
+}
+
+HARBOL_EXPORT void harbol_unrolled_from_unilist(struct HarbolUnrolledList *const list, const struct HarbolUniList *const unilist)
+{
+	if( !list || !unilist )
+		return;
+	
+	for( struct HarbolUniListNode *n=unilist->Head; n; n = n->Next )
+		harbol_unrolled_insert_at_tail(list, n->Data);
+}
+
+HARBOL_EXPORT void harbol_unrolled_from_bilist(struct HarbolUnrolledList *const list, const struct HarbolBiList *const bilist)
+{
+	if( !list || !bilist )
+		return;
+	
+	for( struct HarbolBiListNode *n=bilist->Head; n; n = n->Next )
+		harbol_unrolled_insert_at_tail(list, n->Data);
+}
+
+HARBOL_EXPORT void harbol_unrolled_from_hashmap(struct HarbolUnrolledList *const list, const struct HarbolHashMap *const map)
+{
+	if( !list || !map )
+		return;
+	
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		struct HarbolVector *vec = harbol_hashmap_get_bucket(map, i);
+		for( size_t n=0; n<harbol_vector_get_count(vec); n++ ) {
+			struct HarbolKeyValPair *node = vec->Table[n].Ptr;
+			harbol_unrolled_insert_at_tail(list, node->Data);
+		}
+	}
+}
+
+HARBOL_EXPORT void harbol_unrolled_from_vector(struct HarbolUnrolledList *const list, const struct HarbolVector *const v)
+{
+	if( !list || !v || !v->Table )
+		return;
+	
+	for( size_t i=0; i<v->Count; i++ )
+		harbol_unrolled_insert_at_tail(list, v->Table[i]);
+}
+
+HARBOL_EXPORT void harbol_unrolled_from_graph(struct HarbolUnrolledList *const list, const struct HarbolGraph *const graph)
+{
+	if( !list || !graph )
+		return;
+	
+	for( size_t i=0; i<graph->Vertices.Count; i++ ) {
+		struct HarbolGraphVertex *vert = graph->Vertices.Table[i].Ptr;
+		harbol_unrolled_insert_at_tail(list, vert->Data);
+	}
+}
+
+HARBOL_EXPORT void harbol_unrolled_from_linkmap(struct HarbolUnrolledList *const list, const struct HarbolLinkMap *const map)
+{
+	if( !list || !map )
+		return;
+	
+	for( size_t i=0; i<map->Order.Count; i++ ) {
+		struct HarbolKeyValPair *n = map->Order.Table[i].Ptr;
+		if( !n )
+			continue;
+		harbol_unrolled_insert_at_tail(list, n->Data);
+	}
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_unilist(const struct HarbolUniList *const unilist)
+{
+	if( !unilist )
+		return NULL;
+	struct HarbolUnrolledList *const list = harbol_unrolled_new();
+	harbol_unrolled_from_unilist(list, unilist);
+	return list;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_bilist(const struct HarbolBiList *const bilist)
+{
+	if( !bilist )
+		return NULL;
+	struct HarbolUnrolledList *const list = harbol_unrolled_new();
+	harbol_unrolled_from_bilist(list, bilist);
+	return list;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_hashmap(const struct HarbolHashMap *const map)
+{
+	if( !map )
+		return NULL;
+	struct HarbolUnrolledList *const list = harbol_unrolled_new();
+	harbol_unrolled_from_hashmap(list, map);
+	return list;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_vector(const struct HarbolVector *const v)
+{
+	if( !v )
+		return NULL;
+	struct HarbolUnrolledList *const list = harbol_unrolled_new();
+	harbol_unrolled_from_vector(list, v);
+	return list;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_graph(const struct HarbolGraph *const graph)
+{
+	if( !graph )
+		return NULL;
+	struct HarbolUnrolledList *const list = harbol_unrolled_new();
+	harbol_unrolled_from_graph(list, graph);
+	return list;
+}
+
+HARBOL_EXPORT struct HarbolUnrolledList *harbol_unrolled_new_from_linkmap(const struct HarbolLinkMap *const map)
+{
+	if( !map )
+		return NULL;
+	struct HarbolUnrolledList *const list = harbol_unrolled_new();
+	harbol_unrolled_from_linkmap(list, map);
+	return list;
+}
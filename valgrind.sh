@@ -1,7 +1,7 @@
 #!/bin/bash
 cd "$(dirname "$0")"
 
-gcc -Wall -Wextra -pedantic -g -O2 stringobj.c vector.c hashmap.c unilist.c bilist.c bytebuffer.c tuple.c mempool.c graph.c tree.c linkmap.c variant.c cfg.c plugins.c test_suite.c -o harbol_testprogram -ldl -Wl,--export-dynamic
+gcc -Wall -Wextra -pedantic -g -O2 stringobj.c vector.c objpool.c hashmap.c hashset.c unilist.c bilist.c unrolled.c lockfree.c bytebuffer.c bytecursor.c lz.c checksum.c encoding.c tuple.c coltable.c mempool.c graph.c tree.c intrusive.c bufchain.c filewriter.c linkmap.c frozenmap.c cache.c bptree.c variant.c cfg.c plugins.c test_suite.c -o harbol_testprogram -ldl -lpthread -Wl,--export-dynamic
 
 gcc -Wall -Wextra -g -O2 -shared -c test_harbol_plugins/test_plugin.c
 gcc -shared -o test_plugin.so test_plugin.o
@@ -179,6 +179,20 @@ HARBOL_EXPORT void harbol_vector_from_unilist(struct HarbolVector *const v, cons
 		v->Table[v->Count++] = n->Data;
 }
 
+HARBOL_EXPORT void harbol_vector_from_unrolled(struct HarbolVector *const v, const struct HarbolUnrolledList *const list)
+{
+	if( !v || !list )
+		return;
+	else if( !v->Table || v->Count+list->Len >= v->Len )
+		while( v->Count+list->Len >= v->Len )
+			harbol_vector_resize(v);
+	
+	for( struct HarbolUnrolledNode *n=list->Head; n; n = n->Next ) {
+		memcpy(v->Table + v->Count, n->Vals, n->Count * sizeof *n->Vals);
+		v->Count += n->Count;
+	}
+}
+
 HARBOL_EXPORT void harbol_vector_from_bilist(struct HarbolVector *const v, const struct HarbolBiList *const list)
 {
 	if( !v || !list )
@@ -199,8 +213,9 @@ HARBOL_EXPORT void harbol_vector_from_hashmap(struct HarbolVector *const restric
 		while( v->Count+map->Count >= v->Len )
 			harbol_vector_resize(v);
 	
-	for( size_t i=0; i<map->Len; i++ ) {
-		struct HarbolVector *restrict vec = map->Table + i;
+	// buckets past 'Len' belong to an unfinished incremental rehash.
+	for( size_t i=0; i<harbol_hashmap_get_bucket_count(map); i++ ) {
+		struct HarbolVector *restrict vec = harbol_hashmap_get_bucket(map, i);
 		for( size_t n=0; n<harbol_vector_get_count(vec); n++ ) {
 			struct HarbolKeyValPair *node = vec->Table[n].Ptr;
 			v->Table[v->Count++] = node->Data;
@@ -232,10 +247,36 @@ HARBOL_EXPORT void harbol_vector_from_linkmap(struct HarbolVector *const v, cons
 	
 	for( size_t i=0; i<map->Order.Count; i++ ) {
 		struct HarbolKeyValPair *n = map->Order.Table[i].Ptr;
-		v->Table[v->Count++] = n->Data;
+		if( n )
+			v->Table[v->Count++] = n->Data;
 	}
 }
 
+HARBOL_EXPORT void harbol_vector_from_hashset(struct HarbolVector *const v, const struct HarbolHashSet *const set)
+{
+	if( !v || !set )
+		return;
+	else if( !v->Table || v->Count+set->Count >= v->Len )
+		while( v->Count+set->Count >= v->Len )
+			harbol_vector_resize(v);
+	
+	union HarbolValue key;
+	for( size_t iter=0; harbol_hashset_next(set, &iter, &key); )
+		v->Table[v->Count++] = key;
+}
+
+HARBOL_EXPORT void harbol_vector_from_bptree(struct HarbolVector *const v, const struct HarbolBPTree *const tree)
+{
+	if( !v || !tree )
+		return;
+	else if( !v->Table || v->Count+tree->Count >= v->Len )
+		while( v->Count+tree->Count >= v->Len )
+			harbol_vector_resize(v);
+	
+	for( struct HarbolBPTreeIter iter = harbol_bptree_first(tree); harbol_bptree_iter_valid(&iter); harbol_bptree_iter_next(&iter) )
+		v->Table[v->Count++] = harbol_bptree_iter_val(&iter);
+}
+
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_unilist(const struct HarbolUniList *const list)
 {
 	if( !list )
@@ -281,6 +322,33 @@ HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_linkmap(const struct H
 	return v;
 }
 
+HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_unrolled(const struct HarbolUnrolledList *const list)
+{
+	if( !list )
+		return NULL;
+	struct HarbolVector *v = harbol_vector_new();
+	harbol_vector_from_unrolled(v, list);
+	return v;
+}
+
+HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_hashset(const struct HarbolHashSet *const set)
+{
+	if( !set )
+		return NULL;
+	struct HarbolVector *v = harbol_vector_new();
+	harbol_vector_from_hashset(v, set);
+	return v;
+}
+
+HARBOL_EXPORT struct HarbolVector *harbol_vector_new_from_bptree(const struct HarbolBPTree *const tree)
+{
+	if( !tree )
+		return NULL;
+	struct HarbolVector *v = harbol_vector_new();
+	harbol_vector_from_bptree(v, tree);
+	return v;
+}
+
 
 HARBOL_EXPORT void harbol_generic_vector_resizer(void *const table_n_len, const size_t len, const size_t element_size)
 {